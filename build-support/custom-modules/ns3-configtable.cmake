@@ -133,6 +133,9 @@ macro(write_configtable)
   string(APPEND out "Build with runtime logging    : ")
   check_on_or_off("NS3_LOG" "NS3_LOG")
 
+  string(APPEND out "Build without trace sources   : ")
+  check_on_or_off("NS3_DISABLE_TRACING" "NS3_DISABLE_TRACING")
+
   string(APPEND out "Build version embedding       : ")
   check_on_or_off("NS3_ENABLE_BUILD_VERSION" "ENABLE_BUILD_VERSION")
 
@@ -166,6 +169,9 @@ macro(write_configtable)
   string(APPEND out "MPI Support                   : ")
   check_on_or_off("NS3_MPI" "MPI_FOUND")
 
+  string(APPEND out "Multithreading Support        : ")
+  check_on_or_off("NS3_MTP" "ENABLE_MTP")
+
   string(APPEND out "ns-3 Click Integration        : ")
   check_on_or_off("ON" "NS3_CLICK")
 
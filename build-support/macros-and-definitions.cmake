@@ -846,6 +846,12 @@ macro(process_options)
     endif()
   endif()
 
+  set(ENABLE_MTP FALSE)
+  if(${NS3_MTP})
+    add_definitions(-DNS3_MTP)
+    set(ENABLE_MTP TRUE)
+  endif()
+
   mark_as_advanced(Boost_INCLUDE_DIR)
   find_package(Boost)
   if(${Boost_FOUND})
@@ -1144,6 +1150,10 @@ macro(process_options)
   if(${NS3_ASSERT} OR (${build_profile} STREQUAL "debug"))
     add_definitions(-DNS3_ASSERT_ENABLE)
   endif()
+  # Compile the trace sources away if requested, e.g., for production runs
+  if(${NS3_DISABLE_TRACING})
+    add_definitions(-DNS3_DISABLE_TRACING)
+  endif()
 
   set(ENABLE_TAP OFF)
   if(${NS3_TAP})
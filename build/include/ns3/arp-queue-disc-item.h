@@ -0,0 +1 @@
+#include "/root/repo/src/internet/model/arp-queue-disc-item.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/network/helper/binary-trace-helper.h"
@@ -0,0 +1 @@
+#include "../../../src/core/model/checkpoint.h"
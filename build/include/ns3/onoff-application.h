@@ -0,0 +1 @@
+#include "/root/repo/src/applications/model/onoff-application.h"
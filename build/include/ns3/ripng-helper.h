@@ -0,0 +1 @@
+#include "/root/repo/src/internet/helper/ripng-helper.h"
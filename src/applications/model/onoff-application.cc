@@ -263,6 +263,80 @@ OnOffApplication::StopApplication() // Called at time specified by Stop
     }
 }
 
+void
+OnOffApplication::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    SaveApplicationState(writer);
+    if (m_socket)
+    {
+        Address local;
+        m_socket->GetSockName(local);
+        WriteSocketAddress(writer, "local", local);
+    }
+    writer.Write("connected", m_connected);
+    writer.Write("cbrRateFailSafe", m_cbrRateFailSafe.GetBitRate());
+    writer.Write("residualBits", m_residualBits);
+    writer.Write("lastStartTime", m_lastStartTime);
+    writer.Write("totBytes", m_totBytes);
+    writer.Write("seq", m_seq);
+    if (m_unsentPacket)
+    {
+        WritePacket(writer, "unsentPacket", m_unsentPacket);
+    }
+    // During the on periods, the next start/stop event stops sending
+    writer.Write("sending", m_sendEvent.IsPending());
+    writer.WriteEvent("startStop", m_startStopEvent);
+    writer.WriteEvent("send", m_sendEvent);
+}
+
+void
+OnOffApplication::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    RestoreApplicationState(reader);
+    if (reader.Has("local"))
+    {
+        // Bind to the saved port, rather than to the next ephemeral one
+        m_socket = Socket::CreateSocket(GetNode(), m_tid);
+        if (m_socket->Bind(ReadSocketAddress(reader, "local")) == -1)
+        {
+            NS_FATAL_ERROR("Failed to bind socket");
+        }
+        if (InetSocketAddress::IsMatchingType(m_peer))
+        {
+            m_socket->SetIpTos(m_tos); // Affects only IPv4 sockets.
+        }
+        // The connection was notified before the checkpoint: connect before
+        // setting the callbacks.
+        m_socket->Connect(m_peer);
+        m_socket->SetConnectCallback(MakeCallback(&OnOffApplication::ConnectionSucceeded, this),
+                                     MakeCallback(&OnOffApplication::ConnectionFailed, this));
+        m_socket->SetAllowBroadcast(true);
+        m_socket->ShutdownRecv();
+        if (reader.Read<bool>("stopped"))
+        {
+            m_socket->Close();
+        }
+    }
+    m_connected = reader.Read<bool>("connected");
+    m_cbrRateFailSafe = DataRate(reader.Read<uint64_t>("cbrRateFailSafe"));
+    m_residualBits = reader.Read<uint32_t>("residualBits");
+    m_lastStartTime = reader.Read<Time>("lastStartTime");
+    m_totBytes = reader.Read<uint64_t>("totBytes");
+    m_seq = reader.Read<uint32_t>("seq");
+    m_unsentPacket = reader.Has("unsentPacket") ? ReadPacket(reader, "unsentPacket") : nullptr;
+    if (reader.Read<bool>("sending"))
+    {
+        m_startStopEvent = reader.ReadEvent("startStop", &OnOffApplication::StopSending, this);
+    }
+    else
+    {
+        m_startStopEvent = reader.ReadEvent("startStop", &OnOffApplication::StartSending, this);
+    }
+    m_sendEvent = reader.ReadEvent("send", &OnOffApplication::SendPacket, this);
+}
+
 void
 OnOffApplication::CancelEvents()
 {
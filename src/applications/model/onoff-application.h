@@ -92,8 +92,11 @@ class Socket;
  * (enable its "EnableSeqTsSizeHeader" attribute), or users may extract
  * the header via trace sources.  Note that the continuity of the sequence
  * number may be disrupted across On/Off cycles.
+ *
+ * The application can be saved to a checkpoint when its socket is an
+ * IPv4 or IPv6 one.
  */
-class OnOffApplication : public Application
+class OnOffApplication : public Application, public Checkpointable
 {
   public:
     /**
@@ -124,6 +127,10 @@ class OnOffApplication : public Application
 
     int64_t AssignStreams(int64_t stream) override;
 
+    // Inherited from Checkpointable
+    void SaveState(CheckpointWriter& writer) const override;
+    void RestoreState(CheckpointReader& reader) override;
+
   protected:
     void DoDispose() override;
 
@@ -192,6 +192,34 @@ PacketSink::StopApplication() // Called at time specified by Stop
     }
 }
 
+void
+PacketSink::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(!m_socketList.empty(), "Cannot save the accepted sockets: not supported");
+    NS_ABORT_MSG_IF(!m_buffer.empty(), "Cannot save a sink with partially received packets");
+    SaveApplicationState(writer);
+    writer.Write("totalRx", m_totalRx);
+}
+
+void
+PacketSink::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    RestoreApplicationState(reader);
+    m_totalRx = reader.Read<uint64_t>("totalRx");
+    // The socket is bound to the configured address, without scheduling
+    // any event: reopen it as when the application was started.
+    if (reader.Read<bool>("started"))
+    {
+        StartApplication();
+    }
+    if (reader.Read<bool>("stopped"))
+    {
+        StopApplication();
+    }
+}
+
 void
 PacketSink::HandleRead(Ptr<Socket> socket)
 {
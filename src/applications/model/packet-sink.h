@@ -70,8 +70,11 @@ class Packet;
  * as a callback on the receiving socket.  By default, when logging is
  * enabled, it prints out the size of packets and their address.
  * A tracing source to Receive() is also available.
+ *
+ * A checkpoint can be saved when the sink has no accepted socket and no
+ * partially received packet.
  */
-class PacketSink : public Application
+class PacketSink : public Application, public Checkpointable
 {
   public:
     /**
@@ -111,6 +114,10 @@ class PacketSink : public Application
                                       const Address& to,
                                       const SeqTsSizeHeader& header);
 
+    // Inherited from Checkpointable
+    void SaveState(CheckpointWriter& writer) const override;
+    void RestoreState(CheckpointReader& reader) override;
+
   protected:
     void DoDispose() override;
 
@@ -203,6 +203,47 @@ UdpEchoClient::StopApplication()
     Simulator::Cancel(m_sendEvent);
 }
 
+void
+UdpEchoClient::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    SaveApplicationState(writer);
+    writer.Write("sent", m_sent);
+    if (m_socket)
+    {
+        Address local;
+        Address peer;
+        m_socket->GetSockName(local);
+        m_socket->GetPeerName(peer);
+        WriteSocketAddress(writer, "local", local);
+        WriteSocketAddress(writer, "peer", peer);
+    }
+    writer.WriteEvent("send", m_sendEvent);
+}
+
+void
+UdpEchoClient::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    RestoreApplicationState(reader);
+    m_sent = reader.Read<uint32_t>("sent");
+    if (reader.Has("local"))
+    {
+        // Bind to the saved port, rather than to the next ephemeral one
+        TypeId tid = TypeId::LookupByName("ns3::UdpSocketFactory");
+        m_socket = Socket::CreateSocket(GetNode(), tid);
+        if (m_socket->Bind(ReadSocketAddress(reader, "local")) == -1)
+        {
+            NS_FATAL_ERROR("Failed to bind socket");
+        }
+        m_socket->SetIpTos(m_tos); // Affects only IPv4 sockets.
+        m_socket->Connect(ReadSocketAddress(reader, "peer"));
+        m_socket->SetRecvCallback(MakeCallback(&UdpEchoClient::HandleRead, this));
+        m_socket->SetAllowBroadcast(true);
+    }
+    m_sendEvent = reader.ReadEvent("send", &UdpEchoClient::Send, this);
+}
+
 void
 UdpEchoClient::SetDataSize(uint32_t dataSize)
 {
@@ -36,7 +36,7 @@ class Packet;
  *
  * Every packet sent should be returned by the server and received here.
  */
-class UdpEchoClient : public Application
+class UdpEchoClient : public Application, public Checkpointable
 {
   public:
     /**
@@ -130,6 +130,10 @@ class UdpEchoClient : public Application
      */
     void SetFill(uint8_t* fill, uint32_t fillSize, uint32_t dataSize);
 
+    // Inherited from Checkpointable
+    void SaveState(CheckpointWriter& writer) const override;
+    void RestoreState(CheckpointReader& reader) override;
+
   private:
     void StartApplication() override;
     void StopApplication() override;
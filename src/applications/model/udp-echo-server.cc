@@ -155,6 +155,30 @@ UdpEchoServer::StopApplication()
     }
 }
 
+void
+UdpEchoServer::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    SaveApplicationState(writer);
+}
+
+void
+UdpEchoServer::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    RestoreApplicationState(reader);
+    // The sockets are bound to the configured port, without scheduling
+    // any event: reopen them as when the application was started.
+    if (reader.Read<bool>("started"))
+    {
+        StartApplication();
+    }
+    if (reader.Read<bool>("stopped"))
+    {
+        StopApplication();
+    }
+}
+
 void
 UdpEchoServer::HandleRead(Ptr<Socket> socket)
 {
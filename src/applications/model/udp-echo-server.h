@@ -41,7 +41,7 @@ class Packet;
  *
  * Every packet received is sent back.
  */
-class UdpEchoServer : public Application
+class UdpEchoServer : public Application, public Checkpointable
 {
   public:
     /**
@@ -52,6 +52,10 @@ class UdpEchoServer : public Application
     UdpEchoServer();
     ~UdpEchoServer() override;
 
+    // Inherited from Checkpointable
+    void SaveState(CheckpointWriter& writer) const override;
+    void RestoreState(CheckpointReader& reader) override;
+
   private:
     void StartApplication() override;
     void StopApplication() override;
@@ -158,6 +158,27 @@ CalendarScheduler::Insert(const Event& ev)
     ResizeUp();
 }
 
+void
+CalendarScheduler::BulkInsert(const std::vector<Event>& events)
+{
+    NS_LOG_FUNCTION(this << events.size());
+    for (const auto& ev : events)
+    {
+        DoInsert(ev);
+    }
+    m_qSize += events.size();
+    // Resize at once to the final number of buckets
+    uint32_t newSize = m_nBuckets;
+    while (m_qSize > newSize * 2 && newSize < 32768)
+    {
+        newSize *= 2;
+    }
+    if (newSize != m_nBuckets)
+    {
+        Resize(newSize);
+    }
+}
+
 bool
 CalendarScheduler::IsEmpty() const
 {
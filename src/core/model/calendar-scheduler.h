@@ -106,6 +106,7 @@ class CalendarScheduler : public Scheduler
 
     // Inherited
     void Insert(const Scheduler::Event& ev) override;
+    void BulkInsert(const std::vector<Scheduler::Event>& events) override;
     bool IsEmpty() const override;
     Scheduler::Event PeekNext() const override;
     Scheduler::Event RemoveNext() override;
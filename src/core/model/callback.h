@@ -29,6 +29,7 @@
 
 #include <functional>
 #include <memory>
+#include <tuple>
 #include <typeinfo>
 #include <utility>
 #include <vector>
@@ -72,6 +73,8 @@ namespace ns3
  * or not we really want to use it.
  */
 
+class CallbackComponentBase;
+
 /**
  * \ingroup callbackimpl
  * Abstract base class for CallbackImpl
@@ -92,6 +95,13 @@ class CallbackImplBase : public SimpleRefCount<CallbackImplBase>
      * \return \c true if we are equal
      */
     virtual bool IsEqual(Ptr<const CallbackImplBase> other) const = 0;
+    /**
+     * Get the components of the callback, i.e., the callable object and the
+     * bound arguments, to test the equality of two callbacks.
+     *
+     * \return The callback components.
+     */
+    virtual std::vector<std::shared_ptr<CallbackComponentBase>> GetComponents() const = 0;
     /**
      * Get the name of this object type.
      * \return The object type as a string.
@@ -196,9 +206,10 @@ class CallbackComponent : public CallbackComponentBase
  * Partial specialization of class CallbackComponent with isComparable equal
  * to false. This is required to handle callable objects (such as lambdas and
  * objects returned by std::function and std::bind) that do not provide the
- * equality operator. Given that these objects cannot be compared and the only
- * purpose of the class CallbackComponent is to compare values, no object is
- * stored in this specialized class.
+ * equality operator. These objects cannot be compared: this specialized class
+ * stores the address of the callable object held by the callback
+ * implementation, so that the copies of a callback, which share their
+ * implementation, compare equal.
  *
  * \tparam T The type of the callback component.
  */
@@ -209,9 +220,10 @@ class CallbackComponent<T, false> : public CallbackComponentBase
     /**
      * Constructor
      *
-     * \param [in] t The value of the callback component
+     * \param [in] t The callable object held by the callback implementation
      */
     CallbackComponent(const T& t)
+        : m_comp(&t)
     {
     }
 
@@ -219,12 +231,17 @@ class CallbackComponent<T, false> : public CallbackComponentBase
      * Equality test between functions
      *
      * \param [in] other CallbackParam Ptr
-     * \return \c true if we are equal
+     * \return \c true if we are the same callable object
      */
     bool IsEqual(std::shared_ptr<const CallbackComponentBase> other) const override
     {
-        return false;
+        auto p = std::dynamic_pointer_cast<const CallbackComponent<T, false>>(other);
+
+        return p != nullptr && p->m_comp == m_comp;
     }
+
+  private:
+    const T* m_comp; //!< the address of the callable object
 };
 
 /// Vector of callback components
@@ -234,6 +251,11 @@ typedef std::vector<std::shared_ptr<CallbackComponentBase>> CallbackComponentVec
  * \ingroup callbackimpl
  * CallbackImpl class with varying numbers of argument types
  *
+ * The callable object and the bound arguments are stored by the
+ * CallbackFunctorImpl subclass, which provides the function calling them:
+ * a call through the callback is a single indirect call, without virtual
+ * dispatch nor std::function.
+ *
  * \tparam R \explicit The return type of the Callback.
  * \tparam UArgs \explicit The types of any arguments to the Callback.
  */
@@ -241,36 +263,6 @@ template <typename R, typename... UArgs>
 class CallbackImpl : public CallbackImplBase
 {
   public:
-    /**
-     * Constructor.
-     *
-     * \param func the callable object
-     * \param components the callback components (callable object and bound arguments)
-     */
-    CallbackImpl(std::function<R(UArgs...)> func, const CallbackComponentVector& components)
-        : m_func(func),
-          m_components(components)
-    {
-    }
-
-    /**
-     * Get the stored function.
-     * \return A const reference to the stored function.
-     */
-    const std::function<R(UArgs...)>& GetFunction() const
-    {
-        return m_func;
-    }
-
-    /**
-     * Get the vector of callback components.
-     * \return A const reference to the vector of callback components.
-     */
-    const CallbackComponentVector& GetComponents() const
-    {
-        return m_components;
-    }
-
     /**
      * Function call operator.
      *
@@ -279,7 +271,7 @@ class CallbackImpl : public CallbackImplBase
      */
     R operator()(UArgs... uargs) const
     {
-        return m_func(uargs...);
+        return m_invoke(this, std::forward<UArgs>(uargs)...);
     }
 
     bool IsEqual(Ptr<const CallbackImplBase> other) const override
@@ -291,26 +283,25 @@ class CallbackImpl : public CallbackImplBase
         {
             return false;
         }
-
-        // if the two callback implementations are made of a distinct number of
-        // components, they are different
-        if (m_components.size() != otherDerived->GetComponents().size())
+        if (otherDerived == this)
         {
-            return false;
+            return true;
         }
 
-        // the two functions are equal if they compare equal or the shared pointers
-        // point to the same locations
-        if (!m_components.at(0)->IsEqual(otherDerived->GetComponents().at(0)) &&
-            m_components.at(0) != otherDerived->GetComponents().at(0))
+        CallbackComponentVector components = GetComponents();
+        CallbackComponentVector otherComponents = otherDerived->GetComponents();
+
+        // if the two callback implementations are made of a distinct number of
+        // components, they are different
+        if (components.size() != otherComponents.size())
         {
             return false;
         }
 
-        // check if the remaining components are equal one by one
-        for (std::size_t i = 1; i < m_components.size(); i++)
+        // check if the components are equal one by one
+        for (std::size_t i = 0; i < components.size(); i++)
         {
-            if (!m_components.at(i)->IsEqual(otherDerived->GetComponents().at(i)))
+            if (!components.at(i)->IsEqual(otherComponents.at(i)))
             {
                 return false;
             }
@@ -343,12 +334,29 @@ class CallbackImpl : public CallbackImplBase
         return id;
     }
 
-  private:
-    /// Stores the callable object associated with this callback (as a lambda)
-    std::function<R(UArgs...)> m_func;
+  protected:
+    /**
+     * Function calling the callable object of a CallbackImpl.
+     *
+     * \param impl The CallbackImpl.
+     * \param uargs The arguments to the Callback.
+     * \return Callback value
+     */
+    typedef R (*Invoker)(const CallbackImpl* impl, UArgs&&... uargs);
 
-    /// Stores the original callable object and the bound arguments, if any
-    std::vector<std::shared_ptr<CallbackComponentBase>> m_components;
+    /**
+     * Constructor.
+     *
+     * \param invoke The function calling the callable object.
+     */
+    CallbackImpl(Invoker invoke)
+        : m_invoke(invoke)
+    {
+    }
+
+  private:
+    /// The function calling the callable object
+    Invoker m_invoke;
 };
 
 /**
@@ -383,6 +391,114 @@ class CallbackBase
     Ptr<CallbackImplBase> m_impl; //!< the pimpl
 };
 
+/**
+ * \ingroup callbackimpl
+ * CallbackImpl storing the callable object and the values of the bound
+ * arguments in place.
+ *
+ * \tparam F \explicit The type of the callable object, or of the Callback
+ *            when binding arguments to an existing Callback.
+ * \tparam BArgTuple \explicit The std::tuple of the types of the bound
+ *            arguments.
+ * \tparam R \explicit The return type of the Callback.
+ * \tparam UArgs \explicit The types of any arguments to the Callback.
+ */
+template <typename F, typename BArgTuple, typename R, typename... UArgs>
+class CallbackFunctorImpl;
+
+/**
+ * \ingroup callbackimpl
+ * CallbackImpl storing the callable object and the values of the bound
+ * arguments in place.
+ *
+ * \tparam F \explicit The type of the callable object, or of the Callback
+ *            when binding arguments to an existing Callback.
+ * \tparam BArgs \explicit The types of the bound arguments.
+ * \tparam R \explicit The return type of the Callback.
+ * \tparam UArgs \explicit The types of any arguments to the Callback.
+ */
+template <typename F, typename... BArgs, typename R, typename... UArgs>
+class CallbackFunctorImpl<F, std::tuple<BArgs...>, R, UArgs...> : public CallbackImpl<R, UArgs...>
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param func The callable object.
+     * \param bargs The values of the bound arguments.
+     */
+    CallbackFunctorImpl(F func, BArgs... bargs)
+        : CallbackImpl<R, UArgs...>(&CallbackFunctorImpl::DoInvoke),
+          m_func(std::move(func)),
+          m_bargs(std::move(bargs)...)
+    {
+    }
+
+    CallbackComponentVector GetComponents() const override
+    {
+        CallbackComponentVector components;
+        if constexpr (std::is_base_of_v<CallbackBase, F>)
+        {
+            components = m_func.GetImpl()->GetComponents();
+        }
+        else
+        {
+            // The original function is comparable if it is a function pointer or
+            // a pointer to a member function or a pointer to a member data.
+            constexpr bool isComp =
+                std::is_function_v<std::remove_pointer_t<F>> || std::is_member_pointer_v<F>;
+            components.push_back(std::make_shared<CallbackComponent<F, isComp>>(m_func));
+        }
+        std::apply(
+            [&components](const BArgs&... bargs) {
+                (components.push_back(std::make_shared<CallbackComponent<BArgs>>(bargs)), ...);
+            },
+            m_bargs);
+        return components;
+    }
+
+  private:
+    /**
+     * Call the callable object of a CallbackFunctorImpl.
+     *
+     * \param impl The CallbackFunctorImpl.
+     * \param uargs The arguments to the Callback.
+     * \return Callback value
+     */
+    static R DoInvoke(const CallbackImpl<R, UArgs...>* impl, UArgs&&... uargs)
+    {
+        return static_cast<const CallbackFunctorImpl*>(impl)->Invoke(
+            std::index_sequence_for<BArgs...>{},
+            std::forward<UArgs>(uargs)...);
+    }
+
+    /**
+     * Call the callable object with the bound arguments.
+     *
+     * \tparam INDEX \deduced The indices of the bound arguments.
+     * \param seq A compile-time integer sequence.
+     * \param uargs The arguments to the Callback.
+     * \return Callback value
+     */
+    template <std::size_t... INDEX>
+    R Invoke(std::index_sequence<INDEX...> seq, UArgs&&... uargs) const
+    {
+        if constexpr (std::is_void_v<R>)
+        {
+            std::invoke(m_func, std::get<INDEX>(m_bargs)..., std::forward<UArgs>(uargs)...);
+        }
+        else
+        {
+            return std::invoke(m_func, std::get<INDEX>(m_bargs)..., std::forward<UArgs>(uargs)...);
+        }
+    }
+
+    /// The callable object, which may keep a state of its own
+    mutable F m_func;
+    /// The values of the bound arguments
+    mutable std::tuple<BArgs...> m_bargs;
+};
+
 /**
  * \ingroup callback
  * \brief Callback template class
@@ -464,17 +580,10 @@ class Callback : public CallbackBase
     template <typename... BArgs>
     Callback(const Callback<R, BArgs..., UArgs...>& cb, BArgs... bargs)
     {
-        auto f = cb.DoPeekImpl()->GetFunction();
-
-        CallbackComponentVector components(cb.DoPeekImpl()->GetComponents());
-        components.insert(components.end(),
-                          {std::make_shared<CallbackComponent<std::decay_t<BArgs>>>(bargs)...});
-
-        m_impl = Create<CallbackImpl<R, UArgs...>>(
-            [f, bargs...](auto&&... uargs) -> R {
-                return f(bargs..., std::forward<decltype(uargs)>(uargs)...);
-            },
-            components);
+        m_impl = Create<
+            CallbackFunctorImpl<Callback<R, BArgs..., UArgs...>, std::tuple<BArgs...>, R, UArgs...>>(
+            cb,
+            bargs...);
     }
 
     /**
@@ -492,27 +601,11 @@ class Callback : public CallbackBase
     template <typename T,
               typename... BArgs,
               std::enable_if_t<!std::is_base_of_v<CallbackBase, T> &&
-                                   std::is_invocable_r_v<R, T, BArgs..., UArgs...>,
+                                   std::is_invocable_r_v<R, T&, BArgs&..., UArgs...>,
                                int> = 0>
     Callback(T func, BArgs... bargs)
     {
-        // store the function in a std::function object
-        std::function<R(BArgs..., UArgs...)> f(func);
-
-        // The original function is comparable if it is a function pointer or
-        // a pointer to a member function or a pointer to a member data.
-        constexpr bool isComp =
-            std::is_function_v<std::remove_pointer_t<T>> || std::is_member_pointer_v<T>;
-
-        CallbackComponentVector components(
-            {std::make_shared<CallbackComponent<T, isComp>>(func),
-             std::make_shared<CallbackComponent<std::decay_t<BArgs>>>(bargs)...});
-
-        m_impl = Create<CallbackImpl<R, UArgs...>>(
-            [f, bargs...](auto&&... uargs) -> R {
-                return f(bargs..., std::forward<decltype(uargs)>(uargs)...);
-            },
-            components);
+        m_impl = Create<CallbackFunctorImpl<T, std::tuple<BArgs...>, R, UArgs...>>(func, bargs...);
     }
 
   private:
@@ -532,17 +625,13 @@ class Callback : public CallbackBase
     {
         Callback<R, std::tuple_element_t<sizeof...(bargs) + INDEX, std::tuple<UArgs...>>...> cb;
 
-        const auto f = DoPeekImpl()->GetFunction();
-
-        CallbackComponentVector components(DoPeekImpl()->GetComponents());
-        components.insert(components.end(),
-                          {std::make_shared<CallbackComponent<std::decay_t<BoundArgs>>>(bargs)...});
-
-        cb.m_impl = Create<std::remove_pointer_t<decltype(cb.DoPeekImpl())>>(
-            [f, bargs...](auto&&... uargs) mutable {
-                return f(bargs..., std::forward<decltype(uargs)>(uargs)...);
-            },
-            components);
+        cb.m_impl = Create<CallbackFunctorImpl<
+            Callback,
+            std::tuple<std::decay_t<BoundArgs>...>,
+            R,
+            std::tuple_element_t<sizeof...(bargs) + INDEX, std::tuple<UArgs...>>...>>(
+            *this,
+            std::forward<BoundArgs>(bargs)...);
 
         return cb;
     }
@@ -587,7 +676,10 @@ class Callback : public CallbackBase
      */
     R operator()(UArgs... uargs) const
     {
-        return (*(DoPeekImpl()))(uargs...);
+        // Keep the implementation, hence the object and the bound arguments,
+        // alive until the call returns, even if the call resets this Callback
+        Ptr<CallbackImpl<R, UArgs...>> impl = DoPeekImpl();
+        return (*impl)(std::forward<UArgs>(uargs)...);
     }
 
     /**
@@ -745,6 +837,49 @@ MakeNullCallback()
     return Callback<R, Args...>();
 }
 
+/**
+ * \ingroup callbackimpl
+ * The type of the Callback left after binding the first arguments.
+ *
+ * \tparam R \explicit The return type of the Callback.
+ * \tparam N \explicit The number of bound arguments.
+ * \tparam ArgTuple \explicit The std::tuple of the types of the arguments.
+ * \tparam Seq \explicit The sequence 0..M-1, where M is the number of
+ *             arguments left unbound.
+ */
+template <typename R, std::size_t N, typename ArgTuple, typename Seq>
+struct BoundCallbackType;
+
+/**
+ * \ingroup callbackimpl
+ * The type of the Callback left after binding the first arguments.
+ *
+ * \tparam R \explicit The return type of the Callback.
+ * \tparam N \explicit The number of bound arguments.
+ * \tparam Args \explicit The types of the arguments.
+ * \tparam INDEX \explicit The indices of the arguments left unbound, from 0.
+ */
+template <typename R, std::size_t N, typename... Args, std::size_t... INDEX>
+struct BoundCallbackType<R, N, std::tuple<Args...>, std::index_sequence<INDEX...>>
+{
+    /// The Callback type
+    typedef Callback<R, std::tuple_element_t<N + INDEX, std::tuple<Args...>>...> Type;
+};
+
+/**
+ * \ingroup callbackimpl
+ * The type of the Callback left after binding the first arguments.
+ *
+ * \tparam R \explicit The return type of the Callback.
+ * \tparam N \explicit The number of bound arguments.
+ * \tparam Args \explicit The types of the arguments.
+ */
+template <typename R, std::size_t N, typename... Args>
+using BoundCallback = typename BoundCallbackType<R,
+                                                 N,
+                                                 std::tuple<Args...>,
+                                                 std::make_index_sequence<sizeof...(Args) - N>>::Type;
+
 /**
  * \ingroup makeboundcallback
  * @{
@@ -760,7 +895,7 @@ template <typename R, typename... Args, typename... BArgs>
 auto
 MakeBoundCallback(R (*fnPtr)(Args...), BArgs&&... bargs)
 {
-    return Callback<R, Args...>(fnPtr).Bind(std::forward<BArgs>(bargs)...);
+    return BoundCallback<R, sizeof...(BArgs), Args...>(fnPtr, std::forward<BArgs>(bargs)...);
 }
 
 /**
@@ -781,14 +916,14 @@ template <typename T, typename OBJ, typename R, typename... Args, typename... BA
 auto
 MakeCallback(R (T::*memPtr)(Args...), OBJ objPtr, BArgs... bargs)
 {
-    return Callback<R, Args...>(memPtr, objPtr).Bind(bargs...);
+    return BoundCallback<R, sizeof...(BArgs), Args...>(memPtr, objPtr, bargs...);
 }
 
 template <typename T, typename OBJ, typename R, typename... Args, typename... BArgs>
 auto
 MakeCallback(R (T::*memPtr)(Args...) const, OBJ objPtr, BArgs... bargs)
 {
-    return Callback<R, Args...>(memPtr, objPtr).Bind(bargs...);
+    return BoundCallback<R, sizeof...(BArgs), Args...>(memPtr, objPtr, bargs...);
 }
 
 /**@}*/
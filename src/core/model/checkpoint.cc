@@ -0,0 +1,749 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "checkpoint.h"
+
+#include "callback.h"
+#include "config.h"
+#include "event-impl.h"
+#include "event-profiler.h"
+#include "fatal-error.h"
+#include "log.h"
+#include "object-ptr-container.h"
+#include "object.h"
+#include "pointer.h"
+#include "random-variable-stream.h"
+#include "simulator-impl.h"
+#include "simulator.h"
+#include "string.h"
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+
+/**
+ * \file
+ * \ingroup checkpoint
+ * ns3::Checkpointable, ns3::CheckpointWriter, ns3::CheckpointReader and
+ * ns3::CheckpointManager implementations.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("Checkpoint");
+
+namespace
+{
+
+/** The first line of a checkpoint file. */
+const std::string g_header = "ns3-checkpoint 1";
+
+/** The path of the section of the simulator. */
+const std::string g_simulatorPath = "Simulator";
+/** The prefix of the paths of the sections of the random variable streams. */
+const std::string g_streamPrefix = "RandomVariableStream/";
+/** The prefix of the paths of the sections of the global states. */
+const std::string g_globalPrefix = "Global/";
+
+/** An object to save, with its path. */
+typedef std::pair<std::string, Ptr<Object>> PathObject;
+
+/**
+ * \ingroup checkpoint
+ * Get the types registered as stateless.
+ * \returns The types.
+ */
+std::set<TypeId>&
+GetStatelessTypes()
+{
+    static std::set<TypeId> types;
+    return types;
+}
+
+/** A global state. */
+struct GlobalState
+{
+    CheckpointManager::SaveFunction save;       //!< Save the state.
+    CheckpointManager::RestoreFunction restore; //!< Restore the state.
+};
+
+/**
+ * \ingroup checkpoint
+ * Get the registered global states.
+ * \returns The global states, by name.
+ */
+std::map<std::string, GlobalState>&
+GetGlobalStates()
+{
+    static std::map<std::string, GlobalState> states;
+    return states;
+}
+
+/**
+ * \ingroup checkpoint
+ * Escape the characters separating the fields and the lines.
+ *
+ * \param [in] s The string.
+ * \returns The escaped string.
+ */
+std::string
+Escape(const std::string& s)
+{
+    std::string escaped;
+    escaped.reserve(s.size());
+    for (char c : s)
+    {
+        switch (c)
+        {
+        case '%':
+            escaped += "%25";
+            break;
+        case ' ':
+            escaped += "%20";
+            break;
+        case '\n':
+            escaped += "%0A";
+            break;
+        case '\r':
+            escaped += "%0D";
+            break;
+        default:
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+/**
+ * \ingroup checkpoint
+ * Undo Escape().
+ *
+ * \param [in] s The escaped string.
+ * \returns The string.
+ */
+std::string
+Unescape(const std::string& s)
+{
+    std::string unescaped;
+    unescaped.reserve(s.size());
+    for (std::size_t i = 0; i < s.size(); i++)
+    {
+        if (s[i] == '%' && i + 2 < s.size())
+        {
+            unescaped += static_cast<char>(std::stoi(s.substr(i + 1, 2), nullptr, 16));
+            i += 2;
+        }
+        else
+        {
+            unescaped += s[i];
+        }
+    }
+    return unescaped;
+}
+
+/**
+ * \ingroup checkpoint
+ * Check whether an attribute is saved in the checkpoints: the
+ * attributes with a getter and a setter, not holding objects or
+ * callbacks.
+ *
+ * \param [in] info The attribute.
+ * \returns \c true if the attribute is saved.
+ */
+bool
+IsSavedAttribute(const TypeId::AttributeInformation& info)
+{
+    return (info.flags & TypeId::ATTR_GET) && (info.flags & TypeId::ATTR_SET) &&
+           info.accessor->HasGetter() && info.accessor->HasSetter() &&
+           info.supportLevel == TypeId::SUPPORTED &&
+           dynamic_cast<const PointerChecker*>(PeekPointer(info.checker)) == nullptr &&
+           dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker)) == nullptr &&
+           dynamic_cast<const CallbackChecker*>(PeekPointer(info.checker)) == nullptr;
+}
+
+/**
+ * \ingroup checkpoint
+ * Get the serialized value of an attribute.
+ *
+ * \param [in] object The object.
+ * \param [in] info The attribute.
+ * \returns The serialized value.
+ */
+std::string
+GetAttributeString(Ptr<const Object> object, const TypeId::AttributeInformation& info)
+{
+    Ptr<AttributeValue> value = info.checker->Create();
+    object->GetAttribute(info.name, *value);
+    return value->SerializeToString(info.checker);
+}
+
+/**
+ * \ingroup checkpoint
+ * Collect the objects reachable from an object, depth first.
+ *
+ * The objects are reached through the Pointer and ObjectPtrContainer
+ * attributes of the object, then through its aggregates, sorted by
+ * name so the order does not depend on the history of the object.
+ *
+ * \param [in] path The path of the object.
+ * \param [in] object The object.
+ * \param [in,out] visited The objects already reached.
+ * \param [in,out] objects The objects collected, with their paths.
+ */
+void
+CollectChildren(const std::string& path,
+                Ptr<Object> object,
+                std::set<const Object*>& visited,
+                std::vector<PathObject>& objects)
+{
+    auto add = [&visited, &objects](const std::string& childPath, Ptr<Object> child) {
+        if (child && visited.insert(PeekPointer(child)).second)
+        {
+            objects.emplace_back(childPath, child);
+            CollectChildren(childPath, child, visited, objects);
+        }
+    };
+
+    TypeId tid = object->GetInstanceTypeId();
+    TypeId parent;
+    do
+    {
+        for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+        {
+            TypeId::AttributeInformation info = tid.GetAttribute(i);
+            if (!(info.flags & TypeId::ATTR_GET) || !info.accessor->HasGetter())
+            {
+                continue;
+            }
+            if (dynamic_cast<const PointerChecker*>(PeekPointer(info.checker)) != nullptr)
+            {
+                PointerValue value;
+                object->GetAttribute(info.name, value);
+                add(path + "/" + info.name, value.Get<Object>());
+            }
+            else if (dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker)) !=
+                     nullptr)
+            {
+                ObjectPtrContainerValue container;
+                object->GetAttribute(info.name, container);
+                for (auto it = container.Begin(); it != container.End(); it++)
+                {
+                    add(path + "/" + info.name + "/" + std::to_string(it->first), it->second);
+                }
+            }
+        }
+        parent = tid;
+        tid = tid.GetParent();
+    } while (tid != parent);
+
+    // The aggregates share the same aggregates: claim them all before
+    // visiting their children, so their paths are relative to this object.
+    std::map<std::string, Ptr<Object>> aggregates;
+    Object::AggregateIterator it = object->GetAggregateIterator();
+    while (it.HasNext())
+    {
+        Ptr<Object> aggregate = ConstCast<Object>(it.Next());
+        if (visited.insert(PeekPointer(aggregate)).second)
+        {
+            aggregates["$" + aggregate->GetInstanceTypeId().GetName()] = aggregate;
+        }
+    }
+    for (const auto& [name, aggregate] : aggregates)
+    {
+        objects.emplace_back(path + "/" + name, aggregate);
+        CollectChildren(path + "/" + name, aggregate, visited, objects);
+    }
+}
+
+/**
+ * \ingroup checkpoint
+ * Collect the objects reachable from the root namespace objects.
+ * \returns The objects, with their paths.
+ */
+std::vector<PathObject>
+CollectObjects()
+{
+    std::vector<PathObject> objects;
+    std::set<const Object*> visited;
+    for (std::size_t i = 0; i < Config::GetRootNamespaceObjectN(); i++)
+    {
+        Ptr<Object> root = Config::GetRootNamespaceObject(i);
+        visited.insert(PeekPointer(root));
+        CollectChildren("", root, visited, objects);
+    }
+    return objects;
+}
+
+} // unnamed namespace
+
+Checkpointable::~Checkpointable()
+{
+}
+
+CheckpointWriter::CheckpointWriter(std::ostream& os,
+                                   const std::unordered_map<const EventImpl*, EventId>& events)
+    : m_os(os),
+      m_events(events)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+CheckpointWriter::WriteLine(const std::string& kind,
+                            const std::string& key,
+                            const std::string& value)
+{
+    m_os << kind << ' ' << Escape(key) << ' ' << Escape(value) << '\n';
+}
+
+void
+CheckpointWriter::BeginSection(const std::string& path, const std::string& type, bool initialized)
+{
+    NS_LOG_FUNCTION(this << path << type << initialized);
+    m_os << "section " << Escape(path) << ' ' << Escape(type) << ' ' << initialized << '\n';
+    m_path = path;
+}
+
+void
+CheckpointWriter::WriteAttribute(const std::string& name, const std::string& value)
+{
+    WriteLine("attribute", name, value);
+}
+
+void
+CheckpointWriter::WriteString(const std::string& key, const std::string& value)
+{
+    WriteLine("value", key, value);
+}
+
+void
+CheckpointWriter::WriteBytes(const std::string& key, const uint8_t* buffer, uint32_t size)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string hex;
+    hex.reserve(2 * size);
+    for (uint32_t i = 0; i < size; i++)
+    {
+        hex += digits[buffer[i] >> 4];
+        hex += digits[buffer[i] & 0xf];
+    }
+    WriteLine("value", key, hex);
+}
+
+void
+CheckpointWriter::WriteEvent(const std::string& key, const EventId& id)
+{
+    NS_LOG_FUNCTION(this << key << id.GetUid());
+    auto it = m_events.find(id.PeekEventImpl());
+    if (it == m_events.end() || it->second.GetUid() != id.GetUid())
+    {
+        // Expired or cancelled
+        return;
+    }
+    auto [written, inserted] = m_written.emplace(id.PeekEventImpl(), m_path + " " + key);
+    if (!inserted)
+    {
+        NS_FATAL_ERROR("Event " << key << " of " << m_path << " already saved as "
+                                << written->second);
+    }
+    m_os << "event " << Escape(key) << ' ' << id.GetTs() << ' ' << id.GetContext() << ' '
+         << id.GetUid() << '\n';
+}
+
+std::vector<EventId>
+CheckpointWriter::GetPendingEvents() const
+{
+    std::vector<EventId> events;
+    for (const auto& [event, id] : m_events)
+    {
+        if (m_written.find(event) == m_written.end())
+        {
+            events.push_back(id);
+        }
+    }
+    std::sort(events.begin(), events.end(), [](const EventId& a, const EventId& b) {
+        return a.GetTs() < b.GetTs() || (a.GetTs() == b.GetTs() && a.GetUid() < b.GetUid());
+    });
+    return events;
+}
+
+CheckpointReader::CheckpointReader(std::istream& is, const std::string& name)
+    : m_name(name),
+      m_current(nullptr)
+{
+    NS_LOG_FUNCTION(this << name);
+    std::string line;
+    if (!std::getline(is, line) || line != g_header)
+    {
+        NS_FATAL_ERROR(name << " is not a checkpoint, or has an unsupported version");
+    }
+    uint32_t lineNumber = 1;
+    while (std::getline(is, line))
+    {
+        lineNumber++;
+        std::vector<std::string> fields;
+        std::string::size_type start = 0;
+        std::string::size_type end;
+        while ((end = line.find(' ', start)) != std::string::npos)
+        {
+            fields.push_back(Unescape(line.substr(start, end - start)));
+            start = end + 1;
+        }
+        fields.push_back(Unescape(line.substr(start)));
+
+        const std::string& kind = fields[0];
+        if (kind == "section" && fields.size() == 4)
+        {
+            if (m_index.find(fields[1]) != m_index.end())
+            {
+                NS_FATAL_ERROR("Duplicate section " << fields[1] << " in " << name << ":"
+                                                    << lineNumber);
+            }
+            m_index[fields[1]] = m_sections.size();
+            m_sections.push_back({fields[1], fields[2], fields[3] == "1", false, {}, {}, {}});
+        }
+        else if (m_sections.empty())
+        {
+            NS_FATAL_ERROR("Invalid line in " << name << ":" << lineNumber << ": " << line);
+        }
+        else if (kind == "attribute" && fields.size() == 3)
+        {
+            m_sections.back().attributes.emplace_back(fields[1], fields[2]);
+        }
+        else if (kind == "value" && fields.size() == 3)
+        {
+            m_sections.back().values[fields[1]] = fields[2];
+        }
+        else if (kind == "event" && fields.size() == 5)
+        {
+            EventKey key;
+            key.ts = std::stoull(fields[2]);
+            key.context = std::stoul(fields[3]);
+            key.uid = std::stoul(fields[4]);
+            m_sections.back().events[fields[1]] = key;
+        }
+        else
+        {
+            NS_FATAL_ERROR("Invalid line in " << name << ":" << lineNumber << ": " << line);
+        }
+    }
+}
+
+CheckpointReader::Section*
+CheckpointReader::Select(const std::string& path)
+{
+    auto it = m_index.find(path);
+    m_current = it != m_index.end() ? &m_sections[it->second] : nullptr;
+    return m_current;
+}
+
+const std::string&
+CheckpointReader::GetPath() const
+{
+    return m_current->path;
+}
+
+bool
+CheckpointReader::Has(const std::string& key) const
+{
+    return m_current->values.find(key) != m_current->values.end() ||
+           m_current->events.find(key) != m_current->events.end();
+}
+
+void
+CheckpointReader::Missing(const std::string& key) const
+{
+    NS_FATAL_ERROR("Missing " << key << " of " << m_current->path << " in " << m_name);
+}
+
+const std::string&
+CheckpointReader::ReadString(const std::string& key) const
+{
+    auto it = m_current->values.find(key);
+    if (it == m_current->values.end())
+    {
+        Missing(key);
+    }
+    return it->second;
+}
+
+std::vector<uint8_t>
+CheckpointReader::ReadBytes(const std::string& key) const
+{
+    const std::string& hex = ReadString(key);
+    std::vector<uint8_t> buffer(hex.size() / 2);
+    for (std::size_t i = 0; i < buffer.size(); i++)
+    {
+        buffer[i] = static_cast<uint8_t>(std::stoi(hex.substr(2 * i, 2), nullptr, 16));
+    }
+    return buffer;
+}
+
+EventId
+CheckpointReader::ReadEventImpl(const std::string& key, EventImpl* event) const
+{
+    NS_LOG_FUNCTION(this << key << event);
+    auto it = m_current->events.find(key);
+    if (it == m_current->events.end())
+    {
+        event->Unref();
+        return EventId();
+    }
+    const EventKey& saved = it->second;
+    return Simulator::GetImplementation()->RestoreEvent(saved.ts,
+                                                        saved.context,
+                                                        saved.uid,
+                                                        event);
+}
+
+bool
+CheckpointManager::RegisterStateless(TypeId tid)
+{
+    GetStatelessTypes().insert(tid);
+    return true;
+}
+
+bool
+CheckpointManager::IsSupported(const Object* object)
+{
+    return dynamic_cast<const Checkpointable*>(object) != nullptr ||
+           GetStatelessTypes().count(object->GetInstanceTypeId()) > 0;
+}
+
+bool
+CheckpointManager::RegisterGlobal(const std::string& name,
+                                  SaveFunction save,
+                                  RestoreFunction restore)
+{
+    NS_ASSERT_MSG(GetGlobalStates().find(name) == GetGlobalStates().end(),
+                  "Global state " << name << " already registered");
+    GetGlobalStates()[name] = {save, restore};
+    return true;
+}
+
+void
+CheckpointManager::Save(const std::string& path)
+{
+    NS_LOG_FUNCTION(path);
+    Ptr<SimulatorImpl> impl = Simulator::GetImplementation();
+    auto simulator = dynamic_cast<const Checkpointable*>(PeekPointer(impl));
+    if (simulator == nullptr)
+    {
+        NS_FATAL_ERROR(impl->GetInstanceTypeId().GetName() << " does not support checkpoints");
+    }
+
+    std::unordered_map<const EventImpl*, EventId> events;
+    for (const auto& id : impl->GetPendingEvents())
+    {
+        events.emplace(id.PeekEventImpl(), id);
+    }
+
+    std::ostringstream oss;
+    oss << g_header << '\n';
+    CheckpointWriter writer(oss, events);
+    writer.BeginSection(g_simulatorPath, impl->GetInstanceTypeId().GetName(), true);
+    simulator->SaveState(writer);
+
+    for (const auto& [objectPath, object] : CollectObjects())
+    {
+        TypeId tid = object->GetInstanceTypeId();
+        if (!IsSupported(PeekPointer(object)))
+        {
+            NS_FATAL_ERROR("Cannot save " << objectPath << ": " << tid.GetName()
+                                          << " does not support checkpoints");
+        }
+        writer.BeginSection(objectPath, tid.GetName(), object->IsInitialized());
+        TypeId parent;
+        do
+        {
+            for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+            {
+                TypeId::AttributeInformation info = tid.GetAttribute(i);
+                if (IsSavedAttribute(info))
+                {
+                    writer.WriteAttribute(info.name, GetAttributeString(object, info));
+                }
+            }
+            parent = tid;
+            tid = tid.GetParent();
+        } while (tid != parent);
+
+        // The state of the random variable streams is saved below, with
+        // the streams not reachable from the root namespace objects.
+        auto checkpointable = dynamic_cast<const Checkpointable*>(PeekPointer(object));
+        if (checkpointable != nullptr && !DynamicCast<RandomVariableStream>(object))
+        {
+            checkpointable->SaveState(writer);
+        }
+    }
+
+    for (const auto& [id, stream] : RandomVariableStream::GetStreams())
+    {
+        writer.BeginSection(g_streamPrefix + id, stream->GetInstanceTypeId().GetName(), true);
+        stream->SaveState(writer);
+    }
+
+    for (const auto& [name, state] : GetGlobalStates())
+    {
+        writer.BeginSection(g_globalPrefix + name, "global", true);
+        state.save(writer);
+    }
+
+    std::vector<EventId> unsaved = writer.GetPendingEvents();
+    if (!unsaved.empty())
+    {
+        std::ostringstream list;
+        for (const auto& id : unsaved)
+        {
+            list << "\n  " << TimeStep(id.GetTs()).As(Time::S) << " context " << id.GetContext()
+                 << ": " << EventProfiler::GetTypeName(id.PeekEventImpl());
+        }
+        NS_FATAL_ERROR("Cannot save " << path << ": " << unsaved.size()
+                                      << " pending events are not owned by any object:"
+                                      << list.str());
+    }
+
+    std::ofstream file(path);
+    file << oss.str();
+    file.close();
+    if (!file)
+    {
+        NS_FATAL_ERROR("Cannot write " << path);
+    }
+    NS_LOG_INFO("Saved " << events.size() << " events to " << path);
+}
+
+void
+CheckpointManager::Restore(const std::string& path)
+{
+    NS_LOG_FUNCTION(path);
+    std::ifstream file(path);
+    if (!file)
+    {
+        NS_FATAL_ERROR("Cannot read " << path);
+    }
+    CheckpointReader reader(file, path);
+
+    Ptr<SimulatorImpl> impl = Simulator::GetImplementation();
+    auto simulator = dynamic_cast<Checkpointable*>(PeekPointer(impl));
+    CheckpointReader::Section* section = reader.Select(g_simulatorPath);
+    if (simulator == nullptr || section == nullptr ||
+        section->type != impl->GetInstanceTypeId().GetName())
+    {
+        NS_FATAL_ERROR("Cannot restore " << path << " with "
+                                         << impl->GetInstanceTypeId().GetName());
+    }
+
+    // Initialize the objects first: this may schedule events, which are
+    // superseded by the saved ones.
+    for (const auto& [objectPath, object] : CollectObjects())
+    {
+        section = reader.Select(objectPath);
+        if (section != nullptr && section->initialized && !object->IsInitialized())
+        {
+            object->Initialize();
+        }
+    }
+
+    reader.Select(g_simulatorPath);
+    simulator->RestoreState(reader);
+    reader.m_current->restored = true;
+
+    // Restoring an object may create new objects, such as the sockets of
+    // the applications: restore them in turn, until no new object appears.
+    std::set<const Object*> restored;
+    bool found;
+    do
+    {
+        found = false;
+        for (const auto& [objectPath, object] : CollectObjects())
+        {
+            if (!restored.insert(PeekPointer(object)).second)
+            {
+                continue;
+            }
+            found = true;
+            TypeId tid = object->GetInstanceTypeId();
+            section = reader.Select(objectPath);
+            if (section == nullptr)
+            {
+                NS_FATAL_ERROR("Cannot restore " << objectPath << " (" << tid.GetName()
+                                                 << "): not found in " << path);
+            }
+            if (section->type != tid.GetName())
+            {
+                NS_FATAL_ERROR("Cannot restore " << objectPath << ": " << tid.GetName()
+                                                 << " saved as " << section->type);
+            }
+            for (const auto& [name, value] : section->attributes)
+            {
+                TypeId::AttributeInformation info;
+                if (!tid.LookupAttributeByName(name, &info))
+                {
+                    NS_FATAL_ERROR("Cannot restore attribute " << name << " of " << objectPath);
+                }
+                if (GetAttributeString(object, info) != value &&
+                    !object->SetAttributeFailSafe(name, StringValue(value)))
+                {
+                    NS_FATAL_ERROR("Cannot restore attribute " << name << " of " << objectPath
+                                                               << " to " << value);
+                }
+            }
+            auto checkpointable = dynamic_cast<Checkpointable*>(PeekPointer(object));
+            if (checkpointable != nullptr && !DynamicCast<RandomVariableStream>(object))
+            {
+                checkpointable->RestoreState(reader);
+            }
+            section->restored = true;
+        }
+    } while (found);
+
+    for (const auto& [id, stream] : RandomVariableStream::GetStreams())
+    {
+        section = reader.Select(g_streamPrefix + id);
+        if (section == nullptr || section->type != stream->GetInstanceTypeId().GetName())
+        {
+            NS_FATAL_ERROR("Cannot restore the random variable stream "
+                           << id << " (" << stream->GetInstanceTypeId().GetName()
+                           << "): not found in " << path);
+        }
+        stream->RestoreState(reader);
+        section->restored = true;
+    }
+
+    for (const auto& [name, state] : GetGlobalStates())
+    {
+        section = reader.Select(g_globalPrefix + name);
+        if (section == nullptr)
+        {
+            NS_FATAL_ERROR("Cannot restore " << name << ": not found in " << path);
+        }
+        state.restore(reader);
+        section->restored = true;
+    }
+
+    for (const auto& saved : reader.m_sections)
+    {
+        if (!saved.restored)
+        {
+            NS_FATAL_ERROR("Cannot restore " << path << ": " << saved.path << " ("
+                                             << saved.type << ") not found in the simulation");
+        }
+    }
+    NS_LOG_INFO("Restored " << path << " at " << Simulator::Now().As(Time::S));
+}
+
+} // namespace ns3
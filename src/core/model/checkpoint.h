@@ -0,0 +1,503 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "abort.h"
+#include "event-id.h"
+#include "make-event.h"
+#include "nstime.h"
+#include "type-id.h"
+
+#include <map>
+#include <sstream>
+#include <stdint.h>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup checkpoint
+ * ns3::Checkpointable, ns3::CheckpointWriter, ns3::CheckpointReader and
+ * ns3::CheckpointManager declarations.
+ */
+
+/**
+ * \ingroup core
+ * \defgroup checkpoint Checkpoints
+ *
+ * Save the state of a simulation, and restore it into an identically
+ * constructed simulation, to resume from the saved time.
+ *
+ * A checkpoint holds:
+ *
+ * - the clock of the simulator and the pending events,
+ * - the attributes and the state of the objects reachable from the
+ *   root namespace objects of the configuration system (i.e., the
+ *   objects of the \c /NodeList and \c /ChannelList), through their
+ *   Pointer and ObjectPtrContainer attributes and their aggregates,
+ * - the seed, the run number and the state of all the random
+ *   variable streams, and
+ * - the global state registered with CheckpointManager::RegisterGlobal().
+ *
+ * The objects are identified by their configuration path, such as
+ * \c /NodeList/0/DeviceList/1/TxQueue.  The events are owned by the
+ * objects which hold their EventId: each object saves its events with
+ * CheckpointWriter::WriteEvent(), and recreates them with
+ * CheckpointReader::ReadEvent(), with the same time, context and
+ * unique id, so the events keep their relative order.
+ *
+ * Saving a checkpoint fails, with a message naming the culprit, if one
+ * of the reachable objects neither implements Checkpointable nor is
+ * registered as stateless, or if a pending event is not owned by any
+ * of the objects.
+ */
+
+namespace ns3
+{
+
+class EventImpl;
+class Object;
+
+/**
+ * \ingroup checkpoint
+ * Write the state of an object to a checkpoint.
+ *
+ * The values are stored under keys unique within the object.
+ */
+class CheckpointWriter
+{
+  public:
+    /**
+     * Write a value.
+     *
+     * Integers, booleans, Time, strings, and the types with a stream
+     * insertion operator and a matching extraction operator are
+     * supported.  The floating point values are written with enough
+     * digits to be restored exactly.
+     *
+     * \tparam T \deduced The type of the value.
+     * \param [in] key The key of the value.
+     * \param [in] value The value.
+     */
+    template <typename T>
+    void Write(const std::string& key, const T& value);
+    /**
+     * Write a string.
+     *
+     * \param [in] key The key of the value.
+     * \param [in] value The value.
+     */
+    void WriteString(const std::string& key, const std::string& value);
+    /**
+     * Write a buffer.
+     *
+     * \param [in] key The key of the value.
+     * \param [in] buffer The buffer.
+     * \param [in] size The size of the buffer.
+     */
+    void WriteBytes(const std::string& key, const uint8_t* buffer, uint32_t size);
+    /**
+     * Write a pending event, which can be recreated with
+     * CheckpointReader::ReadEvent().  Expired and cancelled events are
+     * not written.
+     *
+     * \param [in] key The key of the event.
+     * \param [in] id The event.
+     */
+    void WriteEvent(const std::string& key, const EventId& id);
+    /**
+     * Get the pending events not written yet.
+     *
+     * The objects which do not keep the EventId of their events, such as
+     * the channels for their deliveries, can find them by the dynamic
+     * type of their implementation.
+     *
+     * \returns The events, sorted by time and unique id.
+     */
+    std::vector<EventId> GetPendingEvents() const;
+
+  private:
+    friend class CheckpointManager;
+
+    /**
+     * Constructor.
+     *
+     * \param [in] os The output stream.
+     * \param [in] events The pending events, by implementation.
+     */
+    CheckpointWriter(std::ostream& os, const std::unordered_map<const EventImpl*, EventId>& events);
+    /**
+     * Start the section of an object.
+     *
+     * \param [in] path The path of the object.
+     * \param [in] type The type of the object.
+     * \param [in] initialized Whether the object has been initialized.
+     */
+    void BeginSection(const std::string& path, const std::string& type, bool initialized);
+    /**
+     * Write an attribute of the current object.
+     *
+     * \param [in] name The name of the attribute.
+     * \param [in] value The serialized value.
+     */
+    void WriteAttribute(const std::string& name, const std::string& value);
+    /**
+     * Write a line.
+     *
+     * \param [in] kind The kind of line.
+     * \param [in] key The key of the line.
+     * \param [in] value The value.
+     */
+    void WriteLine(const std::string& kind, const std::string& key, const std::string& value);
+
+    std::ostream& m_os; //!< The output stream.
+    /** The pending events, by implementation. */
+    const std::unordered_map<const EventImpl*, EventId>& m_events;
+    /** The pending events written so far. */
+    std::unordered_map<const EventImpl*, std::string> m_written;
+    /** The path of the current section. */
+    std::string m_path;
+};
+
+/**
+ * \ingroup checkpoint
+ * Read the state of an object from a checkpoint.
+ */
+class CheckpointReader
+{
+  public:
+    /**
+     * Check whether a value, or an event, was written.
+     *
+     * \param [in] key The key of the value.
+     * \returns \c true if the value exists.
+     */
+    bool Has(const std::string& key) const;
+    /**
+     * Read a value written by CheckpointWriter::Write().
+     *
+     * Reading a missing key is a fatal error.
+     *
+     * \tparam T The type of the value.
+     * \param [in] key The key of the value.
+     * \returns The value.
+     */
+    template <typename T>
+    T Read(const std::string& key) const;
+    /**
+     * Read a value, if it was written.
+     *
+     * \tparam T The type of the value.
+     * \param [in] key The key of the value.
+     * \param [in] defaultValue The value returned if the key is missing.
+     * \returns The value.
+     */
+    template <typename T>
+    T Read(const std::string& key, const T& defaultValue) const;
+    /**
+     * Read a string.
+     *
+     * \param [in] key The key of the value.
+     * \returns The value.
+     */
+    const std::string& ReadString(const std::string& key) const;
+    /**
+     * Read a buffer.
+     *
+     * \param [in] key The key of the value.
+     * \returns The buffer.
+     */
+    std::vector<uint8_t> ReadBytes(const std::string& key) const;
+    /**
+     * Recreate an event written by CheckpointWriter::WriteEvent(), with
+     * its original time, context and unique id.
+     *
+     * \tparam FUNC \deduced The type of the function to invoke.
+     * \tparam Ts \deduced The types of the arguments.
+     * \param [in] key The key of the event.
+     * \param [in] f The function to invoke, as for Simulator::Schedule().
+     * \param [in] args The arguments of the function.
+     * \returns The event, or an expired EventId if no event was written.
+     */
+    template <typename FUNC, typename... Ts>
+    EventId ReadEvent(const std::string& key, FUNC f, Ts&&... args) const;
+    /**
+     * Recreate an event written by CheckpointWriter::WriteEvent(), with
+     * its original time, context and unique id.
+     *
+     * \param [in] key The key of the event.
+     * \param [in] event The implementation of the event, released if no
+     * event was written.
+     * \returns The event, or an expired EventId if no event was written.
+     */
+    EventId ReadEventImpl(const std::string& key, EventImpl* event) const;
+    /**
+     * Get the path of the current object.
+     * \returns The path.
+     */
+    const std::string& GetPath() const;
+
+  private:
+    friend class CheckpointManager;
+
+    /** The key of a saved event. */
+    struct EventKey
+    {
+        uint64_t ts;      //!< The event time, in time steps.
+        uint32_t context; //!< The event context.
+        uint32_t uid;     //!< The event unique id.
+    };
+
+    /** The saved state of an object. */
+    struct Section
+    {
+        std::string path; //!< The path of the object.
+        std::string type; //!< The type of the object.
+        bool initialized; //!< Whether the object was initialized.
+        bool restored;    //!< Whether the object has been restored.
+        /** The attributes. */
+        std::vector<std::pair<std::string, std::string>> attributes;
+        /** The values. */
+        std::map<std::string, std::string> values;
+        /** The events. */
+        std::map<std::string, EventKey> events;
+    };
+
+    /**
+     * Constructor.
+     *
+     * \param [in] is The input stream.
+     * \param [in] name The name of the checkpoint, for the error messages.
+     */
+    CheckpointReader(std::istream& is, const std::string& name);
+    /**
+     * Find the section of an object, and make it the current one.
+     *
+     * \param [in] path The path of the object.
+     * \returns The section, or \c nullptr if the object was not saved.
+     */
+    Section* Select(const std::string& path);
+    /**
+     * Abort on a missing key.
+     *
+     * \param [in] key The key.
+     */
+    [[noreturn]] void Missing(const std::string& key) const;
+
+    std::string m_name;                    //!< The name of the checkpoint.
+    std::vector<Section> m_sections;       //!< The sections, in order.
+    std::map<std::string, size_t> m_index; //!< The sections, by path.
+    Section* m_current;                    //!< The current section.
+};
+
+/**
+ * \ingroup checkpoint
+ * Interface of the objects which can save their state to a checkpoint.
+ *
+ * The attributes with both a getter and a setter are saved and restored
+ * by the CheckpointManager; the objects only handle the state not
+ * accessible through their attributes, including their pending events.
+ *
+ * The state is restored into an object constructed and configured
+ * like the saved one, after the objects have been initialized, and
+ * after the events pending at that time have been discarded.  The
+ * objects created while restoring, such as the sockets created by the
+ * applications, are restored afterwards, if they are reachable.
+ */
+class Checkpointable
+{
+  public:
+    virtual ~Checkpointable();
+
+    /**
+     * Save the state.
+     *
+     * \param [in,out] writer The checkpoint writer.
+     */
+    virtual void SaveState(CheckpointWriter& writer) const = 0;
+    /**
+     * Restore the state.
+     *
+     * \param [in,out] reader The checkpoint reader.
+     */
+    virtual void RestoreState(CheckpointReader& reader) = 0;
+};
+
+/**
+ * \ingroup checkpoint
+ * Save and restore the whole simulation.
+ *
+ * \see Simulator::Checkpoint() and Simulator::Restore()
+ */
+class CheckpointManager
+{
+  public:
+    /**
+     * Save the state of the simulation.
+     *
+     * \param [in] path The name of the checkpoint file.
+     */
+    static void Save(const std::string& path);
+    /**
+     * Restore the state of the simulation.
+     *
+     * The simulation must have been constructed like the saved one, and
+     * not yet run.  The events pending when restoring are discarded.
+     *
+     * \param [in] path The name of the checkpoint file.
+     */
+    static void Restore(const std::string& path);
+
+    /**
+     * Declare that the objects of a type, excluding its subclasses,
+     * have no state beyond their attributes.
+     *
+     * \param [in] tid The TypeId of the objects.
+     * \returns \c true.
+     */
+    static bool RegisterStateless(TypeId tid);
+    /**
+     * Check whether an object can be saved.
+     *
+     * \param [in] object The object.
+     * \returns \c true if the object implements Checkpointable, or its
+     * type is registered as stateless.
+     */
+    static bool IsSupported(const Object* object);
+
+    /** Function saving a global state. */
+    typedef void (*SaveFunction)(CheckpointWriter& writer);
+    /** Function restoring a global state. */
+    typedef void (*RestoreFunction)(CheckpointReader& reader);
+    /**
+     * Register a global state, i.e., not attached to an object.
+     *
+     * The global states are restored after the objects.
+     *
+     * \param [in] name The unique name of the state.
+     * \param [in] save The function saving the state.
+     * \param [in] restore The function restoring the state.
+     * \returns \c true.
+     */
+    static bool RegisterGlobal(const std::string& name, SaveFunction save, RestoreFunction restore);
+};
+
+} // namespace ns3
+
+/**
+ * \ingroup checkpoint
+ * Register a type as having no state beyond its attributes.
+ *
+ * \param [in] type The type, in the current namespace.
+ */
+#define NS_CHECKPOINT_STATELESS(type)                                                              \
+    static bool g_##type##CheckpointStateless [[maybe_unused]] =                                   \
+        ns3::CheckpointManager::RegisterStateless(type::GetTypeId())
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3
+{
+
+template <typename T>
+void
+CheckpointWriter::Write(const std::string& key, const T& value)
+{
+    if constexpr (std::is_same_v<T, Time>)
+    {
+        WriteString(key, std::to_string(value.GetTimeStep()));
+    }
+    else if constexpr (std::is_convertible_v<T, std::string>)
+    {
+        WriteString(key, value);
+    }
+    else if constexpr (std::is_integral_v<T>)
+    {
+        WriteString(key, std::to_string(value));
+    }
+    else
+    {
+        std::ostringstream oss;
+        oss.precision(17);
+        oss << value;
+        WriteString(key, oss.str());
+    }
+}
+
+template <typename T>
+T
+CheckpointReader::Read(const std::string& key) const
+{
+    const std::string& value = ReadString(key);
+    if constexpr (std::is_same_v<T, Time>)
+    {
+        return TimeStep(std::stoll(value));
+    }
+    else if constexpr (std::is_same_v<T, std::string>)
+    {
+        return value;
+    }
+    else if constexpr (std::is_same_v<T, bool>)
+    {
+        return value == "1";
+    }
+    else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+    {
+        return static_cast<T>(std::stoll(value));
+    }
+    else if constexpr (std::is_integral_v<T>)
+    {
+        return static_cast<T>(std::stoull(value));
+    }
+    else
+    {
+        T result;
+        std::istringstream iss(value);
+        iss >> result;
+        NS_ABORT_MSG_IF(iss.fail(),
+                        "Invalid value \"" << value << "\" of " << key << " in "
+                                            << m_current->path);
+        return result;
+    }
+}
+
+template <typename T>
+T
+CheckpointReader::Read(const std::string& key, const T& defaultValue) const
+{
+    return Has(key) ? Read<T>(key) : defaultValue;
+}
+
+template <typename FUNC, typename... Ts>
+EventId
+CheckpointReader::ReadEvent(const std::string& key, FUNC f, Ts&&... args) const
+{
+    if (m_current->events.find(key) == m_current->events.end())
+    {
+        return EventId();
+    }
+    return ReadEventImpl(key, MakeEvent(f, std::forward<Ts>(args)...));
+}
+
+} // namespace ns3
+
+#endif /* CHECKPOINT_H */
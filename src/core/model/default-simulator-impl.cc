@@ -20,11 +20,19 @@
 #include "default-simulator-impl.h"
 
 #include "assert.h"
+#include "boolean.h"
+#include "double.h"
+#include "event-profiler.h"
 #include "log.h"
 #include "scheduler.h"
 #include "simulator.h"
+#include "string.h"
+#include "uinteger.h"
 
 #include <cmath>
+#include <fstream>
+#include <iostream>
+#include <vector>
 
 /**
  * \file
@@ -45,10 +53,34 @@ NS_OBJECT_ENSURE_REGISTERED(DefaultSimulatorImpl);
 TypeId
 DefaultSimulatorImpl::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::DefaultSimulatorImpl")
-                            .SetParent<SimulatorImpl>()
-                            .SetGroupName("Core")
-                            .AddConstructor<DefaultSimulatorImpl>();
+    static TypeId tid =
+        TypeId("ns3::DefaultSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Core")
+            .AddConstructor<DefaultSimulatorImpl>()
+            .AddAttribute("CompactionThreshold",
+                          "The fraction of cancelled events in the event list above which "
+                          "they are removed at once; 0 disables the compaction.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&DefaultSimulatorImpl::m_compactionThreshold),
+                          MakeDoubleChecker<double>(0, 1))
+            .AddAttribute("CompactionMinEvents",
+                          "The minimum number of cancelled events for a compaction.",
+                          UintegerValue(1024),
+                          MakeUintegerAccessor(&DefaultSimulatorImpl::m_compactionMinEvents),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("EnableProfiler",
+                          "Profile the wall-clock time spent in the events, by event type "
+                          "and by node; the report is written at Simulator::Destroy.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&DefaultSimulatorImpl::SetProfilerEnabled,
+                                              &DefaultSimulatorImpl::IsProfilerEnabled),
+                          MakeBooleanChecker())
+            .AddAttribute("ProfilerFile",
+                          "The file of the profiler report; empty for the standard error.",
+                          StringValue(""),
+                          MakeStringAccessor(&DefaultSimulatorImpl::m_profilerFile),
+                          MakeStringChecker());
     return tid;
 }
 
@@ -61,6 +93,10 @@ DefaultSimulatorImpl::DefaultSimulatorImpl()
     m_currentTs = 0;
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
+    m_cancelledEvents = 0;
+    m_compactionThreshold = 0;
+    m_compactionMinEvents = 1024;
+    m_compactionCount = 0;
     m_eventCount = 0;
     m_eventsWithContextEmpty = true;
     m_mainThreadId = std::this_thread::get_id();
@@ -83,6 +119,8 @@ DefaultSimulatorImpl::DoDispose()
         next.impl->Unref();
     }
     m_events = nullptr;
+    m_unscheduledEvents = 0;
+    m_cancelledEvents = 0;
     SimulatorImpl::DoDispose();
 }
 
@@ -100,6 +138,60 @@ DefaultSimulatorImpl::Destroy()
             ev->Invoke();
         }
     }
+    if (m_profiler)
+    {
+        WriteProfile();
+    }
+}
+
+void
+DefaultSimulatorImpl::SetProfilerEnabled(bool enable)
+{
+    NS_LOG_FUNCTION(this << enable);
+    if (!enable)
+    {
+        m_profiler.reset();
+    }
+    else if (!m_profiler)
+    {
+        m_profiler = std::make_unique<EventProfiler>();
+    }
+}
+
+bool
+DefaultSimulatorImpl::IsProfilerEnabled() const
+{
+    return bool(m_profiler);
+}
+
+const EventProfiler*
+DefaultSimulatorImpl::GetProfiler() const
+{
+    return m_profiler.get();
+}
+
+void
+DefaultSimulatorImpl::WriteProfile()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_profilerFile.empty())
+    {
+        m_profiler->Report(std::clog);
+    }
+    else
+    {
+        std::ofstream os(m_profilerFile);
+        if (!os.is_open())
+        {
+            NS_LOG_WARN("Unable to open profiler file " << m_profilerFile);
+            m_profiler->Report(std::clog);
+        }
+        else
+        {
+            m_profiler->Report(os);
+        }
+    }
+    m_profiler->Clear();
 }
 
 void
@@ -141,7 +233,18 @@ DefaultSimulatorImpl::ProcessOneEvent()
     m_currentTs = next.key.m_ts;
     m_currentContext = next.key.m_context;
     m_currentUid = next.key.m_uid;
-    next.impl->Invoke();
+    if (next.impl->IsCancelled() && m_cancelledEvents > 0)
+    {
+        m_cancelledEvents--;
+    }
+    if (m_profiler)
+    {
+        m_profiler->Invoke(next.impl, next.key.m_context);
+    }
+    else
+    {
+        next.impl->Invoke();
+    }
     next.impl->Unref();
 
     ProcessEventsWithContext();
@@ -168,6 +271,8 @@ DefaultSimulatorImpl::ProcessEventsWithContext()
         m_eventsWithContext.swap(eventsWithContext);
         m_eventsWithContextEmpty = true;
     }
+    std::vector<Scheduler::Event> events;
+    events.reserve(eventsWithContext.size());
     while (!eventsWithContext.empty())
     {
         EventWithContext event = eventsWithContext.front();
@@ -179,8 +284,9 @@ DefaultSimulatorImpl::ProcessEventsWithContext()
         ev.key.m_uid = m_uid;
         m_uid++;
         m_unscheduledEvents++;
-        m_events->Insert(ev);
+        events.push_back(ev);
     }
+    m_events->BulkInsert(events);
 }
 
 void
@@ -272,6 +378,45 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
     }
 }
 
+void
+DefaultSimulatorImpl::ScheduleWithContextBatch(const std::vector<Simulator::ContextEvent>& events)
+{
+    NS_LOG_FUNCTION(this << events.size());
+
+    if (m_mainThreadId == std::this_thread::get_id())
+    {
+        std::vector<Scheduler::Event> batch;
+        batch.reserve(events.size());
+        for (const auto& event : events)
+        {
+            Time tAbsolute = event.delay + TimeStep(m_currentTs);
+            Scheduler::Event ev;
+            ev.impl = event.event;
+            ev.key.m_ts = (uint64_t)tAbsolute.GetTimeStep();
+            ev.key.m_context = event.context;
+            ev.key.m_uid = m_uid;
+            m_uid++;
+            batch.push_back(ev);
+        }
+        m_unscheduledEvents += batch.size();
+        m_events->BulkInsert(batch);
+    }
+    else
+    {
+        std::unique_lock lock{m_eventsWithContextMutex};
+        for (const auto& event : events)
+        {
+            EventWithContext ev;
+            ev.context = event.context;
+            // Current time added in ProcessEventsWithContext()
+            ev.timestamp = event.delay.GetTimeStep();
+            ev.event = event.event;
+            m_eventsWithContext.push_back(ev);
+        }
+        m_eventsWithContextEmpty = false;
+    }
+}
+
 EventId
 DefaultSimulatorImpl::ScheduleNow(EventImpl* event)
 {
@@ -349,10 +494,125 @@ DefaultSimulatorImpl::Remove(const EventId& id)
 void
 DefaultSimulatorImpl::Cancel(const EventId& id)
 {
-    if (!IsExpired(id))
+    if (IsExpired(id))
+    {
+        return;
+    }
+    id.PeekEventImpl()->Cancel();
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        return;
+    }
+    m_cancelledEvents++;
+    if (m_compactionThreshold > 0 && m_cancelledEvents >= m_compactionMinEvents &&
+        m_cancelledEvents >= m_compactionThreshold * m_unscheduledEvents)
+    {
+        Compact();
+    }
+}
+
+void
+DefaultSimulatorImpl::Compact()
+{
+    NS_LOG_FUNCTION(this << m_unscheduledEvents << m_cancelledEvents);
+    std::vector<Scheduler::Event> events;
+    events.reserve(m_unscheduledEvents - m_cancelledEvents);
+    while (!m_events->IsEmpty())
+    {
+        Scheduler::Event next = m_events->RemoveNext();
+        if (next.impl->IsCancelled())
+        {
+            next.impl->Unref();
+            m_unscheduledEvents--;
+        }
+        else
+        {
+            events.push_back(next);
+        }
+    }
+    m_events->BulkInsert(events);
+    m_cancelledEvents = 0;
+    m_compactionCount++;
+}
+
+std::vector<EventId>
+DefaultSimulatorImpl::GetPendingEvents()
+{
+    NS_LOG_FUNCTION(this);
+    ProcessEventsWithContext();
+    std::vector<Scheduler::Event> events;
+    events.reserve(m_unscheduledEvents - m_cancelledEvents);
+    while (!m_events->IsEmpty())
+    {
+        Scheduler::Event next = m_events->RemoveNext();
+        if (next.impl->IsCancelled())
+        {
+            next.impl->Unref();
+            m_unscheduledEvents--;
+        }
+        else
+        {
+            events.push_back(next);
+        }
+    }
+    m_events->BulkInsert(events);
+    m_cancelledEvents = 0;
+
+    std::vector<EventId> pending;
+    pending.reserve(events.size());
+    for (const auto& ev : events)
+    {
+        pending.emplace_back(ev.impl, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+    }
+    return pending;
+}
+
+EventId
+DefaultSimulatorImpl::RestoreEvent(uint64_t ts, uint32_t context, uint32_t uid, EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << ts << context << uid << event);
+    NS_ASSERT_MSG(ts >= m_currentTs, "Restored event in the past");
+    NS_ASSERT_MSG(uid >= EventId::UID::VALID && uid < m_uid, "Invalid restored event uid " << uid);
+
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = ts;
+    ev.key.m_context = context;
+    ev.key.m_uid = uid;
+    m_unscheduledEvents++;
+    m_events->Insert(ev);
+    return EventId(event, ts, context, uid);
+}
+
+void
+DefaultSimulatorImpl::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    writer.Write("ts", m_currentTs);
+    writer.Write("context", m_currentContext);
+    writer.Write("currentUid", m_currentUid);
+    writer.Write("nextUid", m_uid);
+    writer.Write("eventCount", m_eventCount);
+}
+
+void
+DefaultSimulatorImpl::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    ProcessEventsWithContext();
+    while (!m_events->IsEmpty())
     {
-        id.PeekEventImpl()->Cancel();
+        Scheduler::Event next = m_events->RemoveNext();
+        next.impl->Unref();
     }
+    m_unscheduledEvents = 0;
+    m_cancelledEvents = 0;
+
+    m_currentTs = reader.Read<uint64_t>("ts");
+    m_currentContext = reader.Read<uint32_t>("context");
+    m_currentUid = reader.Read<uint32_t>("currentUid");
+    m_uid = reader.Read<uint32_t>("nextUid");
+    m_eventCount = reader.Read<uint64_t>("eventCount");
 }
 
 bool
@@ -397,4 +657,22 @@ DefaultSimulatorImpl::GetEventCount() const
     return m_eventCount;
 }
 
+uint64_t
+DefaultSimulatorImpl::GetPendingEventCount() const
+{
+    return m_unscheduledEvents - m_cancelledEvents;
+}
+
+uint64_t
+DefaultSimulatorImpl::GetCancelledEventCount() const
+{
+    return m_cancelledEvents;
+}
+
+uint64_t
+DefaultSimulatorImpl::GetCompactionCount() const
+{
+    return m_compactionCount;
+}
+
 } // namespace ns3
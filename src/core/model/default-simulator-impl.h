@@ -20,11 +20,14 @@
 #ifndef DEFAULT_SIMULATOR_IMPL_H
 #define DEFAULT_SIMULATOR_IMPL_H
 
+#include "checkpoint.h"
 #include "simulator-impl.h"
 
 #include <list>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 /**
  * \file
@@ -36,14 +39,28 @@ namespace ns3
 {
 
 // Forward
+class EventProfiler;
 class Scheduler;
 
 /**
  * \ingroup simulator
  *
  * The default single process simulator implementation.
+ *
+ * Cancelled events are not removed from the event list, they are
+ * discarded when they reach its head.  The number of cancelled events
+ * still in the event list is tracked, and when it exceeds the
+ * \c CompactionThreshold fraction of the event list (and at least
+ * \c CompactionMinEvents events), the cancelled events are removed
+ * from the event list at once.  This bounds the memory and the cost of
+ * the event list operations in simulations with many timers which are
+ * cancelled and rescheduled.
+ *
+ * When the \c EnableProfiler attribute is set, the events are executed
+ * through an EventProfiler, and its report is written at
+ * Simulator::Destroy() to the \c ProfilerFile file, or to \c std::clog.
  */
-class DefaultSimulatorImpl : public SimulatorImpl
+class DefaultSimulatorImpl : public SimulatorImpl, public Checkpointable
 {
   public:
     /**
@@ -64,6 +81,7 @@ class DefaultSimulatorImpl : public SimulatorImpl
     EventId Stop(const Time& delay) override;
     EventId Schedule(const Time& delay, EventImpl* event) override;
     void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    void ScheduleWithContextBatch(const std::vector<Simulator::ContextEvent>& events) override;
     EventId ScheduleNow(EventImpl* event) override;
     EventId ScheduleDestroy(EventImpl* event) override;
     void Remove(const EventId& id) override;
@@ -77,6 +95,35 @@ class DefaultSimulatorImpl : public SimulatorImpl
     uint32_t GetSystemId() const override;
     uint32_t GetContext() const override;
     uint64_t GetEventCount() const override;
+    uint64_t GetPendingEventCount() const override;
+    uint64_t GetCancelledEventCount() const override;
+    std::vector<EventId> GetPendingEvents() override;
+    EventId RestoreEvent(uint64_t ts, uint32_t context, uint32_t uid, EventImpl* event) override;
+
+    /**
+     * Save the clock and the event counters.
+     *
+     * \param [in,out] writer The checkpoint writer.
+     */
+    void SaveState(CheckpointWriter& writer) const override;
+    /**
+     * Discard the pending events, and restore the clock and the event
+     * counters.
+     *
+     * \param [in,out] reader The checkpoint reader.
+     */
+    void RestoreState(CheckpointReader& reader) override;
+
+    /**
+     * Get the number of compactions of the event list.
+     * \returns The number of compactions.
+     */
+    uint64_t GetCompactionCount() const;
+    /**
+     * Get the event profiler.
+     * \returns The event profiler, or \c nullptr if profiling is disabled.
+     */
+    const EventProfiler* GetProfiler() const;
 
   private:
     void DoDispose() override;
@@ -85,6 +132,20 @@ class DefaultSimulatorImpl : public SimulatorImpl
     void ProcessOneEvent();
     /** Move events from a different context into the main event queue. */
     void ProcessEventsWithContext();
+    /** Remove the cancelled events from the event list. */
+    void Compact();
+    /**
+     * Enable or disable the event profiler.
+     * \param [in] enable Whether to profile the events.
+     */
+    void SetProfilerEnabled(bool enable);
+    /**
+     * Check whether the event profiler is enabled.
+     * \returns \c true if the events are profiled.
+     */
+    bool IsProfilerEnabled() const;
+    /** Write the report of the event profiler and reset it. */
+    void WriteProfile();
 
     /** Wrap an event with its execution context. */
     struct EventWithContext
@@ -133,6 +194,18 @@ class DefaultSimulatorImpl : public SimulatorImpl
      *  not counting the Destroy events; this is used for validation
      */
     int m_unscheduledEvents;
+    /** Number of cancelled events in the event list. */
+    uint64_t m_cancelledEvents;
+    /** Fraction of cancelled events triggering a compaction; 0 disables compactions. */
+    double m_compactionThreshold;
+    /** Minimum number of cancelled events for a compaction. */
+    uint32_t m_compactionMinEvents;
+    /** Number of compactions of the event list. */
+    uint64_t m_compactionCount;
+    /** The event profiler, if enabled. */
+    std::unique_ptr<EventProfiler> m_profiler;
+    /** Name of the file of the profiler report; empty for \c std::clog. */
+    std::string m_profilerFile;
 
     /** Main execution thread. */
     std::thread::id m_mainThreadId;
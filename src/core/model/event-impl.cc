@@ -21,6 +21,9 @@
 
 #include "log.h"
 
+#include <atomic>
+#include <new>
+
 /**
  * \file
  * \ingroup events
@@ -32,6 +35,83 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("EventImpl");
 
+namespace
+{
+
+/** Granularity of the pool size classes, in bytes. */
+constexpr std::size_t POOL_GRANULARITY = 16;
+/** Number of pool size classes. */
+constexpr std::size_t POOL_CLASSES = 16;
+/** Maximum number of free blocks held for each size class. */
+constexpr uint32_t POOL_MAX_CACHED = 4096;
+
+/** A free block, linked in the list of its size class. */
+struct FreeBlock
+{
+    FreeBlock* next; //!< The next free block.
+};
+
+/**
+ * The event pool of a thread.
+ *
+ * Each block is allocated individually with the global allocator, so
+ * a block may be released by a thread other than the one which
+ * allocated it.  This structure is trivially destructible, so it
+ * remains usable while static objects are destroyed, after
+ * EventPoolDrain has released the blocks.
+ */
+struct EventPool
+{
+    FreeBlock* free[POOL_CLASSES]; //!< The free blocks of each size class.
+    uint32_t count[POOL_CLASSES];  //!< The number of free blocks of each size class.
+    EventImpl::PoolStats stats;    //!< The pool statistics.
+    bool registered;               //!< Whether the EventPoolDrain of the thread is set up.
+    bool drained;                  //!< Whether the thread is terminating.
+};
+
+/** The event pool of the calling thread. */
+thread_local EventPool g_eventPool{};
+
+/** Whether the event pool is used. */
+std::atomic<bool> g_eventPoolEnabled{true};
+
+/** Release the free blocks of the event pool at thread termination. */
+struct EventPoolDrain
+{
+    /** Destructor. */
+    ~EventPoolDrain()
+    {
+        for (std::size_t i = 0; i < POOL_CLASSES; ++i)
+        {
+            while (g_eventPool.free[i] != nullptr)
+            {
+                FreeBlock* block = g_eventPool.free[i];
+                g_eventPool.free[i] = block->next;
+                ::operator delete(block);
+            }
+            g_eventPool.count[i] = 0;
+        }
+        g_eventPool.stats.cached = 0;
+        g_eventPool.drained = true;
+    }
+};
+
+/** Set up the release of the event pool at thread termination. */
+thread_local EventPoolDrain g_eventPoolDrain;
+
+/**
+ * Get the size class of an event.
+ * \param [in] size The size of the event.
+ * \returns The size class, or POOL_CLASSES if the event is too large.
+ */
+inline std::size_t
+GetSizeClass(std::size_t size)
+{
+    return (size - 1) / POOL_GRANULARITY;
+}
+
+} // unnamed namespace
+
 EventImpl::~EventImpl()
 {
     NS_LOG_FUNCTION(this);
@@ -67,4 +147,64 @@ EventImpl::IsCancelled()
     return m_cancel;
 }
 
+void*
+EventImpl::operator new(std::size_t size)
+{
+    std::size_t sizeClass = GetSizeClass(size);
+    EventPool& pool = g_eventPool;
+    pool.stats.allocations++;
+    if (sizeClass >= POOL_CLASSES || !g_eventPoolEnabled.load(std::memory_order_relaxed))
+    {
+        return ::operator new(size);
+    }
+    FreeBlock* block = pool.free[sizeClass];
+    if (block != nullptr)
+    {
+        pool.free[sizeClass] = block->next;
+        pool.count[sizeClass]--;
+        pool.stats.cached--;
+        pool.stats.reused++;
+        return block;
+    }
+    // Allocate the whole size class, so the block fits any event of the class
+    return ::operator new((sizeClass + 1) * POOL_GRANULARITY);
+}
+
+void
+EventImpl::operator delete(void* p, std::size_t size)
+{
+    std::size_t sizeClass = GetSizeClass(size);
+    EventPool& pool = g_eventPool;
+    if (sizeClass >= POOL_CLASSES || pool.drained || pool.count[sizeClass] >= POOL_MAX_CACHED ||
+        !g_eventPoolEnabled.load(std::memory_order_relaxed))
+    {
+        ::operator delete(p);
+        return;
+    }
+    if (!pool.registered)
+    {
+        // Odr-use the drain to construct it in this thread
+        static_cast<void>(&g_eventPoolDrain);
+        pool.registered = true;
+    }
+    auto block = static_cast<FreeBlock*>(p);
+    block->next = pool.free[sizeClass];
+    pool.free[sizeClass] = block;
+    pool.count[sizeClass]++;
+    pool.stats.cached++;
+}
+
+void
+EventImpl::SetPoolEnabled(bool enabled)
+{
+    NS_LOG_FUNCTION(enabled);
+    g_eventPoolEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+EventImpl::PoolStats
+EventImpl::GetPoolStats()
+{
+    return g_eventPool.stats;
+}
+
 } // namespace ns3
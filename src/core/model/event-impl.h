@@ -21,6 +21,7 @@
 
 #include "simple-ref-count.h"
 
+#include <cstddef>
 #include <stdint.h>
 
 /**
@@ -41,10 +42,25 @@ namespace ns3
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * The memory of the events is recycled through a per-thread pool of
+ * free blocks, one list per size class of 16 bytes, up to 256 bytes.
+ * Since the events are deleted through Unref(), whether they were
+ * executed, cancelled or removed, the blocks return to the pool of the
+ * thread releasing the last reference, and the next events of the same
+ * size class are created without calling the global allocator.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
   public:
+    /** Event pool statistics, for the calling thread. */
+    struct PoolStats
+    {
+        uint64_t allocations; //!< Number of events allocated.
+        uint64_t reused;      //!< Number of allocations served from the pool.
+        uint32_t cached;      //!< Number of free blocks held by the pool.
+    };
+
     /** Default constructor. */
     EventImpl();
     /** Destructor. */
@@ -67,6 +83,37 @@ class EventImpl : public SimpleRefCount<EventImpl>
      */
     bool IsCancelled();
 
+    /**
+     * Allocate the memory of an event from the pool of the calling thread.
+     *
+     * \param [in] size The size of the event.
+     * \returns The memory block.
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * Return the memory of an event to the pool of the calling thread.
+     *
+     * \param [in] p The memory block.
+     * \param [in] size The size of the event.
+     */
+    static void operator delete(void* p, std::size_t size);
+
+    /**
+     * Enable or disable the event pool, in all threads.
+     *
+     * When disabled, the events are allocated and freed with the
+     * global allocator.  The pool is enabled by default.
+     *
+     * \param [in] enabled Whether to use the event pool.
+     */
+    static void SetPoolEnabled(bool enabled);
+    /**
+     * Get the statistics of the event pool of the calling thread.
+     *
+     * \returns The pool statistics.
+     */
+    static PoolStats GetPoolStats();
+
   protected:
     /**
      * Implementation for Invoke().
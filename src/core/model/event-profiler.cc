@@ -0,0 +1,205 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "event-profiler.h"
+
+#include "event-impl.h"
+#include "log.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cxxabi.h>
+#include <iomanip>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EventProfiler");
+
+namespace
+{
+
+/**
+ * \ingroup simulator
+ * Demangle a C++ type name.
+ *
+ * \param [in] mangled The mangled name.
+ * \returns The demangled name, or \pname{mangled} if it cannot be demangled.
+ */
+std::string
+Demangle(const char* mangled)
+{
+    int status;
+    char* demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+    if (status != 0)
+    {
+        return mangled;
+    }
+    std::string ret = demangled;
+    std::free(demangled);
+    return ret;
+}
+
+/**
+ * \ingroup simulator
+ * Sort the statistics by decreasing time, then by name.
+ *
+ * \tparam T \deduced The type of the name.
+ * \param [in,out] entries The statistics to sort.
+ */
+template <typename T>
+void
+SortByTime(std::vector<std::pair<T, EventProfiler::Entry>>& entries)
+{
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+        if (a.second.nanoseconds != b.second.nanoseconds)
+        {
+            return a.second.nanoseconds > b.second.nanoseconds;
+        }
+        return a.first < b.first;
+    });
+}
+
+} // unnamed namespace
+
+EventProfiler::EventProfiler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+EventProfiler::Invoke(EventImpl* event, uint32_t context)
+{
+    if (event->IsCancelled())
+    {
+        return;
+    }
+    EventImpl::PoolStats before = EventImpl::GetPoolStats();
+    auto start = std::chrono::steady_clock::now();
+    event->Invoke();
+    auto end = std::chrono::steady_clock::now();
+    EventImpl::PoolStats after = EventImpl::GetPoolStats();
+
+    uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    uint64_t allocations = after.allocations - before.allocations;
+    uint64_t heapAllocations = allocations - (after.reused - before.reused);
+    for (Entry* entry : {&m_types[std::type_index(typeid(*event))], &m_contexts[context]})
+    {
+        entry->count++;
+        entry->nanoseconds += ns;
+        entry->allocations += allocations;
+        entry->heapAllocations += heapAllocations;
+    }
+}
+
+void
+EventProfiler::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    m_types.clear();
+    m_contexts.clear();
+}
+
+EventProfiler::Entry
+EventProfiler::GetTotal() const
+{
+    Entry total;
+    for (const auto& [context, entry] : m_contexts)
+    {
+        total.count += entry.count;
+        total.nanoseconds += entry.nanoseconds;
+        total.allocations += entry.allocations;
+        total.heapAllocations += entry.heapAllocations;
+    }
+    return total;
+}
+
+std::vector<std::pair<std::string, EventProfiler::Entry>>
+EventProfiler::GetTypeEntries() const
+{
+    std::vector<std::pair<std::string, Entry>> entries;
+    entries.reserve(m_types.size());
+    for (const auto& [type, entry] : m_types)
+    {
+        entries.emplace_back(Demangle(type.name()), entry);
+    }
+    SortByTime(entries);
+    return entries;
+}
+
+std::vector<std::pair<uint32_t, EventProfiler::Entry>>
+EventProfiler::GetContextEntries() const
+{
+    std::vector<std::pair<uint32_t, Entry>> entries(m_contexts.begin(), m_contexts.end());
+    SortByTime(entries);
+    return entries;
+}
+
+std::string
+EventProfiler::GetTypeName(const EventImpl* event)
+{
+    return Demangle(typeid(*event).name());
+}
+
+void
+EventProfiler::WriteEntry(std::ostream& os,
+                          const std::string& kind,
+                          const std::string& name,
+                          const Entry& entry,
+                          uint64_t total)
+{
+    double percent = total > 0 ? 100.0 * entry.nanoseconds / total : 0;
+    double mean = entry.count > 0 ? entry.nanoseconds / 1e3 / entry.count : 0;
+    os << kind << '\t' << name << '\t' << entry.count << '\t' << std::fixed
+       << std::setprecision(6) << entry.nanoseconds / 1e9 << '\t' << std::setprecision(2)
+       << percent << '\t' << std::setprecision(3) << mean << '\t' << entry.allocations << '\t'
+       << entry.heapAllocations << '\n';
+}
+
+void
+EventProfiler::Report(std::ostream& os) const
+{
+    NS_LOG_FUNCTION(this);
+    Entry total = GetTotal();
+    std::ios_base::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+
+    os << "# Event profile: " << total.count << " events, " << std::fixed << std::setprecision(6)
+       << total.nanoseconds / 1e9 << " s\n";
+    os << "# kind\tname\tcount\ttime(s)\ttime(%)\tmean(us)\tallocations\theap-allocations\n";
+    for (const auto& [name, entry] : GetTypeEntries())
+    {
+        WriteEntry(os, "type", name, entry, total.nanoseconds);
+    }
+    for (const auto& [context, entry] : GetContextEntries())
+    {
+        std::string name =
+            context == Simulator::NO_CONTEXT ? std::string("none") : std::to_string(context);
+        WriteEntry(os, "node", name, entry, total.nanoseconds);
+    }
+
+    os.flags(flags);
+    os.precision(precision);
+}
+
+} // namespace ns3
@@ -0,0 +1,146 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include <ostream>
+#include <stdint.h>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler declaration.
+ */
+
+namespace ns3
+{
+
+class EventImpl;
+
+/**
+ * \ingroup simulator
+ *
+ * \brief Attribute the wall-clock time of the event loop to event types and nodes.
+ *
+ * The profiler invokes the events on behalf of the simulator
+ * implementation, and accumulates for each event:
+ *
+ * - the wall-clock time spent in the event,
+ * - the number of events allocated by the event (i.e., scheduled), and
+ * - the number of those allocations not served by the event pool.
+ *
+ * The statistics are aggregated both by the dynamic type of the
+ * EventImpl, which for the events created by MakeEvent() identifies the
+ * function or the member function invoked and the types of its
+ * arguments, and by the context (the node id) of the event.
+ *
+ * The type names are only demangled when the report is produced.
+ */
+class EventProfiler
+{
+  public:
+    /** Statistics of a group of events. */
+    struct Entry
+    {
+        uint64_t count{0};           //!< Number of events executed.
+        uint64_t nanoseconds{0};     //!< Wall-clock time spent in the events.
+        uint64_t allocations{0};     //!< Number of events allocated by the events.
+        uint64_t heapAllocations{0}; //!< Allocations not served by the event pool.
+    };
+
+    /** Constructor. */
+    EventProfiler();
+
+    /**
+     * Invoke an event and account for it.
+     *
+     * \param [in] event The event.
+     * \param [in] context The context of the event.
+     */
+    void Invoke(EventImpl* event, uint32_t context);
+
+    /** Discard the statistics collected so far. */
+    void Clear();
+
+    /**
+     * Get the statistics of all the events.
+     * \returns The totals.
+     */
+    Entry GetTotal() const;
+    /**
+     * Get the statistics by event type, sorted by decreasing time.
+     * \returns The demangled type names and their statistics.
+     */
+    std::vector<std::pair<std::string, Entry>> GetTypeEntries() const;
+    /**
+     * Get the statistics by context, sorted by decreasing time.
+     * \returns The contexts and their statistics.
+     */
+    std::vector<std::pair<uint32_t, Entry>> GetContextEntries() const;
+
+    /**
+     * Write the report.
+     *
+     * The report is made of tab-separated lines, each starting with
+     * \c type or \c node, followed by the event type or the context, the
+     * number of events, the total time in seconds, the percentage of the
+     * total time, the mean time in microseconds, and the numbers of
+     * allocations.  Lines starting with \c # are comments.  Within each
+     * section, the lines are sorted by decreasing time, so the report can
+     * also be re-sorted with standard tools, by any tab-separated field.
+     *
+     * \param [in,out] os The output stream.
+     */
+    void Report(std::ostream& os) const;
+
+    /**
+     * Get the demangled name of the dynamic type of an event.
+     *
+     * \param [in] event The event.
+     * \returns The name of the type of the event.
+     */
+    static std::string GetTypeName(const EventImpl* event);
+
+  private:
+    /**
+     * Write a line of the report.
+     *
+     * \param [in,out] os The output stream.
+     * \param [in] kind The kind of the line.
+     * \param [in] name The name of the group.
+     * \param [in] entry The statistics of the group.
+     * \param [in] total The total time, in nanoseconds.
+     */
+    static void WriteEntry(std::ostream& os,
+                           const std::string& kind,
+                           const std::string& name,
+                           const Entry& entry,
+                           uint64_t total);
+
+    /** Statistics by event type. */
+    std::unordered_map<std::type_index, Entry> m_types;
+    /** Statistics by context. */
+    std::unordered_map<uint32_t, Entry> m_contexts;
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
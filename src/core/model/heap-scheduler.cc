@@ -206,6 +206,27 @@ HeapScheduler::Insert(const Event& ev)
     BottomUp();
 }
 
+void
+HeapScheduler::BulkInsert(const std::vector<Event>& events)
+{
+    NS_LOG_FUNCTION(this << events.size());
+    if (events.size() < m_heap.size())
+    {
+        for (const auto& ev : events)
+        {
+            m_heap.push_back(ev);
+            BottomUp();
+        }
+        return;
+    }
+    // Rebuild the heap, in linear time
+    m_heap.insert(m_heap.end(), events.begin(), events.end());
+    for (std::size_t i = Parent(Last()); i >= Root(); i--)
+    {
+        TopDown(i);
+    }
+}
+
 Scheduler::Event
 HeapScheduler::PeekNext() const
 {
@@ -236,6 +257,12 @@ HeapScheduler::Remove(const Event& ev)
             NS_ASSERT(m_heap[i].impl == ev.impl);
             Exch(i, Last());
             m_heap.pop_back();
+            // The last event may belong above the removed one
+            while (!IsBottom(i) && !IsRoot(i) && IsLessStrictly(i, Parent(i)))
+            {
+                Exch(i, Parent(i));
+                i = Parent(i);
+            }
             TopDown(i);
             return;
         }
@@ -86,6 +86,7 @@ class HeapScheduler : public Scheduler
 
     // Inherited
     void Insert(const Scheduler::Event& ev) override;
+    void BulkInsert(const std::vector<Scheduler::Event>& events) override;
     bool IsEmpty() const override;
     Scheduler::Event PeekNext() const override;
     Scheduler::Event RemoveNext() override;
@@ -0,0 +1,313 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+#include "type-id.h"
+#include "uinteger.h"
+
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler class implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(LadderScheduler);
+
+TypeId
+LadderScheduler::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::LadderScheduler")
+            .SetParent<Scheduler>()
+            .SetGroupName("Core")
+            .AddConstructor<LadderScheduler>()
+            .AddAttribute("Threshold",
+                          "The number of events above which a bucket is split into a new rung",
+                          TypeId::ATTR_CONSTRUCT,
+                          UintegerValue(50),
+                          MakeUintegerAccessor(&LadderScheduler::m_threshold),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("MaxRungs",
+                          "The maximum number of rungs of the ladder",
+                          TypeId::ATTR_CONSTRUCT,
+                          UintegerValue(8),
+                          MakeUintegerAccessor(&LadderScheduler::m_maxRungs),
+                          MakeUintegerChecker<uint32_t>(1));
+    return tid;
+}
+
+LadderScheduler::LadderScheduler()
+    : m_topStart(0),
+      m_topMin(0),
+      m_topMax(0),
+      m_nRungs(0),
+      m_qSize(0),
+      m_threshold(50),
+      m_maxRungs(8)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LadderScheduler::~LadderScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+std::size_t
+LadderScheduler::Hash(const Rung& rung, uint64_t ts)
+{
+    return (ts - rung.start) / rung.width;
+}
+
+std::size_t
+LadderScheduler::FindRung(uint64_t ts) const
+{
+    // Each rung spans the buckets of the rung above it which have
+    // already been dequeued, so the coarsest rung accepting the
+    // timestamp is the right one.
+    for (std::size_t i = 0; i < m_nRungs; i++)
+    {
+        if (ts >= m_rungs[i].current)
+        {
+            return i;
+        }
+    }
+    return m_nRungs;
+}
+
+void
+LadderScheduler::SpawnRung(Bucket& events, uint64_t start, uint64_t end)
+{
+    NS_LOG_FUNCTION(this << events.size() << start << end);
+    NS_ASSERT(!events.empty() && end > start);
+    if (m_nRungs == m_rungs.size())
+    {
+        m_rungs.emplace_back();
+    }
+    Rung& rung = m_rungs[m_nRungs];
+    uint64_t n = events.size();
+    rung.start = start;
+    rung.width = std::max<uint64_t>((end - start + n - 1) / n, 1);
+    rung.current = start;
+    rung.currentBucket = 0;
+    rung.count = events.size();
+    // The buckets of a recycled rung are all empty, only their
+    // capacity is kept.
+    rung.buckets.resize((end - start + rung.width - 1) / rung.width);
+    for (const auto& ev : events)
+    {
+        std::size_t bucket = Hash(rung, ev.key.m_ts);
+        NS_ASSERT(bucket < rung.buckets.size());
+        rung.buckets[bucket].push_back(ev);
+    }
+    events.clear();
+    m_nRungs++;
+}
+
+void
+LadderScheduler::InsertBottom(const Scheduler::Event& ev)
+{
+    if (m_bottom.empty() || m_bottom.back() < ev)
+    {
+        m_bottom.push_back(ev);
+        return;
+    }
+    m_bottom.insert(std::upper_bound(m_bottom.begin(), m_bottom.end(), ev), ev);
+}
+
+void
+LadderScheduler::Refill()
+{
+    while (m_bottom.empty() && m_qSize > 0)
+    {
+        while (m_nRungs > 0 && m_rungs[m_nRungs - 1].count == 0)
+        {
+            m_nRungs--;
+        }
+
+        if (m_nRungs == 0)
+        {
+            NS_ASSERT(!m_top.empty());
+            if (m_top.size() <= m_threshold || m_topMin == m_topMax)
+            {
+                // Too few events to be worth a rung
+                std::sort(m_top.begin(), m_top.end());
+                m_bottom.assign(m_top.begin(), m_top.end());
+                m_top.clear();
+                m_topStart = m_topMax + 1;
+                return;
+            }
+            m_topStart = m_topMax + 1;
+            SpawnRung(m_top, m_topMin, m_topStart);
+            continue;
+        }
+
+        Rung& rung = m_rungs[m_nRungs - 1];
+        while (rung.buckets[rung.currentBucket].empty())
+        {
+            rung.currentBucket++;
+            rung.current += rung.width;
+        }
+        Bucket& bucket = rung.buckets[rung.currentBucket];
+        uint64_t bucketStart = rung.current;
+        uint64_t bucketWidth = rung.width;
+        rung.currentBucket++;
+        rung.current += rung.width;
+        rung.count -= bucket.size();
+
+        if (bucket.size() > m_threshold && bucketWidth > 1 && m_nRungs < m_maxRungs)
+        {
+            // Move the events out of the bucket first: spawning a rung
+            // may reallocate the rungs, and thus the bucket.
+            Bucket events;
+            events.swap(bucket);
+            SpawnRung(events, bucketStart, bucketStart + bucketWidth);
+            continue;
+        }
+
+        std::sort(bucket.begin(), bucket.end());
+        m_bottom.assign(bucket.begin(), bucket.end());
+        bucket.clear();
+    }
+}
+
+void
+LadderScheduler::DoInsert(const Scheduler::Event& ev)
+{
+    m_qSize++;
+    uint64_t ts = ev.key.m_ts;
+    if (ts >= m_topStart)
+    {
+        if (m_top.empty())
+        {
+            m_topMin = ts;
+            m_topMax = ts;
+        }
+        else
+        {
+            m_topMin = std::min(m_topMin, ts);
+            m_topMax = std::max(m_topMax, ts);
+        }
+        m_top.push_back(ev);
+        return;
+    }
+    std::size_t i = FindRung(ts);
+    if (i < m_nRungs)
+    {
+        Rung& rung = m_rungs[i];
+        std::size_t bucket = Hash(rung, ts);
+        NS_ASSERT(bucket >= rung.currentBucket && bucket < rung.buckets.size());
+        rung.buckets[bucket].push_back(ev);
+        rung.count++;
+    }
+    else
+    {
+        InsertBottom(ev);
+    }
+}
+
+void
+LadderScheduler::Insert(const Scheduler::Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    DoInsert(ev);
+    Refill();
+}
+
+void
+LadderScheduler::BulkInsert(const std::vector<Scheduler::Event>& events)
+{
+    NS_LOG_FUNCTION(this << events.size());
+    for (const auto& ev : events)
+    {
+        DoInsert(ev);
+    }
+    Refill();
+}
+
+bool
+LadderScheduler::IsEmpty() const
+{
+    return m_qSize == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    return m_bottom.front();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    Scheduler::Event ev = m_bottom.front();
+    m_bottom.pop_front();
+    m_qSize--;
+    Refill();
+    return ev;
+}
+
+void
+LadderScheduler::Remove(const Scheduler::Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    NS_ASSERT(!IsEmpty());
+    uint64_t ts = ev.key.m_ts;
+    Bucket* bucket = nullptr;
+    std::size_t i = FindRung(ts);
+    if (ts >= m_topStart)
+    {
+        bucket = &m_top;
+    }
+    else if (i < m_nRungs)
+    {
+        bucket = &m_rungs[i].buckets[Hash(m_rungs[i], ts)];
+        m_rungs[i].count--;
+    }
+
+    if (bucket != nullptr)
+    {
+        // Buckets are unsorted: swap the event with the last one
+        auto it = std::find(bucket->begin(), bucket->end(), ev);
+        NS_ASSERT(it != bucket->end());
+        *it = bucket->back();
+        bucket->pop_back();
+    }
+    else
+    {
+        auto it = std::lower_bound(m_bottom.begin(), m_bottom.end(), ev);
+        NS_ASSERT(it != m_bottom.end() && *it == ev);
+        m_bottom.erase(it);
+    }
+    m_qSize--;
+    Refill();
+}
+
+} // namespace ns3
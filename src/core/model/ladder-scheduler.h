@@ -0,0 +1,188 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+
+#include <deque>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler class declaration.
+ */
+
+namespace ns3
+{
+
+class EventImpl;
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the ladder queue published in
+ * ["Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Wai Teng Tang, Rick Siow Mong Goh and
+ * Ian Li-Jin Thng][Tang].
+ *
+ * [Tang]: https://doi.org/10.1145/1103323.1103324 "Tang"
+ *
+ * The events are stored in three tiers:
+ *
+ * - **Top**: an unsorted vector holding the events far in the future,
+ *   i.e., with a timestamp after the end of the ladder.
+ * - **Ladder**: a stack of rungs.  Each rung is a vector of unsorted
+ *   buckets of uniform width; each rung spans a single bucket of the
+ *   rung above it, with a finer width.  The first rung is created from
+ *   the Top, with a width computed from the range of its timestamps.
+ * - **Bottom**: a short sorted list of the earliest events, from which
+ *   the events are dequeued.
+ *
+ * When the Bottom is empty, the first non-empty bucket of the last rung
+ * is either split into a new rung, if it holds more than \c Threshold
+ * events, or sorted into the Bottom.  The sorting of the events is thus
+ * deferred until they are about to be dequeued, and only a few events
+ * are sorted at once.  The bucket width adapts to the distribution of
+ * the timestamps, so the structure performs well with skewed
+ * distributions, where the CalendarScheduler degrades.
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | ~Constant       | Append to Top or bucket; sorted insert in Bottom
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | Constant        | Bottom is always populated
+ * Remove()     | ~Constant       | Search within bucket or Bottom
+ * RemoveNext() | ~Constant       | Possible transfer of a bucket to a new rung or Bottom
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | 3 x `sizeof (*)` per bucket      | `std::vector`
+ * Per Event | 0                                | Events stored in `std::vector`
+ */
+class LadderScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    LadderScheduler();
+    /** Destructor. */
+    ~LadderScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    void BulkInsert(const std::vector<Scheduler::Event>& events) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+  private:
+    /** Bucket type: an unsorted vector of Events. */
+    typedef std::vector<Scheduler::Event> Bucket;
+
+    /** A rung of the ladder. */
+    struct Rung
+    {
+        /** Timestamp of the start of the first bucket. */
+        uint64_t start;
+        /** Duration of a bucket, in dimensionless time units. */
+        uint64_t width;
+        /** Timestamp of the start of the first bucket not yet dequeued. */
+        uint64_t current;
+        /** Index of the first bucket not yet dequeued. */
+        std::size_t currentBucket;
+        /** Number of events in the rung. */
+        std::size_t count;
+        /** The buckets. */
+        std::vector<Bucket> buckets;
+    };
+
+    /**
+     * Create a new rung at the bottom of the ladder and move events into it.
+     *
+     * \param [in] events The events to move; the vector is cleared.
+     * \param [in] start The timestamp of the start of the rung.
+     * \param [in] end The timestamp of the end of the rung.
+     */
+    void SpawnRung(Bucket& events, uint64_t start, uint64_t end);
+    /**
+     * Find the rung accepting a timestamp.
+     *
+     * \param [in] ts The timestamp.
+     * \returns The index of the rung, or the number of rungs if the
+     * event belongs to the Bottom.
+     */
+    std::size_t FindRung(uint64_t ts) const;
+    /**
+     * Hash a timestamp to a bucket of a rung.
+     *
+     * \param [in] rung The rung.
+     * \param [in] ts The timestamp.
+     * \returns The bucket index.
+     */
+    static std::size_t Hash(const Rung& rung, uint64_t ts);
+    /**
+     * Insert an event, without populating the Bottom.
+     *
+     * \param [in] ev The event to insert.
+     */
+    void DoInsert(const Scheduler::Event& ev);
+    /** Insert an event into the sorted Bottom. */
+    void InsertBottom(const Scheduler::Event& ev);
+    /** Populate the Bottom from the ladder or the Top, if empty. */
+    void Refill();
+
+    /** Events with a timestamp after the end of the ladder. */
+    Bucket m_top;
+    /** Timestamp of the start of the Top. */
+    uint64_t m_topStart;
+    /** Smallest timestamp in the Top. */
+    uint64_t m_topMin;
+    /** Largest timestamp in the Top. */
+    uint64_t m_topMax;
+    /**
+     * The rungs of the ladder, from the coarsest to the finest.
+     * The storage of the rungs past \c m_nRungs is kept for reuse.
+     */
+    std::vector<Rung> m_rungs;
+    /** Number of rungs in use. */
+    std::size_t m_nRungs;
+    /** The earliest events, sorted. */
+    std::deque<Scheduler::Event> m_bottom;
+    /** Number of events in queue. */
+    uint32_t m_qSize;
+    /** Number of events above which a bucket is split into a new rung. */
+    uint32_t m_threshold;
+    /** Maximum number of rungs. */
+    uint32_t m_maxRungs;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
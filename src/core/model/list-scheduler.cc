@@ -23,6 +23,7 @@
 #include "event-impl.h"
 #include "log.h"
 
+#include <algorithm>
 #include <string>
 #include <utility>
 
@@ -73,6 +74,24 @@ ListScheduler::Insert(const Event& ev)
     m_events.push_back(ev);
 }
 
+void
+ListScheduler::BulkInsert(const std::vector<Event>& events)
+{
+    NS_LOG_FUNCTION(this << events.size());
+    std::vector<Event> sorted(events);
+    std::sort(sorted.begin(), sorted.end());
+    // Merge the sorted events in a single pass over the list
+    auto i = m_events.begin();
+    for (const auto& ev : sorted)
+    {
+        while (i != m_events.end() && !(ev.key < i->key))
+        {
+            i++;
+        }
+        m_events.insert(i, ev);
+    }
+}
+
 bool
 ListScheduler::IsEmpty() const
 {
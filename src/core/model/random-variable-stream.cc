@@ -37,6 +37,7 @@
 #include <algorithm> // upper_bound
 #include <cmath>
 #include <iostream>
+#include <sstream>
 
 /**
  * \file
@@ -49,6 +50,26 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("RandomVariableStream");
 
+namespace
+{
+
+/**
+ * \ingroup randomvariable
+ * Get the streams alive, by order of creation.
+ * \returns The registry of the streams.
+ */
+std::map<uint64_t, RandomVariableStream*>&
+GetRegistry()
+{
+    static std::map<uint64_t, RandomVariableStream*> registry;
+    return registry;
+}
+
+/** The order of creation of the next stream. */
+uint64_t g_nextCreation = 0;
+
+} // unnamed namespace
+
 NS_OBJECT_ENSURE_REGISTERED(RandomVariableStream);
 
 TypeId
@@ -77,14 +98,18 @@ RandomVariableStream::GetTypeId()
 }
 
 RandomVariableStream::RandomVariableStream()
-    : m_rng(nullptr)
+    : m_rng(nullptr),
+      m_index(0),
+      m_creation(g_nextCreation++)
 {
     NS_LOG_FUNCTION(this);
+    GetRegistry()[m_creation] = this;
 }
 
 RandomVariableStream::~RandomVariableStream()
 {
     NS_LOG_FUNCTION(this);
+    GetRegistry().erase(m_creation);
     delete m_rng;
 }
 
@@ -122,16 +147,16 @@ RandomVariableStream::SetStream(int64_t stream)
         // number assignment.
         uint64_t nextStream = RngSeedManager::GetNextStreamIndex();
         NS_ASSERT(nextStream <= ((1ULL) << 63));
-        m_rng = new RngStream(RngSeedManager::GetSeed(), nextStream, RngSeedManager::GetRun());
+        m_index = nextStream;
     }
     else
     {
         // The last 2^63 streams are reserved for deterministic stream
         // number assignment.
         uint64_t base = ((1ULL) << 63);
-        uint64_t target = base + stream;
-        m_rng = new RngStream(RngSeedManager::GetSeed(), target, RngSeedManager::GetRun());
+        m_index = base + stream;
     }
+    m_rng = new RngStream(RngSeedManager::GetSeed(), m_index, RngSeedManager::GetRun());
     m_stream = stream;
 }
 
@@ -149,6 +174,83 @@ RandomVariableStream::Peek() const
     return m_rng;
 }
 
+std::map<std::string, Ptr<RandomVariableStream>>
+RandomVariableStream::GetStreams()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    std::map<std::string, Ptr<RandomVariableStream>> streams;
+    std::map<int64_t, uint32_t> shared;
+    uint32_t automatic = 0;
+    for (const auto& [creation, stream] : GetRegistry())
+    {
+        if (stream->m_rng == nullptr)
+        {
+            continue;
+        }
+        if (stream->m_stream == -1)
+        {
+            // The index allocated depends on the streams created before
+            streams["auto." + std::to_string(automatic++)] = stream;
+        }
+        else
+        {
+            uint32_t n = shared[stream->m_stream]++;
+            streams[std::to_string(stream->m_stream) + "." + std::to_string(n)] = stream;
+        }
+    }
+    return streams;
+}
+
+void
+RandomVariableStream::ResetStreams()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    for (const auto& [creation, stream] : GetRegistry())
+    {
+        if (stream->m_rng != nullptr)
+        {
+            stream->ResetStream();
+        }
+    }
+}
+
+void
+RandomVariableStream::ResetStream()
+{
+    NS_LOG_FUNCTION(this);
+    delete m_rng;
+    m_rng = new RngStream(RngSeedManager::GetSeed(), m_index, RngSeedManager::GetRun());
+}
+
+void
+RandomVariableStream::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    double state[6];
+    m_rng->GetState(state);
+    std::ostringstream oss;
+    oss.precision(17);
+    for (int i = 0; i < 6; ++i)
+    {
+        oss << (i > 0 ? " " : "") << state[i];
+    }
+    writer.WriteString("rng", oss.str());
+}
+
+void
+RandomVariableStream::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    double state[6];
+    std::istringstream iss(reader.ReadString("rng"));
+    for (int i = 0; i < 6; ++i)
+    {
+        iss >> state[i];
+    }
+    NS_ABORT_MSG_IF(iss.fail(), "Invalid RngStream state in " << reader.GetPath());
+    m_rng->SetState(state);
+}
+
 NS_OBJECT_ENSURE_REGISTERED(UniformRandomVariable);
 
 TypeId
@@ -374,6 +476,26 @@ SequentialRandomVariable::GetValue()
     return r;
 }
 
+void
+SequentialRandomVariable::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    RandomVariableStream::SaveState(writer);
+    writer.Write("current", m_current);
+    writer.Write("currentConsecutive", m_currentConsecutive);
+    writer.Write("isCurrentSet", m_isCurrentSet);
+}
+
+void
+SequentialRandomVariable::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    RandomVariableStream::RestoreState(reader);
+    m_current = reader.Read<double>("current");
+    m_currentConsecutive = reader.Read<uint32_t>("currentConsecutive");
+    m_isCurrentSet = reader.Read<bool>("isCurrentSet");
+}
+
 NS_OBJECT_ENSURE_REGISTERED(ExponentialRandomVariable);
 
 TypeId
@@ -776,6 +898,40 @@ NormalRandomVariable::GetValue()
     return GetValue(m_mean, m_variance, m_bound);
 }
 
+void
+NormalRandomVariable::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    RandomVariableStream::SaveState(writer);
+    writer.Write("nextValid", m_nextValid);
+    if (m_nextValid)
+    {
+        writer.Write("v2", m_v2);
+        writer.Write("y", m_y);
+    }
+}
+
+void
+NormalRandomVariable::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    RandomVariableStream::RestoreState(reader);
+    m_nextValid = reader.Read<bool>("nextValid");
+    if (m_nextValid)
+    {
+        m_v2 = reader.Read<double>("v2");
+        m_y = reader.Read<double>("y");
+    }
+}
+
+void
+NormalRandomVariable::ResetStream()
+{
+    NS_LOG_FUNCTION(this);
+    RandomVariableStream::ResetStream();
+    m_nextValid = false;
+}
+
 NS_OBJECT_ENSURE_REGISTERED(LogNormalRandomVariable);
 
 TypeId
@@ -911,6 +1067,40 @@ LogNormalRandomVariable::GetValue()
     return GetValue(m_mu, m_sigma);
 }
 
+void
+LogNormalRandomVariable::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    RandomVariableStream::SaveState(writer);
+    writer.Write("nextValid", m_nextValid);
+    if (m_nextValid)
+    {
+        writer.Write("v2", m_v2);
+        writer.Write("normal", m_normal);
+    }
+}
+
+void
+LogNormalRandomVariable::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    RandomVariableStream::RestoreState(reader);
+    m_nextValid = reader.Read<bool>("nextValid");
+    if (m_nextValid)
+    {
+        m_v2 = reader.Read<double>("v2");
+        m_normal = reader.Read<double>("normal");
+    }
+}
+
+void
+LogNormalRandomVariable::ResetStream()
+{
+    NS_LOG_FUNCTION(this);
+    RandomVariableStream::ResetStream();
+    m_nextValid = false;
+}
+
 NS_OBJECT_ENSURE_REGISTERED(GammaRandomVariable);
 
 TypeId
@@ -1032,6 +1222,40 @@ GammaRandomVariable::GetValue()
     return GetValue(m_alpha, m_beta);
 }
 
+void
+GammaRandomVariable::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    RandomVariableStream::SaveState(writer);
+    writer.Write("nextValid", m_nextValid);
+    if (m_nextValid)
+    {
+        writer.Write("v2", m_v2);
+        writer.Write("y", m_y);
+    }
+}
+
+void
+GammaRandomVariable::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    RandomVariableStream::RestoreState(reader);
+    m_nextValid = reader.Read<bool>("nextValid");
+    if (m_nextValid)
+    {
+        m_v2 = reader.Read<double>("v2");
+        m_y = reader.Read<double>("y");
+    }
+}
+
+void
+GammaRandomVariable::ResetStream()
+{
+    NS_LOG_FUNCTION(this);
+    RandomVariableStream::ResetStream();
+    m_nextValid = false;
+}
+
 double
 GammaRandomVariable::GetNormalValue(double mean, double variance, double bound)
 {
@@ -1532,6 +1756,22 @@ DeterministicRandomVariable::GetValue()
     return m_data[m_next++];
 }
 
+void
+DeterministicRandomVariable::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    RandomVariableStream::SaveState(writer);
+    writer.Write("next", m_next);
+}
+
+void
+DeterministicRandomVariable::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    RandomVariableStream::RestoreState(reader);
+    m_next = reader.Read<std::size_t>("next");
+}
+
 NS_OBJECT_ENSURE_REGISTERED(EmpiricalRandomVariable);
 
 TypeId
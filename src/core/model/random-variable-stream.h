@@ -27,11 +27,13 @@
 #define RANDOM_VARIABLE_STREAM_H
 
 #include "attribute-helper.h"
+#include "checkpoint.h"
 #include "object.h"
 #include "type-id.h"
 
 #include <map>
 #include <stdint.h>
+#include <string>
 
 /**
  * \file
@@ -97,7 +99,7 @@ class RngStream;
  * See the documentation for the specific distributions to see
  * how this modifies the returned values.
  */
-class RandomVariableStream : public Object
+class RandomVariableStream : public Object, public Checkpointable
 {
   public:
     /**
@@ -154,6 +156,43 @@ class RandomVariableStream : public Object
     // The base implementation returns `(uint32_t)GetValue()`
     virtual uint32_t GetInteger();
 
+    /**
+     * Get the streams alive, e.g., to save them to a checkpoint.
+     *
+     * The streams with an assigned stream number are identified by this
+     * number and, for the streams sharing a number, by their order of
+     * creation.  The other streams are identified by their order of
+     * creation, as the index of their RngStream depends on the streams
+     * created before.
+     *
+     * \returns The streams, by identifier.
+     */
+    static std::map<std::string, Ptr<RandomVariableStream>> GetStreams();
+
+    /**
+     * Restart the streams alive from the current seed and run number.
+     *
+     * Each stream keeps its stream index, so a simulation continued after
+     * RngSeedManager::SetRun() draws the values of the new run, e.g., for
+     * the independent replications of ReplicationRunner.
+     */
+    static void ResetStreams();
+
+    /**
+     * Save the state of the RngStream.
+     *
+     * The subclasses with a state of their own extend this method.
+     *
+     * \param [in,out] writer The checkpoint writer.
+     */
+    void SaveState(CheckpointWriter& writer) const override;
+    /**
+     * Restore the state of the RngStream.
+     *
+     * \param [in,out] reader The checkpoint reader.
+     */
+    void RestoreState(CheckpointReader& reader) override;
+
   protected:
     /**
      * \brief Get the pointer to the underlying RngStream.
@@ -161,16 +200,30 @@ class RandomVariableStream : public Object
      */
     RngStream* Peek() const;
 
+    /**
+     * Restart the RngStream from the current seed and run number.
+     *
+     * The subclasses caching values drawn from the RngStream extend this
+     * method to drop them.
+     */
+    virtual void ResetStream();
+
   private:
     /** Pointer to the underlying RngStream. */
     RngStream* m_rng;
 
+    /** The index of the RngStream. */
+    uint64_t m_index;
+
     /** Indicates if antithetic values should be generated by this RNG stream. */
     bool m_isAntithetic;
 
     /** The stream number for the RngStream. */
     int64_t m_stream;
 
+    /** The order of creation of this stream. */
+    uint64_t m_creation;
+
 }; // class RandomVariableStream
 
 /**
@@ -452,6 +505,8 @@ class SequentialRandomVariable : public RandomVariableStream
 
     // Inherited
     double GetValue() override;
+    void SaveState(CheckpointWriter& writer) const override;
+    void RestoreState(CheckpointReader& reader) override;
     using RandomVariableStream::GetInteger;
 
   private:
@@ -1017,8 +1072,13 @@ class NormalRandomVariable : public RandomVariableStream
 
     // Inherited
     double GetValue() override;
+    void SaveState(CheckpointWriter& writer) const override;
+    void RestoreState(CheckpointReader& reader) override;
     using RandomVariableStream::GetInteger;
 
+  protected:
+    void ResetStream() override;
+
   private:
     /** The mean value for the normal distribution returned by this RNG stream. */
     double m_mean;
@@ -1168,8 +1228,13 @@ class LogNormalRandomVariable : public RandomVariableStream
 
     // Inherited
     double GetValue() override;
+    void SaveState(CheckpointWriter& writer) const override;
+    void RestoreState(CheckpointReader& reader) override;
     using RandomVariableStream::GetInteger;
 
+  protected:
+    void ResetStream() override;
+
   private:
     /** The mu value for the log-normal distribution returned by this RNG stream. */
     double m_mu;
@@ -1281,8 +1346,13 @@ class GammaRandomVariable : public RandomVariableStream
 
     // Inherited
     double GetValue() override;
+    void SaveState(CheckpointWriter& writer) const override;
+    void RestoreState(CheckpointReader& reader) override;
     using RandomVariableStream::GetInteger;
 
+  protected:
+    void ResetStream() override;
+
   private:
     /**
      * \brief Returns a random double from a normal distribution with the specified mean, variance,
@@ -1868,6 +1938,8 @@ class DeterministicRandomVariable : public RandomVariableStream
 
     // Inherited
     double GetValue() override;
+    void SaveState(CheckpointWriter& writer) const override;
+    void RestoreState(CheckpointReader& reader) override;
     using RandomVariableStream::GetInteger;
 
   private:
@@ -0,0 +1,228 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "replication-runner.h"
+
+#include "abort.h"
+#include "fatal-error.h"
+#include "log.h"
+#include "random-variable-stream.h"
+#include "rng-seed-manager.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <poll.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::ReplicationRunner implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ReplicationRunner");
+
+namespace
+{
+
+/** A replication running in a child process. */
+struct Child
+{
+    uint32_t index;     //!< The index of the replication.
+    pid_t pid;          //!< The process id.
+    std::string result; //!< The result received so far.
+};
+
+} // unnamed namespace
+
+ReplicationRunner::ReplicationRunner()
+    : m_replications(1),
+      m_firstRun(0),
+      m_firstRunSet(false),
+      m_maxParallel(std::max(std::thread::hardware_concurrency(), 1U))
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+ReplicationRunner::SetReplications(uint32_t replications)
+{
+    NS_LOG_FUNCTION(this << replications);
+    m_replications = replications;
+}
+
+void
+ReplicationRunner::SetFirstRun(uint64_t run)
+{
+    NS_LOG_FUNCTION(this << run);
+    m_firstRun = run;
+    m_firstRunSet = true;
+}
+
+void
+ReplicationRunner::SetMaxParallel(uint32_t maxParallel)
+{
+    NS_LOG_FUNCTION(this << maxParallel);
+    NS_ABORT_MSG_IF(maxParallel == 0, "At least one replication must run at a time");
+    m_maxParallel = maxParallel;
+}
+
+std::vector<std::string>
+ReplicationRunner::Run(Time warmUp, Time duration, Callback<std::string, uint64_t> collect)
+{
+    NS_LOG_FUNCTION(this << warmUp << duration);
+    NS_ABORT_MSG_IF(warmUp < Simulator::Now(),
+                    "The warm-up phase ends at " << warmUp.As(Time::S) << ", before the time "
+                                                 << Simulator::Now().As(Time::S));
+    if (warmUp > Simulator::Now())
+    {
+        Simulator::Stop(warmUp - Simulator::Now());
+        Simulator::Run();
+        NS_ABORT_MSG_IF(Simulator::Now() != warmUp,
+                        "The simulation stopped at " << Simulator::Now().As(Time::S)
+                                                     << ", before the end of the warm-up phase");
+    }
+    uint64_t firstRun = m_firstRunSet ? m_firstRun : RngSeedManager::GetRun();
+
+    // Do not let the children inherit and flush the buffered outputs
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+
+    std::vector<std::string> results(m_replications);
+    std::map<int, Child> children;
+    uint32_t next = 0;
+    while (next < m_replications || !children.empty())
+    {
+        while (next < m_replications && children.size() < m_maxParallel)
+        {
+            int fds[2];
+            NS_ABORT_MSG_IF(pipe(fds) != 0, "pipe() failed: " << std::strerror(errno));
+            pid_t pid = fork();
+            NS_ABORT_MSG_IF(pid < 0, "fork() failed: " << std::strerror(errno));
+            if (pid == 0)
+            {
+                close(fds[0]);
+                for (const auto& [fd, child] : children)
+                {
+                    close(fd);
+                }
+                RunChild(firstRun + next, duration, collect, fds[1]);
+            }
+            NS_LOG_LOGIC("Replication " << next << " runs in process " << pid);
+            close(fds[1]);
+            children[fds[0]] = {next, pid, ""};
+            next++;
+        }
+
+        std::vector<pollfd> fds;
+        for (const auto& [fd, child] : children)
+        {
+            fds.push_back({fd, POLLIN, 0});
+        }
+        if (poll(fds.data(), fds.size(), -1) < 0)
+        {
+            NS_ABORT_MSG_IF(errno != EINTR, "poll() failed: " << std::strerror(errno));
+            continue;
+        }
+        for (const auto& p : fds)
+        {
+            if (p.revents == 0)
+            {
+                continue;
+            }
+            Child& child = children[p.fd];
+            char buffer[4096];
+            ssize_t n = read(p.fd, buffer, sizeof(buffer));
+            if (n > 0)
+            {
+                child.result.append(buffer, n);
+                continue;
+            }
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            NS_ABORT_MSG_IF(n < 0, "read() failed: " << std::strerror(errno));
+
+            // End of the replication
+            close(p.fd);
+            int status;
+            while (waitpid(child.pid, &status, 0) < 0)
+            {
+                NS_ABORT_MSG_IF(errno != EINTR, "waitpid() failed: " << std::strerror(errno));
+            }
+            NS_ABORT_MSG_IF(!WIFEXITED(status) || WEXITSTATUS(status) != 0,
+                            "Replication " << child.index << " (run " << firstRun + child.index
+                                           << ") failed with status " << status);
+            NS_LOG_LOGIC("Replication " << child.index << " done");
+            results[child.index] = std::move(child.result);
+            children.erase(p.fd);
+        }
+    }
+    return results;
+}
+
+void
+ReplicationRunner::RunChild(uint64_t run,
+                            Time duration,
+                            Callback<std::string, uint64_t> collect,
+                            int fd)
+{
+    NS_LOG_FUNCTION(run << duration << fd);
+    RngSeedManager::SetRun(run);
+    RandomVariableStream::ResetStreams();
+    Simulator::Stop(duration);
+    Simulator::Run();
+    std::string result = collect(run);
+
+    const char* data = result.data();
+    std::size_t size = result.size();
+    while (size > 0)
+    {
+        ssize_t n = write(fd, data, size);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n < 0)
+        {
+            std::cerr << "Replication run " << run << ": write() failed: " << std::strerror(errno)
+                      << std::endl;
+            _exit(1);
+        }
+        data += n;
+        size -= n;
+    }
+    close(fd);
+
+    // Leave the state shared with the parent process to the parent process
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+    _exit(0);
+}
+
+} // namespace ns3
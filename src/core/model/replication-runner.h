@@ -0,0 +1,141 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef REPLICATION_RUNNER_H
+#define REPLICATION_RUNNER_H
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::ReplicationRunner declaration.
+ */
+
+#include "callback.h"
+#include "nstime.h"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup core
+ *
+ * Run independent replications of a simulation sharing a warm-up phase.
+ *
+ * The simulation is run once up to the end of the warm-up phase.  Each
+ * replication is then run in a child process created with \c fork(), which
+ * shares the warm-up state with the parent process and the other
+ * replications, copy-on-write.  The child process sets its run number with
+ * RngSeedManager::SetRun() and restarts all the random variable streams,
+ * runs the simulation for the requested duration, and sends the result
+ * returned by the collect callback to the parent process through a pipe.
+ *
+ * Up to MaxParallel replications run at the same time, by default one per
+ * processor.  The parent process is left at the end of the warm-up phase,
+ * so Run() can be called again, e.g., for more replications.
+ *
+ * Example usage:
+ *
+ * \code
+ *     // Create your model
+ *
+ *     ReplicationRunner runner;
+ *     runner.SetReplications(32);
+ *     std::vector<std::string> results =
+ *         runner.Run(Seconds(100), Seconds(10), MakeCallback(&CollectStatistics));
+ *     Simulator::Destroy();
+ * \endcode
+ *
+ * where \c CollectStatistics(run) returns the statistics of the replication
+ * as a string, e.g., the throughput measured by a PacketSink.
+ *
+ * \note The replications are only available on the POSIX systems.  The
+ * replications run in processes of their own: the traces and the outputs
+ * of a replication, e.g., the files written, are not seen by the parent
+ * process, and the output files of the replications must be given distinct
+ * names.
+ */
+class ReplicationRunner
+{
+  public:
+    /** Constructor. */
+    ReplicationRunner();
+
+    /**
+     * Set the number of replications.
+     * \param [in] replications The number of replications; the default is 1.
+     */
+    void SetReplications(uint32_t replications);
+
+    /**
+     * Set the run number of the first replication.  The replication \c i
+     * uses the run number \c run + \c i.
+     * \param [in] run The run number; the default is the current run number
+     *             of the RngSeedManager.
+     */
+    void SetFirstRun(uint64_t run);
+
+    /**
+     * Set the maximum number of replications running at the same time.
+     * \param [in] maxParallel The maximum number of child processes; the
+     *             default is the number of processors.
+     */
+    void SetMaxParallel(uint32_t maxParallel);
+
+    /**
+     * Run the warm-up phase, then the replications.
+     *
+     * \param [in] warmUp The end of the warm-up phase, as an absolute time.
+     *             The warm-up phase is not run again if the simulation is
+     *             already at this time.
+     * \param [in] duration The duration of each replication after the
+     *             warm-up phase.
+     * \param [in] collect The callback run in each child process at the end
+     *             of the replication, with the run number as argument; it
+     *             returns the result of the replication.
+     * \returns The results of the replications, by replication.
+     */
+    std::vector<std::string> Run(Time warmUp,
+                                 Time duration,
+                                 Callback<std::string, uint64_t> collect);
+
+  private:
+    /**
+     * Run a replication in the child process and send its result.
+     * This function does not return.
+     *
+     * \param [in] run The run number.
+     * \param [in] duration The duration of the replication.
+     * \param [in] collect The callback returning the result.
+     * \param [in] fd The write end of the pipe to the parent process.
+     */
+    [[noreturn]] static void RunChild(uint64_t run,
+                                      Time duration,
+                                      Callback<std::string, uint64_t> collect,
+                                      int fd);
+
+    uint32_t m_replications; //!< The number of replications.
+    uint64_t m_firstRun;     //!< The run number of the first replication.
+    bool m_firstRunSet;      //!< Whether the first run number was set.
+    uint32_t m_maxParallel;  //!< The maximum number of replications at the same time.
+
+}; // class ReplicationRunner
+
+} // namespace ns3
+
+#endif /* REPLICATION_RUNNER_H */
@@ -19,6 +19,7 @@
 #include "rng-seed-manager.h"
 
 #include "attribute-helper.h"
+#include "checkpoint.h"
 #include "config.h"
 #include "global-value.h"
 #include "log.h"
@@ -112,4 +113,42 @@ RngSeedManager::GetNextStreamIndex()
     return next;
 }
 
+namespace
+{
+
+/**
+ * \ingroup rngimpl
+ * Save the seed, the run number and the next stream index to a checkpoint.
+ *
+ * \param [in,out] writer The checkpoint writer.
+ */
+void
+SaveRngSeedManager(CheckpointWriter& writer)
+{
+    writer.Write("seed", RngSeedManager::GetSeed());
+    writer.Write("run", RngSeedManager::GetRun());
+    writer.Write("nextStreamIndex", g_nextStreamIndex);
+}
+
+/**
+ * \ingroup rngimpl
+ * Restore the seed, the run number and the next stream index.
+ *
+ * \param [in,out] reader The checkpoint reader.
+ */
+void
+RestoreRngSeedManager(CheckpointReader& reader)
+{
+    RngSeedManager::SetSeed(reader.Read<uint32_t>("seed"));
+    RngSeedManager::SetRun(reader.Read<uint64_t>("run"));
+    g_nextStreamIndex = reader.Read<uint64_t>("nextStreamIndex");
+}
+
+/** Register the state of the RngSeedManager with the checkpoints. */
+bool g_rngCheckpoint [[maybe_unused]] = CheckpointManager::RegisterGlobal("RngSeedManager",
+                                                                          &SaveRngSeedManager,
+                                                                          &RestoreRngSeedManager);
+
+} // unnamed namespace
+
 } // namespace ns3
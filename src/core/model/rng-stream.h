@@ -70,6 +70,18 @@ class RngStream
      * \returns The next random.
      */
     double RandU01();
+    /**
+     * Get the state of the generator, e.g., to save it to a checkpoint.
+     *
+     * \param [out] state The state vector.
+     */
+    void GetState(double state[6]) const;
+    /**
+     * Set the state of the generator, as returned by GetState().
+     *
+     * \param [in] state The state vector.
+     */
+    void SetState(const double state[6]);
 
   private:
     /**
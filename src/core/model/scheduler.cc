@@ -47,4 +47,14 @@ Scheduler::GetTypeId()
     return tid;
 }
 
+void
+Scheduler::BulkInsert(const std::vector<Event>& events)
+{
+    NS_LOG_FUNCTION(this << events.size());
+    for (const auto& ev : events)
+    {
+        Insert(ev);
+    }
+}
+
 } // namespace ns3
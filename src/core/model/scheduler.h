@@ -23,6 +23,7 @@
 #include "object.h"
 
 #include <stdint.h>
+#include <vector>
 
 /**
  * \file
@@ -111,6 +112,14 @@ class EventImpl;
  *      <td class="markdownTableBodyLeft"> 0 </td>
  * </tr>
  * <tr class="markdownTableBody">
+ *      <td class="markdownTableBodyLeft"> LadderScheduler </td>
+ *      <td class="markdownTableBodyLeft"> `std::vector<std::vector>` </td>
+ *      <td class="markdownTableBodyLeft"> ~Constant </td>
+ *      <td class="markdownTableBodyLeft"> ~Constant </td>
+ *      <td class="markdownTableBodyLeft"> 24 bytes per bucket </td>
+ *      <td class="markdownTableBodyLeft"> 0 </td>
+ * </tr>
+ * <tr class="markdownTableBody">
  *      <td class="markdownTableBodyLeft"> ListScheduler </td>
  *      <td class="markdownTableBodyLeft"> `std::list` </td>
  *      <td class="markdownTableBodyLeft"> Linear </td>
@@ -195,6 +204,16 @@ class Scheduler : public Object
      * \param [in] ev Event to store in the event list
      */
     virtual void Insert(const Event& ev) = 0;
+    /**
+     * Insert a batch of new Events in the schedule.
+     *
+     * The default implementation calls Insert() for each event.
+     * Subclasses can override it to amortize the cost of the
+     * insertions, e.g., by restoring their invariants only once.
+     *
+     * \param [in] events The events to store in the event list
+     */
+    virtual void BulkInsert(const std::vector<Event>& events);
     /**
      * Test if the schedule is empty.
      *
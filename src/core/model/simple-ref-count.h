@@ -27,6 +27,10 @@
 #include <limits>
 #include <stdint.h>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 /**
  * \file
  * \ingroup ptr
@@ -75,6 +79,10 @@ class Empty
  *      to the object it manages exist anymore.
  *
  * Interesting users of this class include ns3::Object as well as ns3::Packet.
+ *
+ * When ns-3 is configured with \c NS3_MTP, the reference count is atomic,
+ * so that objects can be shared between the threads of a multithreaded
+ * simulation.
  */
 template <typename T, typename PARENT = Empty, typename DELETER = DefaultDeleter<T>>
 class SimpleRefCount : public PARENT
@@ -125,8 +133,12 @@ class SimpleRefCount : public PARENT
      */
     inline void Unref() const
     {
+#ifdef NS3_MTP
+        if (m_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+#else
         m_count--;
         if (m_count == 0)
+#endif
         {
             DELETER::Delete(static_cast<T*>(const_cast<SimpleRefCount*>(this)));
         }
@@ -151,7 +163,11 @@ class SimpleRefCount : public PARENT
      * Note we make this mutable so that the const methods can still
      * change it.
      */
+#ifdef NS3_MTP
+    mutable std::atomic<uint32_t> m_count;
+#else
     mutable uint32_t m_count;
+#endif
 };
 
 } // namespace ns3
@@ -18,6 +18,7 @@
 
 #include "simulator-impl.h"
 
+#include "fatal-error.h"
 #include "log.h"
 
 /**
@@ -40,4 +41,37 @@ SimulatorImpl::GetTypeId()
     return tid;
 }
 
+void
+SimulatorImpl::ScheduleWithContextBatch(const std::vector<Simulator::ContextEvent>& events)
+{
+    for (const auto& ev : events)
+    {
+        ScheduleWithContext(ev.context, ev.delay, ev.event);
+    }
+}
+
+uint64_t
+SimulatorImpl::GetPendingEventCount() const
+{
+    return 0;
+}
+
+uint64_t
+SimulatorImpl::GetCancelledEventCount() const
+{
+    return 0;
+}
+
+std::vector<EventId>
+SimulatorImpl::GetPendingEvents()
+{
+    NS_FATAL_ERROR(GetInstanceTypeId().GetName() << " does not support checkpoints");
+}
+
+EventId
+SimulatorImpl::RestoreEvent(uint64_t ts, uint32_t context, uint32_t uid, EventImpl* event)
+{
+    NS_FATAL_ERROR(GetInstanceTypeId().GetName() << " does not support checkpoints");
+}
+
 } // namespace ns3
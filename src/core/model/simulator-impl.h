@@ -26,6 +26,9 @@
 #include "object-factory.h"
 #include "object.h"
 #include "ptr.h"
+#include "simulator.h"
+
+#include <vector>
 
 /**
  * \file
@@ -66,6 +69,12 @@ class SimulatorImpl : public Object
     virtual EventId Schedule(const Time& delay, EventImpl* event) = 0;
     /** \copydoc Simulator::ScheduleWithContext(uint32_t,const Time&,EventImpl*) */
     virtual void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) = 0;
+    /**
+     * \copydoc Simulator::ScheduleWithContextBatch
+     *
+     * The default implementation calls ScheduleWithContext() for each event.
+     */
+    virtual void ScheduleWithContextBatch(const std::vector<Simulator::ContextEvent>& events);
     /** \copydoc Simulator::ScheduleNow(const Ptr<EventImpl>&) */
     virtual EventId ScheduleNow(EventImpl* event) = 0;
     /** \copydoc Simulator::ScheduleDestroy(const Ptr<EventImpl>&) */
@@ -100,6 +109,39 @@ class SimulatorImpl : public Object
     virtual uint32_t GetContext() const = 0;
     /** \copydoc Simulator::GetEventCount */
     virtual uint64_t GetEventCount() const = 0;
+    /**
+     * \copydoc Simulator::GetPendingEventCount
+     *
+     * The default implementation returns 0.
+     */
+    virtual uint64_t GetPendingEventCount() const;
+    /**
+     * \copydoc Simulator::GetCancelledEventCount
+     *
+     * The default implementation returns 0.
+     */
+    virtual uint64_t GetCancelledEventCount() const;
+    /**
+     * Get the events pending in the event list, for a checkpoint.
+     *
+     * The default implementation aborts: checkpoints are not supported.
+     *
+     * \returns The pending events, excluding the cancelled and the
+     * Destroy events, in no particular order.
+     */
+    virtual std::vector<EventId> GetPendingEvents();
+    /**
+     * Insert an event restored from a checkpoint, with its original key.
+     *
+     * The default implementation aborts: checkpoints are not supported.
+     *
+     * \param [in] ts The event time, in time steps.
+     * \param [in] context The event context.
+     * \param [in] uid The event unique id.
+     * \param [in] event The event.
+     * \returns The id of the event.
+     */
+    virtual EventId RestoreEvent(uint64_t ts, uint32_t context, uint32_t uid, EventImpl* event);
 
     /**
      * Hook called before processing each event.
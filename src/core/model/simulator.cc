@@ -19,6 +19,7 @@
 #include "simulator.h"
 
 #include "assert.h"
+#include "checkpoint.h"
 #include "des-metrics.h"
 #include "event-impl.h"
 #include "global-value.h"
@@ -241,6 +242,18 @@ Simulator::ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* i
     return GetImpl()->ScheduleWithContext(context, delay, impl);
 }
 
+void
+Simulator::ScheduleWithContextBatch(const std::vector<ContextEvent>& events)
+{
+#ifdef ENABLE_DES_METRICS
+    for (const auto& ev : events)
+    {
+        DesMetrics::Get()->TraceWithContext(ev.context, Now(), ev.delay);
+    }
+#endif
+    GetImpl()->ScheduleWithContextBatch(events);
+}
+
 EventId
 Simulator::ScheduleDestroy(const Ptr<EventImpl>& ev)
 {
@@ -326,6 +339,32 @@ Simulator::GetEventCount()
     return GetImpl()->GetEventCount();
 }
 
+uint64_t
+Simulator::GetPendingEventCount()
+{
+    return GetImpl()->GetPendingEventCount();
+}
+
+uint64_t
+Simulator::GetCancelledEventCount()
+{
+    return GetImpl()->GetCancelledEventCount();
+}
+
+void
+Simulator::Checkpoint(const std::string& path)
+{
+    NS_LOG_FUNCTION(path);
+    CheckpointManager::Save(path);
+}
+
+void
+Simulator::Restore(const std::string& path)
+{
+    NS_LOG_FUNCTION(path);
+    CheckpointManager::Restore(path);
+}
+
 uint32_t
 Simulator::GetSystemId()
 {
@@ -28,6 +28,7 @@
 
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 /**
  * @file
@@ -216,6 +217,56 @@ class Simulator
      */
     static uint64_t GetEventCount();
 
+    /**
+     * Get the number of events in the event list which have not been
+     * cancelled.
+     *
+     * Only DefaultSimulatorImpl keeps track of the pending events; other
+     * implementations return 0.
+     *
+     * \returns The number of live events.
+     */
+    static uint64_t GetPendingEventCount();
+
+    /**
+     * Get the number of cancelled events still held in the event list.
+     *
+     * Cancelled events remain in the event list until they reach the
+     * head of the list, or until the list is compacted (see the
+     * \c CompactionThreshold attribute of DefaultSimulatorImpl).
+     * Only DefaultSimulatorImpl keeps track of the cancelled events;
+     * other implementations return 0.
+     *
+     * \returns The number of dead events.
+     */
+    static uint64_t GetCancelledEventCount();
+
+    /**
+     * Save the state of the simulation to a file, e.g., at the end of a
+     * warm-up phase shared by several simulations.
+     *
+     * This fails if one of the objects, or of the pending events, is
+     * not supported by the checkpoints.
+     *
+     * @param [in] path The name of the file.
+     * @see CheckpointManager::Save()
+     */
+    static void Checkpoint(const std::string& path);
+
+    /**
+     * Restore the state of the simulation from a file written by
+     * Checkpoint(), to resume the simulation from the saved time.
+     *
+     * The simulation must have been constructed like the saved one, and
+     * not yet run.  The events pending when restoring are discarded, so
+     * the events of the script, e.g., Stop(), must be scheduled after
+     * restoring.
+     *
+     * @param [in] path The name of the file.
+     * @see CheckpointManager::Restore()
+     */
+    static void Restore(const std::string& path);
+
     /**
      * @name Schedule events (in the same context) to run at a future time.
      */
@@ -481,6 +532,28 @@ class Simulator
      */
     static void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event);
 
+    /** An event to schedule with ScheduleWithContextBatch(). */
+    struct ContextEvent
+    {
+        uint32_t context; //!< Event context.
+        Time delay;       //!< Delay until the event expires.
+        EventImpl* event; //!< The event to schedule.
+    };
+
+    /**
+     * Schedule a batch of future event executions, each in its own
+     * context, e.g., the receptions of a frame by all the devices
+     * attached to a channel.
+     *
+     * This is equivalent to calling ScheduleWithContext() for each
+     * event, in order, but lets the simulator implementation insert
+     * the events in the event list at once (see Scheduler::BulkInsert).
+     * This method is thread-safe: it can be called from any thread.
+     *
+     * @param [in] events The events to schedule.
+     */
+    static void ScheduleWithContextBatch(const std::vector<ContextEvent>& events);
+
     /**
      * Schedule an event to run at the end of the simulation, after
      * the Stop() time or condition has been reached.
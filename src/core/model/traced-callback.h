@@ -22,7 +22,7 @@
 
 #include "callback.h"
 
-#include <list>
+#include <vector>
 
 /**
  * \file
@@ -47,6 +47,16 @@ namespace ns3
  * calling the \c operator() form with the appropriate
  * number of arguments.
  *
+ * Invoking a TracedCallback without any Callback connected only
+ * checks that the chain is empty, but the arguments are still
+ * evaluated by the caller.  When building the arguments is costly,
+ * e.g., a copy of a packet, use NS_TRACE, which does not evaluate
+ * them when nothing is connected.
+ *
+ * When ns-3 is configured with \c NS3_DISABLE_TRACING, the
+ * TracedCallback holds no Callback: connecting to it has no effect,
+ * IsEmpty() is always true and the trace calls compile away.
+ *
  * \tparam Ts \explicit Types of the functor arguments.
  */
 template <typename... Ts>
@@ -108,18 +118,43 @@ class TracedCallback
     /**@}*/
 
   private:
+#ifndef NS3_DISABLE_TRACING
     /**
      * Container type for holding the chain of Callbacks.
      *
      * \tparam Ts \deduced Types of the functor arguments.
      */
-    typedef std::list<Callback<void, Ts...>> CallbackList;
+    typedef std::vector<Callback<void, Ts...>> CallbackList;
     /** The chain of Callbacks. */
     CallbackList m_callbackList;
+#endif /* NS3_DISABLE_TRACING */
 };
 
 } // namespace ns3
 
+/**
+ * \ingroup tracing
+ *
+ * Invoke a TracedCallback, evaluating the arguments only when at
+ * least one Callback is connected to it.
+ *
+ * Typical usage looks like:
+ * \code
+ * NS_TRACE(m_rxTrace, packet->Copy(), header);
+ * \endcode
+ *
+ * \param [in] trace The TracedCallback.
+ * \param [in] ... The arguments of the TracedCallback.
+ */
+#define NS_TRACE(trace, ...)                                                                       \
+    do                                                                                             \
+    {                                                                                              \
+        if (!(trace).IsEmpty())                                                                    \
+        {                                                                                          \
+            (trace)(__VA_ARGS__);                                                                  \
+        }                                                                                          \
+    } while (false)
+
 /********************************************************************
  *  Implementation of the templates declared above.
  ********************************************************************/
@@ -127,6 +162,8 @@ class TracedCallback
 namespace ns3
 {
 
+#ifndef NS3_DISABLE_TRACING
+
 template <typename... Ts>
 TracedCallback<Ts...>::TracedCallback()
     : m_callbackList()
@@ -192,9 +229,12 @@ template <typename... Ts>
 void
 TracedCallback<Ts...>::operator()(Ts... args) const
 {
-    for (auto i = m_callbackList.begin(); i != m_callbackList.end(); i++)
+    // A Callback may connect another one to this trace source: index the
+    // chain, which can be reallocated, and invoke the new Callbacks too.
+    for (std::size_t i = 0; i < m_callbackList.size(); i++)
     {
-        (*i)(args...);
+        Callback<void, Ts...> cb = m_callbackList[i];
+        cb(args...);
     }
 }
 
@@ -205,6 +245,52 @@ TracedCallback<Ts...>::IsEmpty() const
     return m_callbackList.empty();
 }
 
+#else /* NS3_DISABLE_TRACING */
+
+template <typename... Ts>
+TracedCallback<Ts...>::TracedCallback()
+{
+}
+
+template <typename... Ts>
+void
+TracedCallback<Ts...>::ConnectWithoutContext(const CallbackBase& /* callback */)
+{
+}
+
+template <typename... Ts>
+void
+TracedCallback<Ts...>::Connect(const CallbackBase& /* callback */, std::string /* path */)
+{
+}
+
+template <typename... Ts>
+void
+TracedCallback<Ts...>::DisconnectWithoutContext(const CallbackBase& /* callback */)
+{
+}
+
+template <typename... Ts>
+void
+TracedCallback<Ts...>::Disconnect(const CallbackBase& /* callback */, std::string /* path */)
+{
+}
+
+template <typename... Ts>
+inline void
+TracedCallback<Ts...>::operator()(Ts... /* args */) const
+{
+}
+
+template <typename... Ts>
+inline bool
+TracedCallback<Ts...>::IsEmpty() const
+{
+    return true;
+}
+
+#endif /* NS3_DISABLE_TRACING */
+
 } // namespace ns3
 
 #endif /* TRACED_CALLBACK_H */
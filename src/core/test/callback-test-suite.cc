@@ -1178,6 +1178,129 @@ MakeCallbackTemplatesTestCase::DoRun()
     that.CheckParentalRights();
 }
 
+/**
+ * \ingroup callback-tests
+ *
+ * Check how the arguments are passed to the target and how the callable
+ * object is shared by the copies of a Callback.
+ */
+class CallbackArgumentsTestCase : public TestCase
+{
+  public:
+    CallbackArgumentsTestCase();
+
+    /** An argument counting its copies. */
+    struct Counted
+    {
+        Counted() = default;
+
+        /** Copy constructor. */
+        Counted(const Counted&)
+        {
+            m_copies++;
+        }
+
+        /** Move constructor. */
+        Counted(Counted&&) = default;
+
+        /**
+         * Copy assignment.
+         * \return This Counted.
+         */
+        Counted& operator=(const Counted&)
+        {
+            m_copies++;
+            return *this;
+        }
+
+        /**
+         * Move assignment.
+         * \return This Counted.
+         */
+        Counted& operator=(Counted&&) = default;
+
+        /**
+         * Equality, required to compare the bound arguments.
+         * \return \c true.
+         */
+        bool operator==(const Counted&) const
+        {
+            return true;
+        }
+
+        static uint32_t m_copies; //!< The number of copies.
+    };
+
+    /**
+     * Target taking its argument by reference.
+     * \param counted The argument.
+     */
+    void ByReference(const Counted& counted)
+    {
+    }
+
+    /**
+     * Target taking its argument by value.
+     * \param counted The argument.
+     */
+    void ByValue(Counted counted)
+    {
+    }
+
+  private:
+    void DoRun() override;
+};
+
+uint32_t CallbackArgumentsTestCase::Counted::m_copies = 0;
+
+CallbackArgumentsTestCase::CallbackArgumentsTestCase()
+    : TestCase("Check the arguments and the state of the callable objects")
+{
+}
+
+void
+CallbackArgumentsTestCase::DoRun()
+{
+    Counted counted;
+
+    //
+    // Make sure that the arguments passed by reference are not copied.
+    //
+    Callback<void, const Counted&> byReference =
+        MakeCallback(&CallbackArgumentsTestCase::ByReference, this);
+    Counted::m_copies = 0;
+    byReference(counted);
+    NS_TEST_ASSERT_MSG_EQ(Counted::m_copies, 0, "Argument passed by reference copied");
+
+    //
+    // Make sure that the arguments passed by value are copied once, by the
+    // call to the Callback, and then moved to the target.
+    //
+    Callback<void, Counted> byValue = MakeCallback(&CallbackArgumentsTestCase::ByValue, this);
+    Counted::m_copies = 0;
+    byValue(counted);
+    NS_TEST_ASSERT_MSG_EQ(Counted::m_copies, 1, "Argument passed by value copied again");
+
+    //
+    // Make sure that the bound arguments are not copied by the calls.
+    //
+    Callback<void> bound = MakeCallback(&CallbackArgumentsTestCase::ByReference, this, counted);
+    Counted::m_copies = 0;
+    bound();
+    bound();
+    NS_TEST_ASSERT_MSG_EQ(Counted::m_copies, 0, "Bound argument copied by the calls");
+
+    //
+    // Make sure that the copies of a Callback share the state of the
+    // callable object.
+    //
+    Callback<int> count([n = 0]() mutable { return ++n; });
+    Callback<int> copy = count;
+    NS_TEST_ASSERT_MSG_EQ(count(), 1, "Wrong state of the callable object");
+    NS_TEST_ASSERT_MSG_EQ(copy(), 2, "State of the callable object not shared");
+    NS_TEST_ASSERT_MSG_EQ(copy.IsEqual(count), true, "Copies of a Callback not equal");
+}
+
 /**
  * \ingroup callback-tests
  *
@@ -1198,6 +1321,7 @@ CallbackTestSuite::CallbackTestSuite()
     AddTestCase(new CallbackEqualityTestCase, TestCase::Duration::QUICK);
     AddTestCase(new NullifyCallbackTestCase, TestCase::Duration::QUICK);
     AddTestCase(new MakeCallbackTemplatesTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new CallbackArgumentsTestCase, TestCase::Duration::QUICK);
 }
 
 static CallbackTestSuite g_gallbackTestSuite; //!< Static variable for test initialization
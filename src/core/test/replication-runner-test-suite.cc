@@ -0,0 +1,173 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/random-variable-stream.h"
+#include "ns3/replication-runner.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <sstream>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup simulator
+ * ReplicationRunner test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup simulator-tests
+ *
+ * Check that the replications share the warm-up phase, and draw
+ * independent and reproducible values.
+ */
+class ReplicationRunnerTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ReplicationRunnerTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** Draw the random variables, and schedule the next draw. */
+    void Draw();
+
+    /**
+     * Get the result of a replication.
+     * \param [in] run The run number of the replication.
+     * \returns The number of draws, the sum of the values and the time.
+     */
+    std::string Collect(uint64_t run);
+
+    Ptr<UniformRandomVariable> m_uniform; //!< A stream with an automatic stream number.
+    Ptr<NormalRandomVariable> m_normal;   //!< A stream with an assigned stream number.
+    uint32_t m_draws;                     //!< The number of draws.
+    double m_sum;                         //!< The sum of the values drawn.
+};
+
+ReplicationRunnerTestCase::ReplicationRunnerTestCase()
+    : TestCase("Check the replications sharing a warm-up phase")
+{
+}
+
+void
+ReplicationRunnerTestCase::Draw()
+{
+    m_draws++;
+    m_sum += m_uniform->GetValue() + m_normal->GetValue();
+    Simulator::Schedule(MilliSeconds(100), &ReplicationRunnerTestCase::Draw, this);
+}
+
+std::string
+ReplicationRunnerTestCase::Collect(uint64_t run)
+{
+    std::ostringstream oss;
+    oss.precision(17);
+    oss << run << " " << m_draws << " " << m_sum << " " << Simulator::Now().GetTimeStep();
+    return oss.str();
+}
+
+void
+ReplicationRunnerTestCase::DoRun()
+{
+    m_draws = 0;
+    m_sum = 0;
+    m_uniform = CreateObject<UniformRandomVariable>();
+    m_normal = CreateObject<NormalRandomVariable>();
+    m_normal->SetStream(7);
+    Simulator::Schedule(MilliSeconds(50), &ReplicationRunnerTestCase::Draw, this);
+
+    uint64_t run = RngSeedManager::GetRun();
+    ReplicationRunner runner;
+    runner.SetReplications(3);
+    runner.SetMaxParallel(2);
+    std::vector<std::string> results =
+        runner.Run(Seconds(1),
+                   Seconds(1),
+                   MakeCallback(&ReplicationRunnerTestCase::Collect, this));
+
+    NS_TEST_ASSERT_MSG_EQ(Simulator::Now(), Seconds(1), "Wrong time after the replications");
+    NS_TEST_ASSERT_MSG_EQ(m_draws, 10, "The replications changed the parent process");
+    NS_TEST_ASSERT_MSG_EQ(RngSeedManager::GetRun(), run, "The run number changed");
+    NS_TEST_ASSERT_MSG_EQ(results.size(), 3, "Wrong number of results");
+    std::vector<double> sums;
+    for (uint32_t i = 0; i < results.size(); i++)
+    {
+        std::istringstream iss(results[i]);
+        uint64_t replicationRun;
+        uint32_t draws;
+        double sum;
+        int64_t now;
+        iss >> replicationRun >> draws >> sum >> now;
+        NS_TEST_ASSERT_MSG_EQ(iss.fail(), false, "Invalid result \"" << results[i] << "\"");
+        NS_TEST_ASSERT_MSG_EQ(replicationRun, run + i, "Wrong run number");
+        NS_TEST_ASSERT_MSG_EQ(draws, 20, "Wrong number of draws");
+        NS_TEST_ASSERT_MSG_EQ(now, Seconds(2).GetTimeStep(), "Wrong end time");
+        for (double other : sums)
+        {
+            NS_TEST_ASSERT_MSG_NE(sum, other, "Replications not independent");
+        }
+        sums.push_back(sum);
+    }
+
+    // The warm-up phase is done: the same replications give the same results
+    runner.SetFirstRun(run + 1);
+    runner.SetReplications(2);
+    std::vector<std::string> again =
+        runner.Run(Seconds(1),
+                   Seconds(1),
+                   MakeCallback(&ReplicationRunnerTestCase::Collect, this));
+    NS_TEST_ASSERT_MSG_EQ(again.size(), 2, "Wrong number of results");
+    NS_TEST_ASSERT_MSG_EQ(again[0], results[1], "Replication not reproducible");
+    NS_TEST_ASSERT_MSG_EQ(again[1], results[2], "Replication not reproducible");
+
+    m_uniform = nullptr;
+    m_normal = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup simulator-tests
+ * ReplicationRunner test suite.
+ */
+class ReplicationRunnerTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    ReplicationRunnerTestSuite()
+        : TestSuite("replication-runner")
+    {
+        AddTestCase(new ReplicationRunnerTestCase());
+    }
+};
+
+/**
+ * \ingroup simulator-tests
+ * ReplicationRunnerTestSuite instance variable.
+ */
+static ReplicationRunnerTestSuite g_replicationRunnerTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -17,12 +17,26 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "ns3/calendar-scheduler.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/event-profiler.h"
 #include "ns3/heap-scheduler.h"
+#include "ns3/ladder-scheduler.h"
 #include "ns3/list-scheduler.h"
+#include "ns3/make-event.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/random-variable-stream.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <fstream>
+#include <map>
+#include <random>
+#include <vector>
 
 using namespace ns3;
 
@@ -707,6 +721,571 @@ SimulatorTemplateTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check the order of the events in a scheduler against the MapScheduler.
+ *
+ * The events are inserted and removed directly through the Scheduler
+ * API, with clustered timestamps, many events with the same timestamp
+ * and inserts before the next event, to exercise the transfers between
+ * the tiers of the LadderScheduler.
+ */
+class SchedulerOrderTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * \param schedulerFactory Scheduler factory.
+     */
+    SchedulerOrderTestCase(ObjectFactory schedulerFactory);
+    void DoRun() override;
+
+  private:
+    /**
+     * Insert an event in both schedulers.
+     * \param ts The event timestamp.
+     */
+    void Insert(uint64_t ts);
+
+    ObjectFactory m_schedulerFactory;              //!< Scheduler factory.
+    Ptr<Scheduler> m_scheduler;                    //!< The scheduler under test.
+    Ptr<Scheduler> m_reference;                    //!< The reference scheduler.
+    std::map<uint32_t, Scheduler::Event> m_events; //!< Pending events, by uid.
+    uint32_t m_uid;                                //!< Next event uid.
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase(ObjectFactory schedulerFactory)
+    : TestCase("Check the order of the events with " + schedulerFactory.GetTypeId().GetName()),
+      m_schedulerFactory(schedulerFactory),
+      m_uid(0)
+{
+}
+
+void
+SchedulerOrderTestCase::Insert(uint64_t ts)
+{
+    Scheduler::Event ev;
+    ev.impl = nullptr;
+    ev.key.m_ts = ts;
+    ev.key.m_uid = m_uid++;
+    ev.key.m_context = 0;
+    m_scheduler->Insert(ev);
+    m_reference->Insert(ev);
+    m_events[ev.key.m_uid] = ev;
+}
+
+void
+SchedulerOrderTestCase::DoRun()
+{
+    m_scheduler = m_schedulerFactory.Create<Scheduler>();
+    m_reference = CreateObject<MapScheduler>();
+    std::mt19937_64 rng(1);
+    std::exponential_distribution<double> delay(1e-3);
+    std::uniform_int_distribution<uint32_t> coin(0, 99);
+
+    uint64_t now = 0;
+    for (uint32_t i = 0; i < 20000; ++i)
+    {
+        uint32_t draw = coin(rng);
+        if (draw < 1)
+        {
+            // Burst of events at the same time
+            for (uint32_t j = 0; j < 100; ++j)
+            {
+                Insert(now + 5000);
+            }
+        }
+        else if (draw < 2)
+        {
+            // Fan-out of events with close timestamps, inserted at once
+            std::vector<Scheduler::Event> batch;
+            for (uint32_t j = 0; j < 20; ++j)
+            {
+                Scheduler::Event ev;
+                ev.impl = nullptr;
+                ev.key.m_ts = now + static_cast<uint64_t>(delay(rng) / 10);
+                ev.key.m_uid = m_uid++;
+                ev.key.m_context = j;
+                batch.push_back(ev);
+                m_reference->Insert(ev);
+                m_events[ev.key.m_uid] = ev;
+            }
+            m_scheduler->BulkInsert(batch);
+        }
+        else if (draw < 5 && !m_events.empty())
+        {
+            auto it = m_events.lower_bound(rng() % m_uid);
+            if (it == m_events.end())
+            {
+                it = m_events.begin();
+            }
+            m_scheduler->Remove(it->second);
+            m_reference->Remove(it->second);
+            m_events.erase(it);
+        }
+        else if (draw < 30)
+        {
+            // Mostly near future, with a long tail
+            Insert(now + static_cast<uint64_t>(delay(rng) * (draw < 25 ? 1 : 1000)));
+        }
+        else if (!m_reference->IsEmpty())
+        {
+            Scheduler::Event expected = m_reference->RemoveNext();
+            NS_TEST_ASSERT_MSG_EQ(m_scheduler->IsEmpty(), false, "Scheduler is empty");
+            NS_TEST_ASSERT_MSG_EQ(m_scheduler->PeekNext().key.m_uid,
+                                  expected.key.m_uid,
+                                  "Unexpected next event");
+            Scheduler::Event ev = m_scheduler->RemoveNext();
+            NS_TEST_ASSERT_MSG_EQ(ev.key.m_ts, expected.key.m_ts, "Unexpected timestamp");
+            NS_TEST_ASSERT_MSG_EQ(ev.key.m_uid, expected.key.m_uid, "Unexpected event");
+            m_events.erase(ev.key.m_uid);
+            now = ev.key.m_ts;
+        }
+    }
+    while (!m_reference->IsEmpty())
+    {
+        Scheduler::Event expected = m_reference->RemoveNext();
+        Scheduler::Event ev = m_scheduler->RemoveNext();
+        NS_TEST_ASSERT_MSG_EQ(ev.key.m_uid, expected.key.m_uid, "Unexpected event");
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_scheduler->IsEmpty(), true, "Scheduler is not empty");
+    m_scheduler = nullptr;
+    m_reference = nullptr;
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that the memory of the events is recycled by the EventImpl pool.
+ */
+class EventImplPoolTestCase : public TestCase
+{
+  public:
+    EventImplPoolTestCase();
+    void DoRun() override;
+
+  private:
+    /** Test event. */
+    void Event();
+};
+
+EventImplPoolTestCase::EventImplPoolTestCase()
+    : TestCase("Check that the memory of the events is recycled")
+{
+}
+
+void
+EventImplPoolTestCase::Event()
+{
+}
+
+void
+EventImplPoolTestCase::DoRun()
+{
+    EventImpl* event = MakeEvent(&EventImplPoolTestCase::Event, this);
+    void* block = event;
+    event->Unref();
+
+    EventImpl::PoolStats before = EventImpl::GetPoolStats();
+    NS_TEST_ASSERT_MSG_GT(before.cached, 0, "Released event not cached");
+    event = MakeEvent(&EventImplPoolTestCase::Event, this);
+    EventImpl::PoolStats after = EventImpl::GetPoolStats();
+    NS_TEST_ASSERT_MSG_EQ(static_cast<void*>(event), block, "Memory of the event not recycled");
+    NS_TEST_ASSERT_MSG_EQ(after.allocations, before.allocations + 1, "Allocation not counted");
+    NS_TEST_ASSERT_MSG_EQ(after.reused, before.reused + 1, "Reuse not counted");
+    NS_TEST_ASSERT_MSG_EQ(after.cached, before.cached - 1, "Block not taken from the pool");
+
+    event->Unref();
+
+    // Removed events return to the pool as well
+    EventId id = Simulator::Schedule(Seconds(1), &EventImplPoolTestCase::Event, this);
+    NS_TEST_ASSERT_MSG_EQ(static_cast<void*>(id.PeekEventImpl()),
+                          block,
+                          "Memory of the scheduled event not recycled");
+    Simulator::Remove(id);
+    id = EventId();
+    before = EventImpl::GetPoolStats();
+    id = Simulator::Schedule(Seconds(1), &EventImplPoolTestCase::Event, this);
+    after = EventImpl::GetPoolStats();
+    NS_TEST_ASSERT_MSG_EQ(static_cast<void*>(id.PeekEventImpl()),
+                          block,
+                          "Memory of the removed event not recycled");
+    NS_TEST_ASSERT_MSG_EQ(after.reused, before.reused + 1, "Reuse not counted");
+    Simulator::Destroy();
+
+    EventImpl::SetPoolEnabled(false);
+    before = EventImpl::GetPoolStats();
+    event = MakeEvent(&EventImplPoolTestCase::Event, this);
+    event->Unref();
+    after = EventImpl::GetPoolStats();
+    EventImpl::SetPoolEnabled(true);
+    NS_TEST_ASSERT_MSG_EQ(after.reused, before.reused, "Disabled pool used");
+    NS_TEST_ASSERT_MSG_EQ(after.cached, before.cached, "Disabled pool used");
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check the tracking of the cancelled events and the compaction
+ * of the event list in DefaultSimulatorImpl.
+ */
+class SimulatorCompactionTestCase : public TestCase
+{
+  public:
+    SimulatorCompactionTestCase();
+    void DoRun() override;
+
+  private:
+    /** Test event. */
+    void Event();
+
+    uint32_t m_executed; //!< Number of events executed.
+};
+
+SimulatorCompactionTestCase::SimulatorCompactionTestCase()
+    : TestCase("Check the compaction of the cancelled events"),
+      m_executed(0)
+{
+}
+
+void
+SimulatorCompactionTestCase::Event()
+{
+    m_executed++;
+}
+
+void
+SimulatorCompactionTestCase::DoRun()
+{
+    ObjectFactory factory("ns3::DefaultSimulatorImpl");
+    factory.Set("CompactionThreshold", DoubleValue(0.5));
+    factory.Set("CompactionMinEvents", UintegerValue(10));
+    Ptr<DefaultSimulatorImpl> impl = factory.Create<DefaultSimulatorImpl>();
+    Simulator::SetImplementation(impl);
+
+    std::vector<EventId> ids;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        ids.push_back(
+            Simulator::Schedule(MicroSeconds(i), &SimulatorCompactionTestCase::Event, this));
+    }
+    NS_TEST_ASSERT_MSG_EQ(Simulator::GetPendingEventCount(), 100, "Wrong number of live events");
+
+    for (uint32_t i = 0; i < 49; ++i)
+    {
+        ids[2 * i].Cancel();
+    }
+    ids[0].Cancel(); // Already cancelled
+    NS_TEST_ASSERT_MSG_EQ(Simulator::GetCancelledEventCount(), 49, "Wrong number of dead events");
+    NS_TEST_ASSERT_MSG_EQ(Simulator::GetPendingEventCount(), 51, "Wrong number of live events");
+    NS_TEST_ASSERT_MSG_EQ(impl->GetCompactionCount(), 0, "Unexpected compaction");
+
+    ids[98].Cancel();
+    NS_TEST_ASSERT_MSG_EQ(impl->GetCompactionCount(), 1, "Event list not compacted");
+    NS_TEST_ASSERT_MSG_EQ(Simulator::GetCancelledEventCount(), 0, "Dead events not removed");
+    NS_TEST_ASSERT_MSG_EQ(Simulator::GetPendingEventCount(), 50, "Live events removed");
+    NS_TEST_ASSERT_MSG_EQ(ids[98].IsExpired(), true, "Removed event not expired");
+    NS_TEST_ASSERT_MSG_EQ(ids[99].IsPending(), true, "Live event not pending");
+
+    ids[1].Cancel();
+    ids[3].Remove();
+    NS_TEST_ASSERT_MSG_EQ(Simulator::GetCancelledEventCount(), 1, "Wrong number of dead events");
+    NS_TEST_ASSERT_MSG_EQ(Simulator::GetPendingEventCount(), 48, "Wrong number of live events");
+
+    Simulator::Run();
+    NS_TEST_ASSERT_MSG_EQ(m_executed, 48, "Wrong number of events executed");
+    NS_TEST_ASSERT_MSG_EQ(Simulator::GetCancelledEventCount(), 0, "Dead events left");
+    NS_TEST_ASSERT_MSG_EQ(Simulator::GetPendingEventCount(), 0, "Live events left");
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that a batch of events scheduled with
+ * Simulator::ScheduleWithContextBatch is executed in the same order as
+ * the same events scheduled one at a time.
+ */
+class SimulatorBatchTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * \param schedulerFactory Scheduler factory.
+     */
+    SimulatorBatchTestCase(ObjectFactory schedulerFactory);
+    void DoRun() override;
+
+  private:
+    /**
+     * Test event, recording its context and index.
+     * \param index The index of the event in the batch.
+     */
+    void Event(uint32_t index);
+    /**
+     * Schedule the test events.
+     * \param batch Whether to schedule the events in a batch.
+     */
+    void ScheduleEvents(bool batch);
+
+    ObjectFactory m_schedulerFactory;                   //!< Scheduler factory.
+    std::vector<std::pair<uint32_t, uint32_t>> m_trace; //!< Executed (context, index).
+};
+
+SimulatorBatchTestCase::SimulatorBatchTestCase(ObjectFactory schedulerFactory)
+    : TestCase("Check batches of events with context with " +
+               schedulerFactory.GetTypeId().GetName()),
+      m_schedulerFactory(schedulerFactory)
+{
+}
+
+void
+SimulatorBatchTestCase::Event(uint32_t index)
+{
+    m_trace.emplace_back(Simulator::GetContext(), index);
+}
+
+void
+SimulatorBatchTestCase::ScheduleEvents(bool batch)
+{
+    std::vector<Simulator::ContextEvent> events;
+    for (uint32_t i = 0; i < 50; ++i)
+    {
+        Time delay = MicroSeconds((i * 7) % 5);
+        if (batch)
+        {
+            events.push_back({i % 3, delay, MakeEvent(&SimulatorBatchTestCase::Event, this, i)});
+        }
+        else
+        {
+            Simulator::ScheduleWithContext(i % 3, delay, &SimulatorBatchTestCase::Event, this, i);
+        }
+    }
+    Simulator::ScheduleWithContextBatch(events);
+}
+
+void
+SimulatorBatchTestCase::DoRun()
+{
+    std::vector<std::pair<uint32_t, uint32_t>> reference;
+    for (bool batch : {false, true})
+    {
+        m_trace.clear();
+        Simulator::SetScheduler(m_schedulerFactory);
+        // Events already in the event list
+        for (uint32_t i = 0; i < 10; ++i)
+        {
+            Simulator::Schedule(MicroSeconds(i), &SimulatorBatchTestCase::Event, this, 100 + i);
+        }
+        Simulator::Schedule(MicroSeconds(2), &SimulatorBatchTestCase::ScheduleEvents, this, batch);
+        Simulator::Run();
+        Simulator::Destroy();
+        if (!batch)
+        {
+            reference = m_trace;
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_trace.size(), 60, "Wrong number of events");
+    NS_TEST_ASSERT_MSG_EQ((m_trace == reference), true, "Batch executed in a different order");
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check the event profiler of DefaultSimulatorImpl.
+ */
+class SimulatorProfilerTestCase : public TestCase
+{
+  public:
+    SimulatorProfilerTestCase();
+    void DoRun() override;
+
+  private:
+    /** Test event without argument. */
+    void EventA();
+    /**
+     * Test event scheduling other events.
+     * \param n The number of events to schedule.
+     */
+    void EventB(uint32_t n);
+    /** Test event scheduled by EventB(). */
+    static void EventC();
+};
+
+SimulatorProfilerTestCase::SimulatorProfilerTestCase()
+    : TestCase("Check the event profiler")
+{
+}
+
+void
+SimulatorProfilerTestCase::EventA()
+{
+}
+
+void
+SimulatorProfilerTestCase::EventB(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        Simulator::Schedule(MicroSeconds(1), &SimulatorProfilerTestCase::EventC);
+    }
+}
+
+void
+SimulatorProfilerTestCase::EventC()
+{
+}
+
+void
+SimulatorProfilerTestCase::DoRun()
+{
+    std::string file = CreateTempDirFilename("event-profile.txt");
+    ObjectFactory factory("ns3::DefaultSimulatorImpl");
+    factory.Set("EnableProfiler", BooleanValue(true));
+    factory.Set("ProfilerFile", StringValue(file));
+    Ptr<DefaultSimulatorImpl> impl = factory.Create<DefaultSimulatorImpl>();
+    Simulator::SetImplementation(impl);
+    const EventProfiler* profiler = impl->GetProfiler();
+    NS_TEST_ASSERT_MSG_NE(profiler, nullptr, "Profiler not enabled");
+
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        Simulator::ScheduleWithContext(1,
+                                       MicroSeconds(i),
+                                       &SimulatorProfilerTestCase::EventA,
+                                       this);
+    }
+    Simulator::ScheduleWithContext(2, MicroSeconds(1), &SimulatorProfilerTestCase::EventB, this, 2);
+    EventId cancelled = Simulator::Schedule(Seconds(1), &SimulatorProfilerTestCase::EventA, this);
+    cancelled.Cancel();
+    Simulator::Run();
+
+    EventProfiler::Entry total = profiler->GetTotal();
+    NS_TEST_ASSERT_MSG_EQ(total.count, 6, "Wrong number of events profiled");
+    NS_TEST_ASSERT_MSG_EQ(total.allocations, 2, "Wrong number of events allocated");
+
+    auto types = profiler->GetTypeEntries();
+    NS_TEST_ASSERT_MSG_EQ(types.size(), 3, "Wrong number of event types");
+    std::map<uint64_t, std::string> typeByCount;
+    for (const auto& [name, entry] : types)
+    {
+        typeByCount[entry.count] = name;
+        NS_TEST_ASSERT_MSG_EQ(entry.allocations,
+                              (entry.count == 1 ? 2 : 0),
+                              "Wrong allocations for " << name);
+    }
+    NS_TEST_ASSERT_MSG_EQ(typeByCount.size(), 3, "Wrong number of events by type");
+    NS_TEST_ASSERT_MSG_NE(typeByCount[1].find("SimulatorProfilerTestCase"),
+                          std::string::npos,
+                          "Type name not demangled: " << typeByCount[1]);
+    NS_TEST_ASSERT_MSG_NE(typeByCount[1].find("unsigned int"),
+                          std::string::npos,
+                          "Type name without the argument types: " << typeByCount[1]);
+
+    auto contexts = profiler->GetContextEntries();
+    NS_TEST_ASSERT_MSG_EQ(contexts.size(), 2, "Wrong number of contexts");
+    for (const auto& [context, entry] : contexts)
+    {
+        NS_TEST_ASSERT_MSG_EQ(entry.count, 3, "Wrong number of events for node " << context);
+    }
+    for (std::size_t i = 1; i < types.size(); ++i)
+    {
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(types[i - 1].second.nanoseconds,
+                                    types[i].second.nanoseconds,
+                                    "Event types not sorted by time");
+    }
+
+    Simulator::Destroy();
+
+    std::ifstream report(file);
+    NS_TEST_ASSERT_MSG_EQ(report.is_open(), true, "Report not written");
+    uint32_t comments = 0;
+    std::map<std::string, uint32_t> lines;
+    std::string line;
+    while (std::getline(report, line))
+    {
+        if (line.starts_with("#"))
+        {
+            comments++;
+        }
+        else
+        {
+            lines[line.substr(0, line.find('\t'))]++;
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(comments, 2, "Wrong report header");
+    NS_TEST_ASSERT_MSG_EQ(lines["type"], 3, "Wrong number of event types in the report");
+    NS_TEST_ASSERT_MSG_EQ(lines["node"], 2, "Wrong number of nodes in the report");
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that a checkpoint restores the time and the random variable streams.
+ */
+class SimulatorCheckpointTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    SimulatorCheckpointTestCase();
+    void DoRun() override;
+};
+
+SimulatorCheckpointTestCase::SimulatorCheckpointTestCase()
+    : TestCase("Check the checkpoint of the simulator and of the random variable streams")
+{
+}
+
+void
+SimulatorCheckpointTestCase::DoRun()
+{
+    std::string file = CreateTempDirFilename("checkpoint.txt");
+    const uint32_t draws = 5;
+
+    Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable>();
+    Ptr<NormalRandomVariable> normal = CreateObject<NormalRandomVariable>();
+    normal->SetStream(7);
+    Simulator::Stop(Seconds(1));
+    Simulator::Run();
+    uniform->GetValue();
+    // An odd number of draws leaves the second normal value cached
+    normal->GetValue();
+    Simulator::Checkpoint(file);
+    Time now = Simulator::Now();
+    std::vector<double> expected;
+    for (uint32_t i = 0; i < draws; i++)
+    {
+        expected.push_back(uniform->GetValue());
+        expected.push_back(normal->GetValue());
+    }
+    uniform = nullptr;
+    normal = nullptr;
+    Simulator::Destroy();
+
+    std::ifstream checkpoint(file);
+    std::string header;
+    std::getline(checkpoint, header);
+    NS_TEST_ASSERT_MSG_EQ(header, "ns3-checkpoint 1", "Wrong checkpoint header");
+
+    uniform = CreateObject<UniformRandomVariable>();
+    normal = CreateObject<NormalRandomVariable>();
+    normal->SetStream(7);
+    Simulator::Restore(file);
+    NS_TEST_ASSERT_MSG_EQ(Simulator::Now(), now, "Time not restored");
+    for (uint32_t i = 0; i < draws; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(uniform->GetValue(), expected[2 * i], "Uniform stream not restored");
+        NS_TEST_ASSERT_MSG_EQ(normal->GetValue(),
+                              expected[2 * i + 1],
+                              "Normal stream not restored");
+    }
+    Simulator::Stop(Seconds(1));
+    Simulator::Run();
+    NS_TEST_ASSERT_MSG_EQ(Simulator::Now(), now + Seconds(1), "Simulation not resumed");
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup simulator-tests
  *
@@ -730,6 +1309,30 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        for (const auto& type : {ListScheduler::GetTypeId(),
+                                 MapScheduler::GetTypeId(),
+                                 HeapScheduler::GetTypeId(),
+                                 CalendarScheduler::GetTypeId(),
+                                 PriorityQueueScheduler::GetTypeId(),
+                                 LadderScheduler::GetTypeId()})
+        {
+            factory.SetTypeId(type);
+            AddTestCase(new SimulatorBatchTestCase(factory), TestCase::Duration::QUICK);
+        }
+        factory.SetTypeId(HeapScheduler::GetTypeId());
+        AddTestCase(new SchedulerOrderTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(CalendarScheduler::GetTypeId());
+        AddTestCase(new SchedulerOrderTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(LadderScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        AddTestCase(new SchedulerOrderTestCase(factory), TestCase::Duration::QUICK);
+        factory.Set("Threshold", UintegerValue(4));
+        factory.Set("MaxRungs", UintegerValue(3));
+        AddTestCase(new SchedulerOrderTestCase(factory), TestCase::Duration::QUICK);
+        AddTestCase(new EventImplPoolTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new SimulatorCompactionTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new SimulatorProfilerTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new SimulatorCheckpointTestCase(), TestCase::Duration::QUICK);
     }
 };
 
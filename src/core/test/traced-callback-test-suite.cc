@@ -133,6 +133,103 @@ BasicTracedCallbackTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_two, true, "Callback CbTwo not called");
 }
 
+/**
+ * \ingroup tracedcallback-tests
+ *
+ * TracedCallback Test case, check that NS_TRACE evaluates the arguments
+ * only when a Callback is connected, and that the Callbacks connected while
+ * the chain is invoked are invoked too.
+ */
+class NsTraceTracedCallbackTestCase : public TestCase
+{
+  public:
+    NsTraceTracedCallbackTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Build an argument of the trace.
+     * \returns The argument.
+     */
+    uint32_t Argument();
+
+    /**
+     * Callback connecting another Callback to the trace the first time it is called.
+     * \param value The argument of the trace.
+     */
+    void Connecting(uint32_t value);
+
+    /**
+     * Callback counting its calls.
+     * \param value The argument of the trace.
+     */
+    void Counting(uint32_t value);
+
+    TracedCallback<uint32_t> m_trace; //!< The trace.
+    uint32_t m_arguments;             //!< Number of arguments built.
+    uint32_t m_connecting;            //!< Number of calls of Connecting.
+    uint32_t m_counting;              //!< Number of calls of Counting.
+};
+
+NsTraceTracedCallbackTestCase::NsTraceTracedCallbackTestCase()
+    : TestCase("Check NS_TRACE and the Callbacks connected by a Callback")
+{
+}
+
+uint32_t
+NsTraceTracedCallbackTestCase::Argument()
+{
+    return ++m_arguments;
+}
+
+void
+NsTraceTracedCallbackTestCase::Connecting(uint32_t /* value */)
+{
+    if (m_connecting++ == 0)
+    {
+        // Force the chain of Callbacks to grow while it is invoked
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            m_trace.ConnectWithoutContext(
+                MakeCallback(&NsTraceTracedCallbackTestCase::Counting, this));
+        }
+    }
+}
+
+void
+NsTraceTracedCallbackTestCase::Counting(uint32_t /* value */)
+{
+    m_counting++;
+}
+
+void
+NsTraceTracedCallbackTestCase::DoRun()
+{
+    m_arguments = 0;
+    m_connecting = 0;
+    m_counting = 0;
+
+    NS_TEST_ASSERT_MSG_EQ(m_trace.IsEmpty(), true, "Trace unexpectedly connected");
+    NS_TRACE(m_trace, Argument());
+    NS_TEST_ASSERT_MSG_EQ(m_arguments, 0, "Argument built without any Callback connected");
+
+    m_trace.ConnectWithoutContext(MakeCallback(&NsTraceTracedCallbackTestCase::Connecting, this));
+    NS_TRACE(m_trace, Argument());
+    NS_TEST_ASSERT_MSG_EQ(m_arguments, 1, "Argument not built");
+    NS_TEST_ASSERT_MSG_EQ(m_connecting, 1, "Callback Connecting not called");
+    NS_TEST_ASSERT_MSG_EQ(m_counting, 16, "Callbacks connected during the call not called");
+
+    m_trace(Argument());
+    NS_TEST_ASSERT_MSG_EQ(m_connecting, 2, "Callback Connecting not called");
+    NS_TEST_ASSERT_MSG_EQ(m_counting, 32, "Callbacks Counting not called");
+
+    m_trace.DisconnectWithoutContext(MakeCallback(&NsTraceTracedCallbackTestCase::Counting, this));
+    m_trace.DisconnectWithoutContext(
+        MakeCallback(&NsTraceTracedCallbackTestCase::Connecting, this));
+    NS_TEST_ASSERT_MSG_EQ(m_trace.IsEmpty(), true, "Callbacks not disconnected");
+}
+
 /**
  * \ingroup tracedcallback-tests
  *
@@ -148,6 +245,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite()
     : TestSuite("traced-callback", Type::UNIT)
 {
     AddTestCase(new BasicTracedCallbackTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new NsTraceTracedCallbackTestCase, TestCase::Duration::QUICK);
 }
 
 static TracedCallbackTestSuite
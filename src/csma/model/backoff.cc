@@ -99,6 +99,12 @@ Backoff::IncrNumRetries()
     m_numBackoffRetries++;
 }
 
+uint32_t
+Backoff::GetNumRetries() const
+{
+    return m_numBackoffRetries;
+}
+
 int64_t
 Backoff::AssignStreams(int64_t stream)
 {
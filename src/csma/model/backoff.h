@@ -104,6 +104,11 @@ class Backoff
      */
     void IncrNumRetries();
 
+    /**
+     * \return The number of retries of the current packet
+     */
+    uint32_t GetNumRetries() const;
+
     /**
      * Assign a fixed random variable stream number to the random variables
      * used by this model.  Return the number of streams (possibly zero) that
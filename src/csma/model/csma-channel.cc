@@ -21,10 +21,13 @@
 
 #include "csma-net-device.h"
 
+#include "ns3/event-impl.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -32,6 +35,56 @@ NS_LOG_COMPONENT_DEFINE("CsmaChannel");
 
 NS_OBJECT_ENSURE_REGISTERED(CsmaChannel);
 
+namespace
+{
+
+/**
+ * \ingroup csma
+ * The reception of a packet by a device of the channel.
+ *
+ * The receptions are found by their type among the pending events when
+ * saving a checkpoint, so the channel does not need to track them.
+ */
+class CsmaReception : public EventImpl
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] channel The channel.
+     * \param [in] deviceId The receiving device.
+     * \param [in] device The receiving device.
+     * \param [in] packet The packet.
+     * \param [in] sender The sending device.
+     */
+    CsmaReception(const CsmaChannel* channel,
+                  uint32_t deviceId,
+                  Ptr<CsmaNetDevice> device,
+                  Ptr<const Packet> packet,
+                  Ptr<CsmaNetDevice> sender)
+        : m_channel(channel),
+          m_deviceId(deviceId),
+          m_device(device),
+          m_packet(packet),
+          m_sender(sender)
+    {
+    }
+
+    const CsmaChannel* m_channel; //!< The channel.
+    uint32_t m_deviceId;          //!< The id of the receiving device.
+    Ptr<CsmaNetDevice> m_device;  //!< The receiving device.
+    Ptr<const Packet> m_packet;   //!< The packet.
+    Ptr<CsmaNetDevice> m_sender;  //!< The sending device.
+
+  private:
+    void Notify() override
+    {
+        m_device->Receive(m_packet, m_sender);
+    }
+};
+
+} // unnamed namespace
+
 TypeId
 CsmaChannel::GetTypeId()
 {
@@ -225,22 +278,28 @@ CsmaChannel::TransmitEnd()
 
     NS_LOG_LOGIC("Receive");
 
-    for (auto it = m_deviceList.begin(); it < m_deviceList.end(); it++)
+    std::vector<Simulator::ContextEvent> receptions;
+    receptions.reserve(m_deviceList.size());
+    for (std::size_t i = 0; i < m_deviceList.size(); i++)
     {
-        if (it->IsActive() && it->devicePtr != m_deviceList[m_currentSrc].devicePtr)
+        const CsmaDeviceRec& rec = m_deviceList[i];
+        if (rec.IsActive() && rec.devicePtr != m_deviceList[m_currentSrc].devicePtr)
         {
             // schedule reception events
-            Simulator::ScheduleWithContext(it->devicePtr->GetNode()->GetId(),
-                                           m_delay,
-                                           &CsmaNetDevice::Receive,
-                                           it->devicePtr,
-                                           m_currentPkt,
-                                           m_deviceList[m_currentSrc].devicePtr);
+            receptions.push_back({rec.devicePtr->GetNode()->GetId(),
+                                  m_delay,
+                                  new CsmaReception(this,
+                                                    i,
+                                                    rec.devicePtr,
+                                                    m_currentPkt,
+                                                    m_deviceList[m_currentSrc].devicePtr)});
         }
     }
+    Simulator::ScheduleWithContextBatch(receptions);
 
     // also schedule for the tx side to go back to IDLE
-    Simulator::Schedule(m_delay, &CsmaChannel::PropagationCompleteEvent, this);
+    m_propagationCompleteEvent =
+        Simulator::Schedule(m_delay, &CsmaChannel::PropagationCompleteEvent, this);
     return retVal;
 }
 
@@ -308,6 +367,74 @@ CsmaChannel::IsBusy()
     return m_state != IDLE;
 }
 
+void
+CsmaChannel::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    for (std::size_t i = 0; i < m_deviceList.size(); i++)
+    {
+        writer.Write("active." + std::to_string(i), m_deviceList[i].active);
+    }
+    writer.Write("state", static_cast<uint32_t>(m_state));
+    if (m_state == IDLE)
+    {
+        return;
+    }
+    writer.Write("currentSource", m_currentSrc);
+    WritePacket(writer, "currentPacket", m_currentPkt);
+    writer.WriteEvent("propagationComplete", m_propagationCompleteEvent);
+
+    uint32_t n = 0;
+    for (const auto& id : writer.GetPendingEvents())
+    {
+        auto reception = dynamic_cast<const CsmaReception*>(id.PeekEventImpl());
+        if (reception != nullptr && reception->m_channel == this)
+        {
+            NS_ASSERT(reception->m_packet == m_currentPkt);
+            std::string key = "reception." + std::to_string(n++);
+            writer.Write(key + ".device", reception->m_deviceId);
+            writer.WriteEvent(key, id);
+        }
+    }
+    writer.Write("receptions", n);
+}
+
+void
+CsmaChannel::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    for (std::size_t i = 0; i < m_deviceList.size(); i++)
+    {
+        m_deviceList[i].active = reader.Read<bool>("active." + std::to_string(i));
+    }
+    m_state = static_cast<WireState>(reader.Read<uint32_t>("state"));
+    if (m_state == IDLE)
+    {
+        return;
+    }
+    m_currentSrc = reader.Read<uint32_t>("currentSource");
+    NS_ABORT_MSG_IF(m_currentSrc >= m_deviceList.size(),
+                    "Invalid source " << m_currentSrc << " in " << reader.GetPath());
+    m_currentPkt = ReadPacket(reader, "currentPacket");
+    m_propagationCompleteEvent =
+        reader.ReadEvent("propagationComplete", &CsmaChannel::PropagationCompleteEvent, this);
+
+    auto n = reader.Read<uint32_t>("receptions");
+    for (uint32_t i = 0; i < n; i++)
+    {
+        std::string key = "reception." + std::to_string(i);
+        auto deviceId = reader.Read<uint32_t>(key + ".device");
+        NS_ABORT_MSG_IF(deviceId >= m_deviceList.size(),
+                        "Invalid device " << deviceId << " in " << reader.GetPath());
+        reader.ReadEventImpl(key,
+                             new CsmaReception(this,
+                                               deviceId,
+                                               m_deviceList[deviceId].devicePtr,
+                                               m_currentPkt,
+                                               m_deviceList[m_currentSrc].devicePtr));
+    }
+}
+
 DataRate
 CsmaChannel::GetDataRate()
 {
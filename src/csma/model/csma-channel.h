@@ -21,7 +21,9 @@
 #define CSMA_CHANNEL_H
 
 #include "ns3/channel.h"
+#include "ns3/checkpoint.h"
 #include "ns3/data-rate.h"
+#include "ns3/event-id.h"
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
 
@@ -87,8 +89,11 @@ enum WireState
  * flag to indicate if the channel is currently in use. It does not
  * take into account the distances between stations or the speed of
  * light to determine collisions.
+ *
+ * The packet being propagated is saved in the checkpoints, and its
+ * receptions are restored with their original time and order.
  */
-class CsmaChannel : public Channel
+class CsmaChannel : public Channel, public Checkpointable
 {
   public:
     /**
@@ -296,6 +301,10 @@ class CsmaChannel : public Channel
      */
     Time GetDelay();
 
+    // Inherited from Checkpointable
+    void SaveState(CheckpointWriter& writer) const override;
+    void RestoreState(CheckpointReader& reader) override;
+
   private:
     /**
      * The assigned data rate of the channel
@@ -338,6 +347,11 @@ class CsmaChannel : public Channel
      * Current state of the channel
      */
     WireState m_state;
+
+    /**
+     * The end of the propagation of the current packet
+     */
+    EventId m_propagationCompleteEvent;
 };
 
 } // namespace ns3
@@ -28,8 +28,10 @@
 #include "ns3/ethernet-trailer.h"
 #include "ns3/llc-snap-header.h"
 #include "ns3/log.h"
+#include "ns3/packet-burst.h"
 #include "ns3/pointer.h"
 #include "ns3/queue.h"
+#include "ns3/segment-offload-tag.h"
 #include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
@@ -503,7 +505,7 @@ CsmaNetDevice::TransmitStart()
 
             NS_LOG_LOGIC("Channel busy, backing off for " << backoffTime.As(Time::S));
 
-            Simulator::Schedule(backoffTime, &CsmaNetDevice::TransmitStart, this);
+            m_txEvent = Simulator::Schedule(backoffTime, &CsmaNetDevice::TransmitStart, this);
         }
     }
     else
@@ -529,8 +531,19 @@ CsmaNetDevice::TransmitStart()
             m_txMachineState = BUSY;
 
             Time tEvent = m_bps.CalculateBytesTxTime(m_currentPkt->GetSize());
+            SegmentOffloadTag offloadTag;
+            if (m_currentPkt->PeekPacketTag(offloadTag))
+            {
+                // The segments of a super-segment are sent back to back, each
+                // with its Ethernet header and trailer
+                EthernetHeader header(false);
+                EthernetTrailer trailer;
+                uint32_t framing = header.GetSerializedSize() + trailer.GetSerializedSize();
+                tEvent = m_bps.CalculateBytesTxTime(
+                    offloadTag.GetWireSize(m_currentPkt->GetSize(), framing));
+            }
             NS_LOG_LOGIC("Schedule TransmitCompleteEvent in " << tEvent.As(Time::S));
-            Simulator::Schedule(tEvent, &CsmaNetDevice::TransmitCompleteEvent, this);
+            m_txEvent = Simulator::Schedule(tEvent, &CsmaNetDevice::TransmitCompleteEvent, this);
         }
     }
 }
@@ -612,7 +625,7 @@ CsmaNetDevice::TransmitCompleteEvent()
 
     NS_LOG_LOGIC("Schedule TransmitReadyEvent in " << m_tInterframeGap.As(Time::S));
 
-    Simulator::Schedule(m_tInterframeGap, &CsmaNetDevice::TransmitReadyEvent, this);
+    m_txEvent = Simulator::Schedule(m_tInterframeGap, &CsmaNetDevice::TransmitReadyEvent, this);
 }
 
 void
@@ -1018,6 +1031,53 @@ CsmaNetDevice::SendFrom(Ptr<Packet> packet,
     return true;
 }
 
+uint32_t
+CsmaNetDevice::SendMany(Ptr<PacketBurst> burst, const Address& dest, uint16_t protocolNumber)
+{
+    NS_LOG_FUNCTION(burst << dest << protocolNumber);
+
+    NS_ASSERT(IsLinkUp());
+
+    if (!IsSendEnabled())
+    {
+        for (auto i = burst->Begin(); i != burst->End(); ++i)
+        {
+            m_macTxDropTrace(*i);
+        }
+        return 0;
+    }
+
+    Mac48Address destination = Mac48Address::ConvertFrom(dest);
+    uint32_t sent = 0;
+    for (auto i = burst->Begin(); i != burst->End(); ++i)
+    {
+        Ptr<Packet> packet = *i;
+        AddHeader(packet, m_address, destination, protocolNumber);
+        m_macTxTrace(packet);
+        if (m_queue->Enqueue(packet))
+        {
+            sent++;
+        }
+        else
+        {
+            m_macTxDropTrace(packet);
+        }
+    }
+
+    //
+    // Start a single transmission if the device is idle, the next packets
+    // are sent when the current one finishes (see TransmitCompleteEvent)
+    //
+    if (m_txMachineState == READY && !m_queue->IsEmpty())
+    {
+        m_currentPkt = m_queue->Dequeue();
+        m_promiscSnifferTrace(m_currentPkt);
+        m_snifferTrace(m_currentPkt);
+        TransmitStart();
+    }
+    return sent;
+}
+
 Ptr<Node>
 CsmaNetDevice::GetNode() const
 {
@@ -1070,6 +1130,53 @@ CsmaNetDevice::SupportsSendFrom() const
     return true;
 }
 
+void
+CsmaNetDevice::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    writer.Write("sendEnable", m_sendEnable);
+    writer.Write("receiveEnable", m_receiveEnable);
+    writer.Write("state", static_cast<uint32_t>(m_txMachineState));
+    writer.Write("backoffRetries", m_backoff.GetNumRetries());
+    if (m_currentPkt)
+    {
+        WritePacket(writer, "currentPacket", m_currentPkt);
+    }
+    writer.WriteEvent("tx", m_txEvent);
+}
+
+void
+CsmaNetDevice::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    m_sendEnable = reader.Read<bool>("sendEnable");
+    m_receiveEnable = reader.Read<bool>("receiveEnable");
+    m_txMachineState = static_cast<TxMachineState>(reader.Read<uint32_t>("state"));
+    m_backoff.ResetBackoffTime();
+    for (auto n = reader.Read<uint32_t>("backoffRetries"); n > 0; n--)
+    {
+        m_backoff.IncrNumRetries();
+    }
+    if (reader.Has("currentPacket"))
+    {
+        m_currentPkt = ReadPacket(reader, "currentPacket");
+    }
+    switch (m_txMachineState)
+    {
+    case BACKOFF:
+        m_txEvent = reader.ReadEvent("tx", &CsmaNetDevice::TransmitStart, this);
+        break;
+    case BUSY:
+        m_txEvent = reader.ReadEvent("tx", &CsmaNetDevice::TransmitCompleteEvent, this);
+        break;
+    case GAP:
+        m_txEvent = reader.ReadEvent("tx", &CsmaNetDevice::TransmitReadyEvent, this);
+        break;
+    default:
+        break;
+    }
+}
+
 int64_t
 CsmaNetDevice::AssignStreams(int64_t stream)
 {
@@ -24,7 +24,9 @@
 
 #include "ns3/address.h"
 #include "ns3/callback.h"
+#include "ns3/checkpoint.h"
 #include "ns3/data-rate.h"
+#include "ns3/event-id.h"
 #include "ns3/mac48-address.h"
 #include "ns3/net-device.h"
 #include "ns3/node.h"
@@ -58,7 +60,7 @@ class ErrorModel;
  * TCP stack. The NetDevice takes a raw packet of bytes and creates a
  * protocol specific packet from them.
  */
-class CsmaNetDevice : public NetDevice
+class CsmaNetDevice : public NetDevice, public Checkpointable
 {
   public:
     /**
@@ -291,6 +293,18 @@ class CsmaNetDevice : public NetDevice
                   const Address& dest,
                   uint16_t protocolNumber) override;
 
+    /**
+     * Start sending several packets down the channel.  All the packets are
+     * placed on the send queue before the transmission is started.
+     * \param burst packets to send
+     * \param dest layer 2 destination address
+     * \param protocolNumber protocol number
+     * \return the number of packets placed on the send queue
+     */
+    uint32_t SendMany(Ptr<PacketBurst> burst,
+                      const Address& dest,
+                      uint16_t protocolNumber) override;
+
     /**
      * Get the node to which this device is attached.
      *
@@ -333,6 +347,10 @@ class CsmaNetDevice : public NetDevice
     void SetPromiscReceiveCallback(PromiscReceiveCallback cb) override;
     bool SupportsSendFrom() const override;
 
+    // Inherited from Checkpointable
+    void SaveState(CheckpointWriter& writer) const override;
+    void RestoreState(CheckpointReader& reader) override;
+
     /**
      * Assign a fixed random variable stream number to the random variables
      * used by this model.  Return the number of streams (possibly zero) that
@@ -521,6 +539,12 @@ class CsmaNetDevice : public NetDevice
      */
     Ptr<Packet> m_currentPkt;
 
+    /**
+     * The pending event of the transmit state machine: the end of the
+     * backoff, of the transmission, or of the interframe gap.
+     */
+    EventId m_txEvent;
+
     /**
      * The CsmaChannel to which this CsmaNetDevice has been
      * attached.
@@ -319,6 +319,50 @@ ArpCache::RemoveAutoGeneratedEntries()
     }
 }
 
+void
+ArpCache::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    uint32_t n = 0;
+    for (const auto& [address, entry] : m_arpCache)
+    {
+        NS_ABORT_MSG_IF(entry->m_state == Entry::WAIT_REPLY || !entry->m_pending.empty(),
+                        "Cannot save an ARP cache while resolving " << address);
+        std::string key = "entry." + std::to_string(n++);
+        uint8_t mac[Address::MAX_SIZE];
+        uint32_t length = entry->m_macAddress.CopyTo(mac);
+        writer.Write(key + ".ipv4", address);
+        writer.Write(key + ".state", static_cast<uint32_t>(entry->m_state));
+        writer.Write(key + ".lastSeen", entry->m_lastSeen);
+        writer.WriteBytes(key + ".mac", mac, length);
+        writer.Write(key + ".retries", entry->m_retries);
+    }
+    writer.Write("entries", n);
+}
+
+void
+ArpCache::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    Flush();
+    for (uint32_t i = 0, n = reader.Read<uint32_t>("entries"); i < n; i++)
+    {
+        std::string key = "entry." + std::to_string(i);
+        Entry* entry = Add(reader.Read<Ipv4Address>(key + ".ipv4"));
+        entry->m_state = static_cast<Entry::ArpCacheEntryState_e>(
+            reader.Read<uint32_t>(key + ".state"));
+        entry->m_lastSeen = reader.Read<Time>(key + ".lastSeen");
+        std::vector<uint8_t> mac = reader.ReadBytes(key + ".mac");
+        if (!mac.empty())
+        {
+            // The type of the address is the one of the device in this run
+            entry->m_macAddress = m_device->GetAddress();
+            entry->m_macAddress.CopyFrom(mac.data(), mac.size());
+        }
+        entry->m_retries = reader.Read<uint32_t>(key + ".retries");
+    }
+}
+
 std::list<ArpCache::Entry*>
 ArpCache::LookupInverse(Address to)
 {
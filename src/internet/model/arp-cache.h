@@ -21,6 +21,7 @@
 
 #include "ns3/address.h"
 #include "ns3/callback.h"
+#include "ns3/checkpoint.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/net-device.h"
 #include "ns3/nstime.h"
@@ -48,8 +49,11 @@ class Ipv4Header;
  *
  * A cached lookup table for translating layer 3 addresses to layer 2.
  * This implementation does lookups from IPv4 to a MAC address
+ *
+ * The entries can be saved to a checkpoint, unless an address is being
+ * resolved.
  */
-class ArpCache : public Object
+class ArpCache : public Object, public Checkpointable
 {
   public:
     /**
@@ -172,6 +176,20 @@ class ArpCache : public Object
      */
     void RemoveAutoGeneratedEntries();
 
+    /**
+     * \brief Save the entries.
+     *
+     * Aborts if an entry is waiting for a reply.
+     *
+     * \param writer the checkpoint writer
+     */
+    void SaveState(CheckpointWriter& writer) const override;
+    /**
+     * \brief Replace the entries with the saved ones.
+     * \param reader the checkpoint reader
+     */
+    void RestoreState(CheckpointReader& reader) override;
+
     /**
      * \brief Pair of a packet and an Ipv4 header.
      */
@@ -290,6 +308,8 @@ class ArpCache : public Object
         void UpdateSeen();
 
       private:
+        friend class ArpCache;
+
         /**
          * \brief ARP cache entry states
          */
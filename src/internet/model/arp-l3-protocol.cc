@@ -24,6 +24,7 @@
 #include "ipv4-interface.h"
 #include "ipv4-l3-protocol.h"
 
+#include "ns3/checkpoint.h"
 #include "ns3/log.h"
 #include "ns3/net-device.h"
 #include "ns3/node.h"
@@ -42,6 +43,7 @@ NS_LOG_COMPONENT_DEFINE("ArpL3Protocol");
 const uint16_t ArpL3Protocol::PROT_NUMBER = 0x0806;
 
 NS_OBJECT_ENSURE_REGISTERED(ArpL3Protocol);
+NS_CHECKPOINT_STATELESS(ArpL3Protocol);
 
 TypeId
 ArpL3Protocol::GetTypeId()
@@ -58,20 +58,22 @@ operator<<(std::ostream& os, const SPFVertex::VertexType& t)
 std::ostream&
 operator<<(std::ostream& os, const CandidateQueue& q)
 {
-    const CandidateQueue::CandidateList_t& list = q.m_candidates;
+    CandidateQueue::CandidateList_t list = q.m_candidates;
+    std::sort(list.begin(), list.end(), &CandidateQueue::IsBefore);
 
     os << "*** CandidateQueue Begin (<id, distance, LSA-type>) ***" << std::endl;
     for (auto iter = list.begin(); iter != list.end(); iter++)
     {
-        os << "<" << (*iter)->GetVertexId() << ", " << (*iter)->GetDistanceFromRoot() << ", "
-           << (*iter)->GetVertexType() << ">" << std::endl;
+        os << "<" << iter->vertex->GetVertexId() << ", " << iter->vertex->GetDistanceFromRoot()
+           << ", " << iter->vertex->GetVertexType() << ">" << std::endl;
     }
     os << "*** CandidateQueue End ***";
     return os;
 }
 
 CandidateQueue::CandidateQueue()
-    : m_candidates()
+    : m_candidates(),
+      m_order(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -99,11 +101,10 @@ CandidateQueue::Push(SPFVertex* vNew)
 {
     NS_LOG_FUNCTION(this << vNew);
 
-    auto i = std::upper_bound(m_candidates.begin(),
-                              m_candidates.end(),
-                              vNew,
-                              &CandidateQueue::CompareSPFVertex);
-    m_candidates.insert(i, vNew);
+    m_candidates.push_back({vNew, m_order++});
+    m_positions[vNew] = m_candidates.size() - 1;
+    m_vertices.emplace(vNew->GetVertexId(), vNew);
+    SiftUp(m_candidates.size() - 1);
 }
 
 SPFVertex*
@@ -115,8 +116,25 @@ CandidateQueue::Pop()
         return nullptr;
     }
 
-    SPFVertex* v = m_candidates.front();
-    m_candidates.pop_front();
+    SPFVertex* v = m_candidates.front().vertex;
+    m_positions.erase(v);
+    auto range = m_vertices.equal_range(v->GetVertexId());
+    for (auto i = range.first; i != range.second; i++)
+    {
+        if (i->second == v)
+        {
+            m_vertices.erase(i);
+            break;
+        }
+    }
+
+    Candidate last = m_candidates.back();
+    m_candidates.pop_back();
+    if (!m_candidates.empty())
+    {
+        Place(0, last);
+        SiftDown(0);
+    }
     return v;
 }
 
@@ -129,7 +147,7 @@ CandidateQueue::Top() const
         return nullptr;
     }
 
-    return m_candidates.front();
+    return m_candidates.front().vertex;
 }
 
 bool
@@ -150,18 +168,19 @@ SPFVertex*
 CandidateQueue::Find(const Ipv4Address addr) const
 {
     NS_LOG_FUNCTION(this);
-    auto i = m_candidates.begin();
+    auto range = m_vertices.equal_range(addr);
+    const Candidate* found = nullptr;
 
-    for (; i != m_candidates.end(); i++)
+    for (auto i = range.first; i != range.second; i++)
     {
-        SPFVertex* v = *i;
-        if (v->GetVertexId() == addr)
+        const Candidate& c = m_candidates[m_positions.at(i->second)];
+        if (found == nullptr || IsBefore(c, *found))
         {
-            return v;
+            found = &c;
         }
     }
 
-    return nullptr;
+    return found ? found->vertex : nullptr;
 }
 
 void
@@ -169,11 +188,88 @@ CandidateQueue::Reorder()
 {
     NS_LOG_FUNCTION(this);
 
-    m_candidates.sort(&CandidateQueue::CompareSPFVertex);
+    for (std::size_t i = m_candidates.size() / 2; i > 0; i--)
+    {
+        SiftDown(i - 1);
+    }
     NS_LOG_LOGIC("After reordering the CandidateQueue");
     NS_LOG_LOGIC(*this);
 }
 
+void
+CandidateQueue::Update(SPFVertex* v)
+{
+    NS_LOG_FUNCTION(this << v);
+
+    auto position = m_positions.find(v);
+    NS_ASSERT_MSG(position != m_positions.end(), "Vertex not in the CandidateQueue");
+    m_candidates[position->second].order = m_order++;
+    SiftDown(SiftUp(position->second));
+    NS_LOG_LOGIC("After updating the CandidateQueue");
+    NS_LOG_LOGIC(*this);
+}
+
+bool
+CandidateQueue::IsBefore(const Candidate& c1, const Candidate& c2)
+{
+    if (CompareSPFVertex(c1.vertex, c2.vertex))
+    {
+        return true;
+    }
+    if (CompareSPFVertex(c2.vertex, c1.vertex))
+    {
+        return false;
+    }
+    return c1.order < c2.order;
+}
+
+void
+CandidateQueue::Place(std::size_t position, const Candidate& c)
+{
+    m_candidates[position] = c;
+    m_positions[c.vertex] = position;
+}
+
+std::size_t
+CandidateQueue::SiftUp(std::size_t position)
+{
+    Candidate c = m_candidates[position];
+    while (position > 0)
+    {
+        std::size_t parent = (position - 1) / 2;
+        if (!IsBefore(c, m_candidates[parent]))
+        {
+            break;
+        }
+        Place(position, m_candidates[parent]);
+        position = parent;
+    }
+    Place(position, c);
+    return position;
+}
+
+void
+CandidateQueue::SiftDown(std::size_t position)
+{
+    Candidate c = m_candidates[position];
+    std::size_t size = m_candidates.size();
+    while (2 * position + 1 < size)
+    {
+        std::size_t child = 2 * position + 1;
+        if (child + 1 < size && IsBefore(m_candidates[child + 1], m_candidates[child]))
+        {
+            child++;
+        }
+        if (!IsBefore(m_candidates[child], c))
+        {
+            break;
+        }
+        Place(position, m_candidates[child]);
+        position = child;
+    }
+    Place(position, c);
+}
+
 /*
  * In this implementation, SPFVertex follows the ordering where
  * a vertex is ranked first if its GetDistanceFromRoot () is smaller;
@@ -22,8 +22,9 @@
 
 #include "ns3/ipv4-address.h"
 
-#include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -46,8 +47,11 @@ class SPFVertex;
  *
  * Although a STL priority_queue almost does what we want, the requirement
  * for a Find () operation, the dynamic nature of the data and the derived
- * requirement for a Reorder () operation led us to implement this simple
- * enhanced priority queue.
+ * requirement for an Update () operation led us to implement this
+ * enhanced priority queue: a binary heap, which knows the position of each
+ * vertex in the heap, and indexes the vertices by IP address.  The vertices
+ * at the same distance are popped in the order of their insertion, or of
+ * the last update of their distance.
  */
 class CandidateQueue
 {
@@ -159,6 +163,18 @@ class CandidateQueue
      */
     void Reorder();
 
+    /**
+     * @brief Reorders a Shortest Path First Vertex in the Candidate Queue
+     * after the change of its m_distanceFromRoot.
+     *
+     * The vertex is ordered after the vertices already in the queue at the
+     * same distance.
+     *
+     * @see SPFVertex
+     * @param v The Shortest Path First Vertex whose distance has changed.
+     */
+    void Update(SPFVertex* v);
+
   private:
     /**
      * \brief return true if v1 < v2
@@ -173,8 +189,52 @@ class CandidateQueue
      */
     static bool CompareSPFVertex(const SPFVertex* v1, const SPFVertex* v2);
 
-    typedef std::list<SPFVertex*> CandidateList_t; //!< container of SPFVertex pointers
-    CandidateList_t m_candidates;                  //!< SPFVertex candidates
+    /// A candidate of the queue
+    struct Candidate
+    {
+        SPFVertex* vertex; //!< the vertex
+        uint64_t order;    //!< the order of the insertion of the vertex
+    };
+
+    /**
+     * \brief return true if c1 should be popped before c2
+     *
+     * \param c1 first operand
+     * \param c2 second operand
+     * \return True if c1 should be popped before c2; false otherwise
+     */
+    static bool IsBefore(const Candidate& c1, const Candidate& c2);
+
+    /**
+     * \brief Store a candidate at a position of the heap
+     *
+     * \param position the position in the heap
+     * \param c the candidate
+     */
+    void Place(std::size_t position, const Candidate& c);
+
+    /**
+     * \brief Move a candidate towards the top of the heap until it is ordered
+     *
+     * \param position the position of the candidate in the heap
+     * \return the new position of the candidate
+     */
+    std::size_t SiftUp(std::size_t position);
+
+    /**
+     * \brief Move a candidate towards the bottom of the heap until it is ordered
+     *
+     * \param position the position of the candidate in the heap
+     */
+    void SiftDown(std::size_t position);
+
+    typedef std::vector<Candidate> CandidateList_t; //!< container of SPFVertex pointers
+    CandidateList_t m_candidates;                   //!< SPFVertex candidates, as a binary heap
+    std::unordered_map<const SPFVertex*, std::size_t>
+        m_positions; //!< positions of the candidates in the heap
+    std::unordered_multimap<Ipv4Address, SPFVertex*, Ipv4AddressHash>
+        m_vertices;   //!< candidates, by IP address
+    uint64_t m_order; //!< order of the next insertion
 
     /**
      * \brief Stream insertion operator.
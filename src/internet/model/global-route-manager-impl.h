@@ -739,6 +739,7 @@ class GlobalRouteManagerImpl
 
   private:
     SPFVertex* m_spfroot;           //!< the root node
+    Ptr<Node> m_spfrootNode;        //!< the node of the root, which receives the routes
     GlobalRouteManagerLSDB* m_lsdb; //!< the Link State DataBase (LSDB) of the Global Route Manager
 
     /**
@@ -761,6 +762,15 @@ class GlobalRouteManagerImpl
      */
     void SPFCalculate(Ipv4Address root);
 
+    /**
+     * \brief Calculate the shortest path first (SPF) tree
+     *
+     * Equivalent to quagga ospf_spf_calculate
+     * \param root the root node
+     * \param rootNode the node of the root, which receives the routes, or null if none
+     */
+    void SPFCalculate(Ipv4Address root, Ptr<Node> rootNode);
+
     /**
      * \brief Process Stub nodes
      *
@@ -27,6 +27,7 @@
 #include "ns3/assert.h"
 #include "ns3/bridge-net-device.h"
 #include "ns3/channel.h"
+#include "ns3/checkpoint.h"
 #include "ns3/log.h"
 #include "ns3/net-device.h"
 #include "ns3/node-list.h"
@@ -496,6 +497,7 @@ operator<<(std::ostream& os, GlobalRoutingLSA& lsa)
 // ---------------------------------------------------------------------------
 
 NS_OBJECT_ENSURE_REGISTERED(GlobalRouter);
+NS_CHECKPOINT_STATELESS(GlobalRouter);
 
 TypeId
 GlobalRouter::GetTypeId()
@@ -28,6 +28,7 @@
 
 #include "ns3/assert.h"
 #include "ns3/boolean.h"
+#include "ns3/checkpoint.h"
 #include "ns3/log.h"
 #include "ns3/node.h"
 #include "ns3/packet.h"
@@ -38,6 +39,7 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("Icmpv4L4Protocol");
 
 NS_OBJECT_ENSURE_REGISTERED(Icmpv4L4Protocol);
+NS_CHECKPOINT_STATELESS(Icmpv4L4Protocol);
 
 // see rfc 792
 const uint8_t Icmpv4L4Protocol::PROT_NUMBER = 1;
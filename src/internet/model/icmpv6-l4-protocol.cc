@@ -29,6 +29,7 @@
 
 #include "ns3/assert.h"
 #include "ns3/boolean.h"
+#include "ns3/checkpoint.h"
 #include "ns3/double.h"
 #include "ns3/integer.h"
 #include "ns3/log.h"
@@ -44,6 +45,7 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("Icmpv6L4Protocol");
 
 NS_OBJECT_ENSURE_REGISTERED(Icmpv6L4Protocol);
+NS_CHECKPOINT_STATELESS(Icmpv6L4Protocol);
 
 const uint8_t Icmpv6L4Protocol::PROT_NUMBER = 58;
 
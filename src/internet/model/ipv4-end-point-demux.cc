@@ -46,29 +46,31 @@ Ipv4EndPointDemux::~Ipv4EndPointDemux()
         delete endPoint;
     }
     m_endPoints.clear();
+    m_ports.clear();
+    m_listeners.clear();
+    m_connections.clear();
+    m_positions.clear();
 }
 
 bool
 Ipv4EndPointDemux::LookupPortLocal(uint16_t port)
 {
     NS_LOG_FUNCTION(this << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        if ((*i)->GetLocalPort() == port)
-        {
-            return true;
-        }
-    }
-    return false;
+    return m_ports.find(port) != m_ports.end();
 }
 
 bool
 Ipv4EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv4Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto endPoints = m_ports.find(port);
+    if (endPoints == m_ports.end())
     {
-        if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
+        return false;
+    }
+    for (auto i = endPoints->second.begin(); i != endPoints->second.end(); i++)
+    {
+        if ((*i)->GetLocalAddress() == addr &&
             (*i)->GetBoundNetDevice() == boundNetDevice)
         {
             return true;
@@ -88,7 +90,7 @@ Ipv4EndPointDemux::Allocate()
         return nullptr;
     }
     auto endPoint = new Ipv4EndPoint(Ipv4Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -104,7 +106,7 @@ Ipv4EndPointDemux::Allocate(Ipv4Address address)
         return nullptr;
     }
     auto endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -127,7 +129,7 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv4Address address,
         return nullptr;
     }
     auto endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -140,19 +142,23 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << localAddress << localPort << peerAddress << peerPort << boundNetDevice);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    const EndPoints* endPoints = GetIndexed(localPort, peerAddress, peerPort);
+    if (endPoints)
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        for (auto i = endPoints->begin(); i != endPoints->end(); i++)
         {
-            NS_LOG_WARN("Duplicated endpoint.");
-            return nullptr;
+            if ((*i)->GetLocalAddress() == localAddress && (*i)->GetPeerPort() == peerPort &&
+                (*i)->GetPeerAddress() == peerAddress &&
+                ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+            {
+                NS_LOG_WARN("Duplicated endpoint.");
+                return nullptr;
+            }
         }
     }
     auto endPoint = new Ipv4EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
 
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
 
@@ -163,15 +169,21 @@ void
 Ipv4EndPointDemux::DeAllocate(Ipv4EndPoint* endPoint)
 {
     NS_LOG_FUNCTION(this << endPoint);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto position = m_positions.find(endPoint);
+    if (position == m_positions.end())
     {
-        if (*i == endPoint)
-        {
-            delete endPoint;
-            m_endPoints.erase(i);
-            break;
-        }
+        return;
     }
+    m_endPoints.erase(position->second.endPoint);
+    auto port = m_ports.find(position->second.key.localPort);
+    port->second.erase(position->second.port);
+    if (port->second.empty())
+    {
+        m_ports.erase(port);
+    }
+    Unindex(position->second);
+    m_positions.erase(position);
+    delete endPoint;
 }
 
 /*
@@ -211,131 +223,140 @@ Ipv4EndPointDemux::Lookup(Ipv4Address daddr,
     EndPoints retval4; // Exact match on all 4
 
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr << ":" << dport);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    // Only the endpoints of the local port without a peer, and the connections
+    // to the source of the packet, may match the packet
+    const EndPoints* candidates[] = {GetIndexed(dport, Ipv4Address::GetAny(), 0), nullptr};
+    if (saddr != Ipv4Address::GetAny() && sport != 0)
     {
-        Ipv4EndPoint* endP = *i;
-
-        NS_LOG_DEBUG("Looking at endpoint dport="
-                     << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
-                     << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
-
-        if (!endP->IsRxEnabled())
-        {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP
-                                              << " because endpoint can not receive packets");
-            continue;
-        }
-
-        if (endP->GetLocalPort() != dport)
+        candidates[1] = GetIndexed(dport, saddr, sport);
+    }
+    for (const EndPoints* endPoints : candidates)
+    {
+        if (!endPoints)
         {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
-                                              << endP->GetLocalPort()
-                                              << " does not match packet dport " << dport);
             continue;
         }
-        if (endP->GetBoundNetDevice())
+        for (auto i = endPoints->begin(); i != endPoints->end(); i++)
         {
-            if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
+            Ipv4EndPoint* endP = *i;
+
+            NS_LOG_DEBUG("Looking at endpoint dport=" << endP->GetLocalPort()
+                                                      << " daddr=" << endP->GetLocalAddress()
+                                                      << " sport=" << endP->GetPeerPort()
+                                                      << " saddr=" << endP->GetPeerAddress());
+
+            if (!endP->IsRxEnabled())
             {
-                NS_LOG_LOGIC("Skipping endpoint "
-                             << &endP << " because endpoint is bound to specific device and"
-                             << endP->GetBoundNetDevice() << " does not match packet device "
-                             << incomingInterface->GetDevice());
+                NS_LOG_LOGIC("Skipping endpoint " << &endP
+                                                  << " because endpoint can not receive packets");
                 continue;
             }
-        }
 
-        bool localAddressMatchesExact = false;
-        bool localAddressIsAny = false;
-        bool localAddressIsSubnetAny = false;
+            if (endP->GetBoundNetDevice())
+            {
+                if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
+                {
+                    NS_LOG_LOGIC("Skipping endpoint "
+                                 << &endP << " because endpoint is bound to specific device and"
+                                 << endP->GetBoundNetDevice() << " does not match packet device "
+                                 << incomingInterface->GetDevice());
+                    continue;
+                }
+            }
+
+            bool localAddressMatchesExact = false;
+            bool localAddressIsAny = false;
+            bool localAddressIsSubnetAny = false;
 
-        // We have 3 cases:
-        // 1) Exact local / destination address match
-        // 2) Local endpoint bound to Any -> matches anything
-        // 3) Local endpoint bound to x.y.z.0 -> matches Subnet-directed broadcast packet (e.g.,
-        // x.y.z.255 in a /24 net) and direct destination match.
+            // We have 3 cases:
+            // 1) Exact local / destination address match
+            // 2) Local endpoint bound to Any -> matches anything
+            // 3) Local endpoint bound to x.y.z.0 -> matches Subnet-directed broadcast packet
+            // (e.g., x.y.z.255 in a /24 net) and direct destination match.
 
-        if (endP->GetLocalAddress() == daddr)
-        {
-            // Case 1:
-            localAddressMatchesExact = true;
-        }
-        else if (endP->GetLocalAddress() == Ipv4Address::GetAny())
-        {
-            // Case 2:
-            localAddressIsAny = true;
-        }
-        else
-        {
-            // Case 3:
-            for (uint32_t i = 0; i < incomingInterface->GetNAddresses(); i++)
+            if (endP->GetLocalAddress() == daddr)
             {
-                Ipv4InterfaceAddress addr = incomingInterface->GetAddress(i);
-
-                Ipv4Address addrNetpart = addr.GetLocal().CombineMask(addr.GetMask());
-                if (endP->GetLocalAddress() == addrNetpart)
+                // Case 1:
+                localAddressMatchesExact = true;
+            }
+            else if (endP->GetLocalAddress() == Ipv4Address::GetAny())
+            {
+                // Case 2:
+                localAddressIsAny = true;
+            }
+            else
+            {
+                // Case 3:
+                for (uint32_t i = 0; i < incomingInterface->GetNAddresses(); i++)
                 {
-                    NS_LOG_LOGIC("Endpoint is SubnetDirectedAny "
-                                 << endP->GetLocalAddress() << "/"
-                                 << addr.GetMask().GetPrefixLength());
+                    Ipv4InterfaceAddress addr = incomingInterface->GetAddress(i);
 
-                    Ipv4Address daddrNetPart = daddr.CombineMask(addr.GetMask());
-                    if (addrNetpart == daddrNetPart)
+                    Ipv4Address addrNetpart = addr.GetLocal().CombineMask(addr.GetMask());
+                    if (endP->GetLocalAddress() == addrNetpart)
                     {
-                        localAddressIsSubnetAny = true;
+                        NS_LOG_LOGIC("Endpoint is SubnetDirectedAny "
+                                     << endP->GetLocalAddress() << "/"
+                                     << addr.GetMask().GetPrefixLength());
+
+                        Ipv4Address daddrNetPart = daddr.CombineMask(addr.GetMask());
+                        if (addrNetpart == daddrNetPart)
+                        {
+                            localAddressIsSubnetAny = true;
+                        }
                     }
                 }
+
+                // if no match here, keep looking
+                if (!localAddressIsSubnetAny)
+                {
+                    continue;
+                }
             }
 
-            // if no match here, keep looking
-            if (!localAddressIsSubnetAny)
+            bool remotePortMatchesExact = endP->GetPeerPort() == sport;
+            bool remotePortMatchesWildCard = endP->GetPeerPort() == 0;
+            bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
+            bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv4Address::GetAny();
+
+            // If remote does not match either with exact or wildcard,
+            // skip this one
+            if (!(remotePortMatchesExact || remotePortMatchesWildCard))
+            {
+                continue;
+            }
+            if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
             {
                 continue;
             }
-        }
-
-        bool remotePortMatchesExact = endP->GetPeerPort() == sport;
-        bool remotePortMatchesWildCard = endP->GetPeerPort() == 0;
-        bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
-        bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv4Address::GetAny();
-
-        // If remote does not match either with exact or wildcard,
-        // skip this one
-        if (!(remotePortMatchesExact || remotePortMatchesWildCard))
-        {
-            continue;
-        }
-        if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
-        {
-            continue;
-        }
 
-        bool localAddressMatchesWildCard = localAddressIsAny || localAddressIsSubnetAny;
+            bool localAddressMatchesWildCard = localAddressIsAny || localAddressIsSubnetAny;
 
-        if (localAddressMatchesExact && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All 4 match - this is the case of an open TCP connection, for example.
-            NS_LOG_LOGIC("Found an endpoint for case 4, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval4.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All but local address - no idea what this case could be.
-            NS_LOG_LOGIC("Found an endpoint for case 3, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval3.push_back(endP);
-        }
-        if (localAddressMatchesExact && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
-        { // Only local port and local address matches exactly - Not yet opened connection
-            NS_LOG_LOGIC("Found an endpoint for case 2, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval2.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remoteAddressMatchesWildCard &&
-            remotePortMatchesWildCard)
-        { // Only local port matches exactly - Endpoint open to "any" connection
-            NS_LOG_LOGIC("Found an endpoint for case 1, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval1.push_back(endP);
+            if (localAddressMatchesExact && remoteAddressMatchesExact && remotePortMatchesExact)
+            { // All 4 match - this is the case of an open TCP connection, for example.
+                NS_LOG_LOGIC("Found an endpoint for case 4, adding "
+                             << endP->GetLocalAddress() << ":" << endP->GetLocalPort());
+                retval4.push_back(endP);
+            }
+            if (localAddressMatchesWildCard && remoteAddressMatchesExact && remotePortMatchesExact)
+            { // All but local address - no idea what this case could be.
+                NS_LOG_LOGIC("Found an endpoint for case 3, adding "
+                             << endP->GetLocalAddress() << ":" << endP->GetLocalPort());
+                retval3.push_back(endP);
+            }
+            if (localAddressMatchesExact && remoteAddressMatchesWildCard &&
+                remotePortMatchesWildCard)
+            { // Only local port and local address matches exactly - Not yet opened connection
+                NS_LOG_LOGIC("Found an endpoint for case 2, adding "
+                             << endP->GetLocalAddress() << ":" << endP->GetLocalPort());
+                retval2.push_back(endP);
+            }
+            if (localAddressMatchesWildCard && remoteAddressMatchesWildCard &&
+                remotePortMatchesWildCard)
+            { // Only local port matches exactly - Endpoint open to "any" connection
+                NS_LOG_LOGIC("Found an endpoint for case 1, adding "
+                             << endP->GetLocalAddress() << ":" << endP->GetLocalPort());
+                retval1.push_back(endP);
+            }
         }
     }
 
@@ -376,12 +397,13 @@ Ipv4EndPointDemux::SimpleLookup(Ipv4Address daddr,
     // function.
     uint32_t genericity = 3;
     Ipv4EndPoint* generic = nullptr;
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto endPoints = m_ports.find(dport);
+    if (endPoints == m_ports.end())
+    {
+        return nullptr;
+    }
+    for (auto i = endPoints->second.begin(); i != endPoints->second.end(); i++)
     {
-        if ((*i)->GetLocalPort() != dport)
-        {
-            continue;
-        }
         if ((*i)->GetLocalAddress() == daddr && (*i)->GetPeerPort() == sport &&
             (*i)->GetPeerAddress() == saddr)
         {
@@ -406,6 +428,105 @@ Ipv4EndPointDemux::SimpleLookup(Ipv4Address daddr,
     return generic;
 }
 
+bool
+Ipv4EndPointDemux::ConnectionKey::operator==(const ConnectionKey& other) const
+{
+    return localPort == other.localPort && peerAddress == other.peerAddress &&
+           peerPort == other.peerPort;
+}
+
+std::size_t
+Ipv4EndPointDemux::ConnectionKeyHash::operator()(const ConnectionKey& key) const
+{
+    uint64_t value = key.peerAddress.Get();
+    value = (value << 32) | (key.localPort << 16) | key.peerPort;
+    return std::hash<uint64_t>()(value);
+}
+
+const Ipv4EndPointDemux::EndPoints*
+Ipv4EndPointDemux::GetIndexed(uint16_t localPort, Ipv4Address peerAddress, uint16_t peerPort) const
+{
+    if (peerAddress != Ipv4Address::GetAny() && peerPort != 0)
+    {
+        auto endPoints = m_connections.find({localPort, peerAddress, peerPort});
+        return endPoints == m_connections.end() ? nullptr : &endPoints->second;
+    }
+    auto endPoints = m_listeners.find(localPort);
+    return endPoints == m_listeners.end() ? nullptr : &endPoints->second;
+}
+
+void
+Ipv4EndPointDemux::Insert(Ipv4EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    Position position;
+    position.endPoint = m_endPoints.insert(m_endPoints.end(), endPoint);
+    EndPoints& port = m_ports[endPoint->GetLocalPort()];
+    position.port = port.insert(port.end(), endPoint);
+    Index(endPoint, position);
+    m_positions[endPoint] = position;
+    endPoint->SetChangeCallback(MakeCallback(&Ipv4EndPointDemux::Reindex, this));
+}
+
+void
+Ipv4EndPointDemux::Index(Ipv4EndPoint* endPoint, Position& position)
+{
+    position.key = {endPoint->GetLocalPort(), endPoint->GetPeerAddress(), endPoint->GetPeerPort()};
+    position.connected =
+        position.key.peerAddress != Ipv4Address::GetAny() && position.key.peerPort != 0;
+    EndPoints& endPoints =
+        position.connected ? m_connections[position.key] : m_listeners[position.key.localPort];
+    position.index = endPoints.insert(endPoints.end(), endPoint);
+}
+
+void
+Ipv4EndPointDemux::Unindex(const Position& position)
+{
+    if (position.connected)
+    {
+        auto endPoints = m_connections.find(position.key);
+        endPoints->second.erase(position.index);
+        if (endPoints->second.empty())
+        {
+            m_connections.erase(endPoints);
+        }
+    }
+    else
+    {
+        auto endPoints = m_listeners.find(position.key.localPort);
+        endPoints->second.erase(position.index);
+        if (endPoints->second.empty())
+        {
+            m_listeners.erase(endPoints);
+        }
+    }
+}
+
+void
+Ipv4EndPointDemux::Reindex(Ipv4EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    auto position = m_positions.find(endPoint);
+    if (position != m_positions.end())
+    {
+        Unindex(position->second);
+        Index(endPoint, position->second);
+    }
+}
+
+uint16_t
+Ipv4EndPointDemux::GetEphemeralPort() const
+{
+    return m_ephemeral;
+}
+
+void
+Ipv4EndPointDemux::SetEphemeralPort(uint16_t port)
+{
+    NS_LOG_FUNCTION(this << port);
+    m_ephemeral = port;
+}
+
 uint16_t
 Ipv4EndPointDemux::AllocateEphemeralPort()
 {
@@ -26,6 +26,7 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -42,6 +43,12 @@ class Ipv4EndPoint;
  * of endpoints, and has APIs to add and find endpoints in this demux.  This
  * code is shared in common to TCP and UDP protocols in ns3.  This demux
  * sits between ns3's layer four and the socket layer
+ *
+ * The endpoints are indexed by local port, and the connected endpoints
+ * (with a peer address and port) by local port, peer address and peer port,
+ * so that the lookups only consider the endpoints which may match, i.e.,
+ * the connection of the packet and the endpoints of its local port which
+ * are not connected.
  */
 
 class Ipv4EndPointDemux
@@ -170,6 +177,18 @@ class Ipv4EndPointDemux
      */
     void DeAllocate(Ipv4EndPoint* endPoint);
 
+    /**
+     * \brief Get the last ephemeral port allocated.
+     * \return the ephemeral port
+     */
+    uint16_t GetEphemeralPort() const;
+
+    /**
+     * \brief Set the last ephemeral port allocated, e.g., when restoring a checkpoint.
+     * \param port the ephemeral port
+     */
+    void SetEphemeralPort(uint16_t port);
+
   private:
     /**
      * \brief Allocate an ephemeral port.
@@ -192,10 +211,109 @@ class Ipv4EndPointDemux
      */
     uint16_t m_portFirst;
 
+    /**
+     * \brief Key of the connected endpoints.
+     */
+    struct ConnectionKey
+    {
+        uint16_t localPort;      //!< The local port
+        Ipv4Address peerAddress; //!< The peer address
+        uint16_t peerPort;       //!< The peer port
+
+        /**
+         * \brief Equality operator.
+         * \param other the other key
+         * \returns true if the keys are equal
+         */
+        bool operator==(const ConnectionKey& other) const;
+    };
+
+    /**
+     * \brief Hash of the keys of the connected endpoints.
+     */
+    struct ConnectionKeyHash
+    {
+        /**
+         * \brief Returns the hash of a key.
+         * \param key the key
+         * \returns the hash of the key
+         */
+        std::size_t operator()(const ConnectionKey& key) const;
+    };
+
+    /**
+     * \brief The positions of an endpoint in the containers of the demux.
+     */
+    struct Position
+    {
+        EndPointsI endPoint; //!< The position in m_endPoints
+        EndPointsI port;     //!< The position in the endpoints of the local port
+        EndPointsI index;    //!< The position in the listeners or in the connection
+        bool connected;      //!< True if the endpoint is indexed as a connection
+        ConnectionKey key;   //!< The key of the endpoint
+    };
+
+    /**
+     * \brief Get the endpoints indexed with a local port and a peer.
+     * \param localPort the local port
+     * \param peerAddress the peer address
+     * \param peerPort the peer port
+     * \returns the connections to the peer if the peer address and port are set, or the
+     * listeners of the local port otherwise (nullptr if none)
+     */
+    const EndPoints* GetIndexed(uint16_t localPort,
+                                Ipv4Address peerAddress,
+                                uint16_t peerPort) const;
+
+    /**
+     * \brief Add an endpoint to the demux.
+     * \param endPoint the endpoint
+     */
+    void Insert(Ipv4EndPoint* endPoint);
+
+    /**
+     * \brief Add an endpoint to the listeners or the connections.
+     * \param endPoint the endpoint
+     * \param position the positions of the endpoint
+     */
+    void Index(Ipv4EndPoint* endPoint, Position& position);
+
+    /**
+     * \brief Remove an endpoint from the listeners or the connections.
+     * \param position the positions of the endpoint
+     */
+    void Unindex(const Position& position);
+
+    /**
+     * \brief Update the index of an endpoint after a change of its peer.
+     * \param endPoint the endpoint
+     */
+    void Reindex(Ipv4EndPoint* endPoint);
+
     /**
      * \brief A list of IPv4 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * \brief The endpoints, by local port.
+     */
+    std::unordered_map<uint16_t, EndPoints> m_ports;
+
+    /**
+     * \brief The endpoints without a peer address and port, by local port.
+     */
+    std::unordered_map<uint16_t, EndPoints> m_listeners;
+
+    /**
+     * \brief The endpoints with a peer address and port, by local port and peer.
+     */
+    std::unordered_map<ConnectionKey, EndPoints, ConnectionKeyHash> m_connections;
+
+    /**
+     * \brief The positions of the endpoints in the containers.
+     */
+    std::unordered_map<const Ipv4EndPoint*, Position> m_positions;
 };
 
 } // namespace ns3
@@ -144,6 +144,13 @@ class Ipv4EndPoint
      * \param callback callback function
      */
     void SetDestroyCallback(Callback<void> callback);
+    /**
+     * \brief Set the callback invoked after a change of the peer of the endpoint.
+     *
+     * Used by the Ipv4EndPointDemux to keep its index of the endpoints up to date.
+     * \param callback callback function
+     */
+    void SetChangeCallback(Callback<void, Ipv4EndPoint*> callback);
 
     /**
      * \brief Forward the packet to the upper level.
@@ -231,6 +238,11 @@ class Ipv4EndPoint
      */
     Callback<void> m_destroyCallback;
 
+    /**
+     * \brief The change callback.
+     */
+    Callback<void, Ipv4EndPoint*> m_changeCallback;
+
     /**
      * \brief true if the endpoint can receive packets.
      */
@@ -30,6 +30,7 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <vector>
 
@@ -83,6 +84,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, Ipv4Address nextHop, uint32_
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, nextHop, interface);
     m_hostRoutes.push_back(route);
+    m_hostRouteIndex.Insert(dest, Ipv4Mask::GetOnes(), route);
 }
 
 void
@@ -92,6 +94,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, uint32_t interface)
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, interface);
     m_hostRoutes.push_back(route);
+    m_hostRouteIndex.Insert(dest, Ipv4Mask::GetOnes(), route);
 }
 
 void
@@ -104,6 +107,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network,
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
     m_networkRoutes.push_back(route);
+    m_networkRouteIndex.Insert(network, networkMask, route);
 }
 
 void
@@ -113,6 +117,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network, Ipv4Mask networkMask,
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
     m_networkRoutes.push_back(route);
+    m_networkRouteIndex.Insert(network, networkMask, route);
 }
 
 void
@@ -125,6 +130,7 @@ Ipv4GlobalRouting::AddASExternalRouteTo(Ipv4Address network,
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
     m_ASexternalRoutes.push_back(route);
+    m_ASexternalRouteIndex.Insert(network, networkMask, route);
 }
 
 Ptr<Ipv4Route>
@@ -137,66 +143,86 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
     typedef std::vector<Ipv4RoutingTableEntry*> RouteVec_t;
     RouteVec_t allRoutes;
 
+    RouteIndex::Key key = RouteIndex::GetKey(dest);
+
     NS_LOG_LOGIC("Number of m_hostRoutes = " << m_hostRoutes.size());
-    for (auto i = m_hostRoutes.begin(); i != m_hostRoutes.end(); i++)
+    const RouteIndex::Bucket* hostRoutes = m_hostRouteIndex.Find(key, 32);
+    if (hostRoutes)
     {
-        NS_ASSERT((*i)->IsHost());
-        if ((*i)->GetDest() == dest)
+        for (const auto& i : *hostRoutes)
         {
+            NS_ASSERT(i.route->IsHost());
             if (oif)
             {
-                if (oif != m_ipv4->GetNetDevice((*i)->GetInterface()))
+                if (oif != m_ipv4->GetNetDevice(i.route->GetInterface()))
                 {
                     NS_LOG_LOGIC("Not on requested interface, skipping");
                     continue;
                 }
             }
-            allRoutes.push_back(*i);
-            NS_LOG_LOGIC(allRoutes.size() << "Found global host route" << *i);
+            allRoutes.push_back(i.route);
+            NS_LOG_LOGIC(allRoutes.size() << "Found global host route" << i.route);
         }
     }
     if (allRoutes.empty()) // if no host route is found
     {
         NS_LOG_LOGIC("Number of m_networkRoutes" << m_networkRoutes.size());
-        for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
-        {
-            Ipv4Mask mask = (*j)->GetDestNetworkMask();
-            Ipv4Address entry = (*j)->GetDestNetwork();
-            if (mask.IsMatch(dest, entry))
+        // all the matching network routes are candidates, whatever their
+        // mask length, in the order of m_networkRoutes
+        std::vector<RouteIndex::Item> matches;
+        m_networkRouteIndex.ForEachMatch(key, [&](uint8_t, const RouteIndex::Bucket& routes) {
+            for (const auto& j : routes)
             {
                 if (oif)
                 {
-                    if (oif != m_ipv4->GetNetDevice((*j)->GetInterface()))
+                    if (oif != m_ipv4->GetNetDevice(j.route->GetInterface()))
                     {
                         NS_LOG_LOGIC("Not on requested interface, skipping");
                         continue;
                     }
                 }
-                allRoutes.push_back(*j);
-                NS_LOG_LOGIC(allRoutes.size() << "Found global network route" << *j);
+                matches.push_back(j);
             }
+            return false;
+        });
+        std::sort(matches.begin(),
+                  matches.end(),
+                  [](const RouteIndex::Item& a, const RouteIndex::Item& b) {
+                      return a.order < b.order;
+                  });
+        for (const auto& j : matches)
+        {
+            allRoutes.push_back(j.route);
+            NS_LOG_LOGIC(allRoutes.size() << "Found global network route" << j.route);
         }
     }
     if (allRoutes.empty()) // consider external if no host/network found
     {
-        for (auto k = m_ASexternalRoutes.begin(); k != m_ASexternalRoutes.end(); k++)
-        {
-            Ipv4Mask mask = (*k)->GetDestNetworkMask();
-            Ipv4Address entry = (*k)->GetDestNetwork();
-            if (mask.IsMatch(dest, entry))
+        // only the first matching external route of m_ASexternalRoutes
+        const RouteIndex::Item* first = nullptr;
+        m_ASexternalRouteIndex.ForEachMatch(key, [&](uint8_t, const RouteIndex::Bucket& routes) {
+            for (const auto& k : routes)
             {
-                NS_LOG_LOGIC("Found external route" << *k);
                 if (oif)
                 {
-                    if (oif != m_ipv4->GetNetDevice((*k)->GetInterface()))
+                    if (oif != m_ipv4->GetNetDevice(k.route->GetInterface()))
                     {
                         NS_LOG_LOGIC("Not on requested interface, skipping");
                         continue;
                     }
                 }
-                allRoutes.push_back(*k);
+                if (!first || k.order < first->order)
+                {
+                    first = &k;
+                }
                 break;
             }
+            return false;
+        });
+        if (first)
+        {
+            NS_LOG_LOGIC("Found external route" << first->route);
+            allRoutes.push_back(first->route);
         }
     }
     if (!allRoutes.empty()) // if route(s) is found
@@ -297,6 +323,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
             if (tmp == index)
             {
                 NS_LOG_LOGIC("Removing route " << index << "; size = " << m_hostRoutes.size());
+                m_hostRouteIndex.Remove((*i)->GetDest(), Ipv4Mask::GetOnes(), *i);
                 delete *i;
                 m_hostRoutes.erase(i);
                 NS_LOG_LOGIC("Done removing host route "
@@ -313,6 +340,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
         if (tmp == index)
         {
             NS_LOG_LOGIC("Removing route " << index << "; size = " << m_networkRoutes.size());
+            m_networkRouteIndex.Remove((*j)->GetDestNetwork(), (*j)->GetDestNetworkMask(), *j);
             delete *j;
             m_networkRoutes.erase(j);
             NS_LOG_LOGIC("Done removing network route "
@@ -328,6 +356,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
         if (tmp == index)
         {
             NS_LOG_LOGIC("Removing route " << index << "; size = " << m_ASexternalRoutes.size());
+            m_ASexternalRouteIndex.Remove((*k)->GetDestNetwork(), (*k)->GetDestNetworkMask(), *k);
             delete *k;
             m_ASexternalRoutes.erase(k);
             NS_LOG_LOGIC("Done removing network route "
@@ -364,6 +393,9 @@ Ipv4GlobalRouting::DoDispose()
     {
         delete (*l);
     }
+    m_hostRouteIndex.Clear();
+    m_networkRouteIndex.Clear();
+    m_ASexternalRouteIndex.Clear();
 
     Ipv4RoutingProtocol::DoDispose();
 }
@@ -22,6 +22,7 @@
 #include "ipv4-header.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
+#include "route-prefix-index.h"
 
 #include "ns3/ipv4-address.h"
 #include "ns3/ptr.h"
@@ -266,6 +267,9 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
     /// iterator of container of Ipv4RoutingTableEntry (routes to external AS)
     typedef std::list<Ipv4RoutingTableEntry*>::iterator ASExternalRoutesI;
 
+    /// index of container of Ipv4RoutingTableEntry, for the lookups
+    typedef Ipv4RoutePrefixIndex<Ipv4RoutingTableEntry*> RouteIndex;
+
     /**
      * \brief Lookup in the forwarding table for destination.
      * \param dest destination address
@@ -278,6 +282,10 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
     NetworkRoutes m_networkRoutes;       //!< Routes to networks
     ASExternalRoutes m_ASexternalRoutes; //!< External routes imported
 
+    RouteIndex m_hostRouteIndex;       //!< Index of the routes to hosts
+    RouteIndex m_networkRouteIndex;    //!< Index of the routes to networks
+    RouteIndex m_ASexternalRouteIndex; //!< Index of the external routes imported
+
     Ptr<Ipv4> m_ipv4; //!< associated IPv4 instance
 };
 
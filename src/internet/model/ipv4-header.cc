@@ -393,12 +393,13 @@ Ipv4Header::Serialize(Buffer::Iterator start) const
 {
     NS_LOG_FUNCTION(this << &start);
     Buffer::Iterator i = start;
+    uint8_t* buffer = i.WriteSpan(20);
 
     uint8_t verIhl = (4 << 4) | (5);
-    i.WriteU8(verIhl);
-    i.WriteU8(m_tos);
-    i.WriteHtonU16(m_payloadSize + 5 * 4);
-    i.WriteHtonU16(m_identification);
+    buffer[0] = verIhl;
+    buffer[1] = m_tos;
+    WriteHtonU16(buffer + 2, m_payloadSize + 5 * 4);
+    WriteHtonU16(buffer + 4, m_identification);
     uint32_t fragmentOffset = m_fragmentOffset / 8;
     uint8_t flagsFrag = (fragmentOffset >> 8) & 0x1f;
     if (m_flags & DONT_FRAGMENT)
@@ -409,23 +410,21 @@ Ipv4Header::Serialize(Buffer::Iterator start) const
     {
         flagsFrag |= (1 << 5);
     }
-    i.WriteU8(flagsFrag);
+    buffer[6] = flagsFrag;
     uint8_t frag = fragmentOffset & 0xff;
-    i.WriteU8(frag);
-    i.WriteU8(m_ttl);
-    i.WriteU8(m_protocol);
-    i.WriteHtonU16(0);
-    i.WriteHtonU32(m_source.Get());
-    i.WriteHtonU32(m_destination.Get());
+    buffer[7] = frag;
+    buffer[8] = m_ttl;
+    buffer[9] = m_protocol;
+    WriteHtonU16(buffer + 10, 0);
+    WriteHtonU32(buffer + 12, m_source.Get());
+    WriteHtonU32(buffer + 16, m_destination.Get());
 
     if (m_calcChecksum)
     {
         i = start;
         uint16_t checksum = i.CalculateIpChecksum(20);
         NS_LOG_LOGIC("checksum=" << checksum);
-        i = start;
-        i.Next(10);
-        i.WriteU16(checksum);
+        WriteHtolsbU16(buffer + 10, checksum);
     }
 }
 
@@ -435,7 +434,7 @@ Ipv4Header::Deserialize(Buffer::Iterator start)
     NS_LOG_FUNCTION(this << &start);
     Buffer::Iterator i = start;
 
-    uint8_t verIhl = i.ReadU8();
+    uint8_t verIhl = i.PeekU8();
     uint8_t ihl = verIhl & 0x0f;
     uint16_t headerSize = ihl * 4;
 
@@ -445,11 +444,13 @@ Ipv4Header::Deserialize(Buffer::Iterator start)
         return 0;
     }
 
-    m_tos = i.ReadU8();
-    uint16_t size = i.ReadNtohU16();
+    uint8_t scratch[20];
+    const uint8_t* buffer = i.ReadSpan(20, scratch);
+    m_tos = buffer[1];
+    uint16_t size = ReadNtohU16(buffer + 2);
     m_payloadSize = size - headerSize;
-    m_identification = i.ReadNtohU16();
-    uint8_t flags = i.ReadU8();
+    m_identification = ReadNtohU16(buffer + 4);
+    uint8_t flags = buffer[6];
     m_flags = 0;
     if (flags & (1 << 6))
     {
@@ -459,17 +460,15 @@ Ipv4Header::Deserialize(Buffer::Iterator start)
     {
         m_flags |= MORE_FRAGMENTS;
     }
-    i.Prev();
-    m_fragmentOffset = i.ReadU8() & 0x1f;
+    m_fragmentOffset = buffer[6] & 0x1f;
     m_fragmentOffset <<= 8;
-    m_fragmentOffset |= i.ReadU8();
+    m_fragmentOffset |= buffer[7];
     m_fragmentOffset <<= 3;
-    m_ttl = i.ReadU8();
-    m_protocol = i.ReadU8();
-    m_checksum = i.ReadU16();
-    /* i.Next (2); // checksum */
-    m_source.Set(i.ReadNtohU32());
-    m_destination.Set(i.ReadNtohU32());
+    m_ttl = buffer[8];
+    m_protocol = buffer[9];
+    m_checksum = ReadLsbtohU16(buffer + 10);
+    m_source.Set(ReadNtohU32(buffer + 12));
+    m_destination.Set(ReadNtohU32(buffer + 16));
     m_headerSize = headerSize;
 
     if (m_calcChecksum)
@@ -25,6 +25,7 @@
 #include "ipv4-queue-disc-item.h"
 #include "loopback-net-device.h"
 
+#include "ns3/checkpoint.h"
 #include "ns3/log.h"
 #include "ns3/net-device.h"
 #include "ns3/node.h"
@@ -38,6 +39,7 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("Ipv4Interface");
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv4Interface);
+NS_CHECKPOINT_STATELESS(Ipv4Interface);
 
 TypeId
 Ipv4Interface::GetTypeId()
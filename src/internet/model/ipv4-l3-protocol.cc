@@ -36,6 +36,7 @@
 #include "ns3/node.h"
 #include "ns3/object-vector.h"
 #include "ns3/packet.h"
+#include "ns3/segment-offload-tag.h"
 #include "ns3/socket.h"
 #include "ns3/string.h"
 #include "ns3/trace-source-accessor.h"
@@ -991,7 +992,11 @@ Ipv4L3Protocol::SendRealOut(Ptr<Ipv4Route> route, Ptr<Packet> packet, const Ipv4
     if (outInterface->IsUp())
     {
         NS_LOG_LOGIC("Send to " << targetLabel << " " << target);
-        if (packet->GetSize() + ipHeader.GetSerializedSize() > outInterface->GetDevice()->GetMtu())
+        // The super-segments of the segmentation offload are not fragmented
+        SegmentOffloadTag offloadTag;
+        if (packet->GetSize() + ipHeader.GetSerializedSize() >
+                outInterface->GetDevice()->GetMtu() &&
+            !packet->PeekPacketTag(offloadTag))
         {
             std::list<Ipv4PayloadHeaderPair> listFragments;
             DoFragmentation(packet, ipHeader, outInterface->GetDevice()->GetMtu(), listFragments);
@@ -1893,4 +1898,39 @@ Ipv4L3Protocol::HandleTimeout()
     m_timeoutEvent = Simulator::Schedule(difference, &Ipv4L3Protocol::HandleTimeout, this);
 }
 
+void
+Ipv4L3Protocol::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(!m_fragments.empty(),
+                    "Cannot save an IPv4 stack while " << m_fragments.size()
+                                                       << " packets are being reassembled");
+    NS_ABORT_MSG_IF(!m_sockets.empty(), "Cannot save the IPv4 raw sockets: not supported");
+    NS_ABORT_MSG_IF(m_enableDpd,
+                    "Cannot save the IPv4 duplicate packet detection state: not supported");
+    uint32_t n = 0;
+    for (const auto& [key, identification] : m_identification)
+    {
+        std::string prefix = "identification." + std::to_string(n++);
+        writer.Write(prefix + ".addresses", key.first);
+        writer.Write(prefix + ".protocol", key.second);
+        writer.Write(prefix + ".value", identification);
+    }
+    writer.Write("identifications", n);
+}
+
+void
+Ipv4L3Protocol::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    m_identification.clear();
+    for (uint32_t i = 0, n = reader.Read<uint32_t>("identifications"); i < n; i++)
+    {
+        std::string prefix = "identification." + std::to_string(i);
+        auto key = std::make_pair(reader.Read<uint64_t>(prefix + ".addresses"),
+                                  reader.Read<uint8_t>(prefix + ".protocol"));
+        m_identification[key] = reader.Read<uint16_t>(prefix + ".value");
+    }
+}
+
 } // namespace ns3
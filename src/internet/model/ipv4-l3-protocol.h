@@ -24,6 +24,7 @@
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
 
+#include "ns3/checkpoint.h"
 #include "ns3/deprecated.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/net-device.h"
@@ -79,8 +80,14 @@ class Icmpv4L4Protocol;
  * Moreover, the actual implementation does not mimic exactly the Linux
  * kernel. Hence it is not possible, for instance, to test a fragmentation
  * attack.
+ *
+ * A checkpoint saves the identification counters. The interfaces and the
+ * routing protocol are configured again by the scenario before restoring,
+ * and the checkpoint is refused while fragments are being reassembled,
+ * while raw sockets are open, or when the multicast duplicate packet
+ * detection is enabled.
  */
-class Ipv4L3Protocol : public Ipv4
+class Ipv4L3Protocol : public Ipv4, public Checkpointable
 {
   public:
     /**
@@ -277,6 +284,17 @@ class Ipv4L3Protocol : public Ipv4
                                        Ptr<Ipv4> ipv4,
                                        uint32_t interface);
 
+    /**
+     * \brief Save the identification counters.
+     * \param writer the checkpoint writer
+     */
+    void SaveState(CheckpointWriter& writer) const override;
+    /**
+     * \brief Restore the identification counters.
+     * \param reader the checkpoint reader
+     */
+    void RestoreState(CheckpointReader& reader) override;
+
   protected:
     void DoDispose() override;
     /**
@@ -18,6 +18,7 @@
  */
 #include "ipv4-raw-socket-factory.h"
 
+#include "ns3/checkpoint.h"
 #include "ns3/log.h"
 #include "ns3/uinteger.h"
 
@@ -27,6 +28,7 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("Ipv4RawSocketFactory");
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv4RawSocketFactory);
+NS_CHECKPOINT_STATELESS(Ipv4RawSocketFactory);
 
 TypeId
 Ipv4RawSocketFactory::GetTypeId()
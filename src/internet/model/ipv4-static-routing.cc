@@ -78,8 +78,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
 
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv4RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AddNetworkRoute(new Ipv4RoutingTableEntry(route), metric);
     }
 }
 
@@ -95,9 +94,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
         Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv4RoutingTableEntry(route);
-
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AddNetworkRoute(new Ipv4RoutingTableEntry(route), metric);
     }
 }
 
@@ -152,7 +149,7 @@ Ipv4StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     Ipv4Address network("224.0.0.0");
     Ipv4Mask networkMask("240.0.0.0");
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
-    m_networkRoutes.emplace_back(route, 0);
+    AddNetworkRoute(route, 0);
 }
 
 uint32_t
@@ -239,12 +236,32 @@ Ipv4StaticRouting::LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metr
     return false;
 }
 
+void
+Ipv4StaticRouting::AddNetworkRoute(Ipv4RoutingTableEntry* route, uint32_t metric)
+{
+    NS_LOG_FUNCTION(this << route << metric);
+    m_networkRoutes.emplace_back(route, metric);
+    m_networkRouteIndex.Insert(route->GetDestNetwork(),
+                               route->GetDestNetworkMask(),
+                               m_networkRoutes.back());
+}
+
+Ipv4StaticRouting::NetworkRoutesI
+Ipv4StaticRouting::RemoveNetworkRoute(NetworkRoutesI route)
+{
+    NS_LOG_FUNCTION(this << route->first);
+    m_networkRouteIndex.Remove(route->first->GetDestNetwork(),
+                               route->first->GetDestNetworkMask(),
+                               *route);
+    delete route->first;
+    return m_networkRoutes.erase(route);
+}
+
 Ptr<Ipv4Route>
 Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
 {
     NS_LOG_FUNCTION(this << dest << " " << oif);
     Ptr<Ipv4Route> rtentry = nullptr;
-    uint16_t longest_mask = 0;
     uint32_t shortest_metric = 0xffffffff;
     /* when sending on local multicast, there have to be interface specified */
     if (dest.IsLocalMulticast())
@@ -261,55 +278,48 @@ Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
         return rtentry;
     }
 
-    for (auto i = m_networkRoutes.begin(); i != m_networkRoutes.end(); i++)
-    {
-        Ipv4RoutingTableEntry* j = i->first;
-        uint32_t metric = i->second;
-        Ipv4Mask mask = (j)->GetDestNetworkMask();
-        uint16_t masklen = mask.GetPrefixLength();
-        Ipv4Address entry = (j)->GetDestNetwork();
-        NS_LOG_LOGIC("Searching for route to " << dest << ", checking against route to " << entry
-                                               << "/" << masklen);
-        if (mask.IsMatch(dest, entry))
-        {
-            NS_LOG_LOGIC("Found global network route " << j << ", mask length " << masklen
-                                                       << ", metric " << metric);
-            if (oif)
+    // the routes with the longest matching mask win, and among them the last
+    // one with the smallest metric, or the first one for a host route
+    Ipv4RoutingTableEntry* route = nullptr;
+    m_networkRouteIndex.ForEachMatch(
+        NetworkRouteIndex::GetKey(dest),
+        [&](uint8_t masklen, const NetworkRouteIndex::Bucket& routes) {
+            for (const auto& i : routes)
             {
-                if (oif != m_ipv4->GetNetDevice(j->GetInterface()))
+                Ipv4RoutingTableEntry* j = i.route.first;
+                uint32_t metric = i.route.second;
+                NS_LOG_LOGIC("Found global network route " << j << ", mask length " << +masklen
+                                                           << ", metric " << metric);
+                if (oif)
+                {
+                    if (oif != m_ipv4->GetNetDevice(j->GetInterface()))
+                    {
+                        NS_LOG_LOGIC("Not on requested interface, skipping");
+                        continue;
+                    }
+                }
+                if (metric > shortest_metric)
                 {
-                    NS_LOG_LOGIC("Not on requested interface, skipping");
+                    NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
                     continue;
                 }
+                shortest_metric = metric;
+                route = j;
+                if (masklen == 32)
+                {
+                    break;
+                }
             }
-            if (masklen < longest_mask) // Not interested if got shorter mask
-            {
-                NS_LOG_LOGIC("Previous match longer, skipping");
-                continue;
-            }
-            if (masklen > longest_mask) // Reset metric if longer masklen
-            {
-                shortest_metric = 0xffffffff;
-            }
-            longest_mask = masklen;
-            if (metric > shortest_metric)
-            {
-                NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
-                continue;
-            }
-            shortest_metric = metric;
-            Ipv4RoutingTableEntry* route = (j);
-            uint32_t interfaceIdx = route->GetInterface();
-            rtentry = Create<Ipv4Route>();
-            rtentry->SetDestination(route->GetDest());
-            rtentry->SetSource(m_ipv4->SourceAddressSelection(interfaceIdx, route->GetDest()));
-            rtentry->SetGateway(route->GetGateway());
-            rtentry->SetOutputDevice(m_ipv4->GetNetDevice(interfaceIdx));
-            if (masklen == 32)
-            {
-                break;
-            }
-        }
+            return route != nullptr;
+        });
+    if (route)
+    {
+        uint32_t interfaceIdx = route->GetInterface();
+        rtentry = Create<Ipv4Route>();
+        rtentry->SetDestination(route->GetDest());
+        rtentry->SetSource(m_ipv4->SourceAddressSelection(interfaceIdx, route->GetDest()));
+        rtentry->SetGateway(route->GetGateway());
+        rtentry->SetOutputDevice(m_ipv4->GetNetDevice(interfaceIdx));
     }
     if (rtentry)
     {
@@ -457,8 +467,7 @@ Ipv4StaticRouting::RemoveRoute(uint32_t index)
     {
         if (tmp == index)
         {
-            delete j->first;
-            m_networkRoutes.erase(j);
+            RemoveNetworkRoute(j);
             return;
         }
         tmp++;
@@ -592,6 +601,7 @@ Ipv4StaticRouting::DoDispose()
     {
         delete (j->first);
     }
+    m_networkRouteIndex.Clear();
     for (auto i = m_multicastRoutes.begin(); i != m_multicastRoutes.end();
          i = m_multicastRoutes.erase(i))
     {
@@ -631,8 +641,7 @@ Ipv4StaticRouting::NotifyInterfaceDown(uint32_t i)
     {
         if (it->first->GetInterface() == i)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = RemoveNetworkRoute(it);
         }
         else
         {
@@ -676,8 +685,7 @@ Ipv4StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress
             it->first->GetDestNetwork() == networkAddress &&
             it->first->GetDestNetworkMask() == networkMask)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = RemoveNetworkRoute(it);
         }
         else
         {
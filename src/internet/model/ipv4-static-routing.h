@@ -24,6 +24,7 @@
 #include "ipv4-header.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
+#include "route-prefix-index.h"
 
 #include "ns3/ipv4-address.h"
 #include "ns3/ptr.h"
@@ -372,6 +373,9 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
     /// Iterator for container for the network routes
     typedef std::list<std::pair<Ipv4RoutingTableEntry*, uint32_t>>::iterator NetworkRoutesI;
 
+    /// Index of the network routes, for the lookups
+    typedef Ipv4RoutePrefixIndex<std::pair<Ipv4RoutingTableEntry*, uint32_t>> NetworkRouteIndex;
+
     /// Container for the multicast routes
     typedef std::list<Ipv4MulticastRoutingTableEntry*> MulticastRoutes;
 
@@ -389,6 +393,20 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
      */
     bool LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metric);
 
+    /**
+     * \brief Add a route at the end of the forwarding table for network.
+     * \param route route, owned by the forwarding table
+     * \param metric metric of route
+     */
+    void AddNetworkRoute(Ipv4RoutingTableEntry* route, uint32_t metric);
+
+    /**
+     * \brief Remove and delete a route of the forwarding table for network.
+     * \param route the route to remove
+     * \return the route following the removed route
+     */
+    NetworkRoutesI RemoveNetworkRoute(NetworkRoutesI route);
+
     /**
      * \brief Lookup in the forwarding table for destination.
      * \param dest destination address
@@ -411,6 +429,11 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * \brief the index of the forwarding table for network, by prefix.
+     */
+    NetworkRouteIndex m_networkRouteIndex;
+
     /**
      * \brief the forwarding table for multicast.
      */
@@ -45,29 +45,31 @@ Ipv6EndPointDemux::~Ipv6EndPointDemux()
         delete endPoint;
     }
     m_endPoints.clear();
+    m_ports.clear();
+    m_listeners.clear();
+    m_connections.clear();
+    m_positions.clear();
 }
 
 bool
 Ipv6EndPointDemux::LookupPortLocal(uint16_t port)
 {
     NS_LOG_FUNCTION(this << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        if ((*i)->GetLocalPort() == port)
-        {
-            return true;
-        }
-    }
-    return false;
+    return m_ports.find(port) != m_ports.end();
 }
 
 bool
 Ipv6EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv6Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto endPoints = m_ports.find(port);
+    if (endPoints == m_ports.end())
     {
-        if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
+        return false;
+    }
+    for (auto i = endPoints->second.begin(); i != endPoints->second.end(); i++)
+    {
+        if ((*i)->GetLocalAddress() == addr &&
             (*i)->GetBoundNetDevice() == boundNetDevice)
         {
             return true;
@@ -87,7 +89,7 @@ Ipv6EndPointDemux::Allocate()
         return nullptr;
     }
     auto endPoint = new Ipv6EndPoint(Ipv6Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -103,7 +105,7 @@ Ipv6EndPointDemux::Allocate(Ipv6Address address)
         return nullptr;
     }
     auto endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -126,7 +128,7 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv6Address address,
         return nullptr;
     }
     auto endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -139,19 +141,23 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << boundNetDevice << localAddress << localPort << peerAddress << peerPort);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    const EndPoints* endPoints = GetIndexed(localPort, peerAddress, peerPort);
+    if (endPoints)
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        for (auto i = endPoints->begin(); i != endPoints->end(); i++)
         {
-            NS_LOG_WARN("Duplicated endpoint.");
-            return nullptr;
+            if ((*i)->GetLocalAddress() == localAddress && (*i)->GetPeerPort() == peerPort &&
+                (*i)->GetPeerAddress() == peerAddress &&
+                ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+            {
+                NS_LOG_WARN("Duplicated endpoint.");
+                return nullptr;
+            }
         }
     }
     auto endPoint = new Ipv6EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
 
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
 
@@ -162,15 +168,21 @@ void
 Ipv6EndPointDemux::DeAllocate(Ipv6EndPoint* endPoint)
 {
     NS_LOG_FUNCTION(this);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto position = m_positions.find(endPoint);
+    if (position == m_positions.end())
     {
-        if (*i == endPoint)
-        {
-            delete endPoint;
-            m_endPoints.erase(i);
-            break;
-        }
+        return;
+    }
+    m_endPoints.erase(position->second.endPoint);
+    auto port = m_ports.find(position->second.key.localPort);
+    port->second.erase(position->second.port);
+    if (port->second.empty())
+    {
+        m_ports.erase(port);
     }
+    Unindex(position->second);
+    m_positions.erase(position);
+    delete endPoint;
 }
 
 /*
@@ -193,92 +205,99 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
     EndPoints retval4; /* Exact match on all 4 */
 
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    // Only the endpoints of the local port without a peer, and the connections
+    // to the source of the packet, may match the packet
+    const EndPoints* candidates[] = {GetIndexed(dport, Ipv6Address::GetAny(), 0), nullptr};
+    if (saddr != Ipv6Address::GetAny() && sport != 0)
     {
-        Ipv6EndPoint* endP = *i;
-
-        NS_LOG_DEBUG("Looking at endpoint dport="
-                     << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
-                     << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
-
-        if (!endP->IsRxEnabled())
+        candidates[1] = GetIndexed(dport, saddr, sport);
+    }
+    for (const EndPoints* endPoints : candidates)
+    {
+        if (!endPoints)
         {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP
-                                              << " because endpoint can not receive packets");
             continue;
         }
-
-        if (endP->GetLocalPort() != dport)
+        for (auto i = endPoints->begin(); i != endPoints->end(); i++)
         {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
-                                              << endP->GetLocalPort()
-                                              << " does not match packet dport " << dport);
-            continue;
-        }
+            Ipv6EndPoint* endP = *i;
 
-        if (endP->GetBoundNetDevice())
-        {
-            if (!incomingInterface)
+            NS_LOG_DEBUG("Looking at endpoint dport=" << endP->GetLocalPort()
+                                                      << " daddr=" << endP->GetLocalAddress()
+                                                      << " sport=" << endP->GetPeerPort()
+                                                      << " saddr=" << endP->GetPeerAddress());
+
+            if (!endP->IsRxEnabled())
             {
+                NS_LOG_LOGIC("Skipping endpoint " << &endP
+                                                  << " because endpoint can not receive packets");
                 continue;
             }
-            if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
+
+            if (endP->GetBoundNetDevice())
             {
-                NS_LOG_LOGIC("Skipping endpoint "
-                             << &endP << " because endpoint is bound to specific device and"
-                             << endP->GetBoundNetDevice() << " does not match packet device "
-                             << incomingInterface->GetDevice());
-                continue;
+                if (!incomingInterface)
+                {
+                    continue;
+                }
+                if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
+                {
+                    NS_LOG_LOGIC("Skipping endpoint "
+                                 << &endP << " because endpoint is bound to specific device and"
+                                 << endP->GetBoundNetDevice() << " does not match packet device "
+                                 << incomingInterface->GetDevice());
+                    continue;
+                }
             }
-        }
 
-        /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
-        NS_LOG_DEBUG("dest addr " << daddr);
+            /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
+            NS_LOG_DEBUG("dest addr " << daddr);
 
-        bool localAddressMatchesWildCard = endP->GetLocalAddress() == Ipv6Address::GetAny();
-        bool localAddressMatchesExact = endP->GetLocalAddress() == daddr;
-        bool localAddressMatchesAllRouters =
-            endP->GetLocalAddress() == Ipv6Address::GetAllRoutersMulticast();
+            bool localAddressMatchesWildCard = endP->GetLocalAddress() == Ipv6Address::GetAny();
+            bool localAddressMatchesExact = endP->GetLocalAddress() == daddr;
+            bool localAddressMatchesAllRouters =
+                endP->GetLocalAddress() == Ipv6Address::GetAllRoutersMulticast();
 
-        /* if no match here, keep looking */
-        if (!(localAddressMatchesExact || localAddressMatchesWildCard))
-        {
-            continue;
-        }
-        bool remotePeerMatchesExact = endP->GetPeerPort() == sport;
-        bool remotePeerMatchesWildCard = endP->GetPeerPort() == 0;
-        bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
-        bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv6Address::GetAny();
-
-        /* If remote does not match either with exact or wildcard,i
-           skip this one */
-        if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
-        {
-            continue;
-        }
-        if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
-        {
-            continue;
-        }
+            /* if no match here, keep looking */
+            if (!(localAddressMatchesExact || localAddressMatchesWildCard))
+            {
+                continue;
+            }
+            bool remotePeerMatchesExact = endP->GetPeerPort() == sport;
+            bool remotePeerMatchesWildCard = endP->GetPeerPort() == 0;
+            bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
+            bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv6Address::GetAny();
+
+            /* If remote does not match either with exact or wildcard,i
+               skip this one */
+            if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
+            {
+                continue;
+            }
+            if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
+            {
+                continue;
+            }
 
-        /* Now figure out which return list to add this one to */
-        if (localAddressMatchesWildCard && remotePeerMatchesWildCard &&
-            remoteAddressMatchesWildCard)
-        { /* Only local port matches exactly */
-            retval1.push_back(endP);
-        }
-        if ((localAddressMatchesExact || (localAddressMatchesAllRouters)) &&
-            remotePeerMatchesWildCard && remoteAddressMatchesWildCard)
-        { /* Only local port and local address matches exactly */
-            retval2.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remotePeerMatchesExact && remoteAddressMatchesExact)
-        { /* All but local address */
-            retval3.push_back(endP);
-        }
-        if (localAddressMatchesExact && remotePeerMatchesExact && remoteAddressMatchesExact)
-        { /* All 4 match */
-            retval4.push_back(endP);
+            /* Now figure out which return list to add this one to */
+            if (localAddressMatchesWildCard && remotePeerMatchesWildCard &&
+                remoteAddressMatchesWildCard)
+            { /* Only local port matches exactly */
+                retval1.push_back(endP);
+            }
+            if ((localAddressMatchesExact || (localAddressMatchesAllRouters)) &&
+                remotePeerMatchesWildCard && remoteAddressMatchesWildCard)
+            { /* Only local port and local address matches exactly */
+                retval2.push_back(endP);
+            }
+            if (localAddressMatchesWildCard && remotePeerMatchesExact && remoteAddressMatchesExact)
+            { /* All but local address */
+                retval3.push_back(endP);
+            }
+            if (localAddressMatchesExact && remotePeerMatchesExact && remoteAddressMatchesExact)
+            { /* All 4 match */
+                retval4.push_back(endP);
+            }
         }
     }
 
@@ -312,16 +331,16 @@ Ipv6EndPointDemux::SimpleLookup(Ipv6Address dst, uint16_t dport, Ipv6Address src
 {
     uint32_t genericity = 3;
     Ipv6EndPoint* generic = nullptr;
+    auto endPoints = m_ports.find(dport);
+    if (endPoints == m_ports.end())
+    {
+        return nullptr;
+    }
 
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    for (auto i = endPoints->second.begin(); i != endPoints->second.end(); i++)
     {
         uint32_t tmp = 0;
 
-        if ((*i)->GetLocalPort() != dport)
-        {
-            continue;
-        }
-
         if ((*i)->GetLocalAddress() == dst && (*i)->GetPeerPort() == sport &&
             (*i)->GetPeerAddress() == src)
         {
@@ -348,6 +367,115 @@ Ipv6EndPointDemux::SimpleLookup(Ipv6Address dst, uint16_t dport, Ipv6Address src
     return generic;
 }
 
+bool
+Ipv6EndPointDemux::ConnectionKey::operator==(const ConnectionKey& other) const
+{
+    return localPort == other.localPort && peerAddress == other.peerAddress &&
+           peerPort == other.peerPort;
+}
+
+std::size_t
+Ipv6EndPointDemux::ConnectionKeyHash::operator()(const ConnectionKey& key) const
+{
+    uint32_t ports = (key.localPort << 16) | key.peerPort;
+    return Ipv6AddressHash()(key.peerAddress) ^ std::hash<uint32_t>()(ports);
+}
+
+const Ipv6EndPointDemux::EndPoints*
+Ipv6EndPointDemux::GetIndexed(uint16_t localPort, Ipv6Address peerAddress, uint16_t peerPort) const
+{
+    if (peerAddress != Ipv6Address::GetAny() && peerPort != 0)
+    {
+        auto endPoints = m_connections.find({localPort, peerAddress, peerPort});
+        return endPoints == m_connections.end() ? nullptr : &endPoints->second;
+    }
+    auto endPoints = m_listeners.find(localPort);
+    return endPoints == m_listeners.end() ? nullptr : &endPoints->second;
+}
+
+void
+Ipv6EndPointDemux::Insert(Ipv6EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    Position position;
+    position.endPoint = m_endPoints.insert(m_endPoints.end(), endPoint);
+    EndPoints& port = m_ports[endPoint->GetLocalPort()];
+    position.port = port.insert(port.end(), endPoint);
+    Index(endPoint, position);
+    m_positions[endPoint] = position;
+    endPoint->SetChangeCallback(MakeCallback(&Ipv6EndPointDemux::Reindex, this));
+}
+
+void
+Ipv6EndPointDemux::Index(Ipv6EndPoint* endPoint, Position& position)
+{
+    position.key = {endPoint->GetLocalPort(), endPoint->GetPeerAddress(), endPoint->GetPeerPort()};
+    position.connected =
+        position.key.peerAddress != Ipv6Address::GetAny() && position.key.peerPort != 0;
+    EndPoints& endPoints =
+        position.connected ? m_connections[position.key] : m_listeners[position.key.localPort];
+    position.index = endPoints.insert(endPoints.end(), endPoint);
+}
+
+void
+Ipv6EndPointDemux::Unindex(const Position& position)
+{
+    if (position.connected)
+    {
+        auto endPoints = m_connections.find(position.key);
+        endPoints->second.erase(position.index);
+        if (endPoints->second.empty())
+        {
+            m_connections.erase(endPoints);
+        }
+    }
+    else
+    {
+        auto endPoints = m_listeners.find(position.key.localPort);
+        endPoints->second.erase(position.index);
+        if (endPoints->second.empty())
+        {
+            m_listeners.erase(endPoints);
+        }
+    }
+}
+
+void
+Ipv6EndPointDemux::Reindex(Ipv6EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    auto position = m_positions.find(endPoint);
+    if (position != m_positions.end())
+    {
+        if (position->second.key.localPort != endPoint->GetLocalPort())
+        {
+            auto port = m_ports.find(position->second.key.localPort);
+            port->second.erase(position->second.port);
+            if (port->second.empty())
+            {
+                m_ports.erase(port);
+            }
+            EndPoints& endPoints = m_ports[endPoint->GetLocalPort()];
+            position->second.port = endPoints.insert(endPoints.end(), endPoint);
+        }
+        Unindex(position->second);
+        Index(endPoint, position->second);
+    }
+}
+
+uint16_t
+Ipv6EndPointDemux::GetEphemeralPort() const
+{
+    return m_ephemeral;
+}
+
+void
+Ipv6EndPointDemux::SetEphemeralPort(uint16_t port)
+{
+    NS_LOG_FUNCTION(this << port);
+    m_ephemeral = port;
+}
+
 uint16_t
 Ipv6EndPointDemux::AllocateEphemeralPort()
 {
@@ -46,6 +46,7 @@ Ipv6EndPoint::~Ipv6EndPoint()
     m_rxCallback.Nullify();
     m_icmpCallback.Nullify();
     m_destroyCallback.Nullify();
+    m_changeCallback.Nullify();
 }
 
 Ipv6Address
@@ -70,6 +71,10 @@ void
 Ipv6EndPoint::SetLocalPort(uint16_t port)
 {
     m_localPort = port;
+    if (!m_changeCallback.IsNull())
+    {
+        m_changeCallback(this);
+    }
 }
 
 Ipv6Address
@@ -101,6 +106,10 @@ Ipv6EndPoint::SetPeer(Ipv6Address addr, uint16_t port)
 {
     m_peerAddr = addr;
     m_peerPort = port;
+    if (!m_changeCallback.IsNull())
+    {
+        m_changeCallback(this);
+    }
 }
 
 void
@@ -123,6 +132,12 @@ Ipv6EndPoint::SetDestroyCallback(Callback<void> callback)
     m_destroyCallback = callback;
 }
 
+void
+Ipv6EndPoint::SetChangeCallback(Callback<void, Ipv6EndPoint*> callback)
+{
+    m_changeCallback = callback;
+}
+
 void
 Ipv6EndPoint::ForwardUp(Ptr<Packet> p,
                         Ipv6Header header,
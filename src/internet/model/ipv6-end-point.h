@@ -151,6 +151,14 @@ class Ipv6EndPoint
      * \param callback callback function
      */
     void SetDestroyCallback(Callback<void> callback);
+    /**
+     * \brief Set the callback invoked after a change of the local port or the peer of the
+     * endpoint.
+     *
+     * Used by the Ipv6EndPointDemux to keep its index of the endpoints up to date.
+     * \param callback callback function
+     */
+    void SetChangeCallback(Callback<void, Ipv6EndPoint*> callback);
 
     /**
      * \brief Forward the packet to the upper level.
@@ -235,6 +243,11 @@ class Ipv6EndPoint
      */
     Callback<void> m_destroyCallback;
 
+    /**
+     * \brief The change callback.
+     */
+    Callback<void, Ipv6EndPoint*> m_changeCallback;
+
     /**
      * \brief true if the endpoint can receive packets.
      */
@@ -21,6 +21,7 @@
 
 #include "ipv6-extension.h"
 
+#include "ns3/checkpoint.h"
 #include "ns3/node.h"
 #include "ns3/object-vector.h"
 #include "ns3/ptr.h"
@@ -31,6 +32,7 @@ namespace ns3
 {
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv6ExtensionDemux);
+NS_CHECKPOINT_STATELESS(Ipv6ExtensionDemux);
 
 TypeId
 Ipv6ExtensionDemux::GetTypeId()
@@ -29,6 +29,7 @@
 #include "ipv6-route.h"
 
 #include "ns3/assert.h"
+#include "ns3/checkpoint.h"
 #include "ns3/ipv6-address.h"
 #include "ns3/log.h"
 #include "ns3/object-vector.h"
@@ -193,6 +194,7 @@ Ipv6Extension::AssignStreams(int64_t stream)
 }
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv6ExtensionHopByHop);
+NS_CHECKPOINT_STATELESS(Ipv6ExtensionHopByHop);
 
 TypeId
 Ipv6ExtensionHopByHop::GetTypeId()
@@ -258,6 +260,7 @@ Ipv6ExtensionHopByHop::Process(Ptr<Packet>& packet,
 }
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv6ExtensionDestination);
+NS_CHECKPOINT_STATELESS(Ipv6ExtensionDestination);
 
 TypeId
 Ipv6ExtensionDestination::GetTypeId()
@@ -637,6 +640,21 @@ Ipv6ExtensionFragment::GetFragments(Ptr<Packet> packet,
     unfragmentablePart.clear();
 }
 
+void
+Ipv6ExtensionFragment::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(!m_fragments.empty(),
+                    "Cannot save an IPv6 stack while " << m_fragments.size()
+                                                       << " packets are being reassembled");
+}
+
+void
+Ipv6ExtensionFragment::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+}
+
 void
 Ipv6ExtensionFragment::HandleFragmentsTimeout(FragmentKey_t fragmentKey, Ipv6Header ipHeader)
 {
@@ -839,6 +857,7 @@ Ipv6ExtensionFragment::Fragments::GetTimeoutIter()
 }
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv6ExtensionRouting);
+NS_CHECKPOINT_STATELESS(Ipv6ExtensionRouting);
 
 TypeId
 Ipv6ExtensionRouting::GetTypeId()
@@ -948,6 +967,7 @@ Ipv6ExtensionRouting::Process(Ptr<Packet>& packet,
 }
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv6ExtensionRoutingDemux);
+NS_CHECKPOINT_STATELESS(Ipv6ExtensionRoutingDemux);
 
 TypeId
 Ipv6ExtensionRoutingDemux::GetTypeId()
@@ -1038,6 +1058,7 @@ Ipv6ExtensionRoutingDemux::Remove(Ptr<Ipv6ExtensionRouting> extensionRouting)
 }
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv6ExtensionLooseRouting);
+NS_CHECKPOINT_STATELESS(Ipv6ExtensionLooseRouting);
 
 TypeId
 Ipv6ExtensionLooseRouting::GetTypeId()
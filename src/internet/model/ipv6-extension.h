@@ -255,8 +255,10 @@ class Ipv6ExtensionDestination : public Ipv6Extension
  * \ingroup ipv6HeaderExt
  *
  * \brief IPv6 Extension Fragment
+ *
+ * A checkpoint can only be saved when no packet is being reassembled.
  */
-class Ipv6ExtensionFragment : public Ipv6Extension
+class Ipv6ExtensionFragment : public Ipv6Extension, public Checkpointable
 {
   public:
     /**
@@ -314,6 +316,17 @@ class Ipv6ExtensionFragment : public Ipv6Extension
                       uint32_t fragmentSize,
                       std::list<Ipv6PayloadHeaderPair>& listFragments);
 
+    /**
+     * \brief Check that no packet is being reassembled.
+     * \param writer the checkpoint writer
+     */
+    void SaveState(CheckpointWriter& writer) const override;
+    /**
+     * \brief Nothing to restore.
+     * \param reader the checkpoint reader
+     */
+    void RestoreState(CheckpointReader& reader) override;
+
   protected:
     /**
      * \brief Dispose this object.
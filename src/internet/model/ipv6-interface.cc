@@ -26,6 +26,7 @@
 #include "loopback-net-device.h"
 #include "ndisc-cache.h"
 
+#include "ns3/checkpoint.h"
 #include "ns3/log.h"
 #include "ns3/mac16-address.h"
 #include "ns3/mac64-address.h"
@@ -40,6 +41,7 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("Ipv6Interface");
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv6Interface);
+NS_CHECKPOINT_STATELESS(Ipv6Interface);
 
 TypeId
 Ipv6Interface::GetTypeId()
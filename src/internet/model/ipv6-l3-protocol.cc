@@ -40,6 +40,7 @@
 #include "ns3/mac64-address.h"
 #include "ns3/node.h"
 #include "ns3/object-vector.h"
+#include "ns3/segment-offload-tag.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/traffic-control-layer.h"
 #include "ns3/uinteger.h"
@@ -1230,7 +1231,10 @@ Ipv6L3Protocol::SendRealOut(Ptr<Ipv6Route> route, Ptr<Packet> packet, const Ipv6
         targetMtu = dev->GetMtu();
     }
 
-    if (packet->GetSize() + ipHeader.GetSerializedSize() > targetMtu)
+    // The super-segments of the segmentation offload are not fragmented
+    SegmentOffloadTag offloadTag;
+    if (packet->GetSize() + ipHeader.GetSerializedSize() > targetMtu &&
+        !packet->PeekPacketTag(offloadTag))
     {
         // Router => drop
         if (!fromMe)
@@ -1821,4 +1825,22 @@ Ipv6L3Protocol::GetStrongEndSystemModel() const
     return m_strongEndSystemModel;
 }
 
+void
+Ipv6L3Protocol::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(GetNInterfaces() > 1,
+                    "Cannot save an IPv6 stack with " << GetNInterfaces()
+                                                      << " interfaces: not supported");
+    NS_ABORT_MSG_IF(!m_sockets.empty(), "Cannot save the IPv6 raw sockets: not supported");
+}
+
+void
+Ipv6L3Protocol::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(GetNInterfaces() > 1,
+                    "Cannot restore " << reader.GetPath() << ": IPv6 interfaces are not supported");
+}
+
 } /* namespace ns3 */
@@ -25,6 +25,7 @@
 #include "ipv6-routing-protocol.h"
 #include "ipv6.h"
 
+#include "ns3/checkpoint.h"
 #include "ns3/ipv6-address.h"
 #include "ns3/net-device.h"
 #include "ns3/traced-callback.h"
@@ -59,8 +60,11 @@ class Ipv6AutoconfiguredPrefix;
  * and LocalDeliver trace sources are slightly higher-level and pass
  * around the Ipv6Header as an explicit parameter and not as part of
  * the packet.
+ *
+ * The IPv6 stack can only be saved to a checkpoint when its only
+ * interface is the loopback one.
  */
-class Ipv6L3Protocol : public Ipv6
+class Ipv6L3Protocol : public Ipv6, public Checkpointable
 {
   public:
     /**
@@ -486,6 +490,20 @@ class Ipv6L3Protocol : public Ipv6
      */
     bool ReachabilityHint(uint32_t ipInterfaceIndex, Ipv6Address address);
 
+    /**
+     * \brief Check that the stack has no state to save.
+     *
+     * Aborts if an interface other than the loopback one has been added.
+     *
+     * \param writer the checkpoint writer
+     */
+    void SaveState(CheckpointWriter& writer) const override;
+    /**
+     * \brief Check that the stack has no state to restore.
+     * \param reader the checkpoint reader
+     */
+    void RestoreState(CheckpointReader& reader) override;
+
   protected:
     /**
      * \brief Dispose object.
@@ -21,6 +21,7 @@
 
 #include "ipv6-option.h"
 
+#include "ns3/checkpoint.h"
 #include "ns3/node.h"
 #include "ns3/object-vector.h"
 #include "ns3/ptr.h"
@@ -31,6 +32,7 @@ namespace ns3
 {
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv6OptionDemux);
+NS_CHECKPOINT_STATELESS(Ipv6OptionDemux);
 
 TypeId
 Ipv6OptionDemux::GetTypeId()
@@ -22,6 +22,7 @@
 #include "ipv6-option-header.h"
 
 #include "ns3/assert.h"
+#include "ns3/checkpoint.h"
 #include "ns3/log.h"
 #include "ns3/uinteger.h"
 
@@ -59,6 +60,7 @@ Ipv6Option::SetNode(Ptr<Node> node)
 }
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv6OptionPad1);
+NS_CHECKPOINT_STATELESS(Ipv6OptionPad1);
 
 TypeId
 Ipv6OptionPad1::GetTypeId()
@@ -108,6 +110,7 @@ Ipv6OptionPad1::Process(Ptr<Packet> packet,
 }
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv6OptionPadn);
+NS_CHECKPOINT_STATELESS(Ipv6OptionPadn);
 
 TypeId
 Ipv6OptionPadn::GetTypeId()
@@ -157,6 +160,7 @@ Ipv6OptionPadn::Process(Ptr<Packet> packet,
 }
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv6OptionJumbogram);
+NS_CHECKPOINT_STATELESS(Ipv6OptionJumbogram);
 
 TypeId
 Ipv6OptionJumbogram::GetTypeId()
@@ -206,6 +210,7 @@ Ipv6OptionJumbogram::Process(Ptr<Packet> packet,
 }
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv6OptionRouterAlert);
+NS_CHECKPOINT_STATELESS(Ipv6OptionRouterAlert);
 
 TypeId
 Ipv6OptionRouterAlert::GetTypeId()
@@ -19,12 +19,14 @@
 
 #include "ipv6-raw-socket-factory.h"
 
+#include "ns3/checkpoint.h"
 #include "ns3/uinteger.h"
 
 namespace ns3
 {
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv6RawSocketFactory);
+NS_CHECKPOINT_STATELESS(Ipv6RawSocketFactory);
 
 TypeId
 Ipv6RawSocketFactory::GetTypeId()
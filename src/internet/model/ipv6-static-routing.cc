@@ -181,8 +181,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
 
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AddNetworkRoute(new Ipv6RoutingTableEntry(route), metric);
     }
 }
 
@@ -208,8 +207,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
                                                                               prefixToUse);
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AddNetworkRoute(new Ipv6RoutingTableEntry(route), metric);
     }
 }
 
@@ -225,8 +223,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
         Ipv6RoutingTableEntry::CreateNetworkRouteTo(network, networkPrefix, interface);
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AddNetworkRoute(new Ipv6RoutingTableEntry(route), metric);
     }
 }
 
@@ -268,7 +265,7 @@ Ipv6StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     Ipv6Address network = Ipv6Address("ff00::"); /* RFC 3513 */
     Ipv6Prefix networkMask = Ipv6Prefix(8);
     *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
-    m_networkRoutes.emplace_back(route, 0);
+    AddNetworkRoute(route, 0);
 }
 
 uint32_t
@@ -379,12 +376,32 @@ Ipv6StaticRouting::LookupRoute(const Ipv6RoutingTableEntry& route, uint32_t metr
     return false;
 }
 
+void
+Ipv6StaticRouting::AddNetworkRoute(Ipv6RoutingTableEntry* route, uint32_t metric)
+{
+    NS_LOG_FUNCTION(this << route << metric);
+    m_networkRoutes.emplace_back(route, metric);
+    m_networkRouteIndex.Insert(route->GetDestNetwork(),
+                               route->GetDestNetworkPrefix(),
+                               m_networkRoutes.back());
+}
+
+Ipv6StaticRouting::NetworkRoutesI
+Ipv6StaticRouting::RemoveNetworkRoute(NetworkRoutesI route)
+{
+    NS_LOG_FUNCTION(this << route->first);
+    m_networkRouteIndex.Remove(route->first->GetDestNetwork(),
+                               route->first->GetDestNetworkPrefix(),
+                               *route);
+    delete route->first;
+    return m_networkRoutes.erase(route);
+}
+
 Ptr<Ipv6Route>
 Ipv6StaticRouting::LookupStatic(Ipv6Address dst, Ptr<NetDevice> interface)
 {
     NS_LOG_FUNCTION(this << dst << interface);
     Ptr<Ipv6Route> rtentry = nullptr;
-    uint16_t longestMask = 0;
     uint32_t shortestMetric = 0xffffffff;
 
     /* when sending on link-local multicast, there have to be interface specified */
@@ -402,70 +419,59 @@ Ipv6StaticRouting::LookupStatic(Ipv6Address dst, Ptr<NetDevice> interface)
         return rtentry;
     }
 
-    for (auto it = m_networkRoutes.begin(); it != m_networkRoutes.end(); it++)
-    {
-        Ipv6RoutingTableEntry* j = it->first;
-        uint32_t metric = it->second;
-        Ipv6Prefix mask = j->GetDestNetworkPrefix();
-        uint16_t maskLen = mask.GetPrefixLength();
-        Ipv6Address entry = j->GetDestNetwork();
-
-        NS_LOG_LOGIC("Searching for route to " << dst << ", mask length " << maskLen << ", metric "
-                                               << metric);
-
-        if (mask.IsMatch(dst, entry))
-        {
-            NS_LOG_LOGIC("Found global network route " << *j << ", mask length " << maskLen
-                                                       << ", metric " << metric);
-
-            /* if interface is given, check the route will output on this interface */
-            if (!interface || interface == m_ipv6->GetNetDevice(j->GetInterface()))
+    // the routes with the longest matching prefix win, and among them the
+    // last one with the smallest metric, or the first one for a host route
+    Ipv6RoutingTableEntry* route = nullptr;
+    m_networkRouteIndex.ForEachMatch(
+        NetworkRouteIndex::GetKey(dst),
+        [&](uint8_t maskLen, const NetworkRouteIndex::Bucket& routes) {
+            for (const auto& it : routes)
             {
-                if (maskLen < longestMask)
-                {
-                    NS_LOG_LOGIC("Previous match longer, skipping");
-                    continue;
-                }
+                Ipv6RoutingTableEntry* j = it.route.first;
+                uint32_t metric = it.route.second;
+                NS_LOG_LOGIC("Found global network route " << *j << ", mask length " << +maskLen
+                                                           << ", metric " << metric);
 
-                if (maskLen > longestMask)
+                /* if interface is given, check the route will output on this interface */
+                if (!interface || interface == m_ipv6->GetNetDevice(j->GetInterface()))
                 {
-                    shortestMetric = 0xffffffff;
-                }
+                    if (metric > shortestMetric)
+                    {
+                        NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
+                        continue;
+                    }
 
-                longestMask = maskLen;
-                if (metric > shortestMetric)
-                {
-                    NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
-                    continue;
+                    shortestMetric = metric;
+                    route = j;
+                    if (maskLen == 128)
+                    {
+                        break;
+                    }
                 }
+            }
+            return route != nullptr;
+        });
 
-                shortestMetric = metric;
-                Ipv6RoutingTableEntry* route = j;
-                uint32_t interfaceIdx = route->GetInterface();
-                rtentry = Create<Ipv6Route>();
-
-                if (route->GetGateway().IsAny() || !route->GetDest().IsAny())
-                {
-                    rtentry->SetSource(
-                        m_ipv6->SourceAddressSelection(interfaceIdx, route->GetDest()));
-                }
-                else
-                {
-                    // Default route
-                    rtentry->SetSource(m_ipv6->SourceAddressSelection(
-                        interfaceIdx,
-                        route->GetPrefixToUse().IsAny() ? dst : route->GetPrefixToUse()));
-                }
+    if (route)
+    {
+        uint32_t interfaceIdx = route->GetInterface();
+        rtentry = Create<Ipv6Route>();
 
-                rtentry->SetDestination(route->GetDest());
-                rtentry->SetGateway(route->GetGateway());
-                rtentry->SetOutputDevice(m_ipv6->GetNetDevice(interfaceIdx));
-                if (maskLen == 128)
-                {
-                    break;
-                }
-            }
+        if (route->GetGateway().IsAny() || !route->GetDest().IsAny())
+        {
+            rtentry->SetSource(m_ipv6->SourceAddressSelection(interfaceIdx, route->GetDest()));
         }
+        else
+        {
+            // Default route
+            rtentry->SetSource(m_ipv6->SourceAddressSelection(
+                interfaceIdx,
+                route->GetPrefixToUse().IsAny() ? dst : route->GetPrefixToUse()));
+        }
+
+        rtentry->SetDestination(route->GetDest());
+        rtentry->SetGateway(route->GetGateway());
+        rtentry->SetOutputDevice(m_ipv6->GetNetDevice(interfaceIdx));
     }
 
     if (rtentry)
@@ -486,6 +492,7 @@ Ipv6StaticRouting::DoDispose()
         delete j->first;
     }
     m_networkRoutes.clear();
+    m_networkRouteIndex.Clear();
 
     for (auto i = m_multicastRoutes.begin(); i != m_multicastRoutes.end();
          i = m_multicastRoutes.erase(i))
@@ -643,8 +650,7 @@ Ipv6StaticRouting::RemoveRoute(uint32_t index)
     {
         if (tmp == index)
         {
-            delete it->first;
-            m_networkRoutes.erase(it);
+            RemoveNetworkRoute(it);
             return;
         }
         tmp++;
@@ -666,8 +672,7 @@ Ipv6StaticRouting::RemoveRoute(Ipv6Address network,
         if (network == rtentry->GetDest() && rtentry->GetInterface() == ifIndex &&
             rtentry->GetPrefixToUse() == prefixToUse)
         {
-            delete it->first;
-            m_networkRoutes.erase(it);
+            RemoveNetworkRoute(it);
             return;
         }
     }
@@ -808,8 +813,7 @@ Ipv6StaticRouting::NotifyInterfaceDown(uint32_t i)
     {
         if (it->first->GetInterface() == i)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = RemoveNetworkRoute(it);
         }
         else
         {
@@ -846,8 +850,7 @@ Ipv6StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv6InterfaceAddress
             it->first->GetDestNetwork() == networkAddress &&
             it->first->GetDestNetworkPrefix() == networkMask)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = RemoveNetworkRoute(it);
         }
         else
         {
@@ -904,8 +907,7 @@ Ipv6StaticRouting::NotifyRemoveRoute(Ipv6Address dst,
 
             if (dst == entry && prefix == mask && rtentry->GetInterface() == interface)
             {
-                delete j->first;
-                j = m_networkRoutes.erase(j);
+                j = RemoveNetworkRoute(j);
             }
             else
             {
@@ -23,6 +23,7 @@
 #include "ipv6-header.h"
 #include "ipv6-routing-protocol.h"
 #include "ipv6.h"
+#include "route-prefix-index.h"
 
 #include "ns3/ipv6-address.h"
 #include "ns3/ptr.h"
@@ -297,6 +298,9 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
     /// Iterator for container for the network routes
     typedef std::list<std::pair<Ipv6RoutingTableEntry*, uint32_t>>::iterator NetworkRoutesI;
 
+    /// Index of the network routes, for the lookups
+    typedef Ipv6RoutePrefixIndex<std::pair<Ipv6RoutingTableEntry*, uint32_t>> NetworkRouteIndex;
+
     /// Container for the multicast routes
     typedef std::list<Ipv6MulticastRoutingTableEntry*> MulticastRoutes;
 
@@ -314,6 +318,20 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
      */
     bool LookupRoute(const Ipv6RoutingTableEntry& route, uint32_t metric);
 
+    /**
+     * \brief Add a route at the end of the forwarding table for network.
+     * \param route route, owned by the forwarding table
+     * \param metric metric of route
+     */
+    void AddNetworkRoute(Ipv6RoutingTableEntry* route, uint32_t metric);
+
+    /**
+     * \brief Remove and delete a route of the forwarding table for network.
+     * \param route the route to remove
+     * \return the route following the removed route
+     */
+    NetworkRoutesI RemoveNetworkRoute(NetworkRoutesI route);
+
     /**
      * \brief Lookup in the forwarding table for destination.
      * \param dest destination address
@@ -336,6 +354,11 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * \brief the index of the forwarding table for network, by prefix.
+     */
+    NetworkRouteIndex m_networkRouteIndex;
+
     /**
      * \brief the forwarding table for multicast.
      */
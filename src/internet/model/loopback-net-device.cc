@@ -19,6 +19,7 @@
 #include "loopback-net-device.h"
 
 #include "ns3/channel.h"
+#include "ns3/checkpoint.h"
 #include "ns3/log.h"
 #include "ns3/node.h"
 #include "ns3/packet.h"
@@ -30,6 +31,7 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("LoopbackNetDevice");
 
 NS_OBJECT_ENSURE_REGISTERED(LoopbackNetDevice);
+NS_CHECKPOINT_STATELESS(LoopbackNetDevice);
 
 TypeId
 LoopbackNetDevice::GetTypeId()
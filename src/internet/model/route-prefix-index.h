@@ -0,0 +1,389 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ROUTE_PREFIX_INDEX_H
+#define ROUTE_PREFIX_INDEX_H
+
+#include "ns3/assert.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv6-address.h"
+
+#include <array>
+#include <cstring>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup ipv4Routing
+ * \ingroup ipv6Routing
+ *
+ * \brief Longest prefix match index of the routes of a routing table
+ *
+ * The routes are stored in one hash table per prefix length, keyed by
+ * the network address of the route, so that finding the routes matching
+ * an address costs one hash lookup per prefix length in use (typically
+ * a handful: host routes, the networks of the links, the default route),
+ * instead of a comparison with each route of the table.
+ *
+ * The index does not own the routes: it is maintained alongside the list
+ * of routes of the routing protocol, which keeps defining the order of
+ * the routes.  The routes with the same prefix are kept in the order of
+ * their insertion, and each route is numbered in the order of its
+ * insertion, so that the routing protocols can reproduce the tie-breaking
+ * of a walk over their list of routes, whose routes are always appended.
+ *
+ * \tparam N the number of bytes of the addresses, 4 for IPv4 and 16 for IPv6.
+ * \tparam T the type of the routes, e.g., a pointer to a routing table entry.
+ */
+template <std::size_t N, typename T>
+class RoutePrefixIndex
+{
+  public:
+    /// The bytes of an address, in network order
+    using Key = std::array<uint8_t, N>;
+
+    /// A route of the index
+    struct Item
+    {
+        uint64_t order; //!< Insertion number of the route
+        T route;        //!< The route
+    };
+
+    /// The routes of the index with the same prefix, in the order of their insertion
+    using Bucket = std::vector<Item>;
+
+    RoutePrefixIndex();
+
+    /**
+     * \brief Get the key of an IPv4 address
+     * \param address the address
+     * \returns the bytes of the address
+     */
+    static Key GetKey(Ipv4Address address);
+
+    /**
+     * \brief Get the key of an IPv6 address
+     * \param address the address
+     * \returns the bytes of the address
+     */
+    static Key GetKey(Ipv6Address address);
+
+    /**
+     * \brief Add a route at the end of the routes with the same prefix
+     * \param network the network address of the route (the bits beyond the prefix are ignored)
+     * \param prefixLength the length of the prefix of the route
+     * \param route the route
+     */
+    void Insert(const Key& network, uint8_t prefixLength, T route);
+
+    /**
+     * \brief Remove a route
+     * \param network the network address of the route
+     * \param prefixLength the length of the prefix of the route
+     * \param route the route
+     * \returns true if the route was in the index
+     */
+    bool Remove(const Key& network, uint8_t prefixLength, T route);
+
+    /**
+     * \brief Add an IPv4 route at the end of the routes with the same prefix
+     * \param network the network address of the route
+     * \param mask the network mask of the route
+     * \param route the route
+     */
+    void Insert(Ipv4Address network, Ipv4Mask mask, T route);
+
+    /**
+     * \brief Remove an IPv4 route
+     * \param network the network address of the route
+     * \param mask the network mask of the route
+     * \param route the route
+     * \returns true if the route was in the index
+     */
+    bool Remove(Ipv4Address network, Ipv4Mask mask, T route);
+
+    /**
+     * \brief Add an IPv6 route at the end of the routes with the same prefix
+     * \param network the network address of the route
+     * \param prefix the network prefix of the route
+     * \param route the route
+     */
+    void Insert(Ipv6Address network, Ipv6Prefix prefix, T route);
+
+    /**
+     * \brief Remove an IPv6 route
+     * \param network the network address of the route
+     * \param prefix the network prefix of the route
+     * \param route the route
+     * \returns true if the route was in the index
+     */
+    bool Remove(Ipv6Address network, Ipv6Prefix prefix, T route);
+
+    /// Remove all the routes
+    void Clear();
+
+    /**
+     * \returns the number of routes in the index
+     */
+    std::size_t GetSize() const;
+
+    /**
+     * \brief Find the routes with a given prefix
+     * \param address an address of the prefix (the bits beyond the prefix are ignored)
+     * \param prefixLength the length of the prefix
+     * \returns the routes with this prefix, or nullptr if none
+     */
+    const Bucket* Find(const Key& address, uint8_t prefixLength) const;
+
+    /**
+     * \brief Visit the routes matching an address, the longest prefixes first
+     *
+     * The visitor is called with the length of the prefix and the non-empty
+     * Bucket of the routes of each matching prefix, and returns true to stop
+     * the visit.
+     *
+     * \tparam F the type of the visitor
+     * \param address the address
+     * \param visitor the visitor
+     */
+    template <typename F>
+    void ForEachMatch(const Key& address, F visitor) const;
+
+  private:
+    /// Hash of the keys
+    struct KeyHash
+    {
+        /**
+         * \param key the key
+         * \returns the hash of the key
+         */
+        std::size_t operator()(const Key& key) const
+        {
+            uint64_t hash = 14695981039346656037ULL;
+            for (uint8_t byte : key)
+            {
+                hash = (hash ^ byte) * 1099511628211ULL;
+            }
+            return hash;
+        }
+    };
+
+    /// The routes of a prefix length, indexed by the network address
+    using Table = std::unordered_map<Key, Bucket, KeyHash>;
+
+    /**
+     * \param address an address
+     * \param prefixLength the length of a prefix
+     * \returns the network address of the prefix of the address
+     */
+    static Key Mask(const Key& address, uint8_t prefixLength);
+
+    std::array<Table, N * 8 + 1> m_tables;        //!< The routes, per prefix length
+    std::array<std::size_t, N * 8 + 1> m_nRoutes; //!< Number of routes, per prefix length
+    std::vector<uint8_t> m_lengths;               //!< The prefix lengths in use, the longest first
+    uint64_t m_order;                             //!< Insertion number of the next route
+    std::size_t m_size;                           //!< Number of routes
+};
+
+/// Index of the routes of an IPv4 routing table
+template <typename T>
+using Ipv4RoutePrefixIndex = RoutePrefixIndex<4, T>;
+
+/// Index of the routes of an IPv6 routing table
+template <typename T>
+using Ipv6RoutePrefixIndex = RoutePrefixIndex<16, T>;
+
+template <std::size_t N, typename T>
+RoutePrefixIndex<N, T>::RoutePrefixIndex()
+    : m_nRoutes{},
+      m_order(0),
+      m_size(0)
+{
+}
+
+template <std::size_t N, typename T>
+typename RoutePrefixIndex<N, T>::Key
+RoutePrefixIndex<N, T>::GetKey(Ipv4Address address)
+{
+    static_assert(N == 4, "Not an index of IPv4 routes");
+    Key key;
+    address.Serialize(key.data());
+    return key;
+}
+
+template <std::size_t N, typename T>
+typename RoutePrefixIndex<N, T>::Key
+RoutePrefixIndex<N, T>::GetKey(Ipv6Address address)
+{
+    static_assert(N == 16, "Not an index of IPv6 routes");
+    Key key;
+    address.GetBytes(key.data());
+    return key;
+}
+
+template <std::size_t N, typename T>
+typename RoutePrefixIndex<N, T>::Key
+RoutePrefixIndex<N, T>::Mask(const Key& address, uint8_t prefixLength)
+{
+    Key network{};
+    std::size_t bytes = prefixLength / 8;
+    std::memcpy(network.data(), address.data(), bytes);
+    if (prefixLength % 8)
+    {
+        network[bytes] = address[bytes] & (0xff << (8 - prefixLength % 8));
+    }
+    return network;
+}
+
+template <std::size_t N, typename T>
+void
+RoutePrefixIndex<N, T>::Insert(const Key& network, uint8_t prefixLength, T route)
+{
+    NS_ASSERT_MSG(prefixLength <= N * 8, "Bad prefix length " << +prefixLength);
+    m_tables[prefixLength][Mask(network, prefixLength)].push_back({m_order++, route});
+    if (m_nRoutes[prefixLength]++ == 0)
+    {
+        auto it = m_lengths.begin();
+        while (it != m_lengths.end() && *it > prefixLength)
+        {
+            it++;
+        }
+        m_lengths.insert(it, prefixLength);
+    }
+    m_size++;
+}
+
+template <std::size_t N, typename T>
+bool
+RoutePrefixIndex<N, T>::Remove(const Key& network, uint8_t prefixLength, T route)
+{
+    NS_ASSERT_MSG(prefixLength <= N * 8, "Bad prefix length " << +prefixLength);
+    Table& table = m_tables[prefixLength];
+    auto bucket = table.find(Mask(network, prefixLength));
+    if (bucket == table.end())
+    {
+        return false;
+    }
+    for (auto it = bucket->second.begin(); it != bucket->second.end(); it++)
+    {
+        if (it->route == route)
+        {
+            bucket->second.erase(it);
+            if (bucket->second.empty())
+            {
+                table.erase(bucket);
+            }
+            if (--m_nRoutes[prefixLength] == 0)
+            {
+                for (auto length = m_lengths.begin(); length != m_lengths.end(); length++)
+                {
+                    if (*length == prefixLength)
+                    {
+                        m_lengths.erase(length);
+                        break;
+                    }
+                }
+            }
+            m_size--;
+            return true;
+        }
+    }
+    return false;
+}
+
+template <std::size_t N, typename T>
+void
+RoutePrefixIndex<N, T>::Insert(Ipv4Address network, Ipv4Mask mask, T route)
+{
+    Insert(GetKey(network), mask.GetPrefixLength(), route);
+}
+
+template <std::size_t N, typename T>
+bool
+RoutePrefixIndex<N, T>::Remove(Ipv4Address network, Ipv4Mask mask, T route)
+{
+    return Remove(GetKey(network), mask.GetPrefixLength(), route);
+}
+
+template <std::size_t N, typename T>
+void
+RoutePrefixIndex<N, T>::Insert(Ipv6Address network, Ipv6Prefix prefix, T route)
+{
+    Insert(GetKey(network), prefix.GetPrefixLength(), route);
+}
+
+template <std::size_t N, typename T>
+bool
+RoutePrefixIndex<N, T>::Remove(Ipv6Address network, Ipv6Prefix prefix, T route)
+{
+    return Remove(GetKey(network), prefix.GetPrefixLength(), route);
+}
+
+template <std::size_t N, typename T>
+void
+RoutePrefixIndex<N, T>::Clear()
+{
+    for (uint8_t length : m_lengths)
+    {
+        m_tables[length].clear();
+        m_nRoutes[length] = 0;
+    }
+    m_lengths.clear();
+    m_size = 0;
+}
+
+template <std::size_t N, typename T>
+std::size_t
+RoutePrefixIndex<N, T>::GetSize() const
+{
+    return m_size;
+}
+
+template <std::size_t N, typename T>
+const typename RoutePrefixIndex<N, T>::Bucket*
+RoutePrefixIndex<N, T>::Find(const Key& address, uint8_t prefixLength) const
+{
+    NS_ASSERT_MSG(prefixLength <= N * 8, "Bad prefix length " << +prefixLength);
+    const Table& table = m_tables[prefixLength];
+    if (table.empty())
+    {
+        return nullptr;
+    }
+    auto bucket = table.find(Mask(address, prefixLength));
+    return bucket == table.end() ? nullptr : &bucket->second;
+}
+
+template <std::size_t N, typename T>
+template <typename F>
+void
+RoutePrefixIndex<N, T>::ForEachMatch(const Key& address, F visitor) const
+{
+    for (uint8_t length : m_lengths)
+    {
+        auto bucket = m_tables[length].find(Mask(address, length));
+        if (bucket != m_tables[length].end() && visitor(length, bucket->second))
+        {
+            return;
+        }
+    }
+}
+
+} // namespace ns3
+
+#endif /* ROUTE_PREFIX_INDEX_H */
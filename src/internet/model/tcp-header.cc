@@ -285,14 +285,15 @@ void
 TcpHeader::Serialize(Buffer::Iterator start) const
 {
     Buffer::Iterator i = start;
-    i.WriteHtonU16(m_sourcePort);
-    i.WriteHtonU16(m_destinationPort);
-    i.WriteHtonU32(m_sequenceNumber.GetValue());
-    i.WriteHtonU32(m_ackNumber.GetValue());
-    i.WriteHtonU16(GetLength() << 12 | m_flags); // reserved bits are all zero
-    i.WriteHtonU16(m_windowSize);
-    i.WriteHtonU16(0);
-    i.WriteHtonU16(m_urgentPointer);
+    uint8_t* buffer = i.WriteSpan(20);
+    WriteHtonU16(buffer, m_sourcePort);
+    WriteHtonU16(buffer + 2, m_destinationPort);
+    WriteHtonU32(buffer + 4, m_sequenceNumber.GetValue());
+    WriteHtonU32(buffer + 8, m_ackNumber.GetValue());
+    WriteHtonU16(buffer + 12, GetLength() << 12 | m_flags); // reserved bits are all zero
+    WriteHtonU16(buffer + 14, m_windowSize);
+    WriteHtonU16(buffer + 16, 0);
+    WriteHtonU16(buffer + 18, m_urgentPointer);
 
     // Serialize options if they exist
     // This implementation does not presently try to align options on word
@@ -319,10 +320,7 @@ TcpHeader::Serialize(Buffer::Iterator start) const
         uint16_t headerChecksum = CalculateHeaderChecksum(start.GetSize());
         i = start;
         uint16_t checksum = i.CalculateIpChecksum(start.GetSize(), headerChecksum);
-
-        i = start;
-        i.Next(16);
-        i.WriteU16(checksum);
+        WriteHtolsbU16(buffer + 16, checksum);
     }
 }
 
@@ -331,16 +329,17 @@ TcpHeader::Deserialize(Buffer::Iterator start)
 {
     m_optionsLen = 0;
     Buffer::Iterator i = start;
-    m_sourcePort = i.ReadNtohU16();
-    m_destinationPort = i.ReadNtohU16();
-    m_sequenceNumber = i.ReadNtohU32();
-    m_ackNumber = i.ReadNtohU32();
-    uint16_t field = i.ReadNtohU16();
+    uint8_t scratch[20];
+    const uint8_t* buffer = i.ReadSpan(20, scratch);
+    m_sourcePort = ReadNtohU16(buffer);
+    m_destinationPort = ReadNtohU16(buffer + 2);
+    m_sequenceNumber = ReadNtohU32(buffer + 4);
+    m_ackNumber = ReadNtohU32(buffer + 8);
+    uint16_t field = ReadNtohU16(buffer + 12);
     m_flags = field & 0xFF;
     m_length = field >> 12;
-    m_windowSize = i.ReadNtohU16();
-    i.Next(2);
-    m_urgentPointer = i.ReadNtohU16();
+    m_windowSize = ReadNtohU16(buffer + 14);
+    m_urgentPointer = ReadNtohU16(buffer + 18);
 
     // Deserialize options if they exist
     m_options.clear();
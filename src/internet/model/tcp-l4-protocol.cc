@@ -804,4 +804,23 @@ TcpL4Protocol::GetDownTarget6() const
     return m_downTarget6;
 }
 
+void
+TcpL4Protocol::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(m_socketIndex != 0, "Cannot save the TCP sockets: not supported");
+    writer.Write("ephemeral", m_endPoints->GetEphemeralPort());
+    writer.Write("ephemeral6", m_endPoints6->GetEphemeralPort());
+}
+
+void
+TcpL4Protocol::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(m_socketIndex != 0,
+                    "Cannot restore " << reader.GetPath() << ": TCP sockets are not supported");
+    m_endPoints->SetEphemeralPort(reader.Read<uint16_t>("ephemeral"));
+    m_endPoints6->SetEphemeralPort(reader.Read<uint16_t>("ephemeral6"));
+}
+
 } // namespace ns3
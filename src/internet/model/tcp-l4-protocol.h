@@ -22,6 +22,7 @@
 
 #include "ip-l4-protocol.h"
 
+#include "ns3/checkpoint.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/ipv6-address.h"
 #include "ns3/sequence-number.h"
@@ -72,12 +73,15 @@ class NetDevice;
  * and SHOULD checksum packets its receives from the socket layer going down
  * the stack, but currently checksumming is disabled.
  *
+ * The TCP sockets cannot be saved to a checkpoint yet: a checkpoint
+ * can only be saved before the first TCP socket is created.
+ *
  * \see CreateSocket
  * \see NotifyNewAggregate
  * \see SendPacket
  */
 
-class TcpL4Protocol : public IpL4Protocol
+class TcpL4Protocol : public IpL4Protocol, public Checkpointable
 {
   public:
     /**
@@ -288,6 +292,20 @@ class TcpL4Protocol : public IpL4Protocol
     IpL4Protocol::DownTargetCallback GetDownTarget() const override;
     IpL4Protocol::DownTargetCallback6 GetDownTarget6() const override;
 
+    /**
+     * \brief Save the ephemeral ports.
+     *
+     * Aborts if a socket has been created.
+     *
+     * \param writer the checkpoint writer
+     */
+    void SaveState(CheckpointWriter& writer) const override;
+    /**
+     * \brief Restore the ephemeral ports.
+     * \param reader the checkpoint reader
+     */
+    void RestoreState(CheckpointReader& reader) override;
+
   protected:
     void DoDispose() override;
 
@@ -57,6 +57,7 @@
 #include "ns3/object.h"
 #include "ns3/packet.h"
 #include "ns3/pointer.h"
+#include "ns3/segment-offload-tag.h"
 #include "ns3/simulation-singleton.h"
 #include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
@@ -161,6 +162,13 @@ TcpSocketBase::GetTypeId()
                           BooleanValue(true),
                           MakeBooleanAccessor(&TcpSocketBase::m_limitedTx),
                           MakeBooleanChecker())
+            .AddAttribute("OffloadSegments",
+                          "Maximum number of full segments of new data sent at once, in a "
+                          "super-segment segmented by the device (TCP segmentation offload). "
+                          "A value of 1 disables the segmentation offload",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&TcpSocketBase::m_offloadSegments),
+                          MakeUintegerChecker<uint16_t>(1))
             .AddAttribute("UseEcn",
                           "Parameter to set ECN functionality",
                           EnumValue(TcpSocketState::Off),
@@ -368,6 +376,7 @@ TcpSocketBase::TcpSocketBase(const TcpSocketBase& sock)
       m_recoverActive(sock.m_recoverActive),
       m_retxThresh(sock.m_retxThresh),
       m_limitedTx(sock.m_limitedTx),
+      m_offloadSegments(sock.m_offloadSegments),
       m_isFirstPartialAck(sock.m_isFirstPartialAck),
       m_txTrace(sock.m_txTrace),
       m_rxTrace(sock.m_rxTrace),
@@ -3203,6 +3212,15 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
     header.SetWindowSize(AdvertisedWindowSize());
     AddOptions(header);
 
+    if (sz > m_tcb->m_segmentSize)
+    {
+        // A super-segment of the segmentation offload: each of its segments
+        // will carry a copy of the TCP and IP headers on the wire
+        uint16_t segments = (sz + m_tcb->m_segmentSize - 1) / m_tcb->m_segmentSize;
+        uint16_t ipHeaderSize = m_endPoint ? 20 : 40;
+        p->AddPacketTag(SegmentOffloadTag(segments, header.GetSerializedSize() + ipHeaderSize));
+    }
+
     if (m_retxEvent.IsExpired())
     {
         // Schedules retransmit timeout. m_rto should be already doubled.
@@ -3378,6 +3396,22 @@ TcpSocketBase::SendPendingData(bool withAck)
             auto maxSizeToSend = static_cast<uint32_t>(nextHigh - next);
             s = std::min(s, maxSizeToSend);
 
+            // Segmentation offload: send the full segments of new data allowed
+            // by the windows at once, in a super-segment that fits in an IP packet
+            if (m_offloadSegments > 1 && s == m_tcb->m_segmentSize &&
+                next == m_tcb->m_highTxMark && !IsPacingEnabled())
+            {
+                uint32_t unAcked = UnAckDataCount();
+                uint32_t rWnd = m_rWnd.Get() > unAcked ? m_rWnd.Get() - unAcked : 0;
+                // Room for the largest IP and TCP headers in an IP packet of 64 KiB
+                uint32_t maxSize = 0xffff - 60 - 60;
+                uint32_t segments = std::min({static_cast<uint32_t>(m_offloadSegments),
+                                              availableWindow / m_tcb->m_segmentSize,
+                                              rWnd / m_tcb->m_segmentSize,
+                                              maxSize / m_tcb->m_segmentSize});
+                s = std::max(segments, 1U) * m_tcb->m_segmentSize;
+            }
+
             // (C.2) If any of the data octets sent in (C.1) are below HighData,
             //       HighRxt MUST be set to the highest sequence number of the
             //       retransmitted segment unless NextSeg () rule (4) was
@@ -3587,7 +3621,14 @@ TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
     }
     else
     { // In-sequence packet: ACK if delayed ack count allows
-        if (++m_delAckCount >= m_delAckMaxCount)
+        uint32_t segments = 1;
+        if (m_offloadSegments > 1)
+        {
+            // A super-segment counts as the segments it coalesces
+            segments = (p->GetSize() + m_tcb->m_segmentSize - 1) / m_tcb->m_segmentSize;
+        }
+        m_delAckCount += segments;
+        if (m_delAckCount >= m_delAckMaxCount)
         {
             m_delAckEvent.Cancel();
             m_delAckCount = 0;
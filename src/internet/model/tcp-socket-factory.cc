@@ -18,6 +18,7 @@
  */
 #include "tcp-socket-factory.h"
 
+#include "ns3/checkpoint.h"
 #include "ns3/double.h"
 #include "ns3/uinteger.h"
 
@@ -25,6 +26,7 @@ namespace ns3
 {
 
 NS_OBJECT_ENSURE_REGISTERED(TcpSocketFactory);
+NS_CHECKPOINT_STATELESS(TcpSocketFactory);
 
 TypeId
 TcpSocketFactory::GetTypeId()
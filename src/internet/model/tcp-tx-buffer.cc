@@ -61,7 +61,8 @@ TcpTxBuffer::TcpTxBuffer(uint32_t n)
     : m_maxBuffer(32768),
       m_size(0),
       m_sentSize(0),
-      m_firstByteSeq(n)
+      m_firstByteSeq(n),
+      m_lostUpTo(n)
 {
     m_rWndCallback = MakeNullCallback<uint32_t>();
 }
@@ -175,6 +176,7 @@ TcpTxBuffer::SetHeadSequence(const SequenceNumber32& seq)
     // if you change the head with data already sent, something bad will happen
     NS_ASSERT(m_sentList.empty());
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    m_lostUpTo = seq;
 }
 
 bool
@@ -295,7 +297,7 @@ TcpTxBuffer::GetNewSegment(uint32_t numBytes)
     NS_ASSERT(it != m_appList.end());
 
     m_appList.erase(it);
-    m_sentList.insert(m_sentList.end(), item);
+    IndexItem(m_sentList, m_sentList.insert(m_sentList.end(), item));
     m_sentSize += item->m_packet->GetSize();
 
     return item;
@@ -309,37 +311,34 @@ TcpTxBuffer::GetTransmittedSegment(uint32_t numBytes, const SequenceNumber32& se
     NS_ASSERT(numBytes <= m_sentSize);
     NS_ASSERT(!m_sentList.empty());
 
-    auto it = m_sentList.begin();
+    auto index = m_sentIndex.find(seq);
     bool listEdited = false;
     uint32_t s = numBytes;
 
     // Avoid to merge different packet for this retransmission if flags are
     // different.
-    for (; it != m_sentList.end(); ++it)
+    if (index != m_sentIndex.end())
     {
-        if ((*it)->m_startSeq == seq)
+        auto it = index->second;
+        auto next = it;
+        next++;
+        if (next != m_sentList.end())
         {
-            auto next = it;
-            next++;
-            if (next != m_sentList.end())
+            // Next is not sacked and have the same value for m_lost ... there is the
+            // possibility to merge
+            if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
             {
-                // Next is not sacked and have the same value for m_lost ... there is the
-                // possibility to merge
-                if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
-                {
-                    s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
-                }
-                else
-                {
-                    // Next is sacked... better to retransmit only the first segment
-                    s = std::min(s, (*it)->m_packet->GetSize());
-                }
+                s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
             }
             else
             {
+                // Next is sacked... better to retransmit only the first segment
                 s = std::min(s, (*it)->m_packet->GetSize());
             }
-            break;
+        }
+        else
+        {
+            s = std::min(s, (*it)->m_packet->GetSize());
         }
     }
 
@@ -396,6 +395,26 @@ TcpTxBuffer::SplitItems(TcpTxItem* t1, TcpTxItem* t2, uint32_t size) const
     NS_LOG_INFO("Split of size " << size << " result: t1 " << *t1 << " t2 " << *t2);
 }
 
+void
+TcpTxBuffer::IndexItem(const PacketList& list, PacketList::iterator it) const
+{
+    if (&list == &m_sentList)
+    {
+        auto self = const_cast<TcpTxBuffer*>(this);
+        self->m_sentIndex[(*it)->m_startSeq] = it;
+    }
+}
+
+void
+TcpTxBuffer::UnindexItem(const PacketList& list, const TcpTxItem* item) const
+{
+    if (&list == &m_sentList)
+    {
+        auto self = const_cast<TcpTxBuffer*>(this);
+        self->m_sentIndex.erase(item->m_startSeq);
+    }
+}
+
 TcpTxItem*
 TcpTxBuffer::GetPacketFromList(PacketList& list,
                                const SequenceNumber32& listStartFrom,
@@ -438,11 +457,22 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
     auto it = list.begin();
     SequenceNumber32 beginOfCurrentPacket = listStartFrom;
 
+    if (&list == &m_sentList && seq > listStartFrom)
+    {
+        // Skip the sent items which end before seq
+        auto index = m_sentIndex.upper_bound(seq);
+        if (index != m_sentIndex.begin())
+        {
+            it = (--index)->second;
+            beginOfCurrentPacket = (*it)->m_startSeq;
+        }
+    }
+
     while (it != list.end())
     {
         currentItem = *it;
         currentPacket = currentItem->m_packet;
-        NS_ASSERT_MSG(list != m_sentList || currentItem->m_startSeq >= m_firstByteSeq,
+        NS_ASSERT_MSG(&list != &m_sentList || currentItem->m_startSeq >= m_firstByteSeq,
                       "start: " << m_firstByteSeq
                                 << " currentItem start: " << currentItem->m_startSeq);
 
@@ -471,7 +501,8 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                 SplitItems(firstPart, currentItem, seq - beginOfCurrentPacket);
 
                 // insert firstPart before currentItem
-                list.insert(it, firstPart);
+                IndexItem(list, list.insert(it, firstPart));
+                IndexItem(list, it);
                 if (listEdited)
                 {
                     *listEdited = true;
@@ -519,6 +550,7 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
 
                     list.erase(it);
 
+                    UnindexItem(list, currentItem);
                     MergeItems(previous, currentItem);
                     delete currentItem;
                     if (listEdited)
@@ -537,7 +569,8 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                 SplitItems(firstPart, currentItem, numBytes);
 
                 // insert firstPart before currentItem
-                list.insert(it, firstPart);
+                IndexItem(list, list.insert(it, firstPart));
+                IndexItem(list, it);
                 if (listEdited)
                 {
                     *listEdited = true;
@@ -566,6 +599,7 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                                      // in the previous if
 
             MergeItems(currentItem, next);
+            UnindexItem(list, next);
             list.erase(it);
 
             delete next;
@@ -650,16 +684,15 @@ bool
 TcpTxBuffer::IsRetransmittedDataAcked(const SequenceNumber32& ack) const
 {
     NS_LOG_FUNCTION(this);
-    for (const auto& it : m_sentList)
+    // Only the item which contains ack - 1 can end at ack
+    auto index = m_sentIndex.lower_bound(ack);
+    if (index == m_sentIndex.begin())
     {
-        TcpTxItem* item = it;
-        Ptr<Packet> p = item->m_packet;
-        if (item->m_startSeq + p->GetSize() == ack && !item->m_sacked && item->m_retrans)
-        {
-            return true;
-        }
+        return false;
     }
-    return false;
+    TcpTxItem* item = *(--index)->second;
+    Ptr<Packet> p = item->m_packet;
+    return item->m_startSeq + p->GetSize() == ack && !item->m_sacked && item->m_retrans;
 }
 
 void
@@ -707,6 +740,7 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
 
             RemoveFromCounts(item, pktSize);
 
+            UnindexItem(m_sentList, item);
             i = m_sentList.erase(i);
             NS_LOG_INFO("Removed " << *item << " lost: " << m_lostOut << " retrans: " << m_retrans
                                    << " sacked: " << m_sackedOut << ". Remaining data " << m_size);
@@ -725,7 +759,9 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
             NS_LOG_INFO(*item);
             // PacketTags are preserved when fragmenting
             item->m_packet = item->m_packet->CreateFragment(offset, pktSize);
+            UnindexItem(m_sentList, item);
             item->m_startSeq += offset;
+            IndexItem(m_sentList, i);
             m_size -= offset;
             m_sentSize -= offset;
             m_firstByteSeq += offset;
@@ -755,6 +791,7 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
             // when adding Reno dupacks in the count.
             head->m_sacked = false;
             m_sackedOut -= head->m_packet->GetSize();
+            m_lostUpTo = m_firstByteSeq;
             NS_LOG_INFO("Moving the SACK flag from the HEAD to another segment");
             AddRenoSack();
             MarkHeadAsLost();
@@ -770,6 +807,12 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
         m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
     }
 
+    // Keep the watermark inside the window, the sequence numbers wrap around
+    if (m_lostUpTo < m_firstByteSeq)
+    {
+        m_lostUpTo = m_firstByteSeq;
+    }
+
     NS_LOG_DEBUG("Discarded up to " << seq << " lost: " << m_lostOut << " retrans: " << m_retrans
                                     << " sacked: " << m_sackedOut);
     NS_LOG_LOGIC("Buffer status after discarding data " << *this);
@@ -797,6 +840,21 @@ TcpTxBuffer::Update(const TcpOptionSack::SackList& list, const Callback<void, Tc
             return bytesSacked;
         }
 
+        if (m_firstByteSeq < (*option_it).first)
+        {
+            // The items which start before the block can not be sacked by it
+            auto index = m_sentIndex.lower_bound((*option_it).first);
+            if (index != m_sentIndex.end())
+            {
+                item_it = index->second;
+                beginOfCurrentPacket = index->first;
+            }
+            else
+            {
+                item_it = m_sentList.end();
+            }
+        }
+
         while (item_it != m_sentList.end())
         {
             uint32_t pktSize = (*item_it)->m_packet->GetSize();
@@ -889,9 +947,16 @@ TcpTxBuffer::UpdateLostCount()
                                                  << *(*m_highestSack.first));
     }
 
+    // The items which start before m_lostUpTo are already lost or sacked
+    SequenceNumber32 lostUpTo = m_lostUpTo;
     for (auto it = m_highestSack.first; it != m_sentList.begin(); --it)
     {
         TcpTxItem* item = *it;
+        if (sacked >= m_dupAckThresh && item->m_startSeq < m_lostUpTo)
+        {
+            break;
+        }
+
         if (item->m_sacked)
         {
             sacked++;
@@ -904,6 +969,10 @@ TcpTxBuffer::UpdateLostCount()
                 item->m_lost = true;
                 m_lostOut += item->m_packet->GetSize();
             }
+            if (lostUpTo < item->m_startSeq + item->m_packet->GetSize())
+            {
+                lostUpTo = item->m_startSeq + item->m_packet->GetSize();
+            }
         }
         beginOfCurrentPacket -= item->m_packet->GetSize();
     }
@@ -917,6 +986,7 @@ TcpTxBuffer::UpdateLostCount()
             m_lostOut += item->m_packet->GetSize();
         }
     }
+    m_lostUpTo = lostUpTo;
     NS_LOG_INFO("Status after the update: " << *this);
     ConsistencyCheck();
 }
@@ -931,24 +1001,25 @@ TcpTxBuffer::IsLost(const SequenceNumber32& seq) const
         return false;
     }
 
-    // In theory, using a map and hints when inserting elements can improve
-    // performance
-    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    // Search for the item which contains seq
+    auto index = m_sentIndex.upper_bound(seq);
+    if (index == m_sentIndex.begin())
+    {
+        return false;
+    }
+    TcpTxItem* item = *(--index)->second;
+    if (seq < item->m_startSeq + item->m_packet->GetSize())
     {
-        // Search for the right iterator before calling IsLost()
-        if ((*it)->m_startSeq <= seq && seq < (*it)->m_startSeq + (*it)->m_packet->GetSize())
+        if (item->m_lost)
         {
-            if ((*it)->m_lost)
-            {
-                NS_LOG_INFO("seq=" << seq << " is lost because of lost flag");
-                return true;
-            }
+            NS_LOG_INFO("seq=" << seq << " is lost because of lost flag");
+            return true;
+        }
 
-            if ((*it)->m_sacked)
-            {
-                NS_LOG_INFO("seq=" << seq << " is not lost because of sacked flag");
-                return false;
-            }
+        if (item->m_sacked)
+        {
+            NS_LOG_INFO("seq=" << seq << " is not lost because of sacked flag");
+            return false;
         }
     }
 
@@ -1213,6 +1284,7 @@ TcpTxBuffer::ResetRenoSack()
     }
 
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    m_lostUpTo = m_firstByteSeq;
 }
 
 void
@@ -1237,11 +1309,13 @@ TcpTxBuffer::ResetSentList()
         m_sentList.pop_back();
     }
 
+    m_sentIndex.clear();
     m_sentSize = 0;
     m_lostOut = 0;
     m_retrans = 0;
     m_sackedOut = 0;
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    m_lostUpTo = m_firstByteSeq;
 }
 
 void
@@ -1252,6 +1326,7 @@ TcpTxBuffer::ResetLastSegmentSent()
     {
         TcpTxItem* item = m_sentList.back();
 
+        UnindexItem(m_sentList, item);
         m_sentList.pop_back();
         m_sentSize -= item->m_packet->GetSize();
         if (item->m_retrans)
@@ -1259,6 +1334,12 @@ TcpTxBuffer::ResetLastSegmentSent()
             m_retrans -= item->m_packet->GetSize();
         }
         m_appList.insert(m_appList.begin(), item);
+
+        // The item will be sent again, neither lost nor sacked
+        if (m_firstByteSeq + m_sentSize < m_lostUpTo)
+        {
+            m_lostUpTo = m_firstByteSeq + m_sentSize;
+        }
     }
     ConsistencyCheck();
 }
@@ -1304,6 +1385,7 @@ TcpTxBuffer::SetSentListLost(bool resetSack)
 
         (*it)->m_retrans = false;
     }
+    m_lostUpTo = m_firstByteSeq + m_sentSize;
 
     NS_LOG_INFO("Set sent list lost, status: " << *this);
     NS_ASSERT_MSG(m_sentSize >= m_sackedOut + m_lostOut, *this);
@@ -1426,8 +1508,16 @@ TcpTxBuffer::ConsistencyCheck() const
     uint32_t lost = 0;
     uint32_t retrans = 0;
 
+    NS_ASSERT_MSG(m_sentIndex.size() == m_sentList.size(),
+                  "Indexed items: " << m_sentIndex.size() << " sent items: " << m_sentList.size());
+
     for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
     {
+        auto index = m_sentIndex.find((*it)->m_startSeq);
+        NS_ASSERT_MSG(index != m_sentIndex.end() && index->second == it,
+                      "Item " << **it << " not indexed");
+        NS_ASSERT_MSG((*it)->m_startSeq >= m_lostUpTo || (*it)->m_lost || (*it)->m_sacked,
+                      "Item " << **it << " before " << m_lostUpTo << " neither lost nor sacked");
         if ((*it)->m_sacked)
         {
             sacked += (*it)->m_packet->GetSize();
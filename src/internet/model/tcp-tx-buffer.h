@@ -28,6 +28,8 @@
 #include "ns3/sequence-number.h"
 #include "ns3/traced-value.h"
 
+#include <map>
+
 namespace ns3
 {
 class Packet;
@@ -590,6 +592,22 @@ class TcpTxBuffer : public Object
      */
     void SplitItems(TcpTxItem* t1, TcpTxItem* t2, uint32_t size) const;
 
+    /**
+     * \brief Index an item by its starting sequence, if it is in the sent list
+     *
+     * \param list list of the item
+     * \param it the item
+     */
+    void IndexItem(const PacketList& list, PacketList::iterator it) const;
+
+    /**
+     * \brief Remove an item from the index, if it is in the sent list
+     *
+     * \param list list of the item
+     * \param item the item
+     */
+    void UnindexItem(const PacketList& list, const TcpTxItem* item) const;
+
     /**
      * \brief Check if the values of sacked, lost, retrans, are in sync
      * with the sent list.
@@ -613,6 +631,9 @@ class TcpTxBuffer : public Object
         m_firstByteSeq; //!< Sequence number of the first byte in data (SND.UNA)
     std::pair<PacketList::const_iterator, SequenceNumber32> m_highestSack; //!< Highest SACK byte
 
+    std::map<SequenceNumber32, PacketList::iterator> m_sentIndex; //!< Sent items by sequence
+    SequenceNumber32 m_lostUpTo;                                  //!< Lost or sacked up to here
+
     uint32_t m_lostOut{0};   //!< Number of lost bytes
     uint32_t m_sackedOut{0}; //!< Number of sacked bytes
     uint32_t m_retrans{0};   //!< Number of retransmitted bytes
@@ -165,21 +165,22 @@ void
 UdpHeader::Serialize(Buffer::Iterator start) const
 {
     Buffer::Iterator i = start;
+    uint8_t* buffer = i.WriteSpan(8);
 
-    i.WriteHtonU16(m_sourcePort);
-    i.WriteHtonU16(m_destinationPort);
+    WriteHtonU16(buffer, m_sourcePort);
+    WriteHtonU16(buffer + 2, m_destinationPort);
     if (m_forcedPayloadSize == 0)
     {
-        i.WriteHtonU16(start.GetSize());
+        WriteHtonU16(buffer + 4, start.GetSize());
     }
     else
     {
-        i.WriteHtonU16(m_forcedPayloadSize);
+        WriteHtonU16(buffer + 4, m_forcedPayloadSize);
     }
 
     if (m_checksum == 0)
     {
-        i.WriteU16(0);
+        WriteHtolsbU16(buffer + 6, 0);
 
         if (m_calcChecksum)
         {
@@ -187,20 +188,17 @@ UdpHeader::Serialize(Buffer::Iterator start) const
             i = start;
             uint16_t checksum = i.CalculateIpChecksum(start.GetSize(), headerChecksum);
 
-            i = start;
-            i.Next(6);
-
             // RFC 768: If the computed checksum is zero, it is transmitted as all ones
             if (checksum == 0)
             {
                 checksum = 0xffff;
             }
-            i.WriteU16(checksum);
+            WriteHtolsbU16(buffer + 6, checksum);
         }
     }
     else
     {
-        i.WriteU16(m_checksum);
+        WriteHtolsbU16(buffer + 6, m_checksum);
     }
 }
 
@@ -208,10 +206,12 @@ uint32_t
 UdpHeader::Deserialize(Buffer::Iterator start)
 {
     Buffer::Iterator i = start;
-    m_sourcePort = i.ReadNtohU16();
-    m_destinationPort = i.ReadNtohU16();
-    m_payloadSize = i.ReadNtohU16() - GetSerializedSize();
-    m_checksum = i.ReadU16();
+    uint8_t scratch[8];
+    const uint8_t* buffer = i.ReadSpan(8, scratch);
+    m_sourcePort = ReadNtohU16(buffer);
+    m_destinationPort = ReadNtohU16(buffer + 2);
+    m_payloadSize = ReadNtohU16(buffer + 4) - GetSerializedSize();
+    m_checksum = ReadLsbtohU16(buffer + 6);
 
     // RFC 768: An all zero transmitted checksum value means that the
     // transmitter generated  no checksum (for debugging or for higher
@@ -38,6 +38,9 @@
 #include "ns3/object-map.h"
 #include "ns3/packet.h"
 
+#include <list>
+#include <map>
+#include <sstream>
 #include <unordered_map>
 
 namespace ns3
@@ -548,6 +551,105 @@ UdpL4Protocol::GetDownTarget6() const
     return m_downTarget6;
 }
 
+namespace
+{
+
+/**
+ * \ingroup udp
+ * Get the local address of a socket, as a string.
+ *
+ * The string does not depend on the type of the Address, which is
+ * allocated at run time.
+ *
+ * \param [in] socket The socket.
+ * \returns The local address and port.
+ */
+std::string
+GetSocketName(Ptr<UdpSocketImpl> socket)
+{
+    Address address;
+    socket->GetSockName(address);
+    std::ostringstream oss;
+    if (Inet6SocketAddress::IsMatchingType(address))
+    {
+        Inet6SocketAddress inet6 = Inet6SocketAddress::ConvertFrom(address);
+        oss << inet6.GetIpv6() << " " << inet6.GetPort();
+    }
+    else
+    {
+        InetSocketAddress inet = InetSocketAddress::ConvertFrom(address);
+        oss << inet.GetIpv4() << " " << inet.GetPort();
+    }
+    return oss.str();
+}
+
+} // unnamed namespace
+
+void
+UdpL4Protocol::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    writer.Write("ephemeral", m_endPoints->GetEphemeralPort());
+    writer.Write("ephemeral6", m_endPoints6->GetEphemeralPort());
+    writer.Write("socketIndex", m_socketIndex);
+    std::map<uint64_t, Ptr<UdpSocketImpl>> sockets(m_sockets.begin(), m_sockets.end());
+    uint32_t n = 0;
+    for (const auto& [id, socket] : sockets)
+    {
+        std::string key = "socket." + std::to_string(n++);
+        writer.Write(key + ".id", id);
+        writer.Write(key + ".local", GetSocketName(socket));
+    }
+    writer.Write("sockets", n);
+}
+
+void
+UdpL4Protocol::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    m_endPoints->SetEphemeralPort(reader.Read<uint16_t>("ephemeral"));
+    m_endPoints6->SetEphemeralPort(reader.Read<uint16_t>("ephemeral6"));
+
+    // The saved identifiers, by local address, in order
+    std::map<std::string, std::list<uint64_t>> saved;
+    for (uint32_t i = 0, n = reader.Read<uint32_t>("sockets"); i < n; i++)
+    {
+        std::string key = "socket." + std::to_string(i);
+        saved[reader.ReadString(key + ".local")].push_back(reader.Read<uint64_t>(key + ".id"));
+    }
+
+    std::map<uint64_t, Ptr<UdpSocketImpl>> current(m_sockets.begin(), m_sockets.end());
+    m_sockets.clear();
+    for (const auto& [id, socket] : current)
+    {
+        std::string local = GetSocketName(socket);
+        auto it = saved.find(local);
+        NS_ABORT_MSG_IF(it == saved.end() || it->second.empty(),
+                        "Cannot restore " << reader.GetPath() << ": no socket bound to " << local
+                                          << " was saved");
+        m_sockets[it->second.front()] = socket;
+        it->second.pop_front();
+    }
+
+    Ptr<UdpSocketImpl> unbound = CreateObject<UdpSocketImpl>();
+    std::string unboundName = GetSocketName(unbound);
+    for (const auto& [local, ids] : saved)
+    {
+        NS_ABORT_MSG_IF(!ids.empty() && local != unboundName,
+                        "Cannot restore " << reader.GetPath() << ": the socket bound to " << local
+                                          << " was not reopened");
+        for (auto id : ids)
+        {
+            // The sockets closed by their owners are not reopened
+            Ptr<UdpSocketImpl> socket = CreateObject<UdpSocketImpl>();
+            socket->SetNode(m_node);
+            socket->SetUdp(this);
+            m_sockets[id] = socket;
+        }
+    }
+    m_socketIndex = reader.Read<uint64_t>("socketIndex");
+}
+
 bool
 UdpL4Protocol::RemoveSocket(Ptr<UdpSocketImpl> socket)
 {
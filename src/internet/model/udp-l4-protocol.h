@@ -22,6 +22,7 @@
 
 #include "ip-l4-protocol.h"
 
+#include "ns3/checkpoint.h"
 #include "ns3/packet.h"
 #include "ns3/ptr.h"
 
@@ -60,7 +61,7 @@ class NetDevice;
  * \ingroup udp
  * \brief Implementation of the UDP protocol
  */
-class UdpL4Protocol : public IpL4Protocol
+class UdpL4Protocol : public IpL4Protocol, public Checkpointable
 {
   public:
     /**
@@ -282,6 +283,24 @@ class UdpL4Protocol : public IpL4Protocol
     IpL4Protocol::DownTargetCallback GetDownTarget() const override;
     IpL4Protocol::DownTargetCallback6 GetDownTarget6() const override;
 
+    /**
+     * \brief Save the sockets, by local address, and the ephemeral ports.
+     * \param writer the checkpoint writer
+     */
+    void SaveState(CheckpointWriter& writer) const override;
+    /**
+     * \brief Restore the ephemeral ports and the identifiers of the sockets.
+     *
+     * The sockets are reopened by their owners, such as the applications,
+     * and bound to their saved local address before this protocol is
+     * restored.  They are identified by their local address, and the
+     * unbound and closed sockets are recreated if needed, so that each
+     * socket gets its saved identifier.
+     *
+     * \param reader the checkpoint reader
+     */
+    void RestoreState(CheckpointReader& reader) override;
+
   protected:
     void DoDispose() override;
     /*
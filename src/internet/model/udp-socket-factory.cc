@@ -18,12 +18,14 @@
  */
 #include "udp-socket-factory.h"
 
+#include "ns3/checkpoint.h"
 #include "ns3/uinteger.h"
 
 namespace ns3
 {
 
 NS_OBJECT_ENSURE_REGISTERED(UdpSocketFactory);
+NS_CHECKPOINT_STATELESS(UdpSocketFactory);
 
 TypeId
 UdpSocketFactory::GetTypeId()
@@ -1295,4 +1295,64 @@ UdpSocketImpl::Ipv6JoinGroup(Ipv6Address address,
     }
 }
 
+void
+UdpSocketImpl::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(!m_deliveryQueue.empty(),
+                    "Cannot save a UDP socket with " << m_deliveryQueue.size()
+                                                     << " packets waiting to be read");
+    writer.Write("shutdownSend", m_shutdownSend);
+    writer.Write("shutdownRecv", m_shutdownRecv);
+    writer.Write("allowBroadcast", m_allowBroadcast);
+    writer.Write("ipTos", GetIpTos());
+    writer.Write("priority", GetPriority());
+    writer.Write("connected", m_connected);
+    if (m_connected)
+    {
+        if (Ipv4Address::IsMatchingType(m_defaultAddress))
+        {
+            WriteSocketAddress(
+                writer,
+                "peer",
+                InetSocketAddress(Ipv4Address::ConvertFrom(m_defaultAddress), m_defaultPort));
+        }
+        else
+        {
+            WriteSocketAddress(
+                writer,
+                "peer",
+                Inet6SocketAddress(Ipv6Address::ConvertFrom(m_defaultAddress), m_defaultPort));
+        }
+    }
+}
+
+void
+UdpSocketImpl::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    m_shutdownSend = reader.Read<bool>("shutdownSend");
+    m_shutdownRecv = reader.Read<bool>("shutdownRecv");
+    m_allowBroadcast = reader.Read<bool>("allowBroadcast");
+    SetIpTos(reader.Read<uint8_t>("ipTos"));
+    SetPriority(reader.Read<uint8_t>("priority"));
+    m_connected = reader.Read<bool>("connected");
+    if (m_connected)
+    {
+        Address peer = ReadSocketAddress(reader, "peer");
+        if (InetSocketAddress::IsMatchingType(peer))
+        {
+            InetSocketAddress inet = InetSocketAddress::ConvertFrom(peer);
+            m_defaultAddress = Address(inet.GetIpv4());
+            m_defaultPort = inet.GetPort();
+        }
+        else
+        {
+            Inet6SocketAddress inet6 = Inet6SocketAddress::ConvertFrom(peer);
+            m_defaultAddress = Address(inet6.GetIpv6());
+            m_defaultPort = inet6.GetPort();
+        }
+    }
+}
+
 } // namespace ns3
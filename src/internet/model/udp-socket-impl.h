@@ -24,6 +24,7 @@
 #include "udp-socket.h"
 
 #include "ns3/callback.h"
+#include "ns3/checkpoint.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/ptr.h"
 #include "ns3/socket.h"
@@ -66,9 +67,12 @@ class Ipv6Interface;
  * priority for the socket (according to the Socket::IpTos2Priority function).
  * A SocketPriority tag is only added to the packet if the resulting priority
  * is non-null.
+ *
+ * A socket can be saved to a checkpoint only when no received packet
+ * is waiting to be read.
  */
 
-class UdpSocketImpl : public UdpSocket
+class UdpSocketImpl : public UdpSocket, public Checkpointable
 {
   public:
     /**
@@ -121,6 +125,20 @@ class UdpSocketImpl : public UdpSocket
                        Socket::Ipv6MulticastFilterMode filterMode,
                        std::vector<Ipv6Address> sourceAddresses) override;
 
+    /**
+     * \brief Save the state of the connection.
+     *
+     * The endpoint is not saved: the socket is bound again by its owner.
+     *
+     * \param writer the checkpoint writer
+     */
+    void SaveState(CheckpointWriter& writer) const override;
+    /**
+     * \brief Restore the state of the connection.
+     * \param reader the checkpoint reader
+     */
+    void RestoreState(CheckpointReader& reader) override;
+
   private:
     // Attributes set through UdpSocket base class
     void SetRcvBufSize(uint32_t size) override;
@@ -0,0 +1,196 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/ipv4-end-point-demux.h"
+#include "ns3/ipv4-end-point.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/ipv6-end-point-demux.h"
+#include "ns3/ipv6-end-point.h"
+#include "ns3/ipv6-interface.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Ipv4EndPointDemux lookups of the listeners and the connections
+ */
+class Ipv4EndPointDemuxTestCase : public TestCase
+{
+  public:
+    Ipv4EndPointDemuxTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv4EndPointDemuxTestCase::Ipv4EndPointDemuxTestCase()
+    : TestCase("Ipv4EndPointDemux lookups of the listeners and the connections")
+{
+}
+
+void
+Ipv4EndPointDemuxTestCase::DoRun()
+{
+    Ptr<Ipv4Interface> interface = CreateObject<Ipv4Interface>();
+    Ipv4Address local("10.0.0.1");
+    Ipv4Address peer("10.0.0.2");
+    Ipv4Address other("10.0.0.3");
+    Ipv4EndPointDemux demux;
+
+    Ipv4EndPoint* listener = demux.Allocate(nullptr, 80);
+    Ipv4EndPoint* localListener = demux.Allocate(nullptr, local, 80);
+    Ipv4EndPoint* connection = demux.Allocate(nullptr, local, 80, peer, 1000);
+    NS_TEST_ASSERT_MSG_NE(listener, nullptr, "Listener not allocated");
+    NS_TEST_ASSERT_MSG_NE(localListener, nullptr, "Listener not allocated");
+    NS_TEST_ASSERT_MSG_NE(connection, nullptr, "Connection not allocated");
+    NS_TEST_ASSERT_MSG_EQ(demux.Allocate(nullptr, local, 80, peer, 1000),
+                          nullptr,
+                          "Duplicated connection allocated");
+    NS_TEST_ASSERT_MSG_EQ(demux.Allocate(nullptr, local, 80), nullptr, "Duplicated listener");
+    NS_TEST_ASSERT_MSG_EQ(demux.LookupPortLocal(80), true, "Port 80 not found");
+    NS_TEST_ASSERT_MSG_EQ(demux.LookupPortLocal(81), false, "Port 81 found");
+
+    Ipv4EndPointDemux::EndPoints endPoints = demux.Lookup(local, 80, peer, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "Bad number of endpoints");
+    NS_TEST_ASSERT_MSG_EQ(endPoints.front(), connection, "The connection does not match");
+    endPoints = demux.Lookup(local, 80, other, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "Bad number of endpoints");
+    NS_TEST_ASSERT_MSG_EQ(endPoints.front(), localListener, "The local listener does not match");
+    endPoints = demux.Lookup(Ipv4Address("10.0.0.4"), 80, other, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "Bad number of endpoints");
+    NS_TEST_ASSERT_MSG_EQ(endPoints.front(), listener, "The listener does not match");
+    NS_TEST_ASSERT_MSG_EQ(demux.Lookup(local, 81, peer, 1000, interface).empty(),
+                          true,
+                          "Endpoint found on port 81");
+    NS_TEST_ASSERT_MSG_EQ(demux.SimpleLookup(local, 80, peer, 1000),
+                          connection,
+                          "The connection is not found by SimpleLookup");
+
+    // An endpoint connected after its allocation
+    Ipv4EndPoint* client = demux.Allocate(local);
+    client->SetPeer(other, 2000);
+    endPoints = demux.Lookup(local, client->GetLocalPort(), other, 2000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "Bad number of endpoints");
+    NS_TEST_ASSERT_MSG_EQ(endPoints.front(), client, "The connected endpoint does not match");
+    endPoints = demux.Lookup(local, client->GetLocalPort(), peer, 2000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.empty(), true, "The connected endpoint matches another peer");
+
+    // The endpoints with disabled Rx are skipped
+    connection->SetRxEnabled(false);
+    endPoints = demux.Lookup(local, 80, peer, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.front(), localListener, "The disabled connection matches");
+    connection->SetRxEnabled(true);
+
+    demux.DeAllocate(connection);
+    endPoints = demux.Lookup(local, 80, peer, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "Bad number of endpoints");
+    NS_TEST_ASSERT_MSG_EQ(endPoints.front(), localListener, "The local listener does not match");
+    demux.DeAllocate(localListener);
+    NS_TEST_ASSERT_MSG_EQ(demux.SimpleLookup(Ipv4Address("10.0.0.4"), 80, other, 1000),
+                          listener,
+                          "The listener is not found by SimpleLookup");
+    demux.DeAllocate(listener);
+    NS_TEST_ASSERT_MSG_EQ(demux.LookupPortLocal(80), false, "Port 80 found");
+    NS_TEST_ASSERT_MSG_EQ(demux.GetAllEndPoints().size(), 1, "Bad number of endpoints");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Ipv6EndPointDemux lookups of the listeners and the connections
+ */
+class Ipv6EndPointDemuxTestCase : public TestCase
+{
+  public:
+    Ipv6EndPointDemuxTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv6EndPointDemuxTestCase::Ipv6EndPointDemuxTestCase()
+    : TestCase("Ipv6EndPointDemux lookups of the listeners and the connections")
+{
+}
+
+void
+Ipv6EndPointDemuxTestCase::DoRun()
+{
+    Ptr<Ipv6Interface> interface = CreateObject<Ipv6Interface>();
+    Ipv6Address local("2001:db8::1");
+    Ipv6Address peer("2001:db8::2");
+    Ipv6Address other("2001:db8::3");
+    Ipv6EndPointDemux demux;
+
+    Ipv6EndPoint* listener = demux.Allocate(nullptr, 80);
+    Ipv6EndPoint* connection = demux.Allocate(nullptr, local, 80, peer, 1000);
+    NS_TEST_ASSERT_MSG_NE(listener, nullptr, "Listener not allocated");
+    NS_TEST_ASSERT_MSG_NE(connection, nullptr, "Connection not allocated");
+    NS_TEST_ASSERT_MSG_EQ(demux.Allocate(nullptr, local, 80, peer, 1000),
+                          nullptr,
+                          "Duplicated connection allocated");
+
+    Ipv6EndPointDemux::EndPoints endPoints = demux.Lookup(local, 80, peer, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "Bad number of endpoints");
+    NS_TEST_ASSERT_MSG_EQ(endPoints.front(), connection, "The connection does not match");
+    endPoints = demux.Lookup(local, 80, other, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "Bad number of endpoints");
+    NS_TEST_ASSERT_MSG_EQ(endPoints.front(), listener, "The listener does not match");
+    NS_TEST_ASSERT_MSG_EQ(demux.SimpleLookup(local, 80, peer, 1000),
+                          connection,
+                          "The connection is not found by SimpleLookup");
+
+    // An endpoint moved to another port
+    connection->SetLocalPort(8080);
+    NS_TEST_ASSERT_MSG_EQ(demux.LookupPortLocal(8080), true, "Port 8080 not found");
+    endPoints = demux.Lookup(local, 80, peer, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.front(), listener, "The moved connection matches");
+    endPoints = demux.Lookup(local, 8080, peer, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "Bad number of endpoints");
+    NS_TEST_ASSERT_MSG_EQ(endPoints.front(), connection, "The moved connection does not match");
+
+    // An endpoint disconnected from its peer
+    connection->SetPeer(Ipv6Address::GetAny(), 0);
+    endPoints = demux.Lookup(local, 8080, other, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "Bad number of endpoints");
+    NS_TEST_ASSERT_MSG_EQ(endPoints.front(), connection, "The listener does not match");
+
+    demux.DeAllocate(connection);
+    NS_TEST_ASSERT_MSG_EQ(demux.LookupPortLocal(8080), false, "Port 8080 found");
+    NS_TEST_ASSERT_MSG_EQ(demux.Lookup(local, 8080, other, 1000, interface).empty(),
+                          true,
+                          "Endpoint found on port 8080");
+    NS_TEST_ASSERT_MSG_EQ(demux.GetEndPoints().size(), 1, "Bad number of endpoints");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief IPv4 and IPv6 endpoint demultiplexers TestSuite
+ */
+class EndPointDemuxTestSuite : public TestSuite
+{
+  public:
+    EndPointDemuxTestSuite()
+        : TestSuite("end-point-demux", Type::UNIT)
+    {
+        AddTestCase(new Ipv4EndPointDemuxTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new Ipv6EndPointDemuxTestCase(), TestCase::Duration::QUICK);
+    }
+};
+
+static EndPointDemuxTestSuite g_endPointDemuxTestSuite; //!< Static variable for test initialization
@@ -20,7 +20,10 @@
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-route.h"
+#include "ns3/ipv4-routing-table-entry.h"
 #include "ns3/ipv4-static-routing-helper.h"
+#include "ns3/ipv4-static-routing.h"
 #include "ns3/node-container.h"
 #include "ns3/node.h"
 #include "ns3/packet.h"
@@ -207,6 +210,105 @@ Ipv4StaticRoutingSlash32TestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup internet-test
+ *
+ * \brief IPv4 StaticRouting longest prefix match Test
+ */
+class Ipv4StaticRoutingLongestPrefixTestCase : public TestCase
+{
+  public:
+    Ipv4StaticRoutingLongestPrefixTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Find the route to a destination.
+     * \param routing The routing protocol.
+     * \param dest The destination.
+     * \returns The gateway of the route, or 0.0.0.0 if none.
+     */
+    Ipv4Address GetGateway(Ptr<Ipv4StaticRouting> routing, Ipv4Address dest);
+};
+
+Ipv4StaticRoutingLongestPrefixTestCase::Ipv4StaticRoutingLongestPrefixTestCase()
+    : TestCase("Check the longest prefix match of the routes, and their metrics")
+{
+}
+
+Ipv4Address
+Ipv4StaticRoutingLongestPrefixTestCase::GetGateway(Ptr<Ipv4StaticRouting> routing,
+                                                   Ipv4Address dest)
+{
+    Ipv4Header header;
+    header.SetDestination(dest);
+    Socket::SocketErrno sockerr;
+    Ptr<Ipv4Route> route = routing->RouteOutput(nullptr, header, nullptr, sockerr);
+    return route ? route->GetGateway() : Ipv4Address::GetZero();
+}
+
+void
+Ipv4StaticRoutingLongestPrefixTestCase::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.Install(node);
+    Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+    device->SetAddress(Mac48Address::Allocate());
+    node->AddDevice(device);
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    uint32_t interface = ipv4->AddInterface(device);
+    ipv4->AddAddress(interface, Ipv4InterfaceAddress("10.0.0.1", "255.0.0.0"));
+    ipv4->SetUp(interface);
+
+    Ptr<Ipv4StaticRouting> routing = CreateObject<Ipv4StaticRouting>();
+    routing->SetIpv4(ipv4);
+    routing->SetDefaultRoute("10.0.0.9", interface, 5);
+    routing->AddNetworkRouteTo("11.2.0.0", "255.255.0.0", "10.0.0.16", interface, 3);
+    routing->AddNetworkRouteTo("11.2.1.0", "255.255.255.0", "10.0.0.24", interface, 2);
+    routing->AddNetworkRouteTo("11.2.1.0", "255.255.255.0", "10.0.0.25", interface, 2);
+    routing->AddNetworkRouteTo("11.2.1.0", "255.255.255.0", "10.0.0.26", interface, 4);
+    routing->AddHostRouteTo("11.2.1.7", "10.0.0.32", interface, 6);
+    routing->AddHostRouteTo("11.2.1.7", "10.0.0.33", interface, 1);
+
+    NS_TEST_EXPECT_MSG_EQ(GetGateway(routing, "11.2.1.7"),
+                          Ipv4Address("10.0.0.32"),
+                          "The first host route should be used");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway(routing, "11.2.1.8"),
+                          Ipv4Address("10.0.0.25"),
+                          "The last route with the smallest metric should be used");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway(routing, "11.2.9.9"),
+                          Ipv4Address("10.0.0.16"),
+                          "The /16 route should be used");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway(routing, "12.0.0.1"),
+                          Ipv4Address("10.0.0.9"),
+                          "The default route should be used");
+
+    for (uint32_t i = 0; i < routing->GetNRoutes(); i++)
+    {
+        if (routing->GetRoute(i).GetGateway() == Ipv4Address("10.0.0.32") ||
+            routing->GetRoute(i).GetGateway() == Ipv4Address("10.0.0.25"))
+        {
+            routing->RemoveRoute(i--);
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(GetGateway(routing, "11.2.1.7"),
+                          Ipv4Address("10.0.0.33"),
+                          "The remaining host route should be used");
+    NS_TEST_EXPECT_MSG_EQ(GetGateway(routing, "11.2.1.8"),
+                          Ipv4Address("10.0.0.24"),
+                          "The remaining route with the smallest metric should be used");
+
+    routing->NotifyInterfaceDown(interface);
+    NS_TEST_EXPECT_MSG_EQ(GetGateway(routing, "11.2.1.7"),
+                          Ipv4Address::GetZero(),
+                          "No route should remain");
+
+    routing->Dispose();
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup internet-test
  *
@@ -222,6 +324,7 @@ Ipv4StaticRoutingTestSuite::Ipv4StaticRoutingTestSuite()
     : TestSuite("ipv4-static-routing", Type::UNIT)
 {
     AddTestCase(new Ipv4StaticRoutingSlash32TestCase, TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4StaticRoutingLongestPrefixTestCase, TestCase::Duration::QUICK);
 }
 
 static Ipv4StaticRoutingTestSuite
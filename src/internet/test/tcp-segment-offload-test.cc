@@ -0,0 +1,171 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark TcpTxBuffer and TcpRxBuffer during
+#include "tcp-general-test.h"
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/segment-offload-tag.h"
+#include "ns3/tcp-header.h"
+#include "ns3/uinteger.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TcpSegmentOffloadTestSuite");
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Check the transfer of data with the TCP segmentation offload
+ *
+ * The sender and the receiver are configured with the OffloadSegments
+ * attribute.  The test checks that all the data is transferred, in
+ * super-segments of at most OffloadSegments segments, sent through an
+ * MTU smaller than them, and that fewer packets are sent than without
+ * the offload.
+ */
+class TcpSegmentOffloadTestCase : public TcpGeneralTest
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param offloadSegments the value of the OffloadSegments attribute.
+     */
+    TcpSegmentOffloadTestCase(uint16_t offloadSegments);
+
+  protected:
+    Ptr<TcpSocketMsgBase> CreateSenderSocket(Ptr<Node> node) override;
+    Ptr<TcpSocketMsgBase> CreateReceiverSocket(Ptr<Node> node) override;
+    void ConfigureEnvironment() override;
+    void ConfigureProperties() override;
+    void Tx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who) override;
+    void Rx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who) override;
+    void FinalChecks() override;
+
+  private:
+    uint16_t m_offloadSegments; //!< The value of the OffloadSegments attribute
+    uint32_t m_txPackets;       //!< Number of data packets sent
+    uint32_t m_txBytes;         //!< Number of data bytes sent
+    uint32_t m_rxBytes;         //!< Number of data bytes received
+    uint32_t m_maxSize;         //!< Size of the largest data packet sent
+};
+
+TcpSegmentOffloadTestCase::TcpSegmentOffloadTestCase(uint16_t offloadSegments)
+    : TcpGeneralTest("Transfer with OffloadSegments=" + std::to_string(offloadSegments)),
+      m_offloadSegments(offloadSegments),
+      m_txPackets(0),
+      m_txBytes(0),
+      m_rxBytes(0),
+      m_maxSize(0)
+{
+}
+
+Ptr<TcpSocketMsgBase>
+TcpSegmentOffloadTestCase::CreateSenderSocket(Ptr<Node> node)
+{
+    Ptr<TcpSocketMsgBase> socket = TcpGeneralTest::CreateSenderSocket(node);
+    socket->SetAttribute("OffloadSegments", UintegerValue(m_offloadSegments));
+    return socket;
+}
+
+Ptr<TcpSocketMsgBase>
+TcpSegmentOffloadTestCase::CreateReceiverSocket(Ptr<Node> node)
+{
+    Ptr<TcpSocketMsgBase> socket = TcpGeneralTest::CreateReceiverSocket(node);
+    socket->SetAttribute("OffloadSegments", UintegerValue(m_offloadSegments));
+    return socket;
+}
+
+void
+TcpSegmentOffloadTestCase::ConfigureEnvironment()
+{
+    TcpGeneralTest::ConfigureEnvironment();
+    SetAppPktCount(100);
+    SetMTU(1500);
+}
+
+void
+TcpSegmentOffloadTestCase::ConfigureProperties()
+{
+    TcpGeneralTest::ConfigureProperties();
+    SetInitialCwnd(SENDER, 10);
+}
+
+void
+TcpSegmentOffloadTestCase::Tx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who)
+{
+    if (who == SENDER && p->GetSize() > 0)
+    {
+        m_txPackets++;
+        m_txBytes += p->GetSize();
+        m_maxSize = std::max(m_maxSize, p->GetSize());
+
+        SegmentOffloadTag tag;
+        NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(tag),
+                              p->GetSize() > GetSegSize(SENDER),
+                              "Bad tagging of a packet of " << p->GetSize() << " bytes");
+    }
+}
+
+void
+TcpSegmentOffloadTestCase::Rx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who)
+{
+    if (who == RECEIVER)
+    {
+        m_rxBytes += p->GetSize();
+    }
+}
+
+void
+TcpSegmentOffloadTestCase::FinalChecks()
+{
+    uint32_t appBytes = GetPktSize() * GetPktCount();
+    NS_TEST_ASSERT_MSG_EQ(m_txBytes, appBytes, "Data lost or retransmitted");
+    NS_TEST_ASSERT_MSG_EQ(m_rxBytes, appBytes, "Data not received");
+    NS_TEST_ASSERT_MSG_LT_OR_EQ(m_maxSize,
+                                m_offloadSegments * GetSegSize(SENDER),
+                                "Super-segment too large");
+    if (m_offloadSegments == 1)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_txPackets, appBytes / GetSegSize(SENDER), "Bad number of packets");
+    }
+    else
+    {
+        NS_TEST_ASSERT_MSG_GT(m_maxSize, 1500, "No super-segment larger than the MTU");
+        NS_TEST_ASSERT_MSG_LT(m_txPackets, appBytes / GetSegSize(SENDER), "No packets saved");
+    }
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief TestSuite: TCP segmentation offload
+ */
+class TcpSegmentOffloadTestSuite : public TestSuite
+{
+  public:
+    TcpSegmentOffloadTestSuite()
+        : TestSuite("tcp-segment-offload", Type::UNIT)
+    {
+        for (uint16_t offloadSegments : {1, 4, 16})
+        {
+            AddTestCase(new TcpSegmentOffloadTestCase(offloadSegments),
+                        TestCase::Duration::QUICK);
+        }
+    }
+};
+
+static TcpSegmentOffloadTestSuite g_tcpSegmentOffloadTestSuite; //!< Static variable for test initialization
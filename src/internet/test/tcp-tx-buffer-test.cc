@@ -53,6 +53,8 @@ class TcpTxBufferTestCase : public TestCase
     /** \brief Test the logic of merging items in GetTransmittedSegment()
      * which is triggered by CopyFromSequence()*/
     void TestMergeItemsWhenGetTransmittedSegment();
+    /** \brief Test the scoreboard of a large window, with every other segment lost */
+    void TestLargeWindow();
     /**
      * \brief Callback to provide a value of receiver window
      * \returns the receiver window size
@@ -99,6 +101,7 @@ TcpTxBufferTestCase::DoRun()
     Simulator::Schedule(Seconds(0.0),
                         &TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment,
                         this);
+    Simulator::Schedule(Seconds(0.0), &TcpTxBufferTestCase::TestLargeWindow, this);
 
     Simulator::Run();
     Simulator::Destroy();
@@ -420,6 +423,79 @@ TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment()
     txBuf.CopyFromSequence(2000, SequenceNumber32(1));
 }
 
+void
+TcpTxBufferTestCase::TestLargeWindow()
+{
+    const uint32_t segments = 2000;
+    TcpTxBuffer txBuf;
+    txBuf.SetHeadSequence(SequenceNumber32(1));
+    txBuf.SetMaxBufferSize(segments * 1000);
+    txBuf.SetSegmentSize(1000);
+    txBuf.SetDupAckThresh(3);
+    txBuf.SetRWndCallback(MakeCallback(&TcpTxBufferTestCase::GetRWnd, this));
+
+    txBuf.Add(Create<Packet>(segments * 1000));
+    for (uint32_t i = 0; i < segments; ++i)
+    {
+        txBuf.CopyFromSequence(1000, SequenceNumber32(i * 1000 + 1));
+    }
+
+    // SACK the odd segments, one at a time
+    TcpOptionSack::SackList sackList(1);
+    for (uint32_t i = 1; i < segments; i += 2)
+    {
+        SequenceNumber32 seq(i * 1000 + 1);
+        sackList.front() = TcpOptionSack::SackBlock(seq, seq + 1000);
+        NS_TEST_ASSERT_MSG_EQ(txBuf.Update(sackList), 1000, "Bad number of bytes sacked");
+    }
+    NS_TEST_ASSERT_MSG_EQ(txBuf.GetSacked(), segments / 2 * 1000, "Bad number of sacked bytes");
+
+    // The even segments with at least 3 sacked segments above are lost
+    NS_TEST_ASSERT_MSG_EQ(txBuf.GetLost(), (segments / 2 - 2) * 1000, "Bad number of lost bytes");
+    NS_TEST_ASSERT_MSG_EQ(txBuf.IsLost(SequenceNumber32(1)), true, "First segment not lost");
+    NS_TEST_ASSERT_MSG_EQ(txBuf.IsLost(SequenceNumber32(1001)), false, "Sacked segment lost");
+    NS_TEST_ASSERT_MSG_EQ(txBuf.IsLost(SequenceNumber32((segments - 6) * 1000 + 501)),
+                          true,
+                          "Segment not lost");
+    NS_TEST_ASSERT_MSG_EQ(txBuf.IsLost(SequenceNumber32((segments - 4) * 1000 + 1)),
+                          false,
+                          "Segment lost with only two sacked segments above");
+
+    // A sacked range already known does not change the scoreboard
+    sackList.front() = TcpOptionSack::SackBlock(SequenceNumber32(1001), SequenceNumber32(2001));
+    NS_TEST_ASSERT_MSG_EQ(txBuf.Update(sackList), 0, "Bad number of bytes sacked");
+
+    // Retransmit a lost segment in the middle of the window
+    SequenceNumber32 middle((segments / 2 + 2) * 1000 + 1);
+    TcpTxItem* item = txBuf.CopyFromSequence(1000, middle);
+    NS_TEST_ASSERT_MSG_EQ(item->GetSeqSize(), 1000, "Bad retransmitted size");
+    NS_TEST_ASSERT_MSG_EQ(item->IsRetrans(), true, "Segment not marked as retransmitted");
+    NS_TEST_ASSERT_MSG_EQ(txBuf.GetRetransmitsCount(), 1000, "Bad number of retransmitted bytes");
+    NS_TEST_ASSERT_MSG_EQ(txBuf.IsRetransmittedDataAcked(middle + 1000),
+                          true,
+                          "Retransmitted segment not found");
+
+    // Cumulative ACK of the first half of the window
+    txBuf.DiscardUpTo(SequenceNumber32(segments / 2 * 1000 + 1));
+    NS_TEST_ASSERT_MSG_EQ(txBuf.GetSacked(), segments / 4 * 1000, "Bad number of sacked bytes");
+    NS_TEST_ASSERT_MSG_EQ(txBuf.GetLost(), (segments / 4 - 2) * 1000, "Bad number of lost bytes");
+    NS_TEST_ASSERT_MSG_EQ(txBuf.GetRetransmitsCount(), 1000, "Bad number of retransmitted bytes");
+
+    SequenceNumber32 seq;
+    SequenceNumber32 seqHigh;
+    NS_TEST_ASSERT_MSG_EQ(txBuf.NextSeg(&seq, &seqHigh, true), true, "No next segment");
+    NS_TEST_ASSERT_MSG_EQ(seq, SequenceNumber32(segments / 2 * 1000 + 1), "Bad next segment");
+
+    // A block which does not cover a whole segment is ignored
+    sackList.front() = TcpOptionSack::SackBlock(SequenceNumber32((segments - 2) * 1000 + 1),
+                                                SequenceNumber32((segments - 2) * 1000 + 501));
+    NS_TEST_ASSERT_MSG_EQ(txBuf.Update(sackList), 0, "Partial block sacked");
+    txBuf.DiscardUpTo(SequenceNumber32(segments * 1000 + 1));
+    NS_TEST_ASSERT_MSG_EQ(txBuf.Size(), 0, "Size is different than expected");
+    NS_TEST_ASSERT_MSG_EQ(txBuf.GetSacked(), 0, "Bad number of sacked bytes");
+    NS_TEST_ASSERT_MSG_EQ(txBuf.GetLost(), 0, "Bad number of lost bytes");
+}
+
 void
 TcpTxBufferTestCase::TestTransmittedBlock()
 {
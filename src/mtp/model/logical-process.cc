@@ -0,0 +1,271 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "logical-process.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+/**
+ * \file
+ * \ingroup mtp
+ * Implementation of class ns3::LogicalProcess.
+ */
+
+namespace ns3
+{
+
+// Note:  Logging in this file is largely avoided because the methods are
+// called concurrently by several threads and the logging framework is
+// not thread-safe.
+NS_LOG_COMPONENT_DEFINE("LogicalProcess");
+
+LogicalProcess::LogicalProcess(uint32_t id, ObjectFactory schedulerFactory)
+    : m_id(id),
+      m_events(schedulerFactory.Create<Scheduler>()),
+      m_uid(EventId::UID::VALID),
+      m_currentUid(EventId::UID::INVALID),
+      m_currentTs(0),
+      m_currentContext(Simulator::NO_CONTEXT),
+      m_eventCount(0),
+      m_sendCount(0),
+      m_executionTime(0)
+{
+    NS_LOG_FUNCTION(this << id);
+}
+
+LogicalProcess::~LogicalProcess()
+{
+    NS_LOG_FUNCTION(this);
+    ReceiveMessages();
+    while (!m_events->IsEmpty())
+    {
+        Scheduler::Event next = m_events->RemoveNext();
+        next.impl->Unref();
+    }
+    m_events = nullptr;
+}
+
+uint32_t
+LogicalProcess::GetId() const
+{
+    return m_id;
+}
+
+void
+LogicalProcess::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler>();
+    while (!m_events->IsEmpty())
+    {
+        scheduler->Insert(m_events->RemoveNext());
+    }
+    m_events = scheduler;
+}
+
+EventId
+LogicalProcess::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_ASSERT_MSG(delay.IsPositive(), "LogicalProcess::Schedule(): Negative delay");
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = m_currentTs + delay.GetTimeStep();
+    ev.key.m_context = m_currentContext;
+    ev.key.m_uid = m_uid++;
+    m_events->Insert(ev);
+    return EventId(event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+LogicalProcess::Insert(uint32_t context, uint64_t ts, EventImpl* event)
+{
+    NS_ASSERT_MSG(ts >= m_currentTs, "LogicalProcess::Insert(): event in the past");
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = ts;
+    ev.key.m_context = context;
+    ev.key.m_uid = m_uid++;
+    m_events->Insert(ev);
+}
+
+void
+LogicalProcess::InsertEvent(const Scheduler::Event& ev)
+{
+    m_events->Insert(ev);
+}
+
+void
+LogicalProcess::Post(uint32_t context, uint64_t ts, uint32_t sender, uint64_t seq, EventImpl* event)
+{
+    std::unique_lock lock{m_mailboxMutex};
+    m_mailbox.push_back({ts, context, sender, seq, event});
+}
+
+uint64_t
+LogicalProcess::NextSendSequence()
+{
+    return m_sendCount++;
+}
+
+void
+LogicalProcess::ReceiveMessages()
+{
+    std::vector<Message> messages;
+    {
+        std::unique_lock lock{m_mailboxMutex};
+        m_mailbox.swap(messages);
+    }
+    if (messages.empty())
+    {
+        return;
+    }
+    std::sort(messages.begin(), messages.end(), [](const Message& a, const Message& b) {
+        if (a.ts != b.ts)
+        {
+            return a.ts < b.ts;
+        }
+        if (a.sender != b.sender)
+        {
+            return a.sender < b.sender;
+        }
+        return a.seq < b.seq;
+    });
+    for (const auto& message : messages)
+    {
+        Insert(message.context, message.ts, message.event);
+    }
+}
+
+void
+LogicalProcess::ProcessEvents(uint64_t grantedTs, const std::atomic<bool>* stop)
+{
+    auto start = std::chrono::steady_clock::now();
+    while (!m_events->IsEmpty() && m_events->PeekNext().key.m_ts < grantedTs)
+    {
+        Scheduler::Event next = m_events->RemoveNext();
+        NS_ASSERT(next.key.m_ts >= m_currentTs);
+        m_eventCount++;
+        m_currentTs = next.key.m_ts;
+        m_currentContext = next.key.m_context;
+        m_currentUid = next.key.m_uid;
+        next.impl->Invoke();
+        next.impl->Unref();
+        if (stop != nullptr && stop->load(std::memory_order_relaxed))
+        {
+            break;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    m_executionTime = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+uint64_t
+LogicalProcess::GetNextTs() const
+{
+    if (m_events->IsEmpty())
+    {
+        return std::numeric_limits<uint64_t>::max();
+    }
+    return m_events->PeekNext().key.m_ts;
+}
+
+bool
+LogicalProcess::IsEmpty() const
+{
+    return m_events->IsEmpty();
+}
+
+Scheduler::Event
+LogicalProcess::RemoveNext()
+{
+    return m_events->RemoveNext();
+}
+
+uint64_t
+LogicalProcess::GetCurrentTs() const
+{
+    return m_currentTs;
+}
+
+void
+LogicalProcess::AdvanceTo(uint64_t ts)
+{
+    NS_ASSERT(ts >= m_currentTs);
+    m_currentTs = ts;
+}
+
+uint32_t
+LogicalProcess::GetContext() const
+{
+    return m_currentContext;
+}
+
+uint64_t
+LogicalProcess::GetEventCount() const
+{
+    return m_eventCount;
+}
+
+int64_t
+LogicalProcess::GetExecutionTime() const
+{
+    return m_executionTime;
+}
+
+uint32_t
+LogicalProcess::GetNextUid() const
+{
+    return m_uid;
+}
+
+void
+LogicalProcess::SetNextUid(uint32_t uid)
+{
+    m_uid = uid;
+}
+
+bool
+LogicalProcess::IsExpired(const EventId& id) const
+{
+    return id.PeekEventImpl() == nullptr || id.GetTs() < m_currentTs ||
+           (id.GetTs() == m_currentTs && id.GetUid() <= m_currentUid) ||
+           id.PeekEventImpl()->IsCancelled();
+}
+
+void
+LogicalProcess::Remove(const EventId& id)
+{
+    if (IsExpired(id))
+    {
+        return;
+    }
+    Scheduler::Event event;
+    event.impl = id.PeekEventImpl();
+    event.key.m_ts = id.GetTs();
+    event.key.m_context = id.GetContext();
+    event.key.m_uid = id.GetUid();
+    m_events->Remove(event);
+    event.impl->Cancel();
+    // whenever we remove an event from the event list, we have to unref it.
+    event.impl->Unref();
+}
+
+} // namespace ns3
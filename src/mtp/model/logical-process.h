@@ -0,0 +1,222 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LOGICAL_PROCESS_H
+#define LOGICAL_PROCESS_H
+
+#include "ns3/event-id.h"
+#include "ns3/event-impl.h"
+#include "ns3/nstime.h"
+#include "ns3/object-factory.h"
+#include "ns3/ptr.h"
+#include "ns3/scheduler.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup mtp
+ * Declaration of class ns3::LogicalProcess.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup mtp
+ *
+ * \brief A partition of the simulated nodes with its own event list and clock.
+ *
+ * Each logical process (LP) owns the events of the contexts (nodes) that
+ * have been assigned to it by the MultithreadedSimulatorImpl.  Within a
+ * synchronization round the LP is executed by exactly one thread, so the
+ * event list and the clock are only touched by that thread.  Events sent
+ * to an LP by other LPs during a round are posted to a mutex-protected
+ * mailbox and merged into the event list at the next round boundary.
+ */
+class LogicalProcess
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] id The LP identifier.
+     * \param [in] schedulerFactory The factory used to create the event list.
+     */
+    LogicalProcess(uint32_t id, ObjectFactory schedulerFactory);
+    /** Destructor. */
+    ~LogicalProcess();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    LogicalProcess(const LogicalProcess&) = delete;
+    LogicalProcess& operator=(const LogicalProcess&) = delete;
+
+    /**
+     * Get the LP identifier.
+     * \return The LP identifier.
+     */
+    uint32_t GetId() const;
+
+    /**
+     * Replace the event list, transferring the pending events.
+     * \param [in] schedulerFactory The factory used to create the new event list.
+     */
+    void SetScheduler(ObjectFactory schedulerFactory);
+
+    /**
+     * Schedule an event in the context of the event being executed.
+     *
+     * Must be called from the thread executing this LP.
+     *
+     * \param [in] delay The delay relative to the LP clock.
+     * \param [in] event The event to schedule.
+     * \return The EventId of the scheduled event.
+     */
+    EventId Schedule(const Time& delay, EventImpl* event);
+    /**
+     * Insert an event directly into the event list.
+     *
+     * Must be called from the thread executing this LP, or while no
+     * LP is being executed.
+     *
+     * \param [in] context The event context.
+     * \param [in] ts The absolute event timestamp.
+     * \param [in] event The event to insert.
+     */
+    void Insert(uint32_t context, uint64_t ts, EventImpl* event);
+    /**
+     * Insert an event with a given key into the event list, without
+     * allocating a new uid.  Used to migrate events between LPs.
+     *
+     * \param [in] ev The event to insert.
+     */
+    void InsertEvent(const Scheduler::Event& ev);
+    /**
+     * Post an event from another LP.  Thread-safe.
+     *
+     * \param [in] context The event context.
+     * \param [in] ts The absolute event timestamp.
+     * \param [in] sender The identifier of the sending LP.
+     * \param [in] seq The sequence number of the message at the sender.
+     * \param [in] event The event to post.
+     */
+    void Post(uint32_t context, uint64_t ts, uint32_t sender, uint64_t seq, EventImpl* event);
+    /**
+     * Allocate the next sequence number for a message posted by this LP.
+     * \return The sequence number.
+     */
+    uint64_t NextSendSequence();
+    /**
+     * Move the events posted to the mailbox into the event list.
+     *
+     * Messages are inserted in (timestamp, sender, sequence) order so that
+     * the resulting event order does not depend on thread interleaving.
+     */
+    void ReceiveMessages();
+
+    /**
+     * Execute all the events whose timestamp is strictly lower than \pname{grantedTs}.
+     *
+     * \param [in] grantedTs The exclusive upper bound of the time window.
+     * \param [in] stop Flag checked after each event; when set, processing stops.
+     */
+    void ProcessEvents(uint64_t grantedTs, const std::atomic<bool>* stop);
+    /**
+     * Get the timestamp of the earliest pending event.
+     * \return The timestamp, or the maximum value if the event list is empty.
+     */
+    uint64_t GetNextTs() const;
+    /**
+     * Check if the event list is empty.
+     * \return \c true if there are no pending events.
+     */
+    bool IsEmpty() const;
+    /**
+     * Remove and return the earliest event.
+     * \return The earliest event.
+     */
+    Scheduler::Event RemoveNext();
+
+    /**
+     * Get the LP clock.
+     * \return The timestamp of the event being (or last) executed.
+     */
+    uint64_t GetCurrentTs() const;
+    /**
+     * Advance the LP clock without executing events.
+     * \param [in] ts The new clock value; must not be in the past.
+     */
+    void AdvanceTo(uint64_t ts);
+    /**
+     * Get the context of the event being (or last) executed.
+     * \return The context.
+     */
+    uint32_t GetContext() const;
+    /**
+     * Get the number of events executed by this LP.
+     * \return The event count.
+     */
+    uint64_t GetEventCount() const;
+    /**
+     * Get the wall-clock time spent in the last call to ProcessEvents.
+     * \return The execution time in nanoseconds.
+     */
+    int64_t GetExecutionTime() const;
+    /**
+     * Get the next uid which will be allocated by this LP.
+     * \return The uid.
+     */
+    uint32_t GetNextUid() const;
+    /**
+     * Set the next uid to be allocated by this LP.
+     * \param [in] uid The uid.
+     */
+    void SetNextUid(uint32_t uid);
+
+    /** \copydoc SimulatorImpl::IsExpired */
+    bool IsExpired(const EventId& id) const;
+    /** \copydoc SimulatorImpl::Remove */
+    void Remove(const EventId& id);
+
+  private:
+    /** An event posted by another LP. */
+    struct Message
+    {
+        uint64_t ts;      //!< Absolute event timestamp.
+        uint32_t context; //!< Event context.
+        uint32_t sender;  //!< Identifier of the sending LP.
+        uint64_t seq;     //!< Sequence number at the sender.
+        EventImpl* event; //!< The event implementation.
+    };
+
+    uint32_t m_id;             //!< The LP identifier.
+    Ptr<Scheduler> m_events;   //!< The event list.
+    uint32_t m_uid;            //!< Next event unique id.
+    uint32_t m_currentUid;     //!< Unique id of the current event.
+    uint64_t m_currentTs;      //!< Timestamp of the current event.
+    uint32_t m_currentContext; //!< Context of the current event.
+    uint64_t m_eventCount;     //!< The event count.
+    uint64_t m_sendCount;      //!< Number of messages posted by this LP.
+    int64_t m_executionTime;   //!< Wall-clock time of the last round, in ns.
+
+    std::vector<Message> m_mailbox; //!< Events posted by other LPs.
+    std::mutex m_mailboxMutex;      //!< Mutex protecting the mailbox.
+};
+
+} // namespace ns3
+
+#endif /* LOGICAL_PROCESS_H */
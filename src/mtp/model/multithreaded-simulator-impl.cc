@@ -0,0 +1,708 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "ns3/assert.h"
+#include "ns3/channel-list.h"
+#include "ns3/channel.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+/**
+ * \file
+ * \ingroup mtp
+ * Implementation of class ns3::MultithreadedSimulatorImpl.
+ */
+
+namespace ns3
+{
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions, and because
+// the logging framework is not thread-safe.
+NS_LOG_COMPONENT_DEFINE("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(MultithreadedSimulatorImpl);
+
+/**
+ * \ingroup mtp
+ * The LP being executed by the calling thread, if any.
+ */
+static thread_local LogicalProcess* g_currentLp = nullptr;
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MultithreadedSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Mtp")
+            .AddConstructor<MultithreadedSimulatorImpl>()
+            .AddAttribute("MaxThreads",
+                          "The maximum number of threads used to execute the logical "
+                          "processes, including the main thread. "
+                          "0 means one thread per hardware core.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&MultithreadedSimulatorImpl::m_maxThreads),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("MinLookahead",
+                          "Nodes connected by a channel with a delay lower than this value "
+                          "are placed in the same logical process.",
+                          TimeValue(Time(0)),
+                          MakeTimeAccessor(&MultithreadedSimulatorImpl::m_minLookahead),
+                          MakeTimeChecker(Time(0)));
+    return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl()
+    : m_partitioned(false),
+      m_stop(false),
+      m_parallel(false),
+      m_grantedTs(0),
+      m_lookahead(std::numeric_limits<uint64_t>::max()),
+      m_roundCount(0),
+      m_nextLp(0),
+      m_roundGeneration(0),
+      m_roundOpen(false),
+      m_busyThreads(0),
+      m_exitThreads(false),
+      m_mainThreadId(std::this_thread::get_id())
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    StopThreads();
+    {
+        std::unique_lock lock{m_eventsWithContextMutex};
+        for (const auto& event : m_eventsWithContext)
+        {
+            event.event->Unref();
+        }
+        m_eventsWithContext.clear();
+    }
+    m_roundLps.clear();
+    m_lps.clear();
+    SimulatorImpl::DoDispose();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    while (!m_destroyEvents.empty())
+    {
+        Ptr<EventImpl> ev = m_destroyEvents.front().PeekEventImpl();
+        m_destroyEvents.pop_front();
+        NS_LOG_LOGIC("handle destroy " << ev);
+        if (!ev->IsCancelled())
+        {
+            ev->Invoke();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    NS_ASSERT_MSG(!m_parallel, "Cannot change the scheduler while the simulation is running");
+    m_schedulerFactory = schedulerFactory;
+    if (m_lps.empty())
+    {
+        m_lps.emplace_back(std::make_unique<LogicalProcess>(0, schedulerFactory));
+        return;
+    }
+    for (auto& lp : m_lps)
+    {
+        lp->SetScheduler(schedulerFactory);
+    }
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId() const
+{
+    return 0;
+}
+
+void
+MultithreadedSimulatorImpl::Partition()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!m_partitioned);
+
+    uint32_t nNodes = NodeList::GetNNodes();
+
+    // Union-find over the nodes: the nodes attached to a channel which
+    // cannot be used to decouple them end up in the same set.
+    std::vector<uint32_t> parent(nNodes);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](uint32_t n) {
+        while (parent[n] != n)
+        {
+            parent[n] = parent[parent[n]];
+            n = parent[n];
+        }
+        return n;
+    };
+    auto unite = [&parent, &find](uint32_t a, uint32_t b) {
+        a = find(a);
+        b = find(b);
+        if (a != b)
+        {
+            // keep the smallest node id as the representative
+            parent[std::max(a, b)] = std::min(a, b);
+        }
+    };
+
+    /** A channel that may separate two LPs. */
+    struct Link
+    {
+        uint64_t delay;             //!< The channel delay, in time steps.
+        std::vector<uint32_t> nodes; //!< The nodes attached to the channel.
+    };
+
+    std::vector<Link> links;
+    for (auto it = ChannelList::Begin(); it != ChannelList::End(); ++it)
+    {
+        Ptr<Channel> channel = *it;
+        std::vector<uint32_t> nodes;
+        for (std::size_t i = 0; i < channel->GetNDevices(); ++i)
+        {
+            Ptr<NetDevice> device = channel->GetDevice(i);
+            if (device && device->GetNode())
+            {
+                nodes.push_back(device->GetNode()->GetId());
+            }
+        }
+        if (nodes.size() < 2)
+        {
+            continue;
+        }
+
+        TimeValue delay;
+        if (!channel->GetAttributeFailSafe("Delay", delay) || !delay.Get().IsStrictlyPositive() ||
+            delay.Get() < m_minLookahead)
+        {
+            NS_LOG_LOGIC("merging the nodes of channel " << channel->GetId());
+            for (std::size_t i = 1; i < nodes.size(); ++i)
+            {
+                unite(nodes[0], nodes[i]);
+            }
+            continue;
+        }
+        links.push_back({static_cast<uint64_t>(delay.Get().GetTimeStep()), nodes});
+    }
+
+    // Assign the LP identifiers in increasing order of the smallest node id
+    m_contextToLp.assign(nNodes, 0);
+    std::vector<uint32_t> setToLp(nNodes, 0);
+    uint32_t nLps = 1;
+    for (uint32_t n = 0; n < nNodes; ++n)
+    {
+        uint32_t root = find(n);
+        if (root == n)
+        {
+            setToLp[n] = nLps++;
+        }
+        m_contextToLp[n] = setToLp[root];
+    }
+
+    m_lookahead = std::numeric_limits<uint64_t>::max();
+    for (const auto& link : links)
+    {
+        for (std::size_t i = 1; i < link.nodes.size(); ++i)
+        {
+            if (m_contextToLp[link.nodes[i]] != m_contextToLp[link.nodes[0]])
+            {
+                m_lookahead = std::min(m_lookahead, link.delay);
+                break;
+            }
+        }
+    }
+
+    // Create the LPs and move the pending events to the LP of their context
+    LogicalProcess* publicLp = m_lps[0].get();
+    for (uint32_t i = 1; i < nLps; ++i)
+    {
+        auto lp = std::make_unique<LogicalProcess>(i, m_schedulerFactory);
+        lp->SetNextUid(publicLp->GetNextUid());
+        lp->AdvanceTo(publicLp->GetCurrentTs());
+        m_lps.push_back(std::move(lp));
+    }
+    m_partitioned = true;
+
+    std::vector<Scheduler::Event> events;
+    while (!publicLp->IsEmpty())
+    {
+        events.push_back(publicLp->RemoveNext());
+    }
+    for (const auto& ev : events)
+    {
+        GetLogicalProcess(ev.key.m_context)->InsertEvent(ev);
+    }
+
+    NS_LOG_INFO("partitioned " << nNodes << " nodes into " << nLps - 1
+                               << " logical processes, lookahead " << GetLookahead());
+}
+
+LogicalProcess*
+MultithreadedSimulatorImpl::GetLogicalProcess(uint32_t context) const
+{
+    if (context < m_contextToLp.size())
+    {
+        return m_lps[m_contextToLp[context]].get();
+    }
+    // Events without context, or with a context which is not a node id
+    return m_lps[0].get();
+}
+
+LogicalProcess*
+MultithreadedSimulatorImpl::GetCurrentLogicalProcess() const
+{
+    if (g_currentLp != nullptr)
+    {
+        return g_currentLp;
+    }
+    return m_lps[0].get();
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished() const
+{
+    if (m_stop)
+    {
+        return true;
+    }
+    return std::all_of(m_lps.begin(), m_lps.end(), [](const auto& lp) { return lp->IsEmpty(); });
+}
+
+void
+MultithreadedSimulatorImpl::ReceiveMessages()
+{
+    for (auto& lp : m_lps)
+    {
+        lp->ReceiveMessages();
+    }
+
+    EventsWithContext eventsWithContext;
+    {
+        std::unique_lock lock{m_eventsWithContextMutex};
+        m_eventsWithContext.swap(eventsWithContext);
+    }
+    for (const auto& event : eventsWithContext)
+    {
+        LogicalProcess* lp = GetLogicalProcess(event.context);
+        lp->Insert(event.context, lp->GetCurrentTs() + event.timestamp, event.event);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::ProcessLogicalProcesses()
+{
+    auto nLps = static_cast<uint32_t>(m_roundLps.size());
+    for (uint32_t i = m_nextLp.fetch_add(1); i < nLps; i = m_nextLp.fetch_add(1))
+    {
+        LogicalProcess* lp = m_roundLps[i];
+        g_currentLp = lp;
+        lp->ProcessEvents(m_grantedTs, nullptr);
+        g_currentLp = nullptr;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::RunParallelRound()
+{
+    // Only the LPs with events in the time window take part in the round;
+    // the longest-running ones are started first to balance the load.
+    m_roundLps.clear();
+    for (uint32_t i = 1; i < m_lps.size(); ++i)
+    {
+        if (m_lps[i]->GetNextTs() < m_grantedTs)
+        {
+            m_roundLps.push_back(m_lps[i].get());
+        }
+    }
+    std::stable_sort(m_roundLps.begin(),
+                     m_roundLps.end(),
+                     [](const LogicalProcess* a, const LogicalProcess* b) {
+                         return a->GetExecutionTime() > b->GetExecutionTime();
+                     });
+
+    m_parallel = true;
+    m_nextLp = 0;
+    if (m_roundLps.size() > 1 && !m_threads.empty())
+    {
+        {
+            std::unique_lock lock{m_poolMutex};
+            m_roundGeneration++;
+            m_roundOpen = true;
+        }
+        m_roundStart.notify_all();
+        ProcessLogicalProcesses();
+        {
+            std::unique_lock lock{m_poolMutex};
+            m_roundEnd.wait(lock, [this] { return m_busyThreads == 0; });
+            m_roundOpen = false;
+        }
+    }
+    else
+    {
+        ProcessLogicalProcesses();
+    }
+    m_parallel = false;
+    m_roundCount++;
+}
+
+void
+MultithreadedSimulatorImpl::WorkerLoop()
+{
+    uint64_t generation = 0;
+    while (true)
+    {
+        {
+            std::unique_lock lock{m_poolMutex};
+            m_roundStart.wait(lock, [this, generation] {
+                return m_exitThreads || (m_roundOpen && m_roundGeneration != generation);
+            });
+            if (m_exitThreads)
+            {
+                return;
+            }
+            generation = m_roundGeneration;
+            m_busyThreads++;
+        }
+        ProcessLogicalProcesses();
+        {
+            std::unique_lock lock{m_poolMutex};
+            m_busyThreads--;
+        }
+        m_roundEnd.notify_all();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::StartThreads()
+{
+    NS_LOG_FUNCTION(this);
+    uint32_t nThreads = m_maxThreads;
+    if (nThreads == 0)
+    {
+        nThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    // The public LP is never executed concurrently with the other LPs
+    nThreads = std::min(nThreads, static_cast<uint32_t>(m_lps.size() - 1));
+    for (uint32_t i = 1; i < nThreads; ++i)
+    {
+        m_threads.emplace_back(&MultithreadedSimulatorImpl::WorkerLoop, this);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::StopThreads()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_threads.empty())
+    {
+        return;
+    }
+    {
+        std::unique_lock lock{m_poolMutex};
+        m_exitThreads = true;
+    }
+    m_roundStart.notify_all();
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+    m_threads.clear();
+    m_exitThreads = false;
+}
+
+void
+MultithreadedSimulatorImpl::Run()
+{
+    NS_LOG_FUNCTION(this);
+    // Set the current threadId as the main threadId
+    m_mainThreadId = std::this_thread::get_id();
+    if (!m_partitioned)
+    {
+        Partition();
+    }
+    m_stop = false;
+    StartThreads();
+
+    LogicalProcess* publicLp = m_lps[0].get();
+    while (!m_stop)
+    {
+        ReceiveMessages();
+
+        uint64_t nextTs = std::numeric_limits<uint64_t>::max();
+        for (uint32_t i = 1; i < m_lps.size(); ++i)
+        {
+            nextTs = std::min(nextTs, m_lps[i]->GetNextTs());
+        }
+        uint64_t publicTs = publicLp->GetNextTs();
+        if (publicTs == std::numeric_limits<uint64_t>::max() &&
+            nextTs == std::numeric_limits<uint64_t>::max())
+        {
+            break;
+        }
+
+        if (publicTs <= nextTs)
+        {
+            // Events without context may touch any node: execute them alone
+            g_currentLp = publicLp;
+            publicLp->ProcessEvents(publicTs + 1, &m_stop);
+            g_currentLp = nullptr;
+            continue;
+        }
+
+        m_grantedTs = nextTs + std::min(m_lookahead, std::numeric_limits<uint64_t>::max() - nextTs);
+        m_grantedTs = std::min(m_grantedTs, publicTs);
+        RunParallelRound();
+    }
+
+    StopThreads();
+
+    // The clock seen from the main program is the one of the most advanced LP
+    uint64_t ts = publicLp->GetCurrentTs();
+    for (const auto& lp : m_lps)
+    {
+        ts = std::max(ts, lp->GetCurrentTs());
+    }
+    publicLp->AdvanceTo(ts);
+}
+
+void
+MultithreadedSimulatorImpl::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    m_stop = true;
+}
+
+EventId
+MultithreadedSimulatorImpl::Stop(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep());
+    return Simulator::Schedule(delay, &Simulator::Stop);
+}
+
+EventId
+MultithreadedSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_ASSERT_MSG(g_currentLp != nullptr || m_mainThreadId == std::this_thread::get_id(),
+                  "Simulator::Schedule Thread-unsafe invocation!");
+    return GetCurrentLogicalProcess()->Schedule(delay, event);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext(uint32_t context,
+                                                const Time& delay,
+                                                EventImpl* event)
+{
+    LogicalProcess* current = g_currentLp;
+    if (current == nullptr && m_mainThreadId != std::this_thread::get_id())
+    {
+        // Foreign thread: current time added in ReceiveMessages()
+        EventWithContext ev;
+        ev.context = context;
+        ev.timestamp = delay.GetTimeStep();
+        ev.event = event;
+        {
+            std::unique_lock lock{m_eventsWithContextMutex};
+            m_eventsWithContext.push_back(ev);
+        }
+        return;
+    }
+
+    if (current == nullptr)
+    {
+        current = m_lps[0].get();
+    }
+    uint64_t ts = current->GetCurrentTs() + delay.GetTimeStep();
+    LogicalProcess* target = GetLogicalProcess(context);
+    if (target == current || !m_parallel)
+    {
+        target->Insert(context, ts, event);
+        return;
+    }
+    NS_ASSERT_MSG(ts >= m_grantedTs,
+                  "Event sent from logical process "
+                      << current->GetId() << " to logical process " << target->GetId()
+                      << " with a delay of " << delay
+                      << " lower than the lookahead " << GetLookahead());
+    target->Post(context, ts, current->GetId(), current->NextSendSequence(), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    return Schedule(Time(0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    NS_ASSERT_MSG(m_mainThreadId == std::this_thread::get_id() && !m_parallel,
+                  "Simulator::ScheduleDestroy Thread-unsafe invocation!");
+
+    EventId id(Ptr<EventImpl>(event, false),
+               GetCurrentLogicalProcess()->GetCurrentTs(),
+               0xffffffff,
+               EventId::UID::DESTROY);
+    m_destroyEvents.push_back(id);
+    return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    return TimeStep(GetCurrentLogicalProcess()->GetCurrentTs());
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft(const EventId& id) const
+{
+    if (IsExpired(id))
+    {
+        return TimeStep(0);
+    }
+    return TimeStep(id.GetTs() - GetLogicalProcess(id.GetContext())->GetCurrentTs());
+}
+
+void
+MultithreadedSimulatorImpl::Remove(const EventId& id)
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        // destroy events.
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                m_destroyEvents.erase(i);
+                break;
+            }
+        }
+        return;
+    }
+    LogicalProcess* lp = GetLogicalProcess(id.GetContext());
+    NS_ASSERT_MSG(!m_parallel || lp == g_currentLp,
+                  "Cannot remove an event of another logical process");
+    lp->Remove(id);
+}
+
+void
+MultithreadedSimulatorImpl::Cancel(const EventId& id)
+{
+    if (!IsExpired(id))
+    {
+        id.PeekEventImpl()->Cancel();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired(const EventId& id) const
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+        {
+            return true;
+        }
+        // destroy events.
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    return GetLogicalProcess(id.GetContext())->IsExpired(id);
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime() const
+{
+    return TimeStep(0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext() const
+{
+    return GetCurrentLogicalProcess()->GetContext();
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount() const
+{
+    uint64_t count = 0;
+    for (const auto& lp : m_lps)
+    {
+        count += lp->GetEventCount();
+    }
+    return count;
+}
+
+Time
+MultithreadedSimulatorImpl::GetLookahead() const
+{
+    if (m_lookahead > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+    {
+        return GetMaximumSimulationTime();
+    }
+    return TimeStep(m_lookahead);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetLogicalProcessCount() const
+{
+    return static_cast<uint32_t>(m_lps.size());
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetLogicalProcessId(uint32_t context) const
+{
+    return GetLogicalProcess(context)->GetId();
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetRoundCount() const
+{
+    return m_roundCount;
+}
+
+} // namespace ns3
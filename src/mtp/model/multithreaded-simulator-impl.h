@@ -0,0 +1,240 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "logical-process.h"
+
+#include "ns3/simulator-impl.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup mtp
+ * Declaration of class ns3::MultithreadedSimulatorImpl.
+ */
+
+namespace ns3
+{
+
+/**
+ * \defgroup mtp Multithreaded Simulation
+ *
+ * Execution of a simulation on several threads of a shared-memory machine.
+ */
+
+/**
+ * \ingroup mtp
+ *
+ * \brief Shared-memory parallel simulator implementation.
+ *
+ * The nodes of the simulation are partitioned into logical processes
+ * (LPs) when Simulator::Run is first called.  Nodes attached to a
+ * channel whose \c Delay attribute is lower than \c MinLookahead (or
+ * which has no \c Delay attribute at all, as for wireless channels) are
+ * placed in the same LP.  The lookahead is the smallest delay of the
+ * channels connecting two different LPs, in the same way as
+ * DistributedSimulatorImpl computes it for the links between MPI ranks.
+ *
+ * Events are assigned to LPs by their context (the node id).  Events
+ * without a context (e.g., scheduled from the main program) belong to a
+ * public LP, which is always executed alone by the main thread.  The
+ * simulation then proceeds in synchronization rounds: in each round, all
+ * the LPs execute concurrently on a pool of threads the events whose
+ * timestamp is lower than the granted time, i.e., the earliest pending
+ * timestamp plus the lookahead.  Events sent across LPs are exchanged at
+ * the end of the round, in an order which does not depend on the thread
+ * interleaving, so the results do not depend on the number of threads.
+ *
+ * Models sharing state between nodes other than through
+ * Simulator::ScheduleWithContext are not safe to run with this
+ * implementation.  ns-3 should be configured with \c NS3_MTP to make
+ * reference counting thread-safe when packets cross LPs.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    MultithreadedSimulatorImpl();
+    /** Destructor. */
+    ~MultithreadedSimulatorImpl() override;
+
+    // Inherited
+    void Destroy() override;
+    bool IsFinished() const override;
+    void Stop() override;
+    EventId Stop(const Time& delay) override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+    void Remove(const EventId& id) override;
+    void Cancel(const EventId& id) override;
+    bool IsExpired(const EventId& id) const override;
+    void Run() override;
+    Time Now() const override;
+    Time GetDelayLeft(const EventId& id) const override;
+    Time GetMaximumSimulationTime() const override;
+    void SetScheduler(ObjectFactory schedulerFactory) override;
+    uint32_t GetSystemId() const override;
+    uint32_t GetContext() const override;
+    uint64_t GetEventCount() const override;
+
+    /**
+     * Get the lookahead computed when the nodes were partitioned.
+     * \return The lookahead.
+     */
+    Time GetLookahead() const;
+    /**
+     * Get the number of logical processes, including the public one.
+     *
+     * Before the first call to Simulator::Run, only the public LP exists.
+     *
+     * \return The number of LPs.
+     */
+    uint32_t GetLogicalProcessCount() const;
+    /**
+     * Get the LP to which the events of a context are assigned.
+     * \param [in] context The context.
+     * \return The LP identifier; 0 is the public LP.
+     */
+    uint32_t GetLogicalProcessId(uint32_t context) const;
+    /**
+     * Get the number of synchronization rounds executed.
+     * \return The number of rounds.
+     */
+    uint64_t GetRoundCount() const;
+
+  private:
+    void DoDispose() override;
+
+    /**
+     * Partition the nodes into LPs, compute the lookahead and move
+     * the pending events to the LP of their context.
+     */
+    void Partition();
+    /**
+     * Get the LP of a context.
+     * \param [in] context The context.
+     * \return The LP.
+     */
+    LogicalProcess* GetLogicalProcess(uint32_t context) const;
+    /**
+     * Get the LP executing the calling thread, or the public LP.
+     * \return The LP.
+     */
+    LogicalProcess* GetCurrentLogicalProcess() const;
+    /** Move the events from foreign threads and other LPs into the event lists. */
+    void ReceiveMessages();
+    /** Execute the LPs of the current round, until none is left. */
+    void ProcessLogicalProcesses();
+    /** Execute a parallel round, up to m_grantedTs. */
+    void RunParallelRound();
+    /** Start the worker threads. */
+    void StartThreads();
+    /** Stop and join the worker threads. */
+    void StopThreads();
+    /** Main loop of a worker thread. */
+    void WorkerLoop();
+
+    /** Wrap an event scheduled by a foreign thread. */
+    struct EventWithContext
+    {
+        /** The event context. */
+        uint32_t context;
+        /** Event delay. */
+        uint64_t timestamp;
+        /** The event implementation. */
+        EventImpl* event;
+    };
+
+    /** The LPs; index 0 is the public LP. */
+    std::vector<std::unique_ptr<LogicalProcess>> m_lps;
+    /** LP identifier for each context, indexed by node id. */
+    std::vector<uint32_t> m_contextToLp;
+    /** Flag \c true once the nodes have been partitioned. */
+    bool m_partitioned;
+    /** The scheduler factory, used to create the LP event lists. */
+    ObjectFactory m_schedulerFactory;
+
+    /** Container type for the events to run at Simulator::Destroy() */
+    typedef std::list<EventId> DestroyEvents;
+    /** The container of events to run at Destroy. */
+    DestroyEvents m_destroyEvents;
+
+    /** Container type for the events from foreign threads. */
+    typedef std::list<EventWithContext> EventsWithContext;
+    /** The container of events from foreign threads. */
+    EventsWithContext m_eventsWithContext;
+    /** Mutex to control access to the list of events from foreign threads. */
+    std::mutex m_eventsWithContextMutex;
+
+    /** Flag calling for the end of the simulation. */
+    std::atomic<bool> m_stop;
+    /** Flag \c true while the LPs are executed concurrently. */
+    bool m_parallel;
+    /** Exclusive upper bound of the current round. */
+    uint64_t m_grantedTs;
+    /** Lookahead between LPs, in time steps. */
+    uint64_t m_lookahead;
+    /** Lower bound on the delay of a channel separating two LPs. */
+    Time m_minLookahead;
+    /** Maximum number of threads, including the main thread. */
+    uint32_t m_maxThreads;
+    /** Number of synchronization rounds executed. */
+    uint64_t m_roundCount;
+
+    /** The LPs executed in the current round, longest-running first. */
+    std::vector<LogicalProcess*> m_roundLps;
+    /** Index of the next LP to execute in the current round. */
+    std::atomic<uint32_t> m_nextLp;
+    /** The worker threads. */
+    std::vector<std::thread> m_threads;
+    /** Mutex protecting the state of the thread pool. */
+    std::mutex m_poolMutex;
+    /** Condition variable signalling the start of a round. */
+    std::condition_variable m_roundStart;
+    /** Condition variable signalling the end of a round. */
+    std::condition_variable m_roundEnd;
+    /** Generation number of the current round. */
+    uint64_t m_roundGeneration;
+    /** Flag \c true while worker threads may join the current round. */
+    bool m_roundOpen;
+    /** Number of worker threads executing LPs of the current round. */
+    uint32_t m_busyThreads;
+    /** Flag asking the worker threads to exit. */
+    bool m_exitThreads;
+
+    /** Main execution thread. */
+    std::thread::id m_mainThreadId;
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
@@ -0,0 +1,325 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/default-simulator-impl.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/node-container.h"
+#include "ns3/object-factory.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup mtp-tests
+ * Multithreaded simulator implementation test suite.
+ */
+
+/**
+ * \ingroup mtp
+ * \defgroup mtp-tests Multithreaded simulation tests
+ */
+
+using namespace ns3;
+
+/**
+ * \ingroup mtp-tests
+ *
+ * Topology used by the tests: a chain of six nodes.
+ *
+ * \verbatim
+   n0 --1ms-- n1 --0ms-- n2 --2ms-- n3 --3ms-- n4 --0.5ms-- n5
+   \endverbatim
+ *
+ * With a MinLookahead of 1 ms, the expected partition is
+ * {n0}, {n1, n2}, {n3}, {n4, n5}, with a lookahead of 1 ms.
+ */
+class MtpTopology
+{
+  public:
+    /** Build the topology. */
+    MtpTopology();
+
+    /**
+     * Get the neighbors of a node.
+     * \param node The node id.
+     * \return The neighbors and the delay of the channel to them.
+     */
+    const std::vector<std::pair<uint32_t, Time>>& GetNeighbors(uint32_t node) const;
+
+    NodeContainer m_nodes; //!< The nodes.
+
+  private:
+    /**
+     * Connect two nodes.
+     * \param a The first node id.
+     * \param b The second node id.
+     * \param delay The channel delay.
+     */
+    void Connect(uint32_t a, uint32_t b, Time delay);
+
+    /// The neighbors of each node
+    std::map<uint32_t, std::vector<std::pair<uint32_t, Time>>> m_neighbors;
+};
+
+MtpTopology::MtpTopology()
+{
+    m_nodes.Create(6);
+    Connect(0, 1, MilliSeconds(1));
+    Connect(1, 2, Time(0));
+    Connect(2, 3, MilliSeconds(2));
+    Connect(3, 4, MilliSeconds(3));
+    Connect(4, 5, MicroSeconds(500));
+}
+
+void
+MtpTopology::Connect(uint32_t a, uint32_t b, Time delay)
+{
+    SimpleNetDeviceHelper helper;
+    helper.SetChannelAttribute("Delay", TimeValue(delay));
+    helper.Install(NodeContainer(m_nodes.Get(a), m_nodes.Get(b)));
+    m_neighbors[a].emplace_back(b, delay);
+    m_neighbors[b].emplace_back(a, delay);
+}
+
+const std::vector<std::pair<uint32_t, Time>>&
+MtpTopology::GetNeighbors(uint32_t node) const
+{
+    return m_neighbors.at(node);
+}
+
+/**
+ * \ingroup mtp-tests
+ *
+ * Check the partitioning of the nodes into logical processes.
+ */
+class MtpPartitionTestCase : public TestCase
+{
+  public:
+    MtpPartitionTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+MtpPartitionTestCase::MtpPartitionTestCase()
+    : TestCase("Check the partitioning of the nodes into logical processes")
+{
+}
+
+void
+MtpPartitionTestCase::DoRun()
+{
+    ObjectFactory factory("ns3::MultithreadedSimulatorImpl");
+    factory.Set("MinLookahead", TimeValue(MilliSeconds(1)));
+    Ptr<MultithreadedSimulatorImpl> impl = factory.Create<MultithreadedSimulatorImpl>();
+    Simulator::SetImplementation(impl);
+
+    MtpTopology topology;
+    NS_TEST_ASSERT_MSG_EQ(impl->GetLogicalProcessCount(), 1, "Only the public LP before Run");
+
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(impl->GetLogicalProcessCount(), 5, "Unexpected number of LPs");
+    NS_TEST_ASSERT_MSG_EQ(impl->GetLookahead(), MilliSeconds(1), "Unexpected lookahead");
+    NS_TEST_ASSERT_MSG_EQ(impl->GetLogicalProcessId(0), 1, "Unexpected LP for node 0");
+    NS_TEST_ASSERT_MSG_EQ(impl->GetLogicalProcessId(1), 2, "Unexpected LP for node 1");
+    NS_TEST_ASSERT_MSG_EQ(impl->GetLogicalProcessId(2), 2, "Unexpected LP for node 2");
+    NS_TEST_ASSERT_MSG_EQ(impl->GetLogicalProcessId(3), 3, "Unexpected LP for node 3");
+    NS_TEST_ASSERT_MSG_EQ(impl->GetLogicalProcessId(4), 4, "Unexpected LP for node 4");
+    NS_TEST_ASSERT_MSG_EQ(impl->GetLogicalProcessId(5), 4, "Unexpected LP for node 5");
+    NS_TEST_ASSERT_MSG_EQ(impl->GetLogicalProcessId(Simulator::NO_CONTEXT),
+                          0,
+                          "Events without context belong to the public LP");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup mtp-tests
+ *
+ * Run a flooding workload on the test topology and check that the
+ * events are executed at the same times as with DefaultSimulatorImpl,
+ * and in the same order regardless of the number of threads.
+ */
+class MtpEventsTestCase : public TestCase
+{
+  public:
+    MtpEventsTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// Per-node trace of the executed events: (timestamp, value)
+    typedef std::vector<std::vector<std::pair<int64_t, int64_t>>> Traces;
+
+    /**
+     * Run the workload.
+     * \param impl The simulator implementation.
+     * \return The per-node traces.
+     */
+    Traces RunWorkload(Ptr<SimulatorImpl> impl);
+    /**
+     * Receive a flooded message.
+     * \param node The receiving node.
+     * \param hops The remaining number of hops.
+     */
+    void Receive(uint32_t node, uint32_t hops);
+    /**
+     * A timer which is expected to be cancelled while messages keep arriving.
+     * \param node The node.
+     */
+    void Timeout(uint32_t node);
+    /** Public event, scheduled without context. */
+    void Public();
+
+    const MtpTopology* m_topology; //!< The topology of the current run.
+    Traces m_traces;               //!< The per-node traces of the current run.
+    std::vector<EventId> m_timers; //!< The per-node timers.
+    std::vector<int64_t> m_public; //!< The times of the public events.
+};
+
+MtpEventsTestCase::MtpEventsTestCase()
+    : TestCase("Check event execution with MultithreadedSimulatorImpl")
+{
+}
+
+void
+MtpEventsTestCase::Receive(uint32_t node, uint32_t hops)
+{
+    NS_ASSERT(Simulator::GetContext() == node);
+    m_traces[node].emplace_back(Simulator::Now().GetTimeStep(), hops);
+    if (m_timers[node].IsPending())
+    {
+        Simulator::Cancel(m_timers[node]);
+    }
+    m_timers[node] =
+        Simulator::Schedule(MicroSeconds(1500), &MtpEventsTestCase::Timeout, this, node);
+    if (hops == 0)
+    {
+        return;
+    }
+    for (const auto& [neighbor, delay] : m_topology->GetNeighbors(node))
+    {
+        Simulator::ScheduleWithContext(neighbor,
+                                       delay + MicroSeconds(node * 10 + hops),
+                                       &MtpEventsTestCase::Receive,
+                                       this,
+                                       neighbor,
+                                       hops - 1);
+    }
+}
+
+void
+MtpEventsTestCase::Timeout(uint32_t node)
+{
+    m_traces[node].emplace_back(Simulator::Now().GetTimeStep(), -1);
+}
+
+void
+MtpEventsTestCase::Public()
+{
+    m_public.push_back(Simulator::Now().GetTimeStep());
+    for (uint32_t i = 0; i < m_topology->m_nodes.GetN(); ++i)
+    {
+        Simulator::ScheduleWithContext(i, Time(0), &MtpEventsTestCase::Receive, this, i, 2);
+    }
+}
+
+MtpEventsTestCase::Traces
+MtpEventsTestCase::RunWorkload(Ptr<SimulatorImpl> impl)
+{
+    Simulator::SetImplementation(impl);
+    MtpTopology topology;
+    m_topology = &topology;
+    m_traces.assign(topology.m_nodes.GetN(), {});
+    m_timers.assign(topology.m_nodes.GetN(), EventId());
+    m_public.clear();
+
+    for (uint32_t i = 0; i < topology.m_nodes.GetN(); ++i)
+    {
+        Simulator::ScheduleWithContext(i, MicroSeconds(i), &MtpEventsTestCase::Receive, this, i, 8);
+    }
+    Simulator::Schedule(MilliSeconds(7), &MtpEventsTestCase::Public, this);
+    Simulator::Stop(MilliSeconds(12));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), MilliSeconds(12), "Simulation stopped at wrong time");
+    NS_TEST_EXPECT_MSG_EQ(m_public.size(), 1, "Public event not executed");
+    NS_TEST_EXPECT_MSG_EQ(m_public.front(), MilliSeconds(7).GetTimeStep(), "Wrong public time");
+
+    Simulator::Destroy();
+    m_topology = nullptr;
+    return m_traces;
+}
+
+void
+MtpEventsTestCase::DoRun()
+{
+    Traces reference = RunWorkload(CreateObject<DefaultSimulatorImpl>());
+
+    std::vector<Traces> results;
+    for (uint32_t threads : {1, 2, 4})
+    {
+        ObjectFactory factory("ns3::MultithreadedSimulatorImpl");
+        factory.Set("MinLookahead", TimeValue(MilliSeconds(1)));
+        factory.Set("MaxThreads", UintegerValue(threads));
+        results.push_back(RunWorkload(factory.Create<SimulatorImpl>()));
+    }
+
+    for (const auto& result : results)
+    {
+        NS_TEST_ASSERT_MSG_EQ((result == results.front()),
+                              true,
+                              "Event order depends on the number of threads");
+    }
+
+    // Events of a node with equal timestamps may be executed in a
+    // different order than with DefaultSimulatorImpl.
+    Traces result = results.front();
+    for (std::size_t node = 0; node < reference.size(); ++node)
+    {
+        std::sort(reference[node].begin(), reference[node].end());
+        std::sort(result[node].begin(), result[node].end());
+        NS_TEST_ASSERT_MSG_GT(reference[node].size(), 0, "No event executed on node " << node);
+        NS_TEST_ASSERT_MSG_EQ((reference[node] == result[node]),
+                              true,
+                              "Events of node " << node << " differ from DefaultSimulatorImpl");
+    }
+}
+
+/**
+ * \ingroup mtp-tests
+ *
+ * The multithreaded simulation test suite.
+ */
+class MtpTestSuite : public TestSuite
+{
+  public:
+    MtpTestSuite()
+        : TestSuite("mtp", Type::UNIT)
+    {
+        AddTestCase(new MtpPartitionTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new MtpEventsTestCase(), TestCase::Duration::QUICK);
+    }
+};
+
+static MtpTestSuite g_mtpTestSuite; //!< Static variable for test initialization
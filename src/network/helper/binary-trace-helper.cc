@@ -0,0 +1,142 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "binary-trace-helper.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("BinaryTraceHelper");
+
+namespace
+{
+
+/**
+ * \brief Trace sink writing a record of a binary trace file
+ *
+ * \param writer the writer of the binary trace file
+ * \param node the id of the node
+ * \param device the index of the device in the node
+ * \param event the kind of event
+ * \param p the packet
+ */
+void
+BinaryTraceSink(Ptr<BinaryTraceWriter> writer,
+                uint32_t node,
+                uint32_t device,
+                BinaryTraceRecord::Event event,
+                Ptr<const Packet> p)
+{
+    writer->Write(Simulator::Now(), node, device, event, p);
+}
+
+/**
+ * \brief Connect a trace source to BinaryTraceSink
+ *
+ * \param object the object which has the trace source
+ * \param name the name of the trace source
+ * \param writer the writer of the binary trace file
+ * \param nd the device
+ * \param event the kind of event
+ */
+void
+ConnectBinaryTraceSink(Ptr<Object> object,
+                       const std::string& name,
+                       Ptr<BinaryTraceWriter> writer,
+                       Ptr<NetDevice> nd,
+                       BinaryTraceRecord::Event event)
+{
+    bool connected =
+        object->TraceConnectWithoutContext(name,
+                                           MakeBoundCallback(&BinaryTraceSink,
+                                                             writer,
+                                                             nd->GetNode()->GetId(),
+                                                             nd->GetIfIndex(),
+                                                             event));
+    NS_LOG_LOGIC((connected ? "Connected " : "No trace source ") << name);
+}
+
+} // namespace
+
+Ptr<BinaryTraceWriter>
+BinaryTraceHelper::CreateFile(const std::string& filename, uint16_t headerBytes)
+{
+    NS_LOG_FUNCTION(filename << headerBytes);
+    Ptr<BinaryTraceWriter> writer = Create<BinaryTraceWriter>();
+    writer->Open(filename, headerBytes);
+    NS_ABORT_MSG_IF(writer->Fail(), "Unable to Open " << filename << " for write");
+    return writer;
+}
+
+void
+BinaryTraceHelper::Enable(Ptr<BinaryTraceWriter> writer, Ptr<NetDevice> nd)
+{
+    NS_LOG_FUNCTION(writer << nd);
+    PointerValue queue;
+    if (nd->GetAttributeFailSafe("TxQueue", queue) && queue.Get<Object>())
+    {
+        ConnectBinaryTraceSink(queue.Get<Object>(),
+                               "Enqueue",
+                               writer,
+                               nd,
+                               BinaryTraceRecord::ENQUEUE);
+        ConnectBinaryTraceSink(queue.Get<Object>(),
+                               "Dequeue",
+                               writer,
+                               nd,
+                               BinaryTraceRecord::DEQUEUE);
+        ConnectBinaryTraceSink(queue.Get<Object>(), "Drop", writer, nd, BinaryTraceRecord::DROP);
+    }
+    ConnectBinaryTraceSink(nd, "MacRx", writer, nd, BinaryTraceRecord::RECEIVE);
+    ConnectBinaryTraceSink(nd, "PhyRxDrop", writer, nd, BinaryTraceRecord::PHY_RX_DROP);
+}
+
+void
+BinaryTraceHelper::Enable(Ptr<BinaryTraceWriter> writer, NetDeviceContainer d)
+{
+    for (auto i = d.Begin(); i != d.End(); ++i)
+    {
+        Enable(writer, *i);
+    }
+}
+
+void
+BinaryTraceHelper::Enable(Ptr<BinaryTraceWriter> writer, NodeContainer n)
+{
+    for (auto i = n.Begin(); i != n.End(); ++i)
+    {
+        Ptr<Node> node = *i;
+        for (uint32_t j = 0; j < node->GetNDevices(); ++j)
+        {
+            Enable(writer, node->GetDevice(j));
+        }
+    }
+}
+
+void
+BinaryTraceHelper::EnableAll(Ptr<BinaryTraceWriter> writer)
+{
+    Enable(writer, NodeContainer::GetGlobal());
+}
+
+} // namespace ns3
@@ -0,0 +1,91 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BINARY_TRACE_HELPER_H
+#define BINARY_TRACE_HELPER_H
+
+#include "net-device-container.h"
+#include "node-container.h"
+
+#include "ns3/binary-trace.h"
+
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * \ingroup network
+ *
+ * \brief Write the events of the devices to a binary trace file
+ *
+ * This is a much faster alternative to the ascii traces of
+ * AsciiTraceHelperForDevice: the same events are recorded, from the same
+ * trace sources of the devices, i.e., the "Enqueue", "Dequeue" and "Drop"
+ * trace sources of the queue of the "TxQueue" attribute, and the "MacRx"
+ * and "PhyRxDrop" trace sources, but the packets are not printed.  The
+ * trace sources that a device does not have are ignored.
+ *
+ * The events of all the devices enabled are written to the same file,
+ * which is written until the BinaryTraceWriter is closed or destroyed.
+ * BinaryTraceReader reads the file back, and converts it to text.
+ */
+class BinaryTraceHelper
+{
+  public:
+    /**
+     * @brief Create a binary trace file
+     *
+     * @param filename The name of the file.
+     * @param headerBytes The number of bytes at the start of each packet to record.
+     * @returns a writer of the file, to pass to the Enable methods.
+     */
+    Ptr<BinaryTraceWriter> CreateFile(const std::string& filename, uint16_t headerBytes = 0);
+
+    /**
+     * @brief Enable binary traces on a device
+     *
+     * @param writer The writer of the binary trace file.
+     * @param nd The device.
+     */
+    void Enable(Ptr<BinaryTraceWriter> writer, Ptr<NetDevice> nd);
+
+    /**
+     * @brief Enable binary traces on each device in the container
+     *
+     * @param writer The writer of the binary trace file.
+     * @param d The container of devices.
+     */
+    void Enable(Ptr<BinaryTraceWriter> writer, NetDeviceContainer d);
+
+    /**
+     * @brief Enable binary traces on each device of the nodes in the container
+     *
+     * @param writer The writer of the binary trace file.
+     * @param n The container of nodes.
+     */
+    void Enable(Ptr<BinaryTraceWriter> writer, NodeContainer n);
+
+    /**
+     * @brief Enable binary traces on each device of all the nodes
+     *
+     * @param writer The writer of the binary trace file.
+     */
+    void EnableAll(Ptr<BinaryTraceWriter> writer);
+};
+
+} // namespace ns3
+
+#endif /* BINARY_TRACE_HELPER_H */
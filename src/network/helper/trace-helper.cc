@@ -24,6 +24,7 @@
 #include "ns3/net-device.h"
 #include "ns3/node.h"
 #include "ns3/pcap-file-wrapper.h"
+#include "ns3/pcapng-file.h"
 #include "ns3/ptr.h"
 
 #include <fstream>
@@ -35,6 +36,9 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("TraceHelper");
 
+/// The PCAP-NG file to which the pcap traces are written, if aggregated
+static Ptr<PcapNgFile> g_aggregatedFile;
+
 PcapHelper::PcapHelper()
 {
     NS_LOG_FUNCTION_NOARGS();
@@ -55,6 +59,22 @@ PcapHelper::CreateFile(std::string filename,
     NS_LOG_FUNCTION(filename << filemode << dataLinkType << snapLen << tzCorrection);
 
     Ptr<PcapFileWrapper> file = CreateObject<PcapFileWrapper>();
+    if (g_aggregatedFile)
+    {
+        std::string extension = ".pcap";
+        std::string interfaceName = filename;
+        if (interfaceName.size() > extension.size() &&
+            interfaceName.compare(interfaceName.size() - extension.size(),
+                                  extension.size(),
+                                  extension) == 0)
+        {
+            interfaceName.resize(interfaceName.size() - extension.size());
+        }
+        file->Open(g_aggregatedFile, interfaceName);
+        file->Init(dataLinkType, snapLen, tzCorrection);
+        NS_ABORT_MSG_IF(file->Fail(), "Unable to write to the aggregated PCAP-NG file");
+        return file;
+    }
     file->Open(filename, filemode);
     NS_ABORT_MSG_IF(file->Fail(), "Unable to Open " << filename << " for mode " << filemode);
 
@@ -75,6 +95,22 @@ PcapHelper::CreateFile(std::string filename,
     return file;
 }
 
+void
+PcapHelper::EnableAggregation(std::string filename, bool compress)
+{
+    NS_LOG_FUNCTION(filename << compress);
+    g_aggregatedFile = Create<PcapNgFile>();
+    g_aggregatedFile->Open(filename, compress);
+    NS_ABORT_MSG_IF(g_aggregatedFile->Fail(), "Unable to Open " << filename);
+}
+
+void
+PcapHelper::DisableAggregation()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    g_aggregatedFile = nullptr;
+}
+
 std::string
 PcapHelper::GetFilenameFromDevice(std::string prefix, Ptr<NetDevice> device, bool useObjectNames)
 {
@@ -116,6 +116,31 @@ class PcapHelper
                                     DataLinkType dataLinkType,
                                     uint32_t snapLen = std::numeric_limits<uint32_t>::max(),
                                     int32_t tzCorrection = 0);
+
+    /**
+     * @brief Write the pcap traces created from now on to a single PCAP-NG file.
+     *
+     * Instead of opening a file of its own, each pcap trace created by
+     * CreateFile(), hence by the EnablePcap methods of the helpers, is
+     * written to an interface of the PCAP-NG file, named after the file
+     * name it would have had without the ".pcap" extension, e.g.,
+     * "prefix-3-1" for the device 1 of the node 3.  This avoids opening
+     * a file per device in large topologies.
+     *
+     * The PCAP-NG file is closed once DisableAggregation() is called and
+     * the traces written to it are destroyed.
+     *
+     * @param filename the name of the PCAP-NG file
+     * @param compress whether the file is compressed with gzip, see
+     * PcapNgFile::IsCompressionSupported()
+     */
+    static void EnableAggregation(std::string filename, bool compress = false);
+
+    /**
+     * @brief Write the pcap traces created from now on to files of their own.
+     */
+    static void DisableAggregation();
+
     /**
      * @brief Hook a trace source to the default trace sink
      *
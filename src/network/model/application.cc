@@ -104,6 +104,25 @@ Application::DoInitialize()
     Object::DoInitialize();
 }
 
+void
+Application::SaveApplicationState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    writer.Write("started", IsInitialized() && m_startEvent.IsExpired());
+    writer.Write("stopped",
+                 IsInitialized() && m_stopTime != TimeStep(0) && m_stopEvent.IsExpired());
+    writer.WriteEvent("start", m_startEvent);
+    writer.WriteEvent("stop", m_stopEvent);
+}
+
+void
+Application::RestoreApplicationState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    m_startEvent = reader.ReadEvent("start", &Application::StartApplication, this);
+    m_stopEvent = reader.ReadEvent("stop", &Application::StopApplication, this);
+}
+
 Ptr<Node>
 Application::GetNode() const
 {
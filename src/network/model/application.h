@@ -22,6 +22,7 @@
 
 #include "node.h"
 
+#include "ns3/checkpoint.h"
 #include "ns3/event-id.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
@@ -52,6 +53,10 @@ class Node;
  *
  * The main purpose of the base class application public API is to
  * provide a uniform way to start and stop applications.
+ *
+ * The applications supporting the checkpoints implement
+ * ns3::Checkpointable, and save their start and stop events with
+ * Application::SaveApplicationState().
  */
 
 /**
@@ -155,6 +160,21 @@ class Application : public Object
     void DoDispose() override;
     void DoInitialize() override;
 
+    /**
+     * \brief Save the start and stop events of the application.
+     * \param writer the checkpoint writer.
+     *
+     * Whether the application has been started and stopped is also
+     * written, as the \c started and \c stopped booleans, so that the
+     * subclasses can restore their sockets.
+     */
+    void SaveApplicationState(CheckpointWriter& writer) const;
+    /**
+     * \brief Restore the start and stop events of the application.
+     * \param reader the checkpoint reader.
+     */
+    void RestoreApplicationState(CheckpointReader& reader);
+
     Ptr<Node> m_node;     //!< The node that this application is installed on
     Time m_startTime;     //!< The simulation time that the application will start
     Time m_stopTime;      //!< The simulation time that the application will end
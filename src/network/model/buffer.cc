@@ -18,6 +18,8 @@
  */
 #include "buffer.h"
 
+#include "packet-memory-pool.h"
+
 #include "ns3/assert.h"
 #include "ns3/log.h"
 
@@ -55,115 +57,10 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("Buffer");
 
 uint32_t Buffer::g_recommendedStart = 0;
-#ifdef BUFFER_FREE_LIST
-/* The following macros are pretty evil but they are needed to allow us to
- * keep track of 3 possible states for the g_freeList variable:
- *  - uninitialized means that no one has created a buffer yet
- *    so no one has created the associated free list (it is created
- *    on-demand when the first buffer is created)
- *  - initialized means that the free list exists and is valid
- *  - destroyed means that the static destructors of this compilation unit
- *    have run so, the free list has been cleared from its content
- * The key is that in destroyed state, we are careful not re-create it
- * which is a typical weakness of lazy evaluation schemes which use
- * '0' as a special value to indicate both un-initialized and destroyed.
- * Note that it is important to use '0' as the marker for un-initialized state
- * because the variable holding this state information is initialized to zero
- * which the compiler assigns to zero-memory which is initialized to _zero_
- * before the constructors run so this ensures perfect handling of crazy
- * constructor orderings.
- */
-#define MAGIC_DESTROYED (~(long)0)
-#define IS_UNINITIALIZED(x) (x == (Buffer::FreeList*)0)
-#define IS_DESTROYED(x) (x == (Buffer::FreeList*)MAGIC_DESTROYED)
-#define IS_INITIALIZED(x) (!IS_UNINITIALIZED(x) && !IS_DESTROYED(x))
-#define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
-#define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList* Buffer::g_freeList = nullptr;
-Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
-
-Buffer::LocalStaticDestructor::~LocalStaticDestructor()
-{
-    NS_LOG_FUNCTION(this);
-    if (IS_INITIALIZED(g_freeList))
-    {
-        for (auto i = g_freeList->begin(); i != g_freeList->end(); i++)
-        {
-            Buffer::Deallocate(*i);
-        }
-        delete g_freeList;
-        g_freeList = DESTROYED;
-    }
-}
-
-void
-Buffer::Recycle(Buffer::Data* data)
-{
-    NS_LOG_FUNCTION(data);
-    NS_ASSERT(data->m_count == 0);
-    NS_ASSERT(!IS_UNINITIALIZED(g_freeList));
-    g_maxSize = std::max(g_maxSize, data->m_size);
-    /* feed into free list */
-    if (data->m_size < g_maxSize || IS_DESTROYED(g_freeList) || g_freeList->size() > 1000)
-    {
-        Buffer::Deallocate(data);
-    }
-    else
-    {
-        NS_ASSERT(IS_INITIALIZED(g_freeList));
-        g_freeList->push_back(data);
-    }
-}
-
-Buffer::Data*
-Buffer::Create(uint32_t dataSize)
-{
-    NS_LOG_FUNCTION(dataSize);
-    /* try to find a buffer correctly sized. */
-    if (IS_UNINITIALIZED(g_freeList))
-    {
-        g_freeList = new Buffer::FreeList();
-    }
-    else if (IS_INITIALIZED(g_freeList))
-    {
-        while (!g_freeList->empty())
-        {
-            Buffer::Data* data = g_freeList->back();
-            g_freeList->pop_back();
-            if (data->m_size >= dataSize)
-            {
-                data->m_count = 1;
-                return data;
-            }
-            Buffer::Deallocate(data);
-        }
-    }
-    Buffer::Data* data = Buffer::Allocate(dataSize);
-    NS_ASSERT(data->m_count == 1);
-    return data;
-}
-#else  /* BUFFER_FREE_LIST */
-void
-Buffer::Recycle(Buffer::Data* data)
-{
-    NS_LOG_FUNCTION(data);
-    NS_ASSERT(data->m_count == 0);
-    Deallocate(data);
-}
-
-Buffer::Data*
-Buffer::Create(uint32_t size)
-{
-    NS_LOG_FUNCTION(size);
-    return Allocate(size);
-}
-#endif /* BUFFER_FREE_LIST */
-
 constexpr uint32_t ALLOC_OVER_PROVISION = 100; //!< Additional bytes to over-provision.
 
 Buffer::Data*
-Buffer::Allocate(uint32_t reqSize)
+Buffer::Create(uint32_t reqSize)
 {
     NS_LOG_FUNCTION(reqSize);
     if (reqSize == 0)
@@ -172,21 +69,21 @@ Buffer::Allocate(uint32_t reqSize)
     }
     NS_ASSERT(reqSize >= 1);
     reqSize += ALLOC_OVER_PROVISION;
-    uint32_t size = reqSize - 1 + sizeof(Buffer::Data);
-    auto b = new uint8_t[size];
+    uint32_t capacity;
+    uint8_t* b = PacketMemoryPool::Allocate(reqSize - 1 + sizeof(Buffer::Data), capacity);
     auto data = reinterpret_cast<Buffer::Data*>(b);
-    data->m_size = reqSize;
+    data->m_size = capacity + 1 - sizeof(Buffer::Data);
     data->m_count = 1;
     return data;
 }
 
 void
-Buffer::Deallocate(Buffer::Data* data)
+Buffer::Recycle(Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
-    auto buf = reinterpret_cast<uint8_t*>(data);
-    delete[] buf;
+    PacketMemoryPool::Deallocate(reinterpret_cast<uint8_t*>(data),
+                                 data->m_size - 1 + sizeof(Buffer::Data));
 }
 
 Buffer::Buffer()
@@ -435,6 +332,56 @@ Buffer::AddAtEnd(const Buffer& o)
         return;
     }
 
+    /*
+     * Keep the zero areas virtual whenever the result can hold them in a
+     * single zero area: only the bytes written are copied.
+     */
+    uint32_t zeroSize = m_zeroAreaEnd - m_zeroAreaStart;
+    uint32_t oZeroSize = o.m_zeroAreaEnd - o.m_zeroAreaStart;
+    if (oZeroSize == 0)
+    {
+        /* Before: |**----**| + |****|
+         * After:  |**----******|
+         */
+        uint32_t size = o.GetSize();
+        AddAtEnd(size);
+        Buffer::Iterator destStart = End();
+        destStart.Prev(size);
+        destStart.Write(o.m_data->m_data + o.m_start, size);
+        NS_ASSERT(CheckInternalState());
+        return;
+    }
+    if (zeroSize == 0)
+    {
+        /* Before: |****| + |**----**|
+         * After:  |******----**|
+         */
+        Buffer tmp = o;
+        tmp.AddAtStart(GetSize());
+        tmp.Begin().Write(m_data->m_data + m_start, GetSize());
+        *this = tmp;
+        NS_ASSERT(CheckInternalState());
+        return;
+    }
+    if (m_end == m_zeroAreaEnd && o.m_start == o.m_zeroAreaStart)
+    {
+        /* Before: |**----| + |----**|
+         * After:  |**--------**|
+         */
+        uint32_t dataStart = m_zeroAreaStart - m_start;
+        uint32_t dataEnd = o.m_end - o.m_zeroAreaEnd;
+        Buffer tmp(zeroSize + oZeroSize);
+        tmp.AddAtStart(dataStart);
+        tmp.Begin().Write(m_data->m_data + m_start, dataStart);
+        tmp.AddAtEnd(dataEnd);
+        Buffer::Iterator i = tmp.End();
+        i.Prev(dataEnd);
+        i.Write(o.m_data->m_data + o.m_zeroAreaStart, dataEnd);
+        *this = tmp;
+        NS_ASSERT(CheckInternalState());
+        return;
+    }
+
     *this = CreateFullCopy();
     AddAtEnd(o.GetSize());
     Buffer::Iterator destStart = End();
@@ -832,27 +779,38 @@ Buffer::Iterator::Write(Iterator start, Iterator end)
     NS_ASSERT(m_data != start.m_data);
     uint32_t size = end.m_current - start.m_current;
     NS_ASSERT_MSG(CheckNoZero(m_current, m_current + size), GetWriteErrorMessage());
+    /* the destination may lie after the zero area of this buffer, e.g.,
+     * when bytes are appended after a virtual payload.
+     */
+    uint8_t* to;
+    if (m_current <= m_zeroStart)
+    {
+        to = &m_data[m_current];
+    }
+    else
+    {
+        to = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+    }
+    m_current += size;
     if (start.m_current <= start.m_zeroStart)
     {
         uint32_t toCopy = std::min(size, start.m_zeroStart - start.m_current);
-        memcpy(&m_data[m_current], &start.m_data[start.m_current], toCopy);
+        memcpy(to, &start.m_data[start.m_current], toCopy);
         start.m_current += toCopy;
-        m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
     if (start.m_current <= start.m_zeroEnd)
     {
         uint32_t toCopy = std::min(size, start.m_zeroEnd - start.m_current);
-        memset(&m_data[m_current], 0, toCopy);
+        memset(to, 0, toCopy);
         start.m_current += toCopy;
-        m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
     uint32_t toCopy = std::min(size, start.m_dataEnd - start.m_current);
     uint8_t* from = &start.m_data[start.m_current - (start.m_zeroEnd - start.m_zeroStart)];
-    uint8_t* to = &m_data[m_current];
     memcpy(to, from, toCopy);
-    m_current += toCopy;
 }
 
 void
@@ -948,7 +906,7 @@ void
 Buffer::Iterator::Write(const uint8_t* buffer, uint32_t size)
 {
     NS_LOG_FUNCTION(this << &buffer << size);
-    NS_ASSERT_MSG(CheckNoZero(m_current, size), GetWriteErrorMessage());
+    NS_ASSERT_MSG(CheckNoZero(m_current, m_current + size), GetWriteErrorMessage());
     uint8_t* to;
     if (m_current <= m_zeroStart)
     {
@@ -1145,14 +1103,30 @@ Buffer::Iterator::CalculateIpChecksum(uint16_t size, uint32_t initialChecksum)
     /* see RFC 1071 to understand this code. */
     uint32_t sum = initialChecksum;
 
-    for (int j = 0; j < size / 2; j++)
+    if (m_current + size <= m_zeroStart || m_current >= m_zeroEnd)
     {
-        sum += ReadU16();
+        // The bytes are contiguous, read them without checking the boundaries
+        const uint8_t* buffer = ReadSpan(size, nullptr);
+        for (int j = 0; j < size / 2; j++)
+        {
+            sum += ns3::ReadLsbtohU16(buffer + 2 * j);
+        }
+        if (size & 1)
+        {
+            sum += buffer[size - 1];
+        }
     }
-
-    if (size & 1)
+    else
     {
-        sum += ReadU8();
+        for (int j = 0; j < size / 2; j++)
+        {
+            sum += ReadU16();
+        }
+
+        if (size & 1)
+        {
+            sum += ReadU8();
+        }
     }
 
     while (sum >> 16)
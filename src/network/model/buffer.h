@@ -23,9 +23,6 @@
 
 #include <ostream>
 #include <stdint.h>
-#include <vector>
-
-#define BUFFER_FREE_LIST 1
 
 namespace ns3
 {
@@ -357,6 +354,33 @@ class Buffer
          */
         inline void Read(Iterator start, uint32_t size);
 
+        /**
+         * \param size the number of bytes to write
+         * \return a pointer to the \pname{size} bytes following the current
+         *         position, which are contiguous in memory.
+         *
+         * Get a direct access to the next \pname{size} bytes, to write
+         * them in bulk with memcpy or with WriteHtonU16(uint8_t*, uint16_t)
+         * and its siblings, and advance the Iterator by \pname{size} bytes.
+         * The boundaries are checked once for the whole span rather than
+         * for each field. As with the other write methods, the bytes must
+         * not overlap the zero area.
+         */
+        inline uint8_t* WriteSpan(uint32_t size);
+        /**
+         * \param size the number of bytes to read
+         * \param scratch storage for \pname{size} bytes
+         * \return a pointer to the \pname{size} bytes following the current
+         *         position.
+         *
+         * Get a direct access to the next \pname{size} bytes, to read
+         * them in bulk, and advance the Iterator by \pname{size} bytes.
+         * The returned pointer points into the buffer if the bytes are
+         * contiguous in memory. Otherwise, i.e., if they overlap the zero
+         * area, the bytes are copied into \pname{scratch}, which is returned.
+         */
+        inline const uint8_t* ReadSpan(uint32_t size, uint8_t* scratch);
+
         /**
          * \brief Calculate the checksum.
          * \param size size of the buffer.
@@ -490,6 +514,12 @@ class Buffer
      */
     inline uint32_t GetSize() const;
 
+    /**
+     * \return the number of zero bytes of this buffer which are not
+     *          stored in memory.
+     */
+    inline uint32_t GetZeroAreaSize() const;
+
     /**
      * \return a pointer to the start of the internal
      * byte buffer.
@@ -729,27 +759,16 @@ class Buffer
     uint32_t GetInternalEnd() const;
 
     /**
-     * \brief Recycle the buffer memory
+     * \brief Recycle the buffer memory into the PacketMemoryPool
      * \param data the buffer data storage
      */
     static void Recycle(Buffer::Data* data);
     /**
-     * \brief Create a buffer data storage
-     * \param size the storage size to create
-     * \returns a pointer to the created buffer storage
-     */
-    static Buffer::Data* Create(uint32_t size);
-    /**
-     * \brief Allocate a buffer data storage
+     * \brief Create a buffer data storage from the PacketMemoryPool
      * \param reqSize the storage size to create
-     * \returns a pointer to the allocated buffer storage
-     */
-    static Buffer::Data* Allocate(uint32_t reqSize);
-    /**
-     * \brief Deallocate the buffer memory
-     * \param data the buffer data storage
+     * \returns a pointer to the created buffer storage
      */
-    static void Deallocate(Buffer::Data* data);
+    static Buffer::Data* Create(uint32_t reqSize);
 
     Data* m_data; //!< the buffer data storage
 
@@ -791,22 +810,84 @@ class Buffer
      * instance from the start of m_data->m_data
      */
     uint32_t m_end;
+};
 
-#ifdef BUFFER_FREE_LIST
-    /// Container for buffer data
-    typedef std::vector<Buffer::Data*> FreeList;
+/**
+ * \ingroup packet
+ * \name Fields of a span
+ *
+ * Write and read the fields of a header in the bytes obtained with
+ * Buffer::Iterator::WriteSpan() and Buffer::Iterator::ReadSpan(), in
+ * the same format as the Buffer::Iterator methods with the same name.
+ * @{
+ */
+/**
+ * \param buffer the bytes to write to
+ * \param data the data to write in network order
+ */
+inline void
+WriteHtonU16(uint8_t* buffer, uint16_t data)
+{
+    buffer[0] = (data >> 8) & 0xff;
+    buffer[1] = (data >> 0) & 0xff;
+}
 
-    /// Local static destructor structure
-    struct LocalStaticDestructor
-    {
-        ~LocalStaticDestructor();
-    };
+/**
+ * \param buffer the bytes to write to
+ * \param data the data to write in network order
+ */
+inline void
+WriteHtonU32(uint8_t* buffer, uint32_t data)
+{
+    buffer[0] = (data >> 24) & 0xff;
+    buffer[1] = (data >> 16) & 0xff;
+    buffer[2] = (data >> 8) & 0xff;
+    buffer[3] = (data >> 0) & 0xff;
+}
 
-    static uint32_t g_maxSize;                            //!< Max observed data size
-    static FreeList* g_freeList;                          //!< Buffer data container
-    static LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
-#endif
-};
+/**
+ * \param buffer the bytes to write to
+ * \param data the data to write in least significant byte first order
+ */
+inline void
+WriteHtolsbU16(uint8_t* buffer, uint16_t data)
+{
+    buffer[0] = (data >> 0) & 0xff;
+    buffer[1] = (data >> 8) & 0xff;
+}
+
+/**
+ * \param buffer the bytes to read from
+ * \return the data read, in network order
+ */
+inline uint16_t
+ReadNtohU16(const uint8_t* buffer)
+{
+    return (buffer[0] << 8) | buffer[1];
+}
+
+/**
+ * \param buffer the bytes to read from
+ * \return the data read, in network order
+ */
+inline uint32_t
+ReadNtohU32(const uint8_t* buffer)
+{
+    return (static_cast<uint32_t>(buffer[0]) << 24) | (buffer[1] << 16) | (buffer[2] << 8) |
+           buffer[3];
+}
+
+/**
+ * \param buffer the bytes to read from
+ * \return the data read, in least significant byte first order
+ */
+inline uint16_t
+ReadLsbtohU16(const uint8_t* buffer)
+{
+    return buffer[0] | (buffer[1] << 8);
+}
+
+/**@}*/
 
 } // namespace ns3
 
@@ -1002,6 +1083,46 @@ Buffer::Iterator::ReadNtohU32()
     return retval;
 }
 
+uint8_t*
+Buffer::Iterator::WriteSpan(uint32_t size)
+{
+    NS_ASSERT_MSG(CheckNoZero(m_current, m_current + size), GetWriteErrorMessage());
+    uint8_t* buffer;
+    if (m_current + size <= m_zeroStart)
+    {
+        buffer = &m_data[m_current];
+    }
+    else
+    {
+        buffer = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+    }
+    m_current += size;
+    return buffer;
+}
+
+const uint8_t*
+Buffer::Iterator::ReadSpan(uint32_t size, uint8_t* scratch)
+{
+    NS_ASSERT_MSG(m_current >= m_dataStart && m_current + size <= m_dataEnd,
+                  GetReadErrorMessage());
+    const uint8_t* buffer;
+    if (m_current + size <= m_zeroStart)
+    {
+        buffer = &m_data[m_current];
+    }
+    else if (m_current >= m_zeroEnd)
+    {
+        buffer = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+    }
+    else
+    {
+        Read(scratch, size);
+        return scratch;
+    }
+    m_current += size;
+    return buffer;
+}
+
 uint8_t
 Buffer::Iterator::PeekU8()
 {
@@ -1070,6 +1191,12 @@ Buffer::GetSize() const
     return m_end - m_start;
 }
 
+uint32_t
+Buffer::GetZeroAreaSize() const
+{
+    return m_zeroAreaEnd - m_zeroAreaStart;
+}
+
 Buffer::Iterator
 Buffer::Begin() const
 {
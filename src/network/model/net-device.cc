@@ -20,6 +20,7 @@
 #include "net-device.h"
 
 #include "ns3/log.h"
+#include "ns3/packet-burst.h"
 
 namespace ns3
 {
@@ -40,4 +41,19 @@ NetDevice::~NetDevice()
     NS_LOG_FUNCTION(this);
 }
 
+uint32_t
+NetDevice::SendMany(Ptr<PacketBurst> burst, const Address& dest, uint16_t protocolNumber)
+{
+    NS_LOG_FUNCTION(this << burst << dest << protocolNumber);
+    uint32_t sent = 0;
+    for (auto i = burst->Begin(); i != burst->End(); ++i)
+    {
+        if (Send(*i, dest, protocolNumber))
+        {
+            sent++;
+        }
+    }
+    return sent;
+}
+
 } // namespace ns3
@@ -36,6 +36,7 @@ namespace ns3
 
 class Node;
 class Channel;
+class PacketBurst;
 
 /**
  * \ingroup network
@@ -264,6 +265,22 @@ class NetDevice : public Object
                           const Address& source,
                           const Address& dest,
                           uint16_t protocolNumber) = 0;
+    /**
+     * \param burst packets sent from above down to Network Device
+     * \param dest mac address of the destination (already resolved)
+     * \param protocolNumber identifies the type of payload contained in
+     *        these packets. Used to call the right L3Protocol when the packets
+     *        are received.
+     *
+     *  Called from higher layer to send several packets into Network Device
+     *  to the specified destination Address, in order. The packets are not
+     *  copied. The default implementation calls Send for each packet; the
+     *  devices which can process the packets as a whole, e.g., to schedule
+     *  their transmission at once, override it.
+     *
+     * \return the number of packets for which the Send operation succeeded
+     */
+    virtual uint32_t SendMany(Ptr<PacketBurst> burst, const Address& dest, uint16_t protocolNumber);
     /**
      * \returns the node base class which contains this network
      *          interface.
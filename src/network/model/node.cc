@@ -27,6 +27,7 @@
 
 #include "ns3/assert.h"
 #include "ns3/boolean.h"
+#include "ns3/checkpoint.h"
 #include "ns3/global-value.h"
 #include "ns3/log.h"
 #include "ns3/object-vector.h"
@@ -39,6 +40,7 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("Node");
 
 NS_OBJECT_ENSURE_REGISTERED(Node);
+NS_CHECKPOINT_STATELESS(Node);
 
 /**
  * \relates Node
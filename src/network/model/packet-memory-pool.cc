@@ -0,0 +1,398 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "packet-memory-pool.h"
+
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace
+{
+
+constexpr uint32_t MIN_CLASS_SHIFT = 6;  //!< log2 of the smallest size class.
+constexpr uint32_t MAX_CLASS_SHIFT = 16; //!< log2 of the largest size class.
+/** Number of size classes. */
+constexpr uint32_t N_CLASSES = MAX_CLASS_SHIFT - MIN_CLASS_SHIFT + 1;
+/** Bytes of blocks kept by a thread cache, per size class. */
+constexpr uint32_t CACHE_BYTES = 256 * 1024;
+/** Bytes of blocks kept by the depot, per size class. */
+constexpr uint32_t DEPOT_BYTES = 4 * 1024 * 1024;
+
+/**
+ * \param [in] size A number of bytes, at most the largest size class.
+ * \returns The index of the smallest size class holding \p size bytes.
+ */
+inline uint32_t
+GetClass(uint32_t size)
+{
+    if (size <= (1U << MIN_CLASS_SHIFT))
+    {
+        return 0;
+    }
+    return std::bit_width(size - 1) - MIN_CLASS_SHIFT;
+}
+
+/**
+ * \param [in] cls A size class.
+ * \returns The size of the blocks of the size class.
+ */
+inline uint32_t
+GetClassSize(uint32_t cls)
+{
+    return 1U << (cls + MIN_CLASS_SHIFT);
+}
+
+/**
+ * \param [in] cls A size class.
+ * \param [in] bytes The number of bytes which can be kept.
+ * \returns The number of blocks of the size class which can be kept.
+ */
+inline std::size_t
+GetMaxBlocks(uint32_t cls, uint32_t bytes)
+{
+    return std::max<std::size_t>(8, bytes / GetClassSize(cls));
+}
+
+/**
+ * Increment a counter written by a single thread, and read by any thread.
+ * \param [in,out] counter The counter.
+ * \param [in] value The increment.
+ */
+template <typename T>
+inline void
+Add(std::atomic<T>& counter, T value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+std::atomic<uint64_t> g_reserved{0};     //!< Bytes obtained from the system.
+std::atomic<uint64_t> g_peakReserved{0}; //!< Peak of g_reserved.
+
+/**
+ * Allocate a block from the system.
+ * \param [in] size The size of the block.
+ * \returns The block.
+ */
+uint8_t*
+SystemAllocate(uint32_t size)
+{
+    uint64_t reserved = g_reserved.fetch_add(size, std::memory_order_relaxed) + size;
+    uint64_t peak = g_peakReserved.load(std::memory_order_relaxed);
+    while (reserved > peak &&
+           !g_peakReserved.compare_exchange_weak(peak, reserved, std::memory_order_relaxed))
+    {
+    }
+    return new uint8_t[size];
+}
+
+/**
+ * Free a block to the system.
+ * \param [in] block The block.
+ * \param [in] size The size of the block.
+ */
+void
+SystemFree(uint8_t* block, uint32_t size)
+{
+    g_reserved.fetch_sub(size, std::memory_order_relaxed);
+    delete[] block;
+}
+
+/** The statistics of a thread. */
+struct Counters
+{
+    std::atomic<uint64_t> allocations{0}; //!< Number of blocks allocated.
+    std::atomic<uint64_t> hits{0};        //!< Number of blocks allocated without the system.
+    std::atomic<uint64_t> oversized{0};   //!< Number of blocks larger than the size classes.
+    std::atomic<int64_t> bytesInUse{0};   //!< Bytes allocated minus bytes freed.
+};
+
+class ThreadCache;
+
+/** The blocks and the statistics shared by the threads. */
+struct Depot
+{
+    ~Depot();
+
+    std::mutex mutex;                          //!< Protect the depot.
+    std::vector<uint8_t*> blocks[N_CLASSES];   //!< The free blocks, by size class.
+    std::set<const ThreadCache*> caches;       //!< The live thread caches.
+    ns3::PacketMemoryPool::Stats retired = {}; //!< The statistics of the threads terminated.
+};
+
+/** Whether the depot was destroyed, at the end of the program. */
+bool g_depotDestroyed = false;
+
+Depot::~Depot()
+{
+    for (uint32_t cls = 0; cls < N_CLASSES; cls++)
+    {
+        for (auto block : blocks[cls])
+        {
+            SystemFree(block, GetClassSize(cls));
+        }
+    }
+    g_depotDestroyed = true;
+}
+
+/**
+ * \returns The depot, created on first use.
+ */
+Depot&
+GetDepot()
+{
+    static Depot depot;
+    return depot;
+}
+
+/** The free blocks and the statistics of a thread. */
+class ThreadCache
+{
+  public:
+    ThreadCache();
+    ~ThreadCache();
+
+    /**
+     * Allocate a block.
+     * \param [in] cls The size class of the block.
+     * \returns The block.
+     */
+    uint8_t* Allocate(uint32_t cls);
+    /**
+     * Free a block.
+     * \param [in] block The block.
+     * \param [in] cls The size class of the block.
+     */
+    void Deallocate(uint8_t* block, uint32_t cls);
+
+    Counters counters; //!< The statistics of the thread.
+
+  private:
+    /**
+     * Move the blocks of a size class from or to the depot.
+     * \param [in] cls The size class.
+     * \param [in] keep The number of blocks to keep in the cache.
+     */
+    void Exchange(uint32_t cls, std::size_t keep);
+
+    std::vector<uint8_t*> m_blocks[N_CLASSES]; //!< The free blocks, by size class.
+};
+
+/** Whether the cache of the thread was destroyed, at the end of the thread. */
+thread_local bool t_cacheDestroyed = false;
+
+ThreadCache::ThreadCache()
+{
+    Depot& depot = GetDepot();
+    std::lock_guard lock(depot.mutex);
+    depot.caches.insert(this);
+}
+
+ThreadCache::~ThreadCache()
+{
+    t_cacheDestroyed = true;
+    if (g_depotDestroyed)
+    {
+        for (uint32_t cls = 0; cls < N_CLASSES; cls++)
+        {
+            for (auto block : m_blocks[cls])
+            {
+                SystemFree(block, GetClassSize(cls));
+            }
+        }
+        return;
+    }
+    for (uint32_t cls = 0; cls < N_CLASSES; cls++)
+    {
+        Exchange(cls, 0);
+    }
+    Depot& depot = GetDepot();
+    std::lock_guard lock(depot.mutex);
+    depot.caches.erase(this);
+    depot.retired.allocations += counters.allocations;
+    depot.retired.hits += counters.hits;
+    depot.retired.oversized += counters.oversized;
+    depot.retired.bytesInUse += counters.bytesInUse;
+}
+
+uint8_t*
+ThreadCache::Allocate(uint32_t cls)
+{
+    Add<uint64_t>(counters.allocations, 1);
+    Add<int64_t>(counters.bytesInUse, GetClassSize(cls));
+    if (m_blocks[cls].empty())
+    {
+        Exchange(cls, GetMaxBlocks(cls, CACHE_BYTES) / 2);
+        if (m_blocks[cls].empty())
+        {
+            return SystemAllocate(GetClassSize(cls));
+        }
+    }
+    Add<uint64_t>(counters.hits, 1);
+    uint8_t* block = m_blocks[cls].back();
+    m_blocks[cls].pop_back();
+    return block;
+}
+
+void
+ThreadCache::Deallocate(uint8_t* block, uint32_t cls)
+{
+    Add<int64_t>(counters.bytesInUse, -static_cast<int64_t>(GetClassSize(cls)));
+    m_blocks[cls].push_back(block);
+    if (m_blocks[cls].size() > GetMaxBlocks(cls, CACHE_BYTES))
+    {
+        Exchange(cls, GetMaxBlocks(cls, CACHE_BYTES) / 2);
+    }
+}
+
+void
+ThreadCache::Exchange(uint32_t cls, std::size_t keep)
+{
+    std::vector<uint8_t*>& local = m_blocks[cls];
+    std::vector<uint8_t*> excess;
+    {
+        Depot& depot = GetDepot();
+        std::lock_guard lock(depot.mutex);
+        std::vector<uint8_t*>& shared = depot.blocks[cls];
+        while (local.size() < keep && !shared.empty())
+        {
+            local.push_back(shared.back());
+            shared.pop_back();
+        }
+        std::size_t maxShared = GetMaxBlocks(cls, DEPOT_BYTES);
+        while (local.size() > keep)
+        {
+            (shared.size() < maxShared ? shared : excess).push_back(local.back());
+            local.pop_back();
+        }
+    }
+    for (auto block : excess)
+    {
+        SystemFree(block, GetClassSize(cls));
+    }
+}
+
+/**
+ * \returns The cache of the thread, or nullptr if it was already destroyed.
+ */
+ThreadCache*
+GetThreadCache()
+{
+    if (t_cacheDestroyed || g_depotDestroyed)
+    {
+        return nullptr;
+    }
+    thread_local ThreadCache cache;
+    return &cache;
+}
+
+} // namespace
+
+namespace ns3
+{
+
+double
+PacketMemoryPool::Stats::GetHitRate() const
+{
+    return allocations == 0 ? 0 : static_cast<double>(hits) / allocations;
+}
+
+uint8_t*
+PacketMemoryPool::Allocate(uint32_t size, uint32_t& capacity)
+{
+    if (size > GetClassSize(N_CLASSES - 1))
+    {
+        if (ThreadCache* cache = GetThreadCache())
+        {
+            Add<uint64_t>(cache->counters.allocations, 1);
+            Add<uint64_t>(cache->counters.oversized, 1);
+            Add<int64_t>(cache->counters.bytesInUse, size);
+        }
+        capacity = size;
+        return SystemAllocate(size);
+    }
+    uint32_t cls = GetClass(size);
+    capacity = GetClassSize(cls);
+    if (ThreadCache* cache = GetThreadCache())
+    {
+        return cache->Allocate(cls);
+    }
+    return SystemAllocate(capacity);
+}
+
+void
+PacketMemoryPool::Deallocate(uint8_t* block, uint32_t capacity)
+{
+    ThreadCache* cache = GetThreadCache();
+    if (capacity > GetClassSize(N_CLASSES - 1) || cache == nullptr)
+    {
+        if (cache != nullptr)
+        {
+            Add<int64_t>(cache->counters.bytesInUse, -static_cast<int64_t>(capacity));
+        }
+        SystemFree(block, capacity);
+        return;
+    }
+    NS_ASSERT_MSG(std::has_single_bit(capacity), "Invalid capacity " << capacity);
+    cache->Deallocate(block, GetClass(capacity));
+}
+
+uint32_t
+PacketMemoryPool::GetCapacity(uint32_t size)
+{
+    if (size > GetClassSize(N_CLASSES - 1))
+    {
+        return size;
+    }
+    return GetClassSize(GetClass(size));
+}
+
+PacketMemoryPool::Stats
+PacketMemoryPool::GetStats()
+{
+    Stats stats = {};
+    if (!g_depotDestroyed)
+    {
+        Depot& depot = GetDepot();
+        std::lock_guard lock(depot.mutex);
+        stats = depot.retired;
+        for (auto cache : depot.caches)
+        {
+            stats.allocations += cache->counters.allocations.load(std::memory_order_relaxed);
+            stats.hits += cache->counters.hits.load(std::memory_order_relaxed);
+            stats.oversized += cache->counters.oversized.load(std::memory_order_relaxed);
+            stats.bytesInUse += cache->counters.bytesInUse.load(std::memory_order_relaxed);
+        }
+    }
+    stats.bytesReserved = g_reserved.load(std::memory_order_relaxed);
+    stats.peakReserved = g_peakReserved.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::ostream&
+operator<<(std::ostream& os, const PacketMemoryPool::Stats& stats)
+{
+    os << "allocations=" << stats.allocations << " hit rate=" << stats.GetHitRate()
+       << " oversized=" << stats.oversized << " bytes in use=" << stats.bytesInUse
+       << " bytes reserved=" << stats.bytesReserved << " peak reserved=" << stats.peakReserved;
+    return os;
+}
+
+} // namespace ns3
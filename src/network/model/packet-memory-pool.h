@@ -0,0 +1,103 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PACKET_MEMORY_POOL_H
+#define PACKET_MEMORY_POOL_H
+
+#include <ostream>
+#include <stdint.h>
+
+namespace ns3
+{
+
+/**
+ * \ingroup packet
+ *
+ * \brief Size-classed pool of the memory blocks of the packets
+ *
+ * The Buffer, ByteTagList and PacketMetadata data blocks are allocated
+ * from this pool.  The requested sizes are rounded up to a power of two,
+ * from 64 bytes to 64 KiB, and the blocks freed are kept in a list per
+ * size class, so that a large buffer of a jumbo frame and a small buffer
+ * of a control frame do not evict each other.  The larger blocks are
+ * allocated and freed directly.
+ *
+ * Each thread keeps the blocks it frees in a cache of its own, without
+ * any lock.  When the list of a size class of the cache is full, half of
+ * it moves to a global depot, shared by the threads and protected by a
+ * mutex, from which the caches refill.  A block may be freed by another
+ * thread than the one which allocated it.
+ */
+class PacketMemoryPool
+{
+  public:
+    /**
+     * \brief Statistics of the pool.
+     */
+    struct Stats
+    {
+        uint64_t allocations;   //!< Number of blocks allocated.
+        uint64_t hits;          //!< Number of blocks allocated from a cache or the depot.
+        uint64_t oversized;     //!< Number of blocks too large for the size classes.
+        int64_t bytesInUse;     //!< Bytes of the blocks allocated and not yet freed.
+        uint64_t bytesReserved; //!< Bytes obtained from the system, in use or cached.
+        uint64_t peakReserved;  //!< Peak of bytesReserved.
+
+        /**
+         * \returns The fraction of the allocations served without the system allocator.
+         */
+        double GetHitRate() const;
+    };
+
+    /**
+     * \brief Allocate a block.
+     * \param [in] size The number of bytes needed.
+     * \param [out] capacity The number of bytes actually usable in the block,
+     *              which must be given back to Deallocate().
+     * \returns The block.
+     */
+    static uint8_t* Allocate(uint32_t size, uint32_t& capacity);
+
+    /**
+     * \brief Free a block.
+     * \param [in] block The block, allocated by Allocate().
+     * \param [in] capacity The capacity returned by Allocate().
+     */
+    static void Deallocate(uint8_t* block, uint32_t capacity);
+
+    /**
+     * \param [in] size A number of bytes.
+     * \returns The capacity of the blocks allocated for \p size bytes.
+     */
+    static uint32_t GetCapacity(uint32_t size);
+
+    /**
+     * \returns The statistics of the pool, summed over the threads.
+     */
+    static Stats GetStats();
+};
+
+/**
+ * \brief Stream insertion operator.
+ *
+ * \param [in] os The reference to the output stream.
+ * \param [in] stats The statistics of the pool.
+ * \returns The reference to the output stream.
+ */
+std::ostream& operator<<(std::ostream& os, const PacketMemoryPool::Stats& stats);
+
+} // namespace ns3
+
+#endif /* PACKET_MEMORY_POOL_H */
@@ -20,8 +20,10 @@
 
 #include "buffer.h"
 #include "header.h"
+#include "packet-memory-pool.h"
 #include "trailer.h"
 
+#include "ns3/abort.h"
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
@@ -37,18 +39,21 @@ NS_LOG_COMPONENT_DEFINE("PacketMetadata");
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
 bool PacketMetadata::m_metadataSkipped = false;
-uint32_t PacketMetadata::m_maxSize = 0;
+PacketMetadata::Backend PacketMetadata::m_backend = PacketMetadata::BUFFER;
 uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+PacketMetadata::Arena PacketMetadata::m_arena;
+uint32_t PacketMetadata::m_arenaSize = 0;
+uint32_t PacketMetadata::m_arenaFree = PacketMetadata::END_OF_LIST;
+std::vector<uint32_t> PacketMetadata::m_arenaScratch;
 
-PacketMetadata::DataFreeList::~DataFreeList()
+PacketMetadata::Arena::~Arena()
 {
-    NS_LOG_FUNCTION(this);
-    for (auto i = begin(); i != end(); i++)
+    for (auto block : *this)
     {
-        PacketMetadata::Deallocate(*i);
+        delete[] block;
     }
-    PacketMetadata::m_enable = false;
+    // The packets destroyed from now on do not release their items
+    clear();
 }
 
 void
@@ -73,6 +78,13 @@ PacketMetadata::EnableChecking()
     m_enableChecking = true;
 }
 
+void
+PacketMetadata::SetBackend(Backend backend)
+{
+    NS_LOG_FUNCTION(backend);
+    m_backend = backend;
+}
+
 void
 PacketMetadata::ReserveCopy(uint32_t size)
 {
@@ -104,8 +116,7 @@ PacketMetadata::Reserve(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
     NS_ASSERT(m_data != nullptr);
-    if (m_data->m_size >= m_used + size &&
-        (m_head == 0xffff || m_data->m_count == 1 || m_data->m_dirtyEnd == m_used))
+    if (m_data->m_size >= m_used + size && (m_data->m_count == 1 || m_data->m_dirtyEnd == m_used))
     {
         /* enough room, not dirty. */
     }
@@ -136,6 +147,19 @@ bool
 PacketMetadata::IsStateOk() const
 {
     NS_LOG_FUNCTION(this);
+    if (m_data == nullptr)
+    {
+        bool ok = true;
+        uint32_t current = m_node;
+        while (ok && current != END_OF_LIST)
+        {
+            const ArenaItem& item = GetArenaItem(current);
+            ok &= item.count > 0;
+            ok &= item.fragmentStart <= item.fragmentEnd && item.fragmentEnd <= item.size;
+            current = item.next;
+        }
+        return ok;
+    }
     bool ok = m_used <= m_data->m_size;
     ok &= IsPointerOk(m_head);
     ok &= IsPointerOk(m_tail);
@@ -384,8 +408,7 @@ PacketMetadata::AddSmall(const PacketMetadata::SmallItem* item)
     uint32_t typeUidSize = GetUleb128Size(item->typeUid);
     uint32_t sizeSize = GetUleb128Size(item->size);
     uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2;
-    if (m_used + n > m_data->m_size ||
-        (m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
+    if (m_used + n > m_data->m_size || (m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
     {
         ReserveCopy(n);
     }
@@ -421,8 +444,7 @@ PacketMetadata::AddBig(uint32_t next,
     uint32_t fragEndSize = GetUleb128Size(extraItem->fragmentEnd);
     uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2 + fragStartSize + fragEndSize + 4;
 
-    if (m_used + n > m_data->m_size ||
-        (m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
+    if (m_used + n > m_data->m_size || (m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
     {
         ReserveCopy(n);
     }
@@ -563,77 +585,159 @@ PacketMetadata::ReadItems(uint16_t current,
     return buffer - &m_data->m_data[current];
 }
 
-PacketMetadata::Data*
-PacketMetadata::Create(uint32_t size)
+uint32_t
+PacketMetadata::GetFirstItem() const
 {
-    NS_LOG_FUNCTION(size);
-    NS_LOG_LOGIC("create size=" << size << ", max=" << m_maxSize);
-    if (size > m_maxSize)
+    if (m_data == nullptr)
+    {
+        return m_node;
+    }
+    return (m_head == 0xffff) ? END_OF_LIST : m_head;
+}
+
+uint32_t
+PacketMetadata::ReadItem(uint32_t current,
+                         PacketMetadata::SmallItem* item,
+                         PacketMetadata::ExtraItem* extraItem) const
+{
+    if (m_data == nullptr)
+    {
+        const ArenaItem& arenaItem = GetArenaItem(current);
+        bool isExtra = arenaItem.fragmentStart != 0 || arenaItem.fragmentEnd != arenaItem.size ||
+                       arenaItem.packetUid != m_packetUid;
+        item->next = 0xffff;
+        item->prev = 0xffff;
+        item->typeUid = (arenaItem.typeUid << 1) | (isExtra ? 1 : 0);
+        item->size = arenaItem.size;
+        item->chunkUid = arenaItem.chunkUid;
+        extraItem->fragmentStart = arenaItem.fragmentStart;
+        extraItem->fragmentEnd = arenaItem.fragmentEnd;
+        extraItem->packetUid = arenaItem.packetUid;
+        return arenaItem.next;
+    }
+    ReadItems(current, item, extraItem);
+    return (current == m_tail) ? END_OF_LIST : item->next;
+}
+
+uint32_t
+PacketMetadata::ArenaAllocate(const ArenaItem& item)
+{
+    NS_LOG_FUNCTION(item.next << item.typeUid << item.size);
+    uint32_t index;
+    if (m_arenaFree != END_OF_LIST)
     {
-        m_maxSize = size;
+        index = m_arenaFree;
+        m_arenaFree = GetArenaItem(index).next;
     }
-    while (!m_freeList.empty())
+    else
     {
-        PacketMetadata::Data* data = m_freeList.back();
-        m_freeList.pop_back();
-        if (data->m_size >= size)
+        if (m_arenaSize == (m_arena.size() << ARENA_BLOCK_BITS))
         {
-            NS_LOG_LOGIC("create found size=" << data->m_size);
-            data->m_count = 1;
-            return data;
+            NS_ABORT_MSG_IF(m_arena.size() == (1 << (32 - ARENA_BLOCK_BITS)) - 1,
+                            "Too many packet metadata items");
+            m_arena.push_back(new ArenaItem[1 << ARENA_BLOCK_BITS]);
         }
-        NS_LOG_LOGIC("create dealloc size=" << data->m_size);
-        PacketMetadata::Deallocate(data);
+        index = m_arenaSize++;
     }
-    NS_LOG_LOGIC("create alloc size=" << m_maxSize);
-    return PacketMetadata::Allocate(m_maxSize);
+    ArenaItem& newItem = GetArenaItem(index);
+    newItem = item;
+    newItem.count = 1;
+    return index;
 }
 
 void
-PacketMetadata::Recycle(PacketMetadata::Data* data)
+PacketMetadata::ArenaUnref(uint32_t index)
 {
-    NS_LOG_FUNCTION(data);
-    if (!m_enable)
+    if (m_arena.empty())
     {
-        PacketMetadata::Deallocate(data);
         return;
     }
-    NS_LOG_LOGIC("recycle size=" << data->m_size << ", list=" << m_freeList.size());
-    NS_ASSERT(data->m_count == 0);
-    if (m_freeList.size() > 1000 || data->m_size < m_maxSize)
+    while (index != END_OF_LIST)
+    {
+        ArenaItem& item = GetArenaItem(index);
+        NS_ASSERT(item.count > 0);
+        item.count--;
+        if (item.count > 0)
+        {
+            return;
+        }
+        uint32_t next = item.next;
+        item.next = m_arenaFree;
+        m_arenaFree = index;
+        index = next;
+    }
+}
+
+uint32_t
+PacketMetadata::ArenaFindLast(uint32_t& n) const
+{
+    n = 0;
+    uint32_t current = m_node;
+    if (current == END_OF_LIST)
     {
-        PacketMetadata::Deallocate(data);
+        return END_OF_LIST;
     }
-    else
+    while (GetArenaItem(current).next != END_OF_LIST)
+    {
+        current = GetArenaItem(current).next;
+        n++;
+    }
+    return current;
+}
+
+void
+PacketMetadata::ArenaRebuild(uint32_t n, uint32_t tail)
+{
+    NS_LOG_FUNCTION(this << n << tail);
+    m_arenaScratch.clear();
+    uint32_t current = m_node;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        m_arenaScratch.push_back(current);
+        current = GetArenaItem(current).next;
+    }
+    if (current == tail)
     {
-        m_freeList.push_back(data);
+        // the list is unchanged
+        ArenaUnref(tail);
+        return;
     }
+    for (auto i = m_arenaScratch.rbegin(); i != m_arenaScratch.rend(); i++)
+    {
+        ArenaItem item = GetArenaItem(*i);
+        item.next = tail;
+        tail = ArenaAllocate(item);
+    }
+    ArenaUnref(m_node);
+    m_node = tail;
 }
 
 PacketMetadata::Data*
-PacketMetadata::Allocate(uint32_t n)
+PacketMetadata::Create(uint32_t size)
 {
-    NS_LOG_FUNCTION(n);
-    uint32_t size = sizeof(Data);
-    if (n <= PACKET_METADATA_DATA_M_DATA_SIZE)
+    NS_LOG_FUNCTION(size);
+    if (size <= PACKET_METADATA_DATA_M_DATA_SIZE)
     {
-        n = PACKET_METADATA_DATA_M_DATA_SIZE;
+        size = PACKET_METADATA_DATA_M_DATA_SIZE;
     }
-    size += n - PACKET_METADATA_DATA_M_DATA_SIZE;
-    auto buf = new uint8_t[size];
+    uint32_t capacity;
+    uint8_t* buf =
+        PacketMemoryPool::Allocate(sizeof(Data) + size - PACKET_METADATA_DATA_M_DATA_SIZE, capacity);
     auto data = (PacketMetadata::Data*)buf;
-    data->m_size = n;
+    data->m_size = capacity - sizeof(Data) + PACKET_METADATA_DATA_M_DATA_SIZE;
     data->m_count = 1;
     data->m_dirtyEnd = 0;
+    NS_LOG_LOGIC("create size=" << size << ", allocated=" << data->m_size);
     return data;
 }
 
 void
-PacketMetadata::Deallocate(PacketMetadata::Data* data)
+PacketMetadata::Recycle(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
-    auto buf = (uint8_t*)data;
-    delete[] buf;
+    NS_ASSERT(data->m_count == 0);
+    PacketMemoryPool::Deallocate((uint8_t*)data,
+                                 sizeof(Data) + data->m_size - PACKET_METADATA_DATA_M_DATA_SIZE);
 }
 
 PacketMetadata
@@ -665,6 +769,22 @@ PacketMetadata::DoAddHeader(uint32_t uid, uint32_t size)
         return;
     }
 
+    if (m_data == nullptr)
+    {
+        ArenaItem arenaItem;
+        arenaItem.next = m_node; // the new item takes over the reference of the packet
+        arenaItem.count = 0;
+        arenaItem.typeUid = uid >> 1;
+        arenaItem.chunkUid = m_chunkUid;
+        arenaItem.size = size;
+        arenaItem.fragmentStart = 0;
+        arenaItem.fragmentEnd = size;
+        arenaItem.packetUid = m_packetUid;
+        m_chunkUid++;
+        m_node = ArenaAllocate(arenaItem);
+        return;
+    }
+
     PacketMetadata::SmallItem item;
     item.next = m_head;
     item.prev = 0xffff;
@@ -686,6 +806,33 @@ PacketMetadata::RemoveHeader(const Header& header, uint32_t size)
         m_metadataSkipped = true;
         return;
     }
+    if (m_data == nullptr)
+    {
+        if (m_node == END_OF_LIST || GetArenaItem(m_node).typeUid != (uid >> 1) ||
+            GetArenaItem(m_node).size != size)
+        {
+            if (m_enableChecking)
+            {
+                NS_FATAL_ERROR("Removing unexpected header.");
+            }
+            return;
+        }
+        const ArenaItem& arenaItem = GetArenaItem(m_node);
+        if (arenaItem.fragmentStart != 0 || arenaItem.fragmentEnd != size)
+        {
+            if (m_enableChecking)
+            {
+                NS_FATAL_ERROR("Removing incomplete header.");
+            }
+            return;
+        }
+        uint32_t next = arenaItem.next;
+        ArenaRef(next);
+        ArenaUnref(m_node);
+        m_node = next;
+        NS_ASSERT(IsStateOk());
+        return;
+    }
     PacketMetadata::SmallItem item;
     PacketMetadata::ExtraItem extraItem;
     uint32_t read = ReadItems(m_head, &item, &extraItem);
@@ -731,6 +878,24 @@ PacketMetadata::AddTrailer(const Trailer& trailer, uint32_t size)
         m_metadataSkipped = true;
         return;
     }
+    if (m_data == nullptr)
+    {
+        ArenaItem arenaItem;
+        arenaItem.next = END_OF_LIST;
+        arenaItem.count = 0;
+        arenaItem.typeUid = uid >> 1;
+        arenaItem.chunkUid = m_chunkUid;
+        arenaItem.size = size;
+        arenaItem.fragmentStart = 0;
+        arenaItem.fragmentEnd = size;
+        arenaItem.packetUid = m_packetUid;
+        m_chunkUid++;
+        uint32_t n;
+        uint32_t last = ArenaFindLast(n);
+        ArenaRebuild((last == END_OF_LIST) ? 0 : n + 1, ArenaAllocate(arenaItem));
+        NS_ASSERT(IsStateOk());
+        return;
+    }
     PacketMetadata::SmallItem item;
     item.next = 0xffff;
     item.prev = m_tail;
@@ -753,6 +918,32 @@ PacketMetadata::RemoveTrailer(const Trailer& trailer, uint32_t size)
         m_metadataSkipped = true;
         return;
     }
+    if (m_data == nullptr)
+    {
+        uint32_t n;
+        uint32_t last = ArenaFindLast(n);
+        if (last == END_OF_LIST || GetArenaItem(last).typeUid != (uid >> 1) ||
+            GetArenaItem(last).size != size)
+        {
+            if (m_enableChecking)
+            {
+                NS_FATAL_ERROR("Removing unexpected trailer.");
+            }
+            return;
+        }
+        const ArenaItem& arenaItem = GetArenaItem(last);
+        if (arenaItem.fragmentStart != 0 || arenaItem.fragmentEnd != size)
+        {
+            if (m_enableChecking)
+            {
+                NS_FATAL_ERROR("Removing incomplete trailer.");
+            }
+            return;
+        }
+        ArenaRebuild(n, END_OF_LIST);
+        NS_ASSERT(IsStateOk());
+        return;
+    }
     PacketMetadata::SmallItem item;
     PacketMetadata::ExtraItem extraItem;
     uint32_t read = ReadItems(m_tail, &item, &extraItem);
@@ -797,6 +988,44 @@ PacketMetadata::AddAtEnd(const PacketMetadata& o)
         m_metadataSkipped = true;
         return;
     }
+    NS_ASSERT_MSG((m_data == nullptr) == (o.m_data == nullptr),
+                  "Cannot concatenate packets whose metadata use different backends");
+    if (m_data == nullptr)
+    {
+        uint32_t n;
+        uint32_t last = ArenaFindLast(n);
+        if (last == END_OF_LIST)
+        {
+            *this = o;
+            NS_ASSERT(IsStateOk());
+            return;
+        }
+        if (o.m_node == END_OF_LIST)
+        {
+            return;
+        }
+        const ArenaItem& tailItem = GetArenaItem(last);
+        const ArenaItem& item = GetArenaItem(o.m_node);
+        if (item.packetUid == tailItem.packetUid && item.typeUid == tailItem.typeUid &&
+            item.chunkUid == tailItem.chunkUid && item.size == tailItem.size &&
+            item.fragmentStart == tailItem.fragmentEnd)
+        {
+            // merge our tail with the head of the other packet, as below.
+            ArenaItem merged = tailItem;
+            merged.fragmentEnd = item.fragmentEnd;
+            merged.next = item.next;
+            ArenaRef(merged.next);
+            ArenaRebuild(n, ArenaAllocate(merged));
+        }
+        else
+        {
+            // share the items of the other packet.
+            ArenaRef(o.m_node);
+            ArenaRebuild(n + 1, o.m_node);
+        }
+        NS_ASSERT(IsStateOk());
+        return;
+    }
     if (m_tail == 0xffff)
     {
         // We have no items so 'AddAtEnd' is
@@ -884,7 +1113,37 @@ PacketMetadata::RemoveAtStart(uint32_t start)
         m_metadataSkipped = true;
         return;
     }
-    NS_ASSERT(m_data != nullptr);
+    if (m_data == nullptr)
+    {
+        uint32_t leftToRemove = start;
+        uint32_t current = m_node;
+        while (current != END_OF_LIST && leftToRemove > 0)
+        {
+            const ArenaItem& item = GetArenaItem(current);
+            uint32_t itemRealSize = item.fragmentEnd - item.fragmentStart;
+            if (itemRealSize > leftToRemove)
+            {
+                // fragment the list item.
+                ArenaItem fragment = item;
+                fragment.fragmentStart += leftToRemove;
+                leftToRemove = 0;
+                ArenaRef(fragment.next);
+                uint32_t first = ArenaAllocate(fragment);
+                ArenaUnref(m_node);
+                m_node = first;
+                NS_ASSERT(IsStateOk());
+                return;
+            }
+            leftToRemove -= itemRealSize;
+            current = item.next;
+        }
+        NS_ASSERT(leftToRemove == 0);
+        ArenaRef(current);
+        ArenaUnref(m_node);
+        m_node = current;
+        NS_ASSERT(IsStateOk());
+        return;
+    }
     uint32_t leftToRemove = start;
     uint16_t current = m_head;
     while (current != 0xffff && leftToRemove > 0)
@@ -945,7 +1204,38 @@ PacketMetadata::RemoveAtEnd(uint32_t end)
         m_metadataSkipped = true;
         return;
     }
-    NS_ASSERT(m_data != nullptr);
+    if (m_data == nullptr)
+    {
+        uint32_t totalSize = GetTotalSize();
+        NS_ASSERT(end <= totalSize);
+        uint32_t leftToKeep = (end < totalSize) ? totalSize - end : 0;
+        uint32_t n = 0;
+        uint32_t current = m_node;
+        while (current != END_OF_LIST)
+        {
+            const ArenaItem& item = GetArenaItem(current);
+            uint32_t itemRealSize = item.fragmentEnd - item.fragmentStart;
+            if (itemRealSize > leftToKeep)
+            {
+                break;
+            }
+            leftToKeep -= itemRealSize;
+            current = item.next;
+            n++;
+        }
+        uint32_t tail = END_OF_LIST;
+        if (leftToKeep > 0)
+        {
+            // fragment the list item.
+            ArenaItem fragment = GetArenaItem(current);
+            fragment.fragmentEnd = fragment.fragmentStart + leftToKeep;
+            fragment.next = END_OF_LIST;
+            tail = ArenaAllocate(fragment);
+        }
+        ArenaRebuild(n, tail);
+        NS_ASSERT(IsStateOk());
+        return;
+    }
 
     uint32_t leftToRemove = end;
     uint16_t current = m_tail;
@@ -1004,20 +1294,15 @@ PacketMetadata::GetTotalSize() const
 {
     NS_LOG_FUNCTION(this);
     uint32_t totalSize = 0;
-    uint16_t current = m_head;
-    uint16_t tail = m_tail;
-    while (current != 0xffff)
+    uint32_t current = GetFirstItem();
+    while (current != END_OF_LIST)
     {
         PacketMetadata::SmallItem item;
         PacketMetadata::ExtraItem extraItem;
-        ReadItems(current, &item, &extraItem);
+        uint32_t next = ReadItem(current, &item, &extraItem);
         totalSize += extraItem.fragmentEnd - extraItem.fragmentStart;
-        if (current == tail)
-        {
-            break;
-        }
-        NS_ASSERT(current != item.next);
-        current = item.next;
+        NS_ASSERT(current != next);
+        current = next;
     }
     return totalSize;
 }
@@ -1039,9 +1324,8 @@ PacketMetadata::BeginItem(Buffer buffer) const
 PacketMetadata::ItemIterator::ItemIterator(const PacketMetadata* metadata, Buffer buffer)
     : m_metadata(metadata),
       m_buffer(buffer),
-      m_current(metadata->m_head),
-      m_offset(0),
-      m_hasReadTail(false)
+      m_current(metadata->GetFirstItem()),
+      m_offset(0)
 {
     NS_LOG_FUNCTION(this << metadata << &buffer);
 }
@@ -1050,15 +1334,7 @@ bool
 PacketMetadata::ItemIterator::HasNext() const
 {
     NS_LOG_FUNCTION(this);
-    if (m_current == 0xffff)
-    {
-        return false;
-    }
-    if (m_hasReadTail)
-    {
-        return false;
-    }
-    return true;
+    return m_current != END_OF_LIST;
 }
 
 PacketMetadata::Item
@@ -1068,12 +1344,7 @@ PacketMetadata::ItemIterator::Next()
     PacketMetadata::Item item;
     PacketMetadata::SmallItem smallItem;
     PacketMetadata::ExtraItem extraItem;
-    m_metadata->ReadItems(m_current, &smallItem, &extraItem);
-    if (m_current == m_metadata->m_tail)
-    {
-        m_hasReadTail = true;
-    }
-    m_current = smallItem.next;
+    m_current = m_metadata->ReadItem(m_current, &smallItem, &extraItem);
     uint32_t uid = (smallItem.typeUid & 0xfffffffe) >> 1;
     item.tid.SetUid(uid);
     item.currentTrimmedFromStart = extraItem.fragmentStart;
@@ -1131,10 +1402,10 @@ PacketMetadata::GetSerializedSize() const
 
     PacketMetadata::SmallItem item;
     PacketMetadata::ExtraItem extraItem;
-    uint32_t current = m_head;
-    while (current != 0xffff)
+    uint32_t current = GetFirstItem();
+    while (current != END_OF_LIST)
     {
-        ReadItems(current, &item, &extraItem);
+        uint32_t next = ReadItem(current, &item, &extraItem);
         uint32_t uid = (item.typeUid & 0xfffffffe) >> 1;
         if (uid == 0)
         {
@@ -1147,12 +1418,8 @@ PacketMetadata::GetSerializedSize() const
             totalSize += 4 + tid.GetName().size();
         }
         totalSize += 1 + 4 + 2 + 4 + 4 + 8;
-        if (current == m_tail)
-        {
-            break;
-        }
-        NS_ASSERT(current != item.next);
-        current = item.next;
+        NS_ASSERT(current != next);
+        current = next;
     }
     return totalSize;
 }
@@ -1171,10 +1438,10 @@ PacketMetadata::Serialize(uint8_t* buffer, uint32_t maxSize) const
 
     PacketMetadata::SmallItem item;
     PacketMetadata::ExtraItem extraItem;
-    uint32_t current = m_head;
-    while (current != 0xffff)
+    uint32_t current = GetFirstItem();
+    while (current != END_OF_LIST)
     {
-        ReadItems(current, &item, &extraItem);
+        uint32_t next = ReadItem(current, &item, &extraItem);
         NS_LOG_LOGIC("bytesWritten=" << static_cast<uint32_t>(buffer - start)
                                      << ", typeUid=" << item.typeUid << ", size=" << item.size
                                      << ", chunkUid=" << item.chunkUid
@@ -1250,13 +1517,8 @@ PacketMetadata::Serialize(uint8_t* buffer, uint32_t maxSize) const
             return 0;
         }
 
-        if (current == m_tail)
-        {
-            break;
-        }
-
-        NS_ASSERT(current != item.next);
-        current = item.next;
+        NS_ASSERT(current != next);
+        current = next;
     }
 
     NS_ASSERT(static_cast<uint32_t>(buffer - start) == maxSize);
@@ -1275,6 +1537,7 @@ PacketMetadata::Deserialize(const uint8_t* buffer, uint32_t size)
 
     PacketMetadata::SmallItem item = {0};
     PacketMetadata::ExtraItem extraItem = {0};
+    std::vector<ArenaItem> arenaItems;
     while (desSize > 0)
     {
         uint32_t uidStringSize = 0;
@@ -1317,9 +1580,35 @@ PacketMetadata::Deserialize(const uint8_t* buffer, uint32_t size)
                              << ", chunkUid=" << item.chunkUid << ", fragmentStart="
                              << extraItem.fragmentStart << ", fragmentEnd=" << extraItem.fragmentEnd
                              << ", packetUid=" << extraItem.packetUid);
+        if (m_data == nullptr)
+        {
+            ArenaItem arenaItem;
+            arenaItem.next = END_OF_LIST;
+            arenaItem.count = 0;
+            arenaItem.typeUid = uid;
+            arenaItem.chunkUid = item.chunkUid;
+            arenaItem.size = item.size;
+            arenaItem.fragmentStart = extraItem.fragmentStart;
+            arenaItem.fragmentEnd = extraItem.fragmentEnd;
+            arenaItem.packetUid = extraItem.packetUid;
+            arenaItems.push_back(arenaItem);
+            continue;
+        }
         uint32_t tmp = AddBig(0xffff, m_tail, &item, &extraItem);
         UpdateTail(tmp);
     }
+    if (m_data == nullptr)
+    {
+        uint32_t tail = END_OF_LIST;
+        for (auto i = arenaItems.rbegin(); i != arenaItems.rend(); i++)
+        {
+            i->next = tail;
+            tail = ArenaAllocate(*i);
+        }
+        uint32_t n;
+        uint32_t last = ArenaFindLast(n);
+        ArenaRebuild((last == END_OF_LIST) ? 0 : n + 1, tail);
+    }
     NS_ASSERT(desSize == 0);
     return (desSize != 0) ? 0 : 1;
 }
@@ -76,6 +76,14 @@ class Trailer;
  * integers, and some others as variable-size 32-bit integers.
  * The variable-size 32 bit integers are stored using the uleb128
  * encoding.
+ *
+ * Alternatively, the ARENA backend, see SetBackend(), stores the items
+ * of all the packets in a global arena of fixed-size items, each
+ * identified by its index in the arena. The list of each packet is
+ * singly linked, from its first item to its last item, and each item
+ * is shared by all the lists which end with it: copying a packet, or
+ * adding a header to it, does not copy any item. The items are
+ * reference-counted, and recycled once no list refers to them.
  */
 class PacketMetadata
 {
@@ -156,9 +164,17 @@ class PacketMetadata
       private:
         const PacketMetadata* m_metadata; //!< pointer to the metadata
         Buffer m_buffer;                  //!< buffer the metadata refers to
-        uint16_t m_current;               //!< current position
+        uint32_t m_current;               //!< current position
         uint32_t m_offset;                //!< offset
-        bool m_hasReadTail;               //!< true if the metadata tail has been read
+    };
+
+    /**
+     * \brief Storage of the metadata items
+     */
+    enum Backend
+    {
+        BUFFER, //!< A byte buffer per packet, with uleb128-encoded items (the default)
+        ARENA   //!< A global arena of fixed-size items, shared by the packets
     };
 
     /**
@@ -169,6 +185,22 @@ class PacketMetadata
      * \brief Enable the packet metadata checking
      */
     static void EnableChecking();
+    /**
+     * \brief Select the storage of the metadata of the packets created from now on
+     *
+     * With the BUFFER backend, the buffer of a packet is copied when the packet
+     * is modified while its buffer is shared with other packets, and the items
+     * must be decoded to be read. With the ARENA backend, adding or removing
+     * a header, and copying a packet, are done in constant time without copying
+     * any item; adding or removing a trailer, or a part of the packet, copies the
+     * items before it.
+     *
+     * The backend should be selected before any packet is created, e.g., before
+     * calling Enable(): the packets using different backends cannot be concatenated.
+     *
+     * \param backend the backend
+     */
+    static void SetBackend(Backend backend);
 
     /**
      * \brief Constructor
@@ -510,15 +542,37 @@ class PacketMetadata
     };
 
     /**
-     * \brief Class to hold all the metadata
+     * \brief An item of the ARENA backend
+     *
+     * Once created, the fields of an item, but its reference count,
+     * are not modified, as it can be shared by several lists.
+     */
+    struct ArenaItem
+    {
+        uint32_t next;          //!< index of the next item, or END_OF_LIST
+        uint32_t count;         //!< number of references to this item
+        uint16_t typeUid;       //!< uid of the TypeId of the header or trailer, 0 for payload
+        uint16_t chunkUid;      //!< see SmallItem::chunkUid
+        uint32_t size;          //!< see SmallItem::size
+        uint32_t fragmentStart; //!< see ExtraItem::fragmentStart
+        uint32_t fragmentEnd;   //!< see ExtraItem::fragmentEnd
+        uint64_t packetUid;     //!< see ExtraItem::packetUid
+    };
+
+    /**
+     * \brief The blocks of items of the ARENA backend
      */
-    class DataFreeList : public std::vector<Data*>
+    class Arena : public std::vector<ArenaItem*>
     {
       public:
-        ~DataFreeList();
+        ~Arena();
     };
 
-    friend DataFreeList::~DataFreeList();
+    /// Position after the last item of a list, in either backend
+    static constexpr uint32_t END_OF_LIST = 0xffffffff;
+    /// Base 2 logarithm of the number of items in a block of the ARENA backend
+    static constexpr uint32_t ARENA_BLOCK_BITS = 12;
+
     /// Friend class
     friend class ItemIterator;
 
@@ -628,12 +682,41 @@ class PacketMetadata
     uint32_t ReadItems(uint16_t current,
                        PacketMetadata::SmallItem* item,
                        PacketMetadata::ExtraItem* extraItem) const;
+    /**
+     * \brief Get the first item of the list, in either backend
+     * \returns the position of the first item, or END_OF_LIST if the list is empty
+     */
+    uint32_t GetFirstItem() const;
+    /**
+     * \brief Read an item of the list, in either backend
+     * \param current the position of the item
+     * \param item pointer to where we should store the data to return to the caller
+     * \param extraItem pointer to where we should store the data to return to the caller
+     * \returns the position of the next item, or END_OF_LIST after the last item
+     */
+    uint32_t ReadItem(uint32_t current,
+                      PacketMetadata::SmallItem* item,
+                      PacketMetadata::ExtraItem* extraItem) const;
     /**
      * \brief Add an header
      * \param uid header's uid to add
      * \param size header serialized size
      */
     void DoAddHeader(uint32_t uid, uint32_t size);
+    /**
+     * \brief Find the last item of the list of the ARENA backend
+     * \param [out] n the number of items before the last item
+     * \returns the index of the last item, or END_OF_LIST if the list is empty
+     */
+    uint32_t ArenaFindLast(uint32_t& n) const;
+    /**
+     * \brief Replace the list of the ARENA backend by a copy of its first
+     * items, followed by other items
+     * \param n the number of items to copy
+     * \param tail the index of the item to link after the copied items,
+     *        whose reference is transferred to the list, or END_OF_LIST
+     */
+    void ArenaRebuild(uint32_t n, uint32_t tail);
     /**
      * \brief Check if the metadata state is ok
      * \returns true if the internal state is ok
@@ -653,31 +736,45 @@ class PacketMetadata
     bool IsSharedPointerOk(uint16_t pointer) const;
 
     /**
-     * \brief Recycle the buffer memory
+     * \brief Recycle the buffer memory into the PacketMemoryPool
      * \param data the buffer data storage
      */
     static void Recycle(PacketMetadata::Data* data);
     /**
-     * \brief Create a buffer data storage
+     * \brief Create a buffer data storage from the PacketMemoryPool
      * \param size the storage size to create
      * \returns a pointer to the created buffer storage
      */
     static PacketMetadata::Data* Create(uint32_t size);
+
     /**
-     * \brief Allocate a buffer data storage
-     * \param n the storage size to create
-     * \returns a pointer to the allocated buffer storage
+     * \brief Get an item of the ARENA backend
+     * \param index the index of the item
+     * \returns the item
      */
-    static PacketMetadata::Data* Allocate(uint32_t n);
+    static inline ArenaItem& GetArenaItem(uint32_t index);
     /**
-     * \brief Deallocate the buffer memory
-     * \param data the buffer data storage
+     * \brief Create an item of the ARENA backend
+     * \param item the fields of the item, whose reference to the next item
+     *        is transferred to the new item
+     * \returns the index of the new item, with a reference owned by the caller
+     */
+    static uint32_t ArenaAllocate(const ArenaItem& item);
+    /**
+     * \brief Add a reference to an item of the ARENA backend
+     * \param index the index of the item, or END_OF_LIST
      */
-    static void Deallocate(PacketMetadata::Data* data);
+    static inline void ArenaRef(uint32_t index);
+    /**
+     * \brief Remove a reference to an item of the ARENA backend,
+     * and recycle the items which are not referenced anymore
+     * \param index the index of the item, or END_OF_LIST
+     */
+    static void ArenaUnref(uint32_t index);
 
-    static DataFreeList m_freeList; //!< the metadata data storage
     static bool m_enable;           //!< Enable the packet metadata
     static bool m_enableChecking;   //!< Enable the packet metadata checking
+    static Backend m_backend;       //!< Backend of the packets created from now on
 
     /**
      * Set to true when adding metadata to a packet is skipped because
@@ -686,9 +783,13 @@ class PacketMetadata
      */
     static bool m_metadataSkipped;
 
-    static uint32_t m_maxSize;  //!< maximum metadata size
     static uint16_t m_chunkUid; //!< Chunk Uid
 
+    static Arena m_arena;                        //!< the blocks of the ARENA backend
+    static uint32_t m_arenaSize;                 //!< number of items created in the blocks
+    static uint32_t m_arenaFree;                 //!< first item of the list of free items
+    static std::vector<uint32_t> m_arenaScratch; //!< indexes of the items to copy
+
     Data* m_data; //!< Metadata storage
     /*
        head -(next)-> tail
@@ -698,6 +799,7 @@ class PacketMetadata
     uint16_t m_head;      //!< list head
     uint16_t m_tail;      //!< list tail
     uint32_t m_used;      //!< used portion
+    uint32_t m_node;      //!< first item of the ARENA backend, m_data being null
     uint64_t m_packetUid; //!< packet Uid
 };
 
@@ -706,14 +808,34 @@ class PacketMetadata
 namespace ns3
 {
 
+PacketMetadata::ArenaItem&
+PacketMetadata::GetArenaItem(uint32_t index)
+{
+    return m_arena[index >> ARENA_BLOCK_BITS][index & ((1 << ARENA_BLOCK_BITS) - 1)];
+}
+
+void
+PacketMetadata::ArenaRef(uint32_t index)
+{
+    if (index != END_OF_LIST)
+    {
+        NS_ASSERT(GetArenaItem(index).count < std::numeric_limits<uint32_t>::max());
+        GetArenaItem(index).count++;
+    }
+}
+
 PacketMetadata::PacketMetadata(uint64_t uid, uint32_t size)
-    : m_data(PacketMetadata::Create(10)),
+    : m_data(m_backend == ARENA ? nullptr : PacketMetadata::Create(10)),
       m_head(0xffff),
       m_tail(0xffff),
       m_used(0),
+      m_node(END_OF_LIST),
       m_packetUid(uid)
 {
-    memset(m_data->m_data, 0xff, 4);
+    if (m_data != nullptr)
+    {
+        memset(m_data->m_data, 0xff, 4);
+    }
     if (size > 0)
     {
         DoAddHeader(0, size);
@@ -725,11 +847,15 @@ PacketMetadata::PacketMetadata(const PacketMetadata& o)
       m_head(o.m_head),
       m_tail(o.m_tail),
       m_used(o.m_used),
+      m_node(o.m_node),
       m_packetUid(o.m_packetUid)
 {
-    NS_ASSERT(m_data != nullptr);
-    NS_ASSERT(m_data->m_count < std::numeric_limits<uint32_t>::max());
-    m_data->m_count++;
+    if (m_data != nullptr)
+    {
+        NS_ASSERT(m_data->m_count < std::numeric_limits<uint32_t>::max());
+        m_data->m_count++;
+    }
+    ArenaRef(m_node);
 }
 
 PacketMetadata&
@@ -738,15 +864,25 @@ PacketMetadata::operator=(const PacketMetadata& o)
     if (m_data != o.m_data)
     {
         // not self assignment
-        NS_ASSERT(m_data != nullptr);
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (m_data != nullptr)
         {
-            PacketMetadata::Recycle(m_data);
+            m_data->m_count--;
+            if (m_data->m_count == 0)
+            {
+                PacketMetadata::Recycle(m_data);
+            }
         }
         m_data = o.m_data;
-        NS_ASSERT(m_data != nullptr);
-        m_data->m_count++;
+        if (m_data != nullptr)
+        {
+            m_data->m_count++;
+        }
+    }
+    if (m_node != o.m_node)
+    {
+        ArenaRef(o.m_node);
+        ArenaUnref(m_node);
+        m_node = o.m_node;
     }
     m_head = o.m_head;
     m_tail = o.m_tail;
@@ -757,11 +893,17 @@ PacketMetadata::operator=(const PacketMetadata& o)
 
 PacketMetadata::~PacketMetadata()
 {
-    NS_ASSERT(m_data != nullptr);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (m_data != nullptr)
+    {
+        m_data->m_count--;
+        if (m_data->m_count == 0)
+        {
+            PacketMetadata::Recycle(m_data);
+        }
+    }
+    if (m_node != END_OF_LIST)
     {
-        PacketMetadata::Recycle(m_data);
+        ArenaUnref(m_node);
     }
 }
 
@@ -19,7 +19,7 @@
 
 /**
 \file   packet-tag-list.cc
-\brief  Implements a linked list of Packet tags, including copy-on-write semantics.
+\brief  Implements a compact list of Packet tags, including copy-on-write semantics.
 */
 
 #include "packet-tag-list.h"
@@ -30,277 +30,183 @@
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
 
+#include <algorithm>
 #include <cstring>
+#include <limits>
 
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("PacketTagList");
 
-PacketTagList::TagData*
-PacketTagList::CreateTagData(size_t dataSize)
+PacketTagList::Data*
+PacketTagList::CreateData(uint32_t capacity)
 {
-    NS_ASSERT_MSG(dataSize < std::numeric_limits<decltype(TagData::size)>::max(),
-                  "Requested TagData size " << dataSize << " exceeds maximum "
-                                            << std::numeric_limits<decltype(TagData::size)>::max());
-
-    void* p = std::malloc(sizeof(TagData) + dataSize - 1);
-    // The matching frees are in RemoveAll and RemoveWriter
+    void* p = std::malloc(sizeof(Data) + capacity - 1);
+    // The matching free is in RemoveAll
 
-    auto tag = new (p) TagData;
-    tag->size = dataSize;
-    return tag;
+    auto data = new (p) Data;
+    data->count = 1;
+    data->capacity = capacity;
+    return data;
 }
 
-bool
-PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
+uint32_t
+PacketTagList::Find(uint16_t uid) const
 {
-    TypeId tid = tag.GetInstanceTypeId();
-    NS_LOG_FUNCTION(this << tid);
-    NS_LOG_INFO("looking for " << tid);
-
-    // trivial case when list is empty
-    if (m_next == nullptr)
+    const uint8_t* buffer = reinterpret_cast<const uint8_t*>(Begin());
+    for (const TagData* cur = Begin(); cur != End(); cur = Next(cur))
     {
-        return false;
-    }
-
-    bool found = false;
-
-    TagData** prevNext = &m_next; // previous node's next pointer
-    TagData* cur = m_next;        // cursor to current node
-    TagData* it = nullptr;        // utility
-
-    // Search from the head of the list until we find tid or a merge
-    while (cur != nullptr)
-    {
-        if (cur->count > 1)
-        {
-            // found merge
-            NS_LOG_INFO("found initial merge before tid");
-            break;
-        }
-        else if (cur->tid == tid)
+        if (cur->uid == uid)
         {
-            NS_LOG_INFO("found tid before initial merge, calling writer");
-            found = (this->*Writer)(tag, true, cur, prevNext);
-            break;
+            return reinterpret_cast<const uint8_t*>(cur) - buffer;
         }
-        else
-        {
-            // no merge or tid found yet, move on
-            prevNext = &cur->next;
-            cur = cur->next;
-        }
-    } // while !found && !cow
-
-    // did we find it or run out of tags?
-    if (cur == nullptr || found)
-    {
-        NS_LOG_INFO("returning after header with found: " << found);
-        return found;
     }
+    return m_size;
+}
 
-    // From here on out, we have to copy the list
-    // until we find tid, then link past it
+uint8_t*
+PacketTagList::Reserve(uint32_t size)
+{
+    NS_LOG_FUNCTION(this << size);
 
-    // Before we do all that work, let's make sure tid really exists
-    for (it = cur; it != nullptr; it = it->next)
+    if (m_data == nullptr && size <= INLINE_SIZE)
     {
-        if (it->tid == tid)
-        {
-            break;
-        }
+        return m_inline;
     }
-    if (it == nullptr)
+    if (m_data != nullptr && m_data->count == 1 && size <= m_data->capacity)
     {
-        // got to end of list without finding tid
-        NS_LOG_INFO("tid not found after first merge");
-        return found;
+        return m_data->data;
     }
 
-    // At this point cur is a merge, but untested for tid
-    NS_ASSERT(cur != nullptr);
-    NS_ASSERT(cur->count > 1);
-
-    /*
-       Walk the remainder of the list, copying, until we find tid
-       As we put a copy of the cur node onto our list,
-       we move the merge point down the list.
-
-       Starting position                  End position
-         T1 is a merge                     T1.count decremented
-                                           T2 is a merge
-                                           T1' is a copy of T1
-
-            other                             other
-                 \                                 \
-        Prev  ->  T1  ->  T2  -> ...                T1  ->  T2  -> ...
-             /   /                                         /|
-        pNext cur                         Prev  ->  T1' --/ |
-                                                       /    |
-                                                  pNext   cur
-
-       When we reach tid, we link past it, decrement count, and we're done.
-    */
-
-    // Should normally check for null cur pointer,
-    // but since we know tid exists, we'll skip this test
-    while (/* cur && */ cur->tid != tid)
+    if (size <= INLINE_SIZE)
     {
-        NS_ASSERT(cur != nullptr);
-        NS_ASSERT(cur->count > 1);
-        cur->count--; // unmerge cur
-        TagData* copy = CreateTagData(cur->size);
-        copy->tid = cur->tid;
-        copy->count = 1;
-        copy->size = cur->size;
-        memcpy(copy->data, cur->data, copy->size);
-        copy->next = cur->next; // merge into tail
-        copy->next->count++;    // mark new merge
-        *prevNext = copy;       // point prior list at copy
-        prevNext = &copy->next; // advance
-        cur = copy->next;
+        // The shared tags fit inline: copy them, and unshare the Data block
+        NS_ASSERT(m_data != nullptr && m_data->count > 1);
+        NS_LOG_INFO("copy the shared tags inline");
+        std::memcpy(m_inline, m_data->data, m_size);
+        m_data->count--;
+        m_data = nullptr;
+        return m_inline;
     }
-    // Sanity check:
-    NS_ASSERT(cur != nullptr);  // cur should be non-zero
-    NS_ASSERT(cur->tid == tid); // cur->tid should be tid
-    NS_ASSERT(cur->count > 1);  // cur should be a merge
-
-    // link around tid, removing it from our list
-    found = (this->*Writer)(tag, false, cur, prevNext);
-    return found;
-}
 
-bool
-PacketTagList::Remove(Tag& tag)
-{
-    return COWTraverse(tag, &PacketTagList::RemoveWriter);
+    uint32_t capacity = (m_data != nullptr) ? m_data->capacity : INLINE_SIZE;
+    if (size > capacity)
+    {
+        capacity = std::max(size, 2 * capacity);
+    }
+    NS_LOG_INFO("copy the tags in a new block of " << capacity << " bytes");
+    Data* data = CreateData(capacity);
+    std::memcpy(data->data, Begin(), m_size);
+    uint32_t tagSize = m_size;
+    RemoveAll();
+    m_data = data;
+    m_size = tagSize;
+    return m_data->data;
 }
 
-// COWWriter implementing Remove
-bool
-PacketTagList::RemoveWriter(Tag& tag,
-                            bool preMerge,
-                            PacketTagList::TagData* cur,
-                            PacketTagList::TagData** prevNext)
+void
+PacketTagList::RemoveAt(uint32_t offset)
 {
-    NS_LOG_FUNCTION_NOARGS();
+    NS_LOG_FUNCTION(this << offset);
 
-    // found tid
-    bool found = true;
-    tag.Deserialize(TagBuffer(cur->data, cur->data + cur->size));
-    *prevNext = cur->next; // link around cur
-
-    if (preMerge)
-    {
-        // found tid before first merge, so delete cur
-        cur->~TagData();
-        std::free(cur);
-    }
-    else
-    {
-        // cur is always a merge at this point
-        // unmerge cur, since we linked around it already
-        cur->count--;
-        if (cur->next != nullptr)
-        {
-            // there's a next, so make it a merge
-            cur->next->count++;
-        }
-    }
-    return found;
+    uint8_t* buffer = Reserve(m_size);
+    auto cur = reinterpret_cast<const TagData*>(buffer + offset);
+    uint32_t entrySize = GetEntrySize(cur->size);
+    std::memmove(buffer + offset, buffer + offset + entrySize, m_size - offset - entrySize);
+    m_size -= entrySize;
 }
 
 bool
-PacketTagList::Replace(Tag& tag)
+PacketTagList::Remove(Tag& tag)
 {
-    bool found = COWTraverse(tag, &PacketTagList::ReplaceWriter);
-    if (!found)
+    TypeId tid = tag.GetInstanceTypeId();
+    NS_LOG_FUNCTION(this << tid);
+
+    uint32_t offset = Find(tid.GetUid());
+    if (offset == m_size)
     {
-        Add(tag);
+        return false;
     }
-    return found;
+    auto cur = reinterpret_cast<const TagData*>(reinterpret_cast<const uint8_t*>(Begin()) + offset);
+    uint8_t* data = const_cast<uint8_t*>(GetData(cur));
+    tag.Deserialize(TagBuffer(data, data + cur->size));
+    RemoveAt(offset);
+    return true;
 }
 
-// COWWriter implementing Replace
 bool
-PacketTagList::ReplaceWriter(Tag& tag,
-                             bool preMerge,
-                             PacketTagList::TagData* cur,
-                             PacketTagList::TagData** prevNext)
+PacketTagList::Replace(Tag& tag)
 {
-    NS_LOG_FUNCTION_NOARGS();
+    TypeId tid = tag.GetInstanceTypeId();
+    NS_LOG_FUNCTION(this << tid);
 
-    // found tid
-    bool found = true;
-    if (preMerge)
+    uint32_t offset = Find(tid.GetUid());
+    if (offset == m_size)
     {
-        // found tid before first merge, so just rewrite
-        tag.Serialize(TagBuffer(cur->data, cur->data + cur->size));
+        Add(tag);
+        return false;
     }
-    else
+    auto cur = reinterpret_cast<const TagData*>(reinterpret_cast<const uint8_t*>(Begin()) + offset);
+    if (cur->size != tag.GetSerializedSize())
     {
-        // cur is always a merge at this point
-        // need to copy, replace, and link past cur
-        cur->count--; // unmerge cur
-        TagData* copy = CreateTagData(tag.GetSerializedSize());
-        copy->tid = tag.GetInstanceTypeId();
-        copy->count = 1;
-        tag.Serialize(TagBuffer(copy->data, copy->data + copy->size));
-        copy->next = cur->next; // merge into tail
-        if (copy->next != nullptr)
-        {
-            copy->next->count++; // mark new merge
-        }
-        *prevNext = copy; // point prior list at copy
+        RemoveAt(offset);
+        Add(tag);
+        return true;
     }
-    return found;
+    // Same size, rewrite the tag in place
+    uint8_t* data = Reserve(m_size) + offset + sizeof(TagData);
+    tag.Serialize(TagBuffer(data, data + tag.GetSerializedSize()));
+    return true;
 }
 
 void
 PacketTagList::Add(const Tag& tag) const
 {
-    NS_LOG_FUNCTION(this << tag.GetInstanceTypeId());
+    TypeId tid = tag.GetInstanceTypeId();
+    NS_LOG_FUNCTION(this << tid);
     // ensure this id was not yet added
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
-    {
-        NS_ASSERT_MSG(cur->tid != tag.GetInstanceTypeId(),
-                      "Error: cannot add the same kind of tag twice. The tag type is "
-                          << tag.GetInstanceTypeId().GetName());
-    }
-    TagData* head = CreateTagData(tag.GetSerializedSize());
-    head->count = 1;
-    head->next = nullptr;
-    head->tid = tag.GetInstanceTypeId();
-    head->next = m_next;
-    tag.Serialize(TagBuffer(head->data, head->data + head->size));
-
-    const_cast<PacketTagList*>(this)->m_next = head;
+    NS_ASSERT_MSG(Find(tid.GetUid()) == m_size,
+                  "Error: cannot add the same kind of tag twice. The tag type is "
+                      << tid.GetName());
+
+    uint32_t size = tag.GetSerializedSize();
+    NS_ASSERT_MSG(size <= std::numeric_limits<decltype(TagData::size)>::max(),
+                  "Requested TagData size " << size << " exceeds maximum "
+                                            << std::numeric_limits<decltype(TagData::size)>::max());
+    uint32_t entrySize = GetEntrySize(size);
+
+    // Only the storage of this list is written to, if needed after a copy
+    auto self = const_cast<PacketTagList*>(this);
+    uint8_t* buffer = self->Reserve(m_size + entrySize);
+
+    // The most recent tag comes first
+    std::memmove(buffer + entrySize, buffer, m_size);
+    auto head = reinterpret_cast<TagData*>(buffer);
+    head->uid = tid.GetUid();
+    head->size = size;
+    uint8_t* data = buffer + sizeof(TagData);
+    tag.Serialize(TagBuffer(data, data + size));
+    self->m_size += entrySize;
 }
 
 bool
 PacketTagList::Peek(Tag& tag) const
 {
-    NS_LOG_FUNCTION(this << tag.GetInstanceTypeId());
     TypeId tid = tag.GetInstanceTypeId();
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    NS_LOG_FUNCTION(this << tid);
+
+    uint32_t offset = Find(tid.GetUid());
+    if (offset == m_size)
     {
-        if (cur->tid == tid)
-        {
-            /* found tag */
-            tag.Deserialize(TagBuffer(cur->data, cur->data + cur->size));
-            return true;
-        }
+        /* no tag found */
+        return false;
     }
-    /* no tag found */
-    return false;
-}
-
-const PacketTagList::TagData*
-PacketTagList::Head() const
-{
-    return m_next;
+    /* found tag */
+    auto cur = reinterpret_cast<const TagData*>(reinterpret_cast<const uint8_t*>(Begin()) + offset);
+    uint8_t* data = const_cast<uint8_t*>(GetData(cur));
+    tag.Deserialize(TagBuffer(data, data + cur->size));
+    return true;
 }
 
 uint32_t
@@ -312,7 +218,7 @@ PacketTagList::GetSerializedSize() const
 
     size = 4; // numberOfTags
 
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    for (const TagData* cur = Begin(); cur != End(); cur = Next(cur))
     {
         size += 4; // TagData -> size
 
@@ -346,7 +252,7 @@ PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
     uint32_t* numberOfTags = p;
     *p++ = 0;
 
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    for (const TagData* cur = Begin(); cur != End(); cur = Next(cur))
     {
         size += 4;
 
@@ -357,7 +263,9 @@ PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
 
         *p++ = cur->size;
 
-        NS_LOG_INFO("Serializing tag id " << cur->tid);
+        TypeId tid;
+        tid.SetUid(cur->uid);
+        NS_LOG_INFO("Serializing tag id " << tid);
 
         // ensure size is multiple of 4 bytes for 4 byte boundaries
         uint32_t hashSize = (sizeof(TypeId::hash_t) + 3) & (~3);
@@ -368,8 +276,8 @@ PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
             return 0;
         }
 
-        TypeId::hash_t tid = cur->tid.GetHash();
-        memcpy(p, &tid, sizeof(TypeId::hash_t));
+        TypeId::hash_t hash = tid.GetHash();
+        memcpy(p, &hash, sizeof(TypeId::hash_t));
         p += hashSize / 4;
 
         // ensure size is multiple of 4 bytes for 4 byte boundaries
@@ -381,7 +289,7 @@ PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
             return 0;
         }
 
-        memcpy(p, cur->data, cur->size);
+        memcpy(p, GetData(cur), cur->size);
         p += tagWordSize / 4;
 
         (*numberOfTags)++;
@@ -404,7 +312,6 @@ PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
 
     NS_LOG_INFO("Deserializing number of tags " << numberOfTags);
 
-    TagData* prevTag = nullptr;
     for (uint32_t i = 0; i < numberOfTags; ++i)
     {
         NS_ASSERT(sizeCheck >= 4);
@@ -422,30 +329,21 @@ PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
 
         NS_LOG_INFO("Deserializing tag of type " << tid);
 
-        TagData* newTag = CreateTagData(tagSize);
-        newTag->count = 1;
-        newTag->next = nullptr;
-        newTag->tid = tid;
+        // The tags are serialized in order: append them
+        uint32_t entrySize = GetEntrySize(tagSize);
+        uint8_t* entry = Reserve(m_size + entrySize) + m_size;
+        auto newTag = reinterpret_cast<TagData*>(entry);
+        newTag->uid = tid.GetUid();
+        newTag->size = tagSize;
 
         NS_ASSERT(sizeCheck >= tagSize);
-        memcpy(newTag->data, p, tagSize);
+        memcpy(entry + sizeof(TagData), p, tagSize);
+        m_size += entrySize;
 
         // ensure 4 byte boundary
         uint32_t tagWordSize = (tagSize + 3) & (~3);
         p += tagWordSize / 4;
         sizeCheck -= tagWordSize;
-
-        // Set link list pointers.
-        if (i == 0)
-        {
-            m_next = newTag;
-        }
-        else
-        {
-            prevTag->next = newTag;
-        }
-
-        prevTag = newTag;
     }
 
     NS_ASSERT(sizeCheck == 0);
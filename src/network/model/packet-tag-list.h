@@ -21,11 +21,13 @@
 
 /**
 \file   packet-tag-list.h
-\brief  Defines a linked list of Packet tags, including copy-on-write semantics.
+\brief  Defines a compact list of Packet tags, including copy-on-write semantics.
 */
 
 #include "ns3/type-id.h"
 
+#include <cstdlib>
+#include <cstring>
 #include <ostream>
 #include <stdint.h>
 
@@ -44,88 +46,49 @@ class Tag;
  *
  * \internal
  *
- * The implementation of this class is a bit tricky.  Refer to this
- * diagram in the discussion that follows.
+ * The tags are stored in serialized form, one after the other, in a flat
+ * byte array:
  *
- * \dot
- *    digraph {
- *        rankdir = "LR";
- *        clusterrank = local;
- *        node [ shape = record, fontname="FreeSans", fontsize="10" ];
- *        oth  [ label="<l> Other branch | <n> next | <c> ..." ];
- *        PTL1 [ label="<l> PacketTagList A | <n> m_next" , shape=Mrecord];
- *        PTL2 [ label="<l> PacketTagList B | <n> m_next" , shape=Mrecord];
- *        oth:n  -> T7:l ;
- *        PTL2:n -> T6:l ;
- *        PTL1:n -> T5:l ;
- *        T1   [ label="<l> T1  | <n> next | <c> count = 1" ];
- *        T2   [ label="<l> T2  | <n> next | <c> count = 1" ];
- *        T3   [ label="<l> T3  | <n> next | <c> count = 2" ];
- *        T4   [ label="<l> T4  | <n> next | <c> count = 1" ];
- *        T5   [ label="<l> T5  | <n> next | <c> count = 2" ];
- *        T6   [ label="<l> T6  | <n> next | <c> count = 1" ];
- *        T7   [ label="<l> T7  | <n> next | <c> count = 1" ];
- *        NULL [ label="0", shape = ellipse ];
- *        subgraph cluster_list {
- *          penwidth = 0;
- *          T6:n -> T5:l ;
- *          T5:n -> T4:l ;
- *          T4:n -> T3:l ;
- *          T7:n -> T3:l ;
- *          T3:n -> T2:l ;
- *          T2:n -> T1:l ;
- *          T1:n -> NULL ;
- *        };
- *      }
- * \enddot
+ * \verbatim
+   +-----+------+------------+-----+------+------------+-----
+   | uid | size | data + pad | uid | size | data + pad | ...
+   +-----+------+------------+-----+------+------------+-----
+   \endverbatim
  *
- *   - Tags are stored in serialized form in a tree of TagData
- *     structures. (<tt>T1-T7</tt> in the diagram)
+ *   - Each tag starts with a TagData header, holding the uid of the
+ *     TypeId of the tag and the size of its serialized form, followed
+ *     by the serialized tag, padded to a multiple of 4 bytes.
  *
- *   - Each TagData points (\c next pointers in the diagram)
- *     toward the root of the tree, which is a null pointer.
+ *   - The most recent tag comes first.
  *
- *   - \c count is the number of incoming pointers to this
- *     TagData.  Branch points, where branches merge or join, have
- *     <tt>count \> 1</tt> (\c T3, \c T5); successive links along
- *     a branch have <tt>count = 1</tt> (\c T1, \c T2, \c T4, \c T6, \c T7).
+ *   - A packet typically carries a handful of small tags, so the
+ *     first #INLINE_SIZE bytes are stored in the PacketTagList itself,
+ *     and adding these tags does not allocate any memory.
  *
- *   - Each PacketTagList points to a specific TagData,
- *     which is the most recent Tag added to the packet. (<tt>T5-T7</tt>)
+ *   - Larger lists are stored in a reference counted Data block.
  *
- *   - Conceptually, therefore, each Packet has a PacketTagList which
- *     points to a singly-linked list of TagData.
+ * Looking for a tag is a linear scan of contiguous memory, comparing
+ * the 16 bits uid of the TypeId of each tag.
  *
  * \par <b> Copy-on-write </b> is implemented as follows:
  *
- *   - #Add prepends the new tag to the list (growing that branch of the tree,
- *     as \c T6). This is a constant time operation, and does not affect
- *     any other #PacketTagList's, hence this is a \c const function.
- *
  *   - Copy constructor (PacketTagList(const PacketTagList & o))
  *     and assignment (#operator=(const PacketTagList & o))
- *     simply join the tree at the same place as the original
- *     PacketTagList \c o, incrementing the \c count.
- *     For assignment, the old branch is deleted, up to
- *     the first branch point, which has its \c count decremented.
- *     (PacketTagList \c B started as a copy of PacketTagList \c A,
- *     before \c T6 was added to \c B).
+ *     copy the inline tags, or share the Data block of the original
+ *     PacketTagList \c o, incrementing its \c count.
+ *
+ *   - #Add, #Remove and #Replace modify the tags in place, unless the
+ *     Data block is shared.  In that case, the tags are first copied,
+ *     inline if they fit, or in a new Data block otherwise.
  *
- *   - #Remove and #Replace are a little tricky, depending on where the
- *     target tag is found relative to the first branch point:
- *     - \e Target before <em> the first branch point: </em> \n
- *       The target is just dealt with in place (linked around and deleted,
- *       in the case of #Remove; rewritten in the case of #Replace).
- *     - \e Target at or after <em> the first branch point: </em> \n
- *       The portion of the list between the first branch and the target is
- *       shared. This portion is copied before the #Remove or #Replace is
- *       performed.
+ *   - #Add does not change the tags seen by the other PacketTagList's,
+ *     hence this is a \c const function.
  */
 class PacketTagList
 {
   public:
     /**
-     * Tree node for sharing serialized tags.
+     * Header of a serialized tag.
      *
      * See PacketTagList for a discussion of the data structure.
      *
@@ -135,17 +98,12 @@ class PacketTagList
      * The Item nested class can't be forward declared, so friending isn't
      * possible.
      *
-     * We use placement new so we can allocate enough room for the Tag
-     * type which will be serialized into data.  See Object::Aggregates
-     * for a similar construction.
+     * The serialized tag follows the header, see GetData().
      */
     struct TagData
     {
-        TagData* next;   //!< Pointer to next in list
-        uint32_t count;  //!< Number of incoming links
-        TypeId tid;      //!< Type of the tag serialized into #data
-        uint32_t size;   //!< Size of the \c data buffer
-        uint8_t data[1]; //!< Serialization buffer
+        uint16_t uid;  //!< Uid of the TypeId of the tag serialized after this header
+        uint16_t size; //!< Size of the serialized tag
     };
 
     /**
@@ -157,8 +115,8 @@ class PacketTagList
      *
      * \param [in] o The PacketTagList to copy.
      *
-     * This makes a light-weight copy by #RemoveAll, then
-     * pointing to the same \ref TagData as \pname{o}.
+     * This copies the inline tags of \pname{o}, or shares the
+     * Data block of \pname{o}.
      */
     inline PacketTagList(const PacketTagList& o);
     /**
@@ -168,18 +126,18 @@ class PacketTagList
      * \returns the copied object
      *
      * This makes a light-weight copy by #RemoveAll, then
-     * pointing to the same \ref TagData as \pname{o}.
+     * copying the inline tags, or sharing the Data block of \pname{o}.
      */
     inline PacketTagList& operator=(const PacketTagList& o);
     /**
      * Destructor
      *
-     * #RemoveAll's the tags up to the first merge.
+     * #RemoveAll's the tags.
      */
     inline ~PacketTagList();
 
     /**
-     * Add a tag to the head of this branch.
+     * Add a tag to the head of the list.
      *
      * \param [in] tag The tag to add
      */
@@ -211,13 +169,27 @@ class PacketTagList
      */
     bool Peek(Tag& tag) const;
     /**
-     * Remove all tags from this list (up to the first merge).
+     * Remove all tags from this list.
      */
     inline void RemoveAll();
     /**
-     * \returns pointer to head of tag list
+     * \returns pointer to the first tag of the list
+     */
+    inline const PacketTagList::TagData* Begin() const;
+    /**
+     * \returns pointer past the last tag of the list
      */
-    const PacketTagList::TagData* Head() const;
+    inline const PacketTagList::TagData* End() const;
+    /**
+     * \param [in] cur A tag of the list.
+     * \returns pointer to the tag following \pname{cur}
+     */
+    static inline const PacketTagList::TagData* Next(const PacketTagList::TagData* cur);
+    /**
+     * \param [in] cur A tag of the list.
+     * \returns pointer to the serialized form of \pname{cur}
+     */
+    static inline const uint8_t* GetData(const PacketTagList::TagData* cur);
     /**
      * Returns number of bytes required for packet serialization.
      *
@@ -245,66 +217,57 @@ class PacketTagList
 
   private:
     /**
-     * Allocate and construct a TagData struct, sizing the data area
-     * large enough to serialize dataSize bytes from a Tag.
-     *
-     * \param [in] dataSize The serialized size of the Tag.
-     * \returns The newly constructed TagData object.
+     * Reference counted storage, for the lists which do not fit inline.
      */
-    static TagData* CreateTagData(size_t dataSize);
+    struct Data
+    {
+        uint32_t count;    //!< Number of PacketTagList's sharing this block
+        uint32_t capacity; //!< Size of the \c data buffer
+        uint8_t data[1];   //!< Serialized tags
+    };
+
+    /** Number of bytes of tags stored in the PacketTagList itself. */
+    static constexpr uint32_t INLINE_SIZE = 52;
 
     /**
-     * Typedef of method function pointer for copy-on-write operations
+     * Allocate a Data block.
      *
-     * \param [in] tag The tag type to operate on.
-     * \param [in] preMerge True if \pname{tag} was found before the first merge,
-     *             false otherwise.
-     * \param [in] cur Pointer to the tag.
-     * \param [in] prevNext Pointer to the struct TagData.next pointer
-     *          pointing to \pname{cur}.
-     * \returns True if operation successful, false otherwise
+     * \param [in] capacity The number of bytes of tags in the block.
+     * \returns The newly allocated Data block, with a count of 1.
      */
-    typedef bool (PacketTagList::*COWWriter)(Tag& tag,
-                                             bool preMerge,
-                                             TagData* cur,
-                                             TagData** prevNext);
+    static Data* CreateData(uint32_t capacity);
     /**
-     * Traverse the list implementing copy-on-write, using \pname{Writer}.
+     * Get the number of bytes taken by a tag in the list.
      *
-     * \param [in] tag The tag type to operate on.
-     * \param [in] Writer The copy-on-write function to use.
-     * \returns True if \pname{tag} found, false otherwise.
+     * \param [in] size The serialized size of the tag.
+     * \returns The size of the TagData header and of the padded tag.
      */
-    bool COWTraverse(Tag& tag, PacketTagList::COWWriter Writer);
+    static inline uint32_t GetEntrySize(uint32_t size);
     /**
-     * Copy-on-write implementing Remove.
+     * Find a tag in the list.
      *
-     * \param [in] tag The target tag type to remove.
-     * \param [in] preMerge True if \pname{tag} was found before the first merge,
-     *             false otherwise.
-     * \param [in] cur Pointer to the tag.
-     * \param [in] prevNext Pointer to the struct TagData.next pointer
-     *          pointing to \pname{cur}.
-     * \returns True, since tag will definitely be removed.
+     * \param [in] uid The uid of the TypeId of the tag.
+     * \returns The offset of the tag in the storage, or #m_size if not found.
      */
-    bool RemoveWriter(Tag& tag, bool preMerge, TagData* cur, TagData** prevNext);
+    uint32_t Find(uint16_t uid) const;
     /**
-     * Copy-on-write implementing Replace
+     * Make sure the storage can be written and holds at least
+     * \pname{size} bytes, keeping the current tags.
      *
-     * \param [in] tag The target tag type to replace
-     * \param [in] preMerge True if \pname{tag} was found before the first merge,
-     *          false otherwise.
-     * \param [in] cur Pointer to the tag
-     * \param [in] prevNext Pointer to the struct TagData.next pointer
-     *          pointing to \pname{cur}.
-     * \returns True, since tag value will definitely be replaced.
+     * \param [in] size The number of bytes needed.
+     * \returns The storage.
      */
-    bool ReplaceWriter(Tag& tag, bool preMerge, TagData* cur, TagData** prevNext);
-
+    uint8_t* Reserve(uint32_t size);
     /**
-     * Pointer to first \ref TagData on the list
+     * Remove a tag from the list.
+     *
+     * \param [in] offset The offset of the tag in the storage.
      */
-    TagData* m_next;
+    void RemoveAt(uint32_t offset);
+
+    Data* m_data;                                   //!< The shared storage, null if inline
+    uint32_t m_size;                                //!< The number of bytes of tags
+    alignas(TagData) uint8_t m_inline[INLINE_SIZE]; //!< The inline storage
 };
 
 } // namespace ns3
@@ -317,16 +280,22 @@ namespace ns3
 {
 
 PacketTagList::PacketTagList()
-    : m_next()
+    : m_data(nullptr),
+      m_size(0)
 {
 }
 
 PacketTagList::PacketTagList(const PacketTagList& o)
-    : m_next(o.m_next)
+    : m_data(o.m_data),
+      m_size(o.m_size)
 {
-    if (m_next != nullptr)
+    if (m_data != nullptr)
+    {
+        m_data->count++;
+    }
+    else
     {
-        m_next->count++;
+        std::memcpy(m_inline, o.m_inline, m_size);
     }
 }
 
@@ -334,15 +303,20 @@ PacketTagList&
 PacketTagList::operator=(const PacketTagList& o)
 {
     // self assignment
-    if (m_next == o.m_next)
+    if (this == &o)
     {
         return *this;
     }
     RemoveAll();
-    m_next = o.m_next;
-    if (m_next != nullptr)
+    m_data = o.m_data;
+    m_size = o.m_size;
+    if (m_data != nullptr)
+    {
+        m_data->count++;
+    }
+    else
     {
-        m_next->count++;
+        std::memcpy(m_inline, o.m_inline, m_size);
     }
     return *this;
 }
@@ -355,27 +329,50 @@ PacketTagList::~PacketTagList()
 void
 PacketTagList::RemoveAll()
 {
-    TagData* prev = nullptr;
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    if (m_data != nullptr)
     {
-        cur->count--;
-        if (cur->count > 0)
+        m_data->count--;
+        if (m_data->count == 0)
         {
-            break;
+            std::free(m_data);
         }
-        if (prev != nullptr)
-        {
-            prev->~TagData();
-            std::free(prev);
-        }
-        prev = cur;
+        m_data = nullptr;
     }
-    if (prev != nullptr)
-    {
-        prev->~TagData();
-        std::free(prev);
-    }
-    m_next = nullptr;
+    m_size = 0;
+}
+
+const PacketTagList::TagData*
+PacketTagList::Begin() const
+{
+    const uint8_t* buffer = (m_data != nullptr) ? m_data->data : m_inline;
+    return reinterpret_cast<const TagData*>(buffer);
+}
+
+const PacketTagList::TagData*
+PacketTagList::End() const
+{
+    const uint8_t* buffer = (m_data != nullptr) ? m_data->data : m_inline;
+    return reinterpret_cast<const TagData*>(buffer + m_size);
+}
+
+const PacketTagList::TagData*
+PacketTagList::Next(const PacketTagList::TagData* cur)
+{
+    const uint8_t* next = reinterpret_cast<const uint8_t*>(cur) + GetEntrySize(cur->size);
+    return reinterpret_cast<const TagData*>(next);
+}
+
+const uint8_t*
+PacketTagList::GetData(const PacketTagList::TagData* cur)
+{
+    return reinterpret_cast<const uint8_t*>(cur) + sizeof(TagData);
+}
+
+uint32_t
+PacketTagList::GetEntrySize(uint32_t size)
+{
+    // ensure size is multiple of 4 bytes for 4 byte boundaries
+    return sizeof(TagData) + ((size + 3) & (~3));
 }
 
 } // namespace ns3
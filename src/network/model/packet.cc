@@ -19,9 +19,11 @@
 #include "packet.h"
 
 #include "ns3/assert.h"
+#include "ns3/checkpoint.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
 #include <cstdarg>
 #include <string>
 
@@ -30,7 +32,20 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Packet");
 
+#ifdef NS3_MTP
+std::atomic<uint32_t> Packet::m_globalUid = 0;
+#else
 uint32_t Packet::m_globalUid = 0;
+#endif
+
+bool Packet::m_enableHeaderCache = false;
+
+bool Packet::m_checkpoint = CheckpointManager::RegisterGlobal(
+    "Packet",
+    [](CheckpointWriter& writer) {
+        writer.Write("globalUid", static_cast<uint32_t>(m_globalUid));
+    },
+    [](CheckpointReader& reader) { m_globalUid = reader.Read<uint32_t>("globalUid"); });
 
 TypeId
 ByteTagIterator::Item::GetTypeId() const
@@ -89,15 +104,17 @@ ByteTagIterator::ByteTagIterator(ByteTagList::Iterator i)
 {
 }
 
-PacketTagIterator::PacketTagIterator(const PacketTagList::TagData* head)
-    : m_current(head)
+PacketTagIterator::PacketTagIterator(const PacketTagList::TagData* head,
+                                     const PacketTagList::TagData* end)
+    : m_current(head),
+      m_end(end)
 {
 }
 
 bool
 PacketTagIterator::HasNext() const
 {
-    return m_current != nullptr;
+    return m_current != m_end;
 }
 
 PacketTagIterator::Item
@@ -105,7 +122,7 @@ PacketTagIterator::Next()
 {
     NS_ASSERT(HasNext());
     const PacketTagList::TagData* prev = m_current;
-    m_current = m_current->next;
+    m_current = PacketTagList::Next(m_current);
     return PacketTagIterator::Item(prev);
 }
 
@@ -117,14 +134,17 @@ PacketTagIterator::Item::Item(const PacketTagList::TagData* data)
 TypeId
 PacketTagIterator::Item::GetTypeId() const
 {
-    return m_data->tid;
+    TypeId tid;
+    tid.SetUid(m_data->uid);
+    return tid;
 }
 
 void
 PacketTagIterator::Item::GetTag(Tag& tag) const
 {
-    NS_ASSERT(tag.GetInstanceTypeId() == m_data->tid);
-    tag.Deserialize(TagBuffer((uint8_t*)m_data->data, (uint8_t*)m_data->data + m_data->size));
+    NS_ASSERT(tag.GetInstanceTypeId().GetUid() == m_data->uid);
+    auto data = const_cast<uint8_t*>(PacketTagList::GetData(m_data));
+    tag.Deserialize(TagBuffer(data, data + m_data->size));
 }
 
 Ptr<Packet>
@@ -146,17 +166,18 @@ Packet::Packet()
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, 0),
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid++, 0),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const Packet& o)
     : m_buffer(o.m_buffer),
       m_byteTagList(o.m_byteTagList),
       m_packetTagList(o.m_packetTagList),
-      m_metadata(o.m_metadata)
+      m_metadata(o.m_metadata),
+      m_headerCache(o.m_headerCache),
+      m_startOffset(o.m_startOffset)
 {
     o.m_nixVector ? m_nixVector = o.m_nixVector->Copy() : m_nixVector = nullptr;
 }
@@ -173,6 +194,8 @@ Packet::operator=(const Packet& o)
     m_packetTagList = o.m_packetTagList;
     m_metadata = o.m_metadata;
     o.m_nixVector ? m_nixVector = o.m_nixVector->Copy() : m_nixVector = nullptr;
+    m_headerCache = o.m_headerCache;
+    m_startOffset = o.m_startOffset;
     return *this;
 }
 
@@ -186,10 +209,9 @@ Packet::Packet(uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid++, size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const uint8_t* buffer, uint32_t size, bool magic)
@@ -213,10 +235,9 @@ Packet::Packet(const uint8_t* buffer, uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid++, size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
     m_buffer.AddAtStart(size);
     Buffer::Iterator i = m_buffer.Begin();
     i.Write(buffer, size);
@@ -274,6 +295,9 @@ Packet::AddHeader(const Header& header)
     m_byteTagList.AddAtStart(size);
     header.Serialize(m_buffer.Begin());
     m_metadata.AddHeader(header, size);
+    // The headers cached since the bytes were removed are overwritten
+    UncacheHeaders(m_startOffset);
+    m_startOffset -= size;
 }
 
 uint32_t
@@ -283,10 +307,7 @@ Packet::RemoveHeader(Header& header, uint32_t size)
     end = m_buffer.Begin();
     end.Next(size);
     uint32_t deserialized = header.Deserialize(m_buffer.Begin(), end);
-    NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << deserialized);
-    m_buffer.RemoveAtStart(deserialized);
-    m_byteTagList.Adjust(-deserialized);
-    m_metadata.RemoveHeader(header, deserialized);
+    RemoveParsedHeader(header, deserialized);
     return deserialized;
 }
 
@@ -294,13 +315,57 @@ uint32_t
 Packet::RemoveHeader(Header& header)
 {
     uint32_t deserialized = header.Deserialize(m_buffer.Begin());
-    NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << deserialized);
-    m_buffer.RemoveAtStart(deserialized);
-    m_byteTagList.Adjust(-deserialized);
-    m_metadata.RemoveHeader(header, deserialized);
+    RemoveParsedHeader(header, deserialized);
     return deserialized;
 }
 
+void
+Packet::RemoveParsedHeader(const Header& header, uint32_t size)
+{
+    NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << size);
+    m_buffer.RemoveAtStart(size);
+    m_byteTagList.Adjust(-size);
+    m_metadata.RemoveHeader(header, size);
+    m_startOffset += size;
+    UncacheHeaders(m_startOffset);
+}
+
+const Header*
+Packet::FindCachedHeader(TypeId tid, uint32_t& size) const
+{
+    for (const auto& cached : m_headerCache)
+    {
+        if (cached.uid == tid.GetUid() && cached.offset == m_startOffset)
+        {
+            NS_LOG_LOGIC("found " << tid.GetName() << " in the header cache");
+            size = cached.size;
+            return cached.header.get();
+        }
+    }
+    return nullptr;
+}
+
+void
+Packet::CacheHeader(std::shared_ptr<const Header> header, uint32_t size) const
+{
+    m_headerCache.push_back({header->GetInstanceTypeId().GetUid(), m_startOffset, size, header});
+}
+
+void
+Packet::UncacheHeaders(int64_t offset)
+{
+    if (m_headerCache.empty())
+    {
+        return;
+    }
+    m_headerCache.erase(std::remove_if(m_headerCache.begin(),
+                                       m_headerCache.end(),
+                                       [offset](const CachedHeader& cached) {
+                                           return cached.offset < offset;
+                                       }),
+                        m_headerCache.end());
+}
+
 uint32_t
 Packet::PeekHeader(Header& header) const
 {
@@ -327,6 +392,7 @@ Packet::AddTrailer(const Trailer& trailer)
     NS_LOG_FUNCTION(this << trailer.GetInstanceTypeId().GetName() << size);
     m_byteTagList.AddAtEnd(GetSize());
     m_buffer.AddAtEnd(size);
+    m_headerCache.clear();
     Buffer::Iterator end = m_buffer.End();
     trailer.Serialize(end);
     m_metadata.AddTrailer(trailer, size);
@@ -339,6 +405,7 @@ Packet::RemoveTrailer(Trailer& trailer)
     NS_LOG_FUNCTION(this << trailer.GetInstanceTypeId().GetName() << deserialized);
     m_buffer.RemoveAtEnd(deserialized);
     m_metadata.RemoveTrailer(trailer, deserialized);
+    m_headerCache.clear();
     return deserialized;
 }
 
@@ -361,6 +428,7 @@ Packet::AddAtEnd(Ptr<const Packet> packet)
     m_byteTagList.Add(copy);
     m_buffer.AddAtEnd(packet->m_buffer);
     m_metadata.AddAtEnd(packet->m_metadata);
+    m_headerCache.clear();
 }
 
 void
@@ -370,6 +438,7 @@ Packet::AddPaddingAtEnd(uint32_t size)
     m_byteTagList.AddAtEnd(GetSize());
     m_buffer.AddAtEnd(size);
     m_metadata.AddPaddingAtEnd(size);
+    m_headerCache.clear();
 }
 
 void
@@ -378,6 +447,7 @@ Packet::RemoveAtEnd(uint32_t size)
     NS_LOG_FUNCTION(this << size);
     m_buffer.RemoveAtEnd(size);
     m_metadata.RemoveAtEnd(size);
+    m_headerCache.clear();
 }
 
 void
@@ -387,6 +457,8 @@ Packet::RemoveAtStart(uint32_t size)
     m_buffer.RemoveAtStart(size);
     m_byteTagList.Adjust(-size);
     m_metadata.RemoveAtStart(size);
+    m_startOffset += size;
+    UncacheHeaders(m_startOffset);
 }
 
 void
@@ -606,6 +678,20 @@ Packet::EnableChecking()
     PacketMetadata::EnableChecking();
 }
 
+void
+Packet::EnableHeaderCache()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    m_enableHeaderCache = true;
+}
+
+void
+Packet::DisableHeaderCache()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    m_enableHeaderCache = false;
+}
+
 uint32_t
 Packet::GetSerializedSize() const
 {
@@ -1019,7 +1105,7 @@ Packet::PrintPacketTags(std::ostream& os) const
 PacketTagIterator
 Packet::GetPacketTagIterator() const
 {
-    return PacketTagIterator(m_packetTagList.Head());
+    return PacketTagIterator(m_packetTagList.Begin(), m_packetTagList.End());
 }
 
 std::ostream&
@@ -1029,4 +1115,22 @@ operator<<(std::ostream& os, const Packet& packet)
     return os;
 }
 
+void
+WritePacket(CheckpointWriter& writer, const std::string& key, Ptr<const Packet> packet)
+{
+    NS_LOG_FUNCTION(&writer << key << packet);
+    std::vector<uint8_t> buffer(packet->GetSerializedSize());
+    uint32_t serialized = packet->Serialize(buffer.data(), buffer.size());
+    NS_ASSERT_MSG(serialized, "Cannot serialize the packet " << key);
+    writer.WriteBytes(key, buffer.data(), buffer.size());
+}
+
+Ptr<Packet>
+ReadPacket(const CheckpointReader& reader, const std::string& key)
+{
+    NS_LOG_FUNCTION(&reader << key);
+    std::vector<uint8_t> buffer = reader.ReadBytes(key);
+    return Create<Packet>(buffer.data(), buffer.size(), true);
+}
+
 } // namespace ns3
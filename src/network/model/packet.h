@@ -33,13 +33,23 @@
 #include "ns3/mac48-address.h"
 #include "ns3/ptr.h"
 
+#include <memory>
 #include <stdint.h>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#ifdef NS3_MTP
+#include <atomic>
+#endif
 
 namespace ns3
 {
 
 // Forward declaration
 class Address;
+class CheckpointReader;
+class CheckpointWriter;
 
 /**
  * \ingroup network
@@ -181,9 +191,11 @@ class PacketTagIterator
     /**
      * Constructor
      * \param head head of the items
+     * \param end end of the items
      */
-    PacketTagIterator(const PacketTagList::TagData* head);
+    PacketTagIterator(const PacketTagList::TagData* head, const PacketTagList::TagData* end);
     const PacketTagList::TagData* m_current; //!< actual position over the set of tags in a packet
+    const PacketTagList::TagData* m_end;     //!< end of the set of tags in a packet
 };
 
 /**
@@ -258,10 +270,14 @@ class Packet : public SimpleRefCount<Packet>
      * \brief Create a packet with a zero-filled payload.
      *
      * The memory necessary for the payload is not allocated:
-     * it will be allocated at any later point if you attempt
-     * to fragment this packet or to access the zero-filled
-     * bytes. The packet is allocated with a new uid (as
-     * returned by getUid).
+     * the payload is virtual.  It stays virtual when headers and
+     * trailers are added or removed, when the packet is fragmented,
+     * and when packets ending and starting with a virtual payload
+     * are concatenated with AddAtEnd().  Reading the payload, e.g.,
+     * with CopyData(), returns zeroes without allocating it.  It is
+     * only allocated when two virtual payloads are concatenated with
+     * bytes stored between them.  The packet is allocated with a new
+     * uid (as returned by getUid).
      *
      * \param size the size of the zero-filled payload
      */
@@ -308,6 +324,13 @@ class Packet : public SimpleRefCount<Packet>
      * \returns the size in bytes of the packet
      */
     inline uint32_t GetSize() const;
+    /**
+     * \brief Returns the size in bytes of the virtual payload of the packet,
+     * which is not stored in memory.
+     *
+     * \returns the size in bytes of the virtual payload
+     */
+    inline uint32_t GetVirtualPayloadSize() const;
     /**
      * \brief Add header to this packet.
      *
@@ -329,6 +352,20 @@ class Packet : public SimpleRefCount<Packet>
      * \returns the number of bytes removed from the packet.
      */
     uint32_t RemoveHeader(Header& header);
+    /**
+     * \brief Deserialize and remove the header from the internal buffer.
+     *
+     * This method invokes Header::Deserialize (begin) and should be used for
+     * fixed-length headers. If the header cache is enabled, a header already
+     * parsed by PeekHeader() is copied from the cache rather than parsed again,
+     * see EnableHeaderCache().
+     *
+     * \tparam T \deduced The type of the header.
+     * \param header a reference to the header to remove from the internal buffer.
+     * \returns the number of bytes removed from the packet.
+     */
+    template <typename T>
+    uint32_t RemoveHeader(T& header);
     /**
      * \brief Deserialize and remove the header from the internal buffer.
      *
@@ -350,6 +387,20 @@ class Packet : public SimpleRefCount<Packet>
      * \returns the number of bytes read from the packet.
      */
     uint32_t PeekHeader(Header& header) const;
+    /**
+     * \brief Deserialize but does _not_ remove the header from the internal buffer.
+     *
+     * This method invokes Header::Deserialize. If the header cache is enabled,
+     * the parsed header is cached, and peeking again at the same header,
+     * e.g., in another layer or in a trace sink, is a copy rather than a parse,
+     * see EnableHeaderCache().
+     *
+     * \tparam T \deduced The type of the header.
+     * \param header a reference to the header to read from the internal buffer.
+     * \returns the number of bytes read from the packet.
+     */
+    template <typename T>
+    uint32_t PeekHeader(T& header) const;
     /**
      * \brief Deserialize but does _not_ remove the header from the internal buffer.
      * s
@@ -536,6 +587,28 @@ class Packet : public SimpleRefCount<Packet>
      * errors will be detected and will abort the program.
      */
     static void EnableChecking();
+    /**
+     * \brief Enable the header cache.
+     *
+     * By default, each call to PeekHeader() and RemoveHeader() parses the
+     * header again. When the header cache is enabled, the headers parsed by
+     * PeekHeader() are kept with the packet and its copies, keyed by their
+     * TypeId and their offset in the packet, until the bytes of the header
+     * are modified. The headers must be copyable, and must be passed with
+     * their actual type to PeekHeader() and RemoveHeader(). A cached header
+     * is returned as it was first parsed, including its state which does not
+     * come from its bytes, e.g., whether its checksum was verified.
+     *
+     * The cache of a packet is not protected against concurrent accesses:
+     * do not enable it if a packet is peeked at from several threads at once.
+     */
+    static void EnableHeaderCache();
+    /**
+     * \brief Disable the header cache.
+     *
+     * \sa EnableHeaderCache
+     */
+    static void DisableHeaderCache();
 
     /**
      * \brief Returns number of bytes required for packet
@@ -787,6 +860,42 @@ class Packet : public SimpleRefCount<Packet>
      */
     uint32_t Deserialize(const uint8_t* buffer, uint32_t size);
 
+    /**
+     * \brief Remove a header which has already been parsed.
+     * \param header the header
+     * \param size the size of the header
+     */
+    void RemoveParsedHeader(const Header& header, uint32_t size);
+    /**
+     * \brief Find a header in the header cache.
+     * \param [in] tid the TypeId of the header
+     * \param [out] size the size of the header
+     * \returns the header at the start of the packet, or null if not cached
+     */
+    const Header* FindCachedHeader(TypeId tid, uint32_t& size) const;
+    /**
+     * \brief Add a header at the start of the packet to the header cache.
+     * \param header the header
+     * \param size the size of the header
+     */
+    void CacheHeader(std::shared_ptr<const Header> header, uint32_t size) const;
+    /**
+     * \brief Remove the headers starting before an offset from the header cache.
+     * \param offset the offset
+     */
+    void UncacheHeaders(int64_t offset);
+
+    /**
+     * A header parsed by PeekHeader(), cached while its bytes are unchanged.
+     */
+    struct CachedHeader
+    {
+        uint16_t uid;                         //!< Uid of the TypeId of the header
+        int64_t offset;                       //!< Offset of the header
+        uint32_t size;                        //!< Size of the header
+        std::shared_ptr<const Header> header; //!< The parsed header
+    };
+
     Buffer m_buffer;               //!< the packet buffer (it's actual contents)
     ByteTagList m_byteTagList;     //!< the ByteTag list
     PacketTagList m_packetTagList; //!< the packet's Tag list
@@ -795,7 +904,23 @@ class Packet : public SimpleRefCount<Packet>
     /* Please see comments above about nix-vector */
     mutable Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
+    mutable std::vector<CachedHeader> m_headerCache; //!< the headers parsed by PeekHeader()
+    /**
+     * Offset of the start of the packet, decreased by the headers added,
+     * and increased by the bytes removed at the start of the packet.
+     * The headers in the cache are keyed by their offset, which stays
+     * the same as the headers before them are removed.
+     */
+    int64_t m_startOffset{0};
+    static bool m_enableHeaderCache; //!< Enable the header cache
+
+#ifdef NS3_MTP
+    static std::atomic<uint32_t> m_globalUid; //!< Global counter of packets Uid
+#else
     static uint32_t m_globalUid; //!< Global counter of packets Uid
+#endif
+    /** Registration of the global counter of packets Uid with the checkpoints */
+    static bool m_checkpoint;
 };
 
 /**
@@ -807,6 +932,26 @@ class Packet : public SimpleRefCount<Packet>
  */
 std::ostream& operator<<(std::ostream& os, const Packet& packet);
 
+/**
+ * \ingroup packet
+ * \brief Save a packet, with its tags and metadata, to a checkpoint.
+ *
+ * \param writer the checkpoint writer
+ * \param key the key of the packet
+ * \param packet the packet
+ */
+void WritePacket(CheckpointWriter& writer, const std::string& key, Ptr<const Packet> packet);
+
+/**
+ * \ingroup packet
+ * \brief Read a packet saved by WritePacket().
+ *
+ * \param reader the checkpoint reader
+ * \param key the key of the packet
+ * \returns the packet, with its original uid
+ */
+Ptr<Packet> ReadPacket(const CheckpointReader& reader, const std::string& key);
+
 /**
  * \ingroup network
  * \defgroup packetperf Packet Performance
@@ -863,6 +1008,68 @@ Packet::GetSize() const
     return m_buffer.GetSize();
 }
 
+template <typename T>
+uint32_t
+Packet::RemoveHeader(T& header)
+{
+    if constexpr (std::is_abstract_v<T> || !std::is_copy_constructible_v<T> ||
+                  !std::is_copy_assignable_v<T>)
+    {
+        return RemoveHeader(static_cast<Header&>(header));
+    }
+    else
+    {
+        if (m_enableHeaderCache && typeid(header) == typeid(T))
+        {
+            uint32_t size;
+            TypeId tid = static_cast<const Header&>(header).GetInstanceTypeId();
+            const Header* cached = FindCachedHeader(tid, size);
+            if (cached != nullptr)
+            {
+                header = static_cast<const T&>(*cached);
+                RemoveParsedHeader(header, size);
+                return size;
+            }
+        }
+        return RemoveHeader(static_cast<Header&>(header));
+    }
+}
+
+template <typename T>
+uint32_t
+Packet::PeekHeader(T& header) const
+{
+    if constexpr (std::is_abstract_v<T> || !std::is_copy_constructible_v<T> ||
+                  !std::is_copy_assignable_v<T>)
+    {
+        return PeekHeader(static_cast<Header&>(header));
+    }
+    else
+    {
+        if (!m_enableHeaderCache || typeid(header) != typeid(T))
+        {
+            return PeekHeader(static_cast<Header&>(header));
+        }
+        uint32_t size;
+        TypeId tid = static_cast<const Header&>(header).GetInstanceTypeId();
+        const Header* cached = FindCachedHeader(tid, size);
+        if (cached != nullptr)
+        {
+            header = static_cast<const T&>(*cached);
+            return size;
+        }
+        size = PeekHeader(static_cast<Header&>(header));
+        CacheHeader(std::make_shared<const T>(header), size);
+        return size;
+    }
+}
+
+uint32_t
+Packet::GetVirtualPayloadSize() const
+{
+    return m_buffer.GetZeroAreaSize();
+}
+
 } // namespace ns3
 
 #endif /* PACKET_H */
@@ -25,9 +25,11 @@
 #include "packet.h"
 #include "socket-factory.h"
 
+#include "ns3/checkpoint.h"
 #include "ns3/log.h"
 
 #include <limits>
+#include <sstream>
 
 namespace ns3
 {
@@ -591,6 +593,55 @@ Socket::Ipv6LeaveGroup()
     m_ipv6MulticastGroupAddress = Ipv6Address::GetAny();
 }
 
+void
+WriteSocketAddress(CheckpointWriter& writer, const std::string& key, const Address& address)
+{
+    NS_LOG_FUNCTION(&writer << key << address);
+    std::ostringstream oss;
+    if (InetSocketAddress::IsMatchingType(address))
+    {
+        InetSocketAddress inet = InetSocketAddress::ConvertFrom(address);
+        oss << "inet " << inet.GetIpv4() << " " << inet.GetPort();
+    }
+    else if (Inet6SocketAddress::IsMatchingType(address))
+    {
+        Inet6SocketAddress inet6 = Inet6SocketAddress::ConvertFrom(address);
+        oss << "inet6 " << inet6.GetIpv6() << " " << inet6.GetPort();
+    }
+    else
+    {
+        NS_ABORT_MSG_UNLESS(address.IsInvalid(),
+                            "Cannot save the address " << address << " of " << key
+                                                       << ": unsupported type");
+        oss << "none";
+    }
+    writer.WriteString(key, oss.str());
+}
+
+Address
+ReadSocketAddress(const CheckpointReader& reader, const std::string& key)
+{
+    NS_LOG_FUNCTION(&reader << key);
+    std::istringstream iss(reader.ReadString(key));
+    std::string family;
+    std::string ip;
+    uint16_t port = 0;
+    iss >> family;
+    if (family == "none")
+    {
+        return Address();
+    }
+    iss >> ip >> port;
+    NS_ABORT_MSG_IF(iss.fail(), "Invalid address " << key << " in " << reader.GetPath());
+    if (family == "inet")
+    {
+        return InetSocketAddress(Ipv4Address(ip.c_str()), port);
+    }
+    NS_ABORT_MSG_UNLESS(family == "inet6",
+                        "Invalid address " << key << " in " << reader.GetPath());
+    return Inet6SocketAddress(Ipv6Address(ip.c_str()), port);
+}
+
 /***************************************************************
  *           Socket Tags
  ***************************************************************/
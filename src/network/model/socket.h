@@ -37,6 +37,8 @@
 namespace ns3
 {
 
+class CheckpointReader;
+class CheckpointWriter;
 class Node;
 class Packet;
 
@@ -1116,6 +1118,32 @@ class Socket : public Object
     uint8_t m_ipv6HopLimit; //!< the socket IPv6 Hop Limit
 };
 
+/**
+ * \ingroup socket
+ * \brief Save a socket address to a checkpoint.
+ *
+ * The type of an Address is allocated when the class of address is
+ * first used, so it can differ between the run which saves a checkpoint
+ * and the run which restores it: the address is saved as
+ * \c inet \<address\> \<port\> or \c inet6 \<address\> \<port\> instead.
+ * Other types of address are not supported.
+ *
+ * \param writer the checkpoint writer
+ * \param key the key of the address
+ * \param address the InetSocketAddress or Inet6SocketAddress, or an invalid Address
+ */
+void WriteSocketAddress(CheckpointWriter& writer, const std::string& key, const Address& address);
+
+/**
+ * \ingroup socket
+ * \brief Read a socket address saved by WriteSocketAddress().
+ *
+ * \param reader the checkpoint reader
+ * \param key the key of the address
+ * \returns the address
+ */
+Address ReadSocketAddress(const CheckpointReader& reader, const std::string& key);
+
 /**
  * \brief This class implements a tag that carries the socket-specific
  * TTL of a packet to the IP layer
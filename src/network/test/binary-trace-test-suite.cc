@@ -0,0 +1,200 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/binary-trace-helper.h"
+#include "ns3/binary-trace.h"
+#include "ns3/error-model.h"
+#include "ns3/mac48-address.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/pointer.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <sstream>
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check that the records written by BinaryTraceWriter are read back
+ * by BinaryTraceReader, and converted to text.
+ */
+class BinaryTraceFileTestCase : public TestCase
+{
+  public:
+    BinaryTraceFileTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+BinaryTraceFileTestCase::BinaryTraceFileTestCase()
+    : TestCase("Check the records of a binary trace file")
+{
+}
+
+void
+BinaryTraceFileTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("binary-trace-file.bin");
+    uint8_t data[] = {0x45, 0x00, 0x01, 0xab, 0xcd};
+    Ptr<Packet> p1 = Create<Packet>(data, sizeof(data));
+    Ptr<Packet> p2 = Create<Packet>(data, 2);
+
+    BinaryTraceWriter writer;
+    writer.Open(filename, 4);
+    NS_TEST_ASSERT_MSG_EQ(writer.Fail(), false, "Unable to open " << filename);
+    writer.Write(Seconds(1.5), 3, 1, BinaryTraceRecord::ENQUEUE, p1);
+    writer.Write(NanoSeconds(2000000001), 4, 0, BinaryTraceRecord::PHY_RX_DROP, p2);
+    writer.Close();
+    NS_TEST_ASSERT_MSG_EQ(writer.Fail(), false, "Unable to write " << filename);
+
+    BinaryTraceReader reader;
+    reader.Open(filename);
+    NS_TEST_ASSERT_MSG_EQ(reader.Fail(), false, "Unable to read " << filename);
+    NS_TEST_ASSERT_MSG_EQ(reader.GetHeaderBytes(), 4, "Bad number of header bytes");
+
+    BinaryTraceRecord record;
+    NS_TEST_ASSERT_MSG_EQ(reader.Read(record), true, "Missing first record");
+    NS_TEST_ASSERT_MSG_EQ(record.time, Seconds(1.5), "Bad time");
+    NS_TEST_ASSERT_MSG_EQ(record.node, 3, "Bad node");
+    NS_TEST_ASSERT_MSG_EQ(record.device, 1, "Bad device");
+    NS_TEST_ASSERT_MSG_EQ(record.event, BinaryTraceRecord::ENQUEUE, "Bad event");
+    NS_TEST_ASSERT_MSG_EQ(record.uid, p1->GetUid(), "Bad uid");
+    NS_TEST_ASSERT_MSG_EQ(record.size, 5, "Bad size");
+    NS_TEST_ASSERT_MSG_EQ(record.header.size(), 4, "Bad number of header bytes captured");
+    NS_TEST_ASSERT_MSG_EQ(record.header[3], 0xab, "Bad header bytes");
+    std::ostringstream oss;
+    record.PrintAscii(oss);
+    std::ostringstream expected;
+    expected << "+ 1.5 /NodeList/3/DeviceList/1/TxQueue/Enqueue uid=" << p1->GetUid()
+             << " size=5 header=450001ab";
+    NS_TEST_ASSERT_MSG_EQ(oss.str(), expected.str(), "Bad conversion to text");
+
+    NS_TEST_ASSERT_MSG_EQ(reader.Read(record), true, "Missing second record");
+    NS_TEST_ASSERT_MSG_EQ(record.time, NanoSeconds(2000000001), "Bad time");
+    NS_TEST_ASSERT_MSG_EQ(record.event, BinaryTraceRecord::PHY_RX_DROP, "Bad event");
+    NS_TEST_ASSERT_MSG_EQ(record.uid, p2->GetUid(), "Bad uid");
+    NS_TEST_ASSERT_MSG_EQ(record.header.size(), 2, "Bad number of header bytes captured");
+    NS_TEST_ASSERT_MSG_EQ(reader.Read(record), false, "Unexpected record");
+
+    reader.Open(filename);
+    oss.str("");
+    NS_TEST_ASSERT_MSG_EQ(reader.WriteAscii(oss), 2, "Bad number of records converted");
+    NS_TEST_ASSERT_MSG_EQ(oss.str().substr(0, expected.str().size() + 1),
+                          expected.str() + "\n",
+                          "Bad conversion to text");
+
+    reader.Open(CreateTempDirFilename("binary-trace-missing.bin"));
+    NS_TEST_ASSERT_MSG_EQ(reader.Fail(), true, "Missing file not detected");
+    NS_TEST_ASSERT_MSG_EQ(reader.Read(record), false, "Record read from a missing file");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check that BinaryTraceHelper records the events of the devices
+ */
+class BinaryTraceHelperTestCase : public TestCase
+{
+  public:
+    BinaryTraceHelperTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+BinaryTraceHelperTestCase::BinaryTraceHelperTestCase()
+    : TestCase("Check the events recorded by BinaryTraceHelper")
+{
+}
+
+void
+BinaryTraceHelperTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    SimpleNetDeviceHelper simple;
+    simple.SetDeviceAttribute("DataRate", StringValue("1Mbps"));
+    NetDeviceContainer devices = simple.Install(nodes);
+
+    Ptr<ReceiveListErrorModel> em = CreateObject<ReceiveListErrorModel>();
+    em->SetList({1});
+    devices.Get(1)->SetAttribute("ReceiveErrorModel", PointerValue(em));
+
+    std::string filename = CreateTempDirFilename("binary-trace-helper.bin");
+    BinaryTraceHelper helper;
+    Ptr<BinaryTraceWriter> writer = helper.CreateFile(filename);
+    helper.Enable(writer, devices);
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        Simulator::Schedule(Seconds(1),
+                            &NetDevice::Send,
+                            devices.Get(0),
+                            Create<Packet>(100),
+                            devices.Get(1)->GetAddress(),
+                            0x800);
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+    writer->Close();
+
+    BinaryTraceReader reader;
+    reader.Open(filename);
+    BinaryTraceRecord record;
+    uint32_t events[BinaryTraceRecord::PHY_RX_DROP + 1] = {};
+    while (reader.Read(record))
+    {
+        NS_TEST_ASSERT_MSG_EQ(record.size, 100, "Bad size");
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(record.time, Seconds(1), "Bad time");
+        uint32_t node = record.event == BinaryTraceRecord::PHY_RX_DROP ? 1 : 0;
+        NS_TEST_ASSERT_MSG_EQ(record.node, nodes.Get(node)->GetId(), "Bad node");
+        NS_TEST_ASSERT_MSG_EQ(record.device, 0, "Bad device");
+        events[record.event]++;
+    }
+    NS_TEST_ASSERT_MSG_EQ(events[BinaryTraceRecord::ENQUEUE], 3, "Bad number of enqueues");
+    NS_TEST_ASSERT_MSG_EQ(events[BinaryTraceRecord::DEQUEUE], 3, "Bad number of dequeues");
+    NS_TEST_ASSERT_MSG_EQ(events[BinaryTraceRecord::DROP], 0, "Bad number of drops");
+    NS_TEST_ASSERT_MSG_EQ(events[BinaryTraceRecord::PHY_RX_DROP], 1, "Bad number of rx drops");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Binary trace TestSuite
+ */
+class BinaryTraceTestSuite : public TestSuite
+{
+  public:
+    BinaryTraceTestSuite();
+};
+
+BinaryTraceTestSuite::BinaryTraceTestSuite()
+    : TestSuite("binary-trace", Type::UNIT)
+{
+    AddTestCase(new BinaryTraceFileTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new BinaryTraceHelperTestCase, TestCase::Duration::QUICK);
+}
+
+static BinaryTraceTestSuite g_binaryTraceTestSuite; //!< Static variable for test initialization
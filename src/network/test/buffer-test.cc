@@ -393,6 +393,87 @@ BufferTest::DoRun()
     val2 <<= 8;
     val2 |= i.ReadU8();
     NS_TEST_ASSERT_MSG_EQ(val1, val2, "Bad ReadNtohU16()");
+
+    // appending bytes stored after a zero area keeps the zero area virtual
+    buffer = Buffer(10);
+    other = Buffer(5);
+    other.AddAtEnd(3);
+    i = other.End();
+    i.Prev(3);
+    i.WriteU8(0x11);
+    i.WriteU8(0x22);
+    i.WriteU8(0x33);
+    buffer.AddAtEnd(other);
+    NS_TEST_ASSERT_MSG_EQ(buffer.GetSize(), 18, "Bad size after AddAtEnd()");
+    NS_TEST_ASSERT_MSG_EQ(buffer.GetZeroAreaSize(), 15, "Zero area materialized by AddAtEnd()");
+    i = buffer.End();
+    i.Prev(3);
+    NS_TEST_ASSERT_MSG_EQ(i.ReadU8(), 0x11, "Bad data appended after a zero area");
+    NS_TEST_ASSERT_MSG_EQ(i.ReadU8(), 0x22, "Bad data appended after a zero area");
+    NS_TEST_ASSERT_MSG_EQ(i.ReadU8(), 0x33, "Bad data appended after a zero area");
+
+    // bytes before and after a zero area on both sides are merged around a single zero area
+    buffer = Buffer(4);
+    buffer.AddAtStart(2);
+    buffer.Begin().WriteU16(0x4455);
+    other = Buffer(6);
+    other.AddAtEnd(1);
+    i = other.End();
+    i.Prev(1);
+    i.WriteU8(0x66);
+    buffer.AddAtEnd(other);
+    NS_TEST_ASSERT_MSG_EQ(buffer.GetSize(), 13, "Bad size after AddAtEnd()");
+    NS_TEST_ASSERT_MSG_EQ(buffer.GetZeroAreaSize(), 10, "Zero areas materialized by AddAtEnd()");
+    ENSURE_WRITTEN_BYTES(buffer, 13, 0x55, 0x44, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x66);
+
+    // Spans, before and after the zero area
+    buffer = Buffer(5);
+    buffer.AddAtStart(4);
+    buffer.AddAtEnd(4);
+    i = buffer.Begin();
+    uint8_t* span = i.WriteSpan(4);
+    WriteHtonU32(span, 0x01020304);
+    i.Next(5);
+    span = i.WriteSpan(4);
+    WriteHtolsbU16(span, 0x0605);
+    WriteHtonU16(span + 2, 0x0708);
+    NS_TEST_ASSERT_MSG_EQ(i.IsEnd(), true, "WriteSpan() did not advance the iterator");
+    ENSURE_WRITTEN_BYTES(buffer, 13, 0x01, 0x02, 0x03, 0x04, 0, 0, 0, 0, 0, 0x05, 0x06, 0x07, 0x08);
+    uint8_t scratch[13];
+    i = buffer.Begin();
+    const uint8_t* read = i.ReadSpan(4, scratch);
+    NS_TEST_ASSERT_MSG_NE(read, scratch, "Contiguous bytes copied by ReadSpan()");
+    NS_TEST_ASSERT_MSG_EQ(ReadNtohU32(read), 0x01020304, "Bad ReadSpan()");
+    i = buffer.Begin();
+    i.Next(2);
+    read = i.ReadSpan(9, scratch);
+    NS_TEST_ASSERT_MSG_EQ(read, scratch, "Bytes overlapping the zero area not copied");
+    NS_TEST_ASSERT_MSG_EQ(ReadNtohU16(read), 0x0304, "Bad ReadSpan() before the zero area");
+    NS_TEST_ASSERT_MSG_EQ((ReadNtohU32(read + 2) | read[6]), 0, "Bad ReadSpan() in the zero area");
+    NS_TEST_ASSERT_MSG_EQ(ReadLsbtohU16(read + 7), 0x0605, "Bad ReadSpan() after the zero area");
+    read = i.ReadSpan(2, scratch);
+    NS_TEST_ASSERT_MSG_NE(read, scratch, "Contiguous bytes copied by ReadSpan()");
+    NS_TEST_ASSERT_MSG_EQ(ReadNtohU16(read), 0x0708, "Bad ReadSpan() after the zero area");
+    NS_TEST_ASSERT_MSG_EQ(i.IsEnd(), true, "ReadSpan() did not advance the iterator");
+
+    // The checksums of contiguous bytes and of bytes overlapping the zero area match
+    Buffer flat;
+    flat.AddAtStart(13);
+    flat.Begin().Write(buffer.Begin(), buffer.End());
+    for (uint16_t size : {12, 13})
+    {
+        i = buffer.Begin();
+        uint16_t expected = i.CalculateIpChecksum(size, 0x1234);
+        i = flat.Begin();
+        NS_TEST_ASSERT_MSG_EQ(i.CalculateIpChecksum(size, 0x1234), expected, "Bad checksum");
+    }
+    i = buffer.Begin();
+    i.Next(9);
+    uint16_t expected = i.CalculateIpChecksum(4);
+    i = flat.Begin();
+    i.Next(9);
+    NS_TEST_ASSERT_MSG_EQ(i.CalculateIpChecksum(4), expected, "Bad checksum");
+    NS_TEST_ASSERT_MSG_EQ(expected, (uint16_t)~0x0e0c, "Bad checksum");
 }
 
 /**
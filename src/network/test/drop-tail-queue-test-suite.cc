@@ -85,6 +85,19 @@ DropTailQueueTestCase::DoRun()
 
     packet = queue->Dequeue();
     NS_TEST_EXPECT_MSG_EQ(packet, nullptr, "There are really no packets in there");
+
+    queue->Enqueue(p1);
+    queue->Enqueue(p2);
+    queue->Enqueue(p3);
+    std::vector<Ptr<Packet>> batch{p4};
+    NS_TEST_EXPECT_MSG_EQ(queue->DequeueBatch(2, batch), 2, "Two packets should be dequeued");
+    NS_TEST_EXPECT_MSG_EQ(batch.size(), 3, "The packets should be appended");
+    NS_TEST_EXPECT_MSG_EQ(batch[1]->GetUid(), p1->GetUid(), "Was this the first packet ?");
+    NS_TEST_EXPECT_MSG_EQ(batch[2]->GetUid(), p2->GetUid(), "Was this the second packet ?");
+    NS_TEST_EXPECT_MSG_EQ(queue->GetNPackets(), 1, "There should be one packet in there");
+    NS_TEST_EXPECT_MSG_EQ(queue->DequeueBatch(2, batch), 1, "One packet should be dequeued");
+    NS_TEST_EXPECT_MSG_EQ(batch[3]->GetUid(), p3->GetUid(), "Was this the third packet ?");
+    NS_TEST_EXPECT_MSG_EQ(queue->GetTotalReceivedPackets(), 6, "Bad number of packets received");
 }
 
 /**
@@ -0,0 +1,161 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/packet-memory-pool.h"
+#include "ns3/packet.h"
+#include "ns3/test.h"
+
+#include <thread>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * PacketMemoryPool size classes and statistics.
+ */
+class PacketMemoryPoolTest : public TestCase
+{
+  public:
+    PacketMemoryPoolTest();
+
+  private:
+    void DoRun() override;
+};
+
+PacketMemoryPoolTest::PacketMemoryPoolTest()
+    : TestCase("Check the size classes and the statistics of the PacketMemoryPool")
+{
+}
+
+void
+PacketMemoryPoolTest::DoRun()
+{
+    NS_TEST_ASSERT_MSG_EQ(PacketMemoryPool::GetCapacity(1), 64, "Wrong smallest size class");
+    NS_TEST_ASSERT_MSG_EQ(PacketMemoryPool::GetCapacity(64), 64, "Wrong size class");
+    NS_TEST_ASSERT_MSG_EQ(PacketMemoryPool::GetCapacity(65), 128, "Wrong size class");
+    NS_TEST_ASSERT_MSG_EQ(PacketMemoryPool::GetCapacity(1500), 2048, "Wrong size class");
+    NS_TEST_ASSERT_MSG_EQ(PacketMemoryPool::GetCapacity(65536), 65536, "Wrong largest size class");
+    NS_TEST_ASSERT_MSG_EQ(PacketMemoryPool::GetCapacity(100000),
+                          100000,
+                          "Oversized block rounded up");
+
+    PacketMemoryPool::Stats before = PacketMemoryPool::GetStats();
+    uint32_t capacity;
+    uint8_t* block = PacketMemoryPool::Allocate(1000, capacity);
+    NS_TEST_ASSERT_MSG_EQ(capacity, 1024, "Wrong capacity");
+    PacketMemoryPool::Deallocate(block, capacity);
+    uint8_t* again = PacketMemoryPool::Allocate(700, capacity);
+    NS_TEST_ASSERT_MSG_EQ(again, block, "Block of the same size class not reused");
+    PacketMemoryPool::Stats during = PacketMemoryPool::GetStats();
+    NS_TEST_ASSERT_MSG_EQ(during.allocations - before.allocations, 2, "Wrong allocations");
+    NS_TEST_ASSERT_MSG_GT_OR_EQ(during.hits - before.hits, 1, "Reused block not counted");
+    NS_TEST_ASSERT_MSG_EQ(during.bytesInUse - before.bytesInUse, 1024, "Wrong bytes in use");
+    NS_TEST_ASSERT_MSG_GT_OR_EQ(during.peakReserved, during.bytesReserved, "Wrong peak");
+    PacketMemoryPool::Deallocate(again, capacity);
+
+    block = PacketMemoryPool::Allocate(100000, capacity);
+    NS_TEST_ASSERT_MSG_EQ(capacity, 100000, "Wrong capacity of an oversized block");
+    PacketMemoryPool::Deallocate(block, capacity);
+    PacketMemoryPool::Stats after = PacketMemoryPool::GetStats();
+    NS_TEST_ASSERT_MSG_EQ(after.oversized - before.oversized, 1, "Oversized block not counted");
+    NS_TEST_ASSERT_MSG_EQ(after.bytesInUse, before.bytesInUse, "Blocks not freed");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * PacketMemoryPool used by several threads.
+ */
+class PacketMemoryPoolThreadsTest : public TestCase
+{
+  public:
+    PacketMemoryPoolThreadsTest();
+
+  private:
+    void DoRun() override;
+};
+
+PacketMemoryPoolThreadsTest::PacketMemoryPoolThreadsTest()
+    : TestCase("Check the PacketMemoryPool used by several threads")
+{
+}
+
+void
+PacketMemoryPoolThreadsTest::DoRun()
+{
+    PacketMemoryPool::Stats before = PacketMemoryPool::GetStats();
+
+    // Each thread frees the packets created by the previous thread
+    const uint32_t nThreads = 4;
+    const uint32_t nPackets = 2000;
+    std::vector<std::vector<Ptr<Packet>>> packets(nThreads + 1);
+    for (uint32_t i = 0; i < nPackets; i++)
+    {
+        packets[0].push_back(Create<Packet>(i % 3000));
+    }
+    for (uint32_t t = 0; t < nThreads; t++)
+    {
+        std::thread thread([&packets, t]() {
+            for (auto& p : packets[t])
+            {
+                Ptr<Packet> fragment = p->CreateFragment(0, p->GetSize() / 2);
+                fragment->AddPaddingAtEnd(100);
+                packets[t + 1].push_back(fragment);
+                p = nullptr;
+            }
+        });
+        thread.join();
+    }
+    for (uint32_t i = 0; i < nPackets; i++)
+    {
+        uint32_t size = i % 3000;
+        for (uint32_t t = 0; t < nThreads; t++)
+        {
+            size = size / 2 + 100;
+        }
+        NS_TEST_ASSERT_MSG_EQ(packets[nThreads][i]->GetSize(), size, "Wrong packet size");
+    }
+    packets.clear();
+
+    PacketMemoryPool::Stats after = PacketMemoryPool::GetStats();
+    NS_TEST_ASSERT_MSG_EQ(after.bytesInUse, before.bytesInUse, "Blocks not freed");
+    NS_TEST_ASSERT_MSG_GT(after.hits, before.hits, "No block reused");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief PacketMemoryPool TestSuite
+ */
+class PacketMemoryPoolTestSuite : public TestSuite
+{
+  public:
+    PacketMemoryPoolTestSuite();
+};
+
+PacketMemoryPoolTestSuite::PacketMemoryPoolTestSuite()
+    : TestSuite("packet-memory-pool", Type::UNIT)
+{
+    AddTestCase(new PacketMemoryPoolTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketMemoryPoolThreadsTest, TestCase::Duration::QUICK);
+}
+
+static PacketMemoryPoolTestSuite
+    g_packetMemoryPoolTestSuite; //!< Static variable for test initialization
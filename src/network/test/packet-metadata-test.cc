@@ -326,7 +326,11 @@ HistoryTrailer<N>::Deserialize(Buffer::Iterator start)
 class PacketMetadataTest : public TestCase
 {
   public:
-    PacketMetadataTest();
+    /**
+     * Constructor
+     * \param backend The backend of the metadata
+     */
+    PacketMetadataTest(PacketMetadata::Backend backend);
     ~PacketMetadataTest() override;
     /**
      * Checks the packet header and trailer history
@@ -336,6 +340,7 @@ class PacketMetadataTest : public TestCase
      */
     void CheckHistory(Ptr<Packet> p, uint32_t n, ...);
     void DoRun() override;
+    void DoTeardown() override;
 
   private:
     /**
@@ -344,10 +349,14 @@ class PacketMetadataTest : public TestCase
      * \return The packet with the header added.
      */
     Ptr<Packet> DoAddHeader(Ptr<Packet> p);
+
+    PacketMetadata::Backend m_backend; //!< The backend of the metadata
 };
 
-PacketMetadataTest::PacketMetadataTest()
-    : TestCase("Packet metadata")
+PacketMetadataTest::PacketMetadataTest(PacketMetadata::Backend backend)
+    : TestCase(backend == PacketMetadata::ARENA ? "Packet metadata, arena backend"
+                                                : "Packet metadata"),
+      m_backend(backend)
 {
 }
 
@@ -476,9 +485,16 @@ PacketMetadataTest::DoAddHeader(Ptr<Packet> p)
     return p;
 }
 
+void
+PacketMetadataTest::DoTeardown()
+{
+    PacketMetadata::SetBackend(PacketMetadata::BUFFER);
+}
+
 void
 PacketMetadataTest::DoRun()
 {
+    PacketMetadata::SetBackend(m_backend);
     PacketMetadata::Enable();
 
     Ptr<Packet> p = Create<Packet>(0);
@@ -879,6 +895,14 @@ PacketMetadataTest::DoRun()
     NS_TEST_EXPECT_MSG_EQ(msg,
                           std::string("hello world"),
                           "Could not find original data in received packet");
+
+    // the copies of an empty packet do not share the headers added to them
+    p = Create<Packet>(0);
+    p1 = p->Copy();
+    ADD_HEADER(p, 3);
+    ADD_HEADER(p1, 5);
+    CHECK_HISTORY(p, 1, 3);
+    CHECK_HISTORY(p1, 1, 5);
 }
 
 /**
@@ -896,7 +920,8 @@ class PacketMetadataTestSuite : public TestSuite
 PacketMetadataTestSuite::PacketMetadataTestSuite()
     : TestSuite("packet-metadata", Type::UNIT)
 {
-    AddTestCase(new PacketMetadataTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketMetadataTest(PacketMetadata::BUFFER), TestCase::Duration::QUICK);
+    AddTestCase(new PacketMetadataTest(PacketMetadata::ARENA), TestCase::Duration::QUICK);
 }
 
 static PacketMetadataTestSuite g_packetMetadataTest; //!< Static variable for test initialization
@@ -26,6 +26,7 @@
 #include <iostream>
 #include <limits> // std:numeric_limits
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -956,6 +957,35 @@ PacketTest::DoRun()
         ALargeTestTag a;
         tmp->AddPacketTag(a);
     }
+
+    /* Test that the payload of the packet stays virtual */
+    {
+        Ptr<Packet> tmp = Create<Packet>(1000);
+        NS_TEST_EXPECT_MSG_EQ(tmp->GetVirtualPayloadSize(), 1000, "Payload not virtual");
+        tmp->AddHeader(ATestHeader<10>());
+        tmp->AddTrailer(ATestTrailer<4>());
+        NS_TEST_EXPECT_MSG_EQ(tmp->GetVirtualPayloadSize(), 1000, "Payload materialized");
+
+        Ptr<Packet> frag = tmp->CreateFragment(5, 500);
+        NS_TEST_EXPECT_MSG_EQ(frag->GetVirtualPayloadSize(), 495, "Fragment materialized");
+        Ptr<Packet> rest = tmp->CreateFragment(505, 509);
+        NS_TEST_EXPECT_MSG_EQ(rest->GetVirtualPayloadSize(), 505, "Fragment materialized");
+        frag->AddAtEnd(rest);
+        NS_TEST_EXPECT_MSG_EQ(frag->GetSize(), 1009, "Bad size of the reassembled packet");
+        NS_TEST_EXPECT_MSG_EQ(frag->GetVirtualPayloadSize(), 1000, "Reassembly materialized");
+
+        frag->RemoveAtStart(200);
+        NS_TEST_EXPECT_MSG_EQ(frag->GetVirtualPayloadSize(), 805, "RemoveAtStart materialized");
+        Ptr<Packet> segment = Create<Packet>(300);
+        segment->AddAtEnd(Create<Packet>(200));
+        NS_TEST_EXPECT_MSG_EQ(segment->GetVirtualPayloadSize(), 500, "Segment materialized");
+
+        std::vector<uint8_t> bytes(frag->GetSize(), 0xff);
+        frag->CopyData(bytes.data(), bytes.size());
+        NS_TEST_EXPECT_MSG_EQ(bytes[0], 0, "Bad virtual payload");
+        NS_TEST_EXPECT_MSG_EQ(bytes[804], 0, "Bad virtual payload");
+        NS_TEST_EXPECT_MSG_EQ(frag->GetVirtualPayloadSize(), 805, "CopyData materialized");
+    }
 }
 
 /**
@@ -1205,6 +1235,63 @@ PacketTagListTest::DoRun()
         ReplaceCheck(7);
     }
 
+    // Iteration, growing and shrinking the storage
+    {
+        std::cout << GetName() << "check iteration and storage growth" << std::endl;
+        MAKE_TEST_TAGS;
+        Ptr<Packet> p = Create<Packet>(10);
+        p->AddPacketTag(t1);
+        p->AddPacketTag(t2);
+        Ptr<Packet> q = p->Copy();
+        q->AddPacketTag(t3);
+        q->AddPacketTag(t4);
+        q->AddPacketTag(t5);
+        q->AddPacketTag(t6);
+        q->AddPacketTag(ALargeTestTag());
+        q->AddPacketTag(t7);
+
+        // The most recent tag comes first
+        std::vector<TypeId> expected{t7.GetInstanceTypeId(),
+                                     ALargeTestTag::GetTypeId(),
+                                     t6.GetInstanceTypeId(),
+                                     t5.GetInstanceTypeId(),
+                                     t4.GetInstanceTypeId(),
+                                     t3.GetInstanceTypeId(),
+                                     t2.GetInstanceTypeId(),
+                                     t1.GetInstanceTypeId()};
+        PacketTagIterator i = q->GetPacketTagIterator();
+        for (const auto& tid : expected)
+        {
+            NS_TEST_ASSERT_MSG_EQ(i.HasNext(), true, "missing tag " << tid.GetName());
+            PacketTagIterator::Item item = i.Next();
+            NS_TEST_EXPECT_MSG_EQ(item.GetTypeId(), tid, "wrong tag order");
+        }
+        NS_TEST_EXPECT_MSG_EQ(i.HasNext(), false, "too many tags");
+
+        // Shrink a copy back to the inline storage
+        Ptr<Packet> r = q->Copy();
+        ALargeTestTag large;
+        NS_TEST_EXPECT_MSG_EQ(r->RemovePacketTag(large), true, "large tag not found");
+        NS_TEST_EXPECT_MSG_EQ(r->RemovePacketTag(t7), true, "t7 not found");
+        NS_TEST_EXPECT_MSG_EQ(r->RemovePacketTag(t2), true, "t2 not found");
+        ATestTag<3> replaced(3);
+        NS_TEST_EXPECT_MSG_EQ(r->ReplacePacketTag(replaced), true, "t3 not found");
+        NS_TEST_EXPECT_MSG_EQ(r->PeekPacketTag(t3), true, "t3 not found");
+        NS_TEST_EXPECT_MSG_EQ(t3.GetData(), 3, "t3 not replaced");
+        NS_TEST_EXPECT_MSG_EQ(r->PeekPacketTag(t2), false, "t2 not removed");
+        NS_TEST_EXPECT_MSG_EQ(r->PeekPacketTag(t4), true, "t4 not found");
+
+        // The original packets are left untouched
+        NS_TEST_EXPECT_MSG_EQ(q->PeekPacketTag(large), true, "large tag removed from the copy");
+        for (ATestTagBase* t : std::vector<ATestTagBase*>{&t1, &t2, &t3, &t4, &t5, &t6, &t7})
+        {
+            NS_TEST_EXPECT_MSG_EQ(q->PeekPacketTag(*t), true, "tag removed from the copy");
+            NS_TEST_EXPECT_MSG_EQ(t->GetData(), 1, "tag changed in the copy");
+        }
+        NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(t1), true, "t1 not found");
+        NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(t3), false, "t3 added to the first packet");
+    }
+
     // Timing
     {
         std::cout << GetName() << "add+remove timing" << std::endl;
@@ -1268,6 +1355,169 @@ PacketTagListTest::DoRun()
     } // Timing
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Header counting the calls to Deserialize
+ *
+ * \note Class internal to packet-test-suite.cc
+ */
+template <int N>
+class ACountingHeader : public Header
+{
+  public:
+    /**
+     * Register this type.
+     * \return The TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        std::ostringstream oss;
+        oss << "anon::ACountingHeader<" << N << ">";
+        static TypeId tid = TypeId(oss.str())
+                                .SetParent<Header>()
+                                .SetGroupName("Network")
+                                .HideFromDocumentation()
+                                .AddConstructor<ACountingHeader<N>>();
+        return tid;
+    }
+
+    TypeId GetInstanceTypeId() const override
+    {
+        return GetTypeId();
+    }
+
+    uint32_t GetSerializedSize() const override
+    {
+        return N;
+    }
+
+    void Serialize(Buffer::Iterator iter) const override
+    {
+        iter.WriteU8(m_value);
+        iter.WriteU8(0, N - 1);
+    }
+
+    uint32_t Deserialize(Buffer::Iterator iter) override
+    {
+        m_deserialized++;
+        m_value = iter.ReadU8();
+        return N;
+    }
+
+    void Print(std::ostream& os) const override
+    {
+        os << "value=" << +m_value;
+    }
+
+    uint8_t m_value{0};             //!< The value of the header
+    static uint32_t m_deserialized; //!< Number of calls to Deserialize
+};
+
+template <int N>
+uint32_t ACountingHeader<N>::m_deserialized = 0;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Packet header cache unit tests.
+ */
+class PacketHeaderCacheTest : public TestCase
+{
+  public:
+    PacketHeaderCacheTest();
+
+  private:
+    void DoRun() override;
+};
+
+PacketHeaderCacheTest::PacketHeaderCacheTest()
+    : TestCase("Check the cache of the parsed headers")
+{
+}
+
+void
+PacketHeaderCacheTest::DoRun()
+{
+    Packet::EnableHeaderCache();
+    uint32_t& outer = ACountingHeader<4>::m_deserialized;
+    uint32_t& inner = ACountingHeader<6>::m_deserialized;
+    outer = 0;
+    inner = 0;
+
+    ACountingHeader<6> h6;
+    ACountingHeader<4> h4;
+    Ptr<Packet> p = Create<Packet>(10);
+    h6.m_value = 6;
+    p->AddHeader(h6);
+    h4.m_value = 4;
+    p->AddHeader(h4);
+
+    // Peeking again, or removing, uses the cached header
+    ACountingHeader<4> peeked;
+    NS_TEST_ASSERT_MSG_EQ(p->PeekHeader(peeked), 4, "Wrong size");
+    NS_TEST_ASSERT_MSG_EQ(+peeked.m_value, 4, "Wrong value");
+    peeked.m_value = 0;
+    NS_TEST_ASSERT_MSG_EQ(p->PeekHeader(peeked), 4, "Wrong size");
+    NS_TEST_ASSERT_MSG_EQ(+peeked.m_value, 4, "Wrong cached value");
+    NS_TEST_ASSERT_MSG_EQ(outer, 1, "Header parsed again");
+
+    // The copies share the cache
+    Ptr<Packet> copy = p->Copy();
+    ACountingHeader<4> removed;
+    NS_TEST_ASSERT_MSG_EQ(copy->RemoveHeader(removed), 4, "Wrong size");
+    NS_TEST_ASSERT_MSG_EQ(+removed.m_value, 4, "Wrong cached value");
+    NS_TEST_ASSERT_MSG_EQ(outer, 1, "Header parsed again");
+    NS_TEST_ASSERT_MSG_EQ(copy->GetSize(), 16, "Wrong size");
+
+    // The headers cached after the copy are not shared
+    ACountingHeader<6> inner6;
+    copy->PeekHeader(inner6);
+    NS_TEST_ASSERT_MSG_EQ(+inner6.m_value, 6, "Wrong value");
+    NS_TEST_ASSERT_MSG_EQ(inner, 1, "Header not parsed");
+    p->RemoveHeader(removed);
+    NS_TEST_ASSERT_MSG_EQ(outer, 1, "Header parsed again");
+    p->PeekHeader(inner6);
+    NS_TEST_ASSERT_MSG_EQ(inner, 2, "Header not parsed");
+    Ptr<Packet> copy2 = p->Copy();
+    copy2->PeekHeader(inner6);
+    NS_TEST_ASSERT_MSG_EQ(inner, 2, "Header parsed again");
+
+    // A header of another type at the same offset is not taken from the cache
+    ACountingHeader<4> other;
+    p->PeekHeader(other);
+    NS_TEST_ASSERT_MSG_EQ(+other.m_value, 6, "Wrong value");
+    NS_TEST_ASSERT_MSG_EQ(outer, 2, "Header not parsed");
+
+    // A new header at the same offset replaces the cached one
+    p->RemoveHeader(inner6);
+    h6.m_value = 7;
+    p->AddHeader(h6);
+    p->PeekHeader(inner6);
+    NS_TEST_ASSERT_MSG_EQ(+inner6.m_value, 7, "Stale header in the cache");
+    NS_TEST_ASSERT_MSG_EQ(inner, 3, "Header not parsed");
+
+    // Changing the end of the packet clears the cache
+    p->AddPaddingAtEnd(2);
+    p->PeekHeader(inner6);
+    NS_TEST_ASSERT_MSG_EQ(inner, 4, "Header not parsed");
+
+    // Removing bytes at the start drops the headers they belong to
+    p->RemoveAtStart(1);
+    p->PeekHeader(other);
+    NS_TEST_ASSERT_MSG_EQ(+other.m_value, 0, "Wrong value");
+    p->PeekHeader(other);
+    NS_TEST_ASSERT_MSG_EQ(outer, 3, "Header parsed again");
+
+    // Without the cache, the headers are parsed each time
+    Packet::DisableHeaderCache();
+    copy2->PeekHeader(inner6);
+    copy2->PeekHeader(inner6);
+    NS_TEST_ASSERT_MSG_EQ(inner, 6, "Header not parsed");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1285,6 +1535,7 @@ PacketTestSuite::PacketTestSuite()
 {
     AddTestCase(new PacketTest, TestCase::Duration::QUICK);
     AddTestCase(new PacketTagListTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketHeaderCacheTest, TestCase::Duration::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite; //!< Static variable for test initialization
@@ -16,14 +16,17 @@
  */
 
 #include "ns3/log.h"
+#include "ns3/packet.h"
 #include "ns3/pcap-file.h"
 #include "ns3/test.h"
 
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 using namespace ns3;
 
@@ -1375,6 +1378,113 @@ DiffTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that the buffered and asynchronous writes
+ * produce the same file as the direct writes.
+ */
+class WriteBufferTestCase : public TestCase
+{
+  public:
+    WriteBufferTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Write records to a file
+     * \param filename the file name
+     * \param bufferSize the size of the write buffer
+     * \param async whether the buffers are written by the background thread
+     */
+    void WriteFile(std::string filename, uint32_t bufferSize, bool async);
+
+    /**
+     * \param filename the file name
+     * \returns the content of the file
+     */
+    std::string ReadFile(std::string filename);
+};
+
+WriteBufferTestCase::WriteBufferTestCase()
+    : TestCase("Check that PcapFile::SetWriteBuffer writes the same file")
+{
+}
+
+void
+WriteBufferTestCase::WriteFile(std::string filename, uint32_t bufferSize, bool async)
+{
+    PcapFile f;
+    f.Open(filename, std::ios::out);
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Open (" << filename << ") returns error");
+    f.SetWriteBuffer(bufferSize, async);
+    f.Init(1, 64);
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Init (1, 64) returns error");
+
+    std::vector<uint8_t> data(200);
+    for (uint32_t i = 0; i < 2000; ++i)
+    {
+        uint32_t size = i % data.size();
+        for (uint32_t j = 0; j < size; ++j)
+        {
+            data[j] = i + j;
+        }
+        if (i % 2 == 0)
+        {
+            f.Write(i / 1000, i % 1000, data.data(), size);
+        }
+        else
+        {
+            // snapshot length shorter than some of the packets
+            f.Write(i / 1000, i % 1000, Create<Packet>(data.data(), size));
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(f.Fail(), false, "Write (" << filename << ") returns error");
+    f.Close();
+}
+
+std::string
+WriteBufferTestCase::ReadFile(std::string filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    std::ostringstream oss;
+    oss << file.rdbuf();
+    return oss.str();
+}
+
+void
+WriteBufferTestCase::DoRun()
+{
+    std::string direct = CreateTempDirFilename("direct.pcap");
+    std::string buffered = CreateTempDirFilename("buffered.pcap");
+    std::string async = CreateTempDirFilename("async.pcap");
+    WriteFile(direct, 0, false);
+    WriteFile(buffered, 1000, false);
+    WriteFile(async, 1000, true);
+
+    std::string expected = ReadFile(direct);
+    NS_TEST_ASSERT_MSG_GT(expected.size(), 24U, "No record written");
+    NS_TEST_EXPECT_MSG_EQ((ReadFile(buffered) == expected),
+                          true,
+                          "The buffered writes produce another file");
+    NS_TEST_EXPECT_MSG_EQ((ReadFile(async) == expected),
+                          true,
+                          "The asynchronous writes produce another file");
+
+    uint32_t sec = 0;
+    uint32_t usec = 0;
+    uint32_t packets = 0;
+    bool diff = PcapFile::Diff(direct, async, sec, usec, packets);
+    NS_TEST_EXPECT_MSG_EQ(diff, false, "PcapDiff(direct, async) must be false");
+    NS_TEST_EXPECT_MSG_EQ(packets, 2000, "Bad number of records");
+
+    remove(direct.c_str());
+    remove(buffered.c_str());
+    remove(async.c_str());
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1398,6 +1508,7 @@ PcapFileTestSuite::PcapFileTestSuite()
     AddTestCase(new RecordHeaderTestCase, TestCase::Duration::QUICK);
     AddTestCase(new ReadFileTestCase, TestCase::Duration::QUICK);
     AddTestCase(new DiffTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new WriteBufferTestCase, TestCase::Duration::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite; //!< Static variable for test initialization
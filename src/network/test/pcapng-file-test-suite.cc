@@ -0,0 +1,307 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/packet.h"
+#include "ns3/pcapng-file.h"
+#include "ns3/test.h"
+#include "ns3/trace-helper.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief A block read from a PCAP-NG file
+ */
+struct PcapNgBlock
+{
+    uint32_t type;             //!< the type of the block
+    std::vector<uint8_t> body; //!< the bytes between the lengths of the block
+
+    /**
+     * \param offset an offset in the body
+     * \returns the 32 bits value at \p offset
+     */
+    uint32_t GetU32(uint32_t offset) const
+    {
+        uint32_t value = 0;
+        memcpy(&value, body.data() + offset, sizeof(value));
+        return value;
+    }
+
+    /**
+     * \param offset an offset in the body
+     * \returns the 16 bits value at \p offset
+     */
+    uint16_t GetU16(uint32_t offset) const
+    {
+        uint16_t value = 0;
+        memcpy(&value, body.data() + offset, sizeof(value));
+        return value;
+    }
+};
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Read the blocks of a PCAP-NG file
+ * \param filename the name of the file
+ * \param [out] blocks the blocks read
+ * \returns true if the lengths of the blocks are consistent
+ */
+static bool
+ReadBlocks(std::string filename, std::vector<PcapNgBlock>& blocks)
+{
+    std::ifstream file(filename, std::ios::binary);
+    std::ostringstream oss;
+    oss << file.rdbuf();
+    std::string content = oss.str();
+
+    std::size_t offset = 0;
+    while (offset + 12 <= content.size())
+    {
+        uint32_t type;
+        uint32_t length;
+        uint32_t trailingLength;
+        memcpy(&type, content.data() + offset, 4);
+        memcpy(&length, content.data() + offset + 4, 4);
+        if (length < 12 || length % 4 != 0 || offset + length > content.size())
+        {
+            return false;
+        }
+        memcpy(&trailingLength, content.data() + offset + length - 4, 4);
+        if (trailingLength != length)
+        {
+            return false;
+        }
+        PcapNgBlock block;
+        block.type = type;
+        block.body.assign(content.begin() + offset + 8, content.begin() + offset + length - 4);
+        blocks.push_back(block);
+        offset += length;
+    }
+    return offset == content.size();
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Get the name of an interface
+ * \param block the Interface Description Block of the interface
+ * \returns the name of the interface, from the if_name option
+ */
+static std::string
+GetInterfaceName(const PcapNgBlock& block)
+{
+    uint32_t offset = 8;
+    while (offset + 4 <= block.body.size())
+    {
+        uint16_t code = block.GetU16(offset);
+        uint16_t length = block.GetU16(offset + 2);
+        if (code == 0)
+        {
+            break;
+        }
+        if (code == 2)
+        {
+            return std::string(block.body.begin() + offset + 4,
+                               block.body.begin() + offset + 4 + length);
+        }
+        offset += 4 + ((length + 3) & ~3);
+    }
+    return "";
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that PcapNgFile writes the expected blocks.
+ */
+class PcapNgFileBlocksTestCase : public TestCase
+{
+  public:
+    PcapNgFileBlocksTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PcapNgFileBlocksTestCase::PcapNgFileBlocksTestCase()
+    : TestCase("Check the blocks written by PcapNgFile")
+{
+}
+
+void
+PcapNgFileBlocksTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("blocks.pcapng");
+    PcapNgFile f;
+    f.Open(filename);
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Open (" << filename << ") returns error");
+    uint32_t first = f.AddInterface("first", PcapHelper::DLT_PPP, 65535);
+    uint32_t second = f.AddInterface("second", PcapHelper::DLT_EN10MB, 10);
+    NS_TEST_EXPECT_MSG_EQ(first, 0, "Bad identifier of the first interface");
+    NS_TEST_EXPECT_MSG_EQ(second, 1, "Bad identifier of the second interface");
+    NS_TEST_EXPECT_MSG_EQ(f.GetNInterfaces(), 2, "Bad number of interfaces");
+
+    uint8_t data[15];
+    for (uint32_t i = 0; i < sizeof(data); ++i)
+    {
+        data[i] = i;
+    }
+    f.Write(first, NanoSeconds(5000000001ULL), data, 15);
+    f.Write(second, Seconds(6), Create<Packet>(data, 15));
+    f.Close();
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Write (" << filename << ") returns error");
+
+    std::vector<PcapNgBlock> blocks;
+    NS_TEST_ASSERT_MSG_EQ(ReadBlocks(filename, blocks), true, "Bad lengths of the blocks");
+    NS_TEST_ASSERT_MSG_EQ(blocks.size(), 5, "Bad number of blocks");
+
+    NS_TEST_EXPECT_MSG_EQ(blocks[0].type, 0x0a0d0d0a, "No Section Header Block");
+    NS_TEST_EXPECT_MSG_EQ(blocks[0].GetU32(0), 0x1a2b3c4d, "Bad byte order magic");
+    NS_TEST_EXPECT_MSG_EQ(blocks[0].GetU16(4), 1, "Bad major version");
+
+    NS_TEST_EXPECT_MSG_EQ(blocks[1].type, 1, "No Interface Description Block");
+    NS_TEST_EXPECT_MSG_EQ(blocks[1].GetU16(0), PcapHelper::DLT_PPP, "Bad data link type");
+    NS_TEST_EXPECT_MSG_EQ(blocks[1].GetU32(4), 65535, "Bad snapshot length");
+    NS_TEST_EXPECT_MSG_EQ(GetInterfaceName(blocks[1]), "first", "Bad interface name");
+    NS_TEST_EXPECT_MSG_EQ(blocks[2].type, 1, "No Interface Description Block");
+    NS_TEST_EXPECT_MSG_EQ(blocks[2].GetU16(0), PcapHelper::DLT_EN10MB, "Bad data link type");
+    NS_TEST_EXPECT_MSG_EQ(GetInterfaceName(blocks[2]), "second", "Bad interface name");
+
+    NS_TEST_EXPECT_MSG_EQ(blocks[3].type, 6, "No Enhanced Packet Block");
+    NS_TEST_EXPECT_MSG_EQ(blocks[3].GetU32(0), first, "Bad interface of the packet");
+    NS_TEST_EXPECT_MSG_EQ(blocks[3].GetU32(4), 1, "Bad high time stamp");
+    NS_TEST_EXPECT_MSG_EQ(blocks[3].GetU32(8), 705032705, "Bad low time stamp");
+    NS_TEST_EXPECT_MSG_EQ(blocks[3].GetU32(12), 15, "Bad captured length");
+    NS_TEST_EXPECT_MSG_EQ(blocks[3].GetU32(16), 15, "Bad original length");
+    NS_TEST_EXPECT_MSG_EQ(memcmp(blocks[3].body.data() + 20, data, 15), 0, "Bad packet data");
+
+    NS_TEST_EXPECT_MSG_EQ(blocks[4].type, 6, "No Enhanced Packet Block");
+    NS_TEST_EXPECT_MSG_EQ(blocks[4].GetU32(0), second, "Bad interface of the packet");
+    NS_TEST_EXPECT_MSG_EQ(blocks[4].GetU32(12), 10, "Snapshot length not applied");
+    NS_TEST_EXPECT_MSG_EQ(blocks[4].GetU32(16), 15, "Bad original length");
+    NS_TEST_EXPECT_MSG_EQ(memcmp(blocks[4].body.data() + 20, data, 10), 0, "Bad packet data");
+
+    remove(filename.c_str());
+
+    if (PcapNgFile::IsCompressionSupported())
+    {
+        f.Open(filename, true);
+        f.AddInterface("first", PcapHelper::DLT_PPP, 65535);
+        f.Write(0, Seconds(1), data, 15);
+        f.Close();
+        NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Write (" << filename << ") returns error");
+        std::ifstream file(filename, std::ios::binary);
+        uint8_t magic[2] = {0, 0};
+        file.read(reinterpret_cast<char*>(magic), 2);
+        NS_TEST_EXPECT_MSG_EQ(magic[0], 0x1f, "The file is not compressed with gzip");
+        NS_TEST_EXPECT_MSG_EQ(magic[1], 0x8b, "The file is not compressed with gzip");
+        file.close();
+        remove(filename.c_str());
+    }
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that the pcap traces created by PcapHelper
+ * are written to a single PCAP-NG file when aggregated.
+ */
+class PcapNgAggregationTestCase : public TestCase
+{
+  public:
+    PcapNgAggregationTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PcapNgAggregationTestCase::PcapNgAggregationTestCase()
+    : TestCase("Check the aggregation of the pcap traces in a PCAP-NG file")
+{
+}
+
+void
+PcapNgAggregationTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("aggregated.pcapng");
+    std::string prefix = CreateTempDirFilename("aggregated");
+    PcapHelper::EnableAggregation(filename);
+
+    PcapHelper pcapHelper;
+    Ptr<PcapFileWrapper> first =
+        pcapHelper.CreateFile(prefix + "-0-1.pcap", std::ios::out, PcapHelper::DLT_PPP);
+    Ptr<PcapFileWrapper> second =
+        pcapHelper.CreateFile(prefix + "-1-1.pcap", std::ios::out, PcapHelper::DLT_EN10MB);
+    PcapHelper::DisableAggregation();
+    NS_TEST_EXPECT_MSG_EQ(std::ifstream(prefix + "-0-1.pcap").good(),
+                          false,
+                          "A pcap file has been created");
+
+    first->Write(Seconds(1), Create<Packet>(100));
+    second->Write(Seconds(2), Create<Packet>(200));
+    first->Write(Seconds(3), Create<Packet>(300));
+    NS_TEST_EXPECT_MSG_EQ(first->Fail(), false, "Write returns error");
+    first = nullptr;
+    second = nullptr;
+
+    std::vector<PcapNgBlock> blocks;
+    NS_TEST_ASSERT_MSG_EQ(ReadBlocks(filename, blocks), true, "Bad lengths of the blocks");
+    NS_TEST_ASSERT_MSG_EQ(blocks.size(), 6, "Bad number of blocks");
+    NS_TEST_EXPECT_MSG_EQ(GetInterfaceName(blocks[1]), prefix + "-0-1", "Bad interface name");
+    NS_TEST_EXPECT_MSG_EQ(GetInterfaceName(blocks[2]), prefix + "-1-1", "Bad interface name");
+    NS_TEST_EXPECT_MSG_EQ(blocks[3].GetU32(0), 0, "Bad interface of the packet");
+    NS_TEST_EXPECT_MSG_EQ(blocks[3].GetU32(16), 100, "Bad original length");
+    NS_TEST_EXPECT_MSG_EQ(blocks[4].GetU32(0), 1, "Bad interface of the packet");
+    NS_TEST_EXPECT_MSG_EQ(blocks[4].GetU32(16), 200, "Bad original length");
+    NS_TEST_EXPECT_MSG_EQ(blocks[5].GetU32(0), 0, "Bad interface of the packet");
+    NS_TEST_EXPECT_MSG_EQ(blocks[5].GetU32(16), 300, "Bad original length");
+
+    remove(filename.c_str());
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief PCAP-NG file TestSuite
+ */
+class PcapNgFileTestSuite : public TestSuite
+{
+  public:
+    PcapNgFileTestSuite();
+};
+
+PcapNgFileTestSuite::PcapNgFileTestSuite()
+    : TestSuite("pcapng-file", Type::UNIT)
+{
+    AddTestCase(new PcapNgFileBlocksTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new PcapNgAggregationTestCase, TestCase::Duration::QUICK);
+}
+
+static PcapNgFileTestSuite g_pcapNgFileTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,263 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "binary-trace.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("BinaryTrace");
+
+namespace
+{
+
+const uint32_t MAGIC = 0x6e733362;     //!< Magic number of the binary trace files
+const uint16_t VERSION = 1;            //!< Version of the format
+const uint32_t FILE_HEADER_SIZE = 16;  //!< Size of the header of the file
+const uint32_t RECORD_FIXED_SIZE = 32; //!< Size of the records without the header bytes
+const uint32_t FLUSH_SIZE = 1 << 20;   //!< Bytes of records accumulated before being written
+
+/**
+ * \param headerBytes the number of header bytes recorded
+ * \returns the size of the records
+ */
+inline uint32_t
+RecordSize(uint16_t headerBytes)
+{
+    return RECORD_FIXED_SIZE + ((headerBytes + 7) & ~7U);
+}
+
+} // namespace
+
+void
+BinaryTraceRecord::PrintAscii(std::ostream& os) const
+{
+    static const char* const events[] = {"+", "-", "d", "r", "d"};
+    static const char* const sources[] = {"TxQueue/Enqueue",
+                                          "TxQueue/Dequeue",
+                                          "TxQueue/Drop",
+                                          "MacRx",
+                                          "PhyRxDrop"};
+    NS_ASSERT_MSG(event <= PHY_RX_DROP, "Unknown event " << +event);
+    os << events[event] << " " << time.GetSeconds() << " /NodeList/" << node << "/DeviceList/"
+       << device << "/" << sources[event] << " uid=" << uid << " size=" << size;
+    if (!header.empty())
+    {
+        std::ios_base::fmtflags flags = os.flags();
+        char fill = os.fill('0');
+        os << " header=" << std::hex;
+        for (uint8_t byte : header)
+        {
+            os << std::setw(2) << +byte;
+        }
+        os.flags(flags);
+        os.fill(fill);
+    }
+}
+
+BinaryTraceWriter::BinaryTraceWriter()
+    : m_headerBytes(0),
+      m_recordSize(RecordSize(0))
+{
+    NS_LOG_FUNCTION(this);
+}
+
+BinaryTraceWriter::~BinaryTraceWriter()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+void
+BinaryTraceWriter::Open(const std::string& filename, uint16_t headerBytes)
+{
+    NS_LOG_FUNCTION(this << filename << headerBytes);
+    NS_ABORT_MSG_IF(headerBytes > 255, "At most 255 header bytes can be recorded");
+    Close();
+    m_headerBytes = headerBytes;
+    m_recordSize = RecordSize(headerBytes);
+    m_file.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+
+    m_buffer.resize(FILE_HEADER_SIZE);
+    uint8_t* buffer = m_buffer.data();
+    memcpy(buffer, &MAGIC, sizeof(MAGIC));
+    memcpy(buffer + 4, &VERSION, sizeof(VERSION));
+    memcpy(buffer + 6, &m_headerBytes, sizeof(m_headerBytes));
+    memcpy(buffer + 8, &m_recordSize, sizeof(m_recordSize));
+    memset(buffer + 12, 0, 4);
+}
+
+void
+BinaryTraceWriter::Close()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_file.is_open())
+    {
+        Flush();
+        m_file.close();
+    }
+}
+
+bool
+BinaryTraceWriter::Fail() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_file.fail();
+}
+
+uint16_t
+BinaryTraceWriter::GetHeaderBytes() const
+{
+    return m_headerBytes;
+}
+
+void
+BinaryTraceWriter::Write(Time t,
+                         uint32_t node,
+                         uint32_t device,
+                         BinaryTraceRecord::Event event,
+                         Ptr<const Packet> p)
+{
+    NS_LOG_FUNCTION(this << t << node << device << +event << p);
+    std::size_t offset = m_buffer.size();
+    m_buffer.resize(offset + m_recordSize);
+    uint8_t* buffer = m_buffer.data() + offset;
+
+    int64_t time = t.GetNanoSeconds();
+    uint64_t uid = p->GetUid();
+    uint32_t size = p->GetSize();
+    memcpy(buffer, &time, sizeof(time));
+    memcpy(buffer + 8, &uid, sizeof(uid));
+    memcpy(buffer + 16, &node, sizeof(node));
+    memcpy(buffer + 20, &device, sizeof(device));
+    memcpy(buffer + 24, &size, sizeof(size));
+    buffer[28] = event;
+    buffer[29] = p->CopyData(buffer + RECORD_FIXED_SIZE, m_headerBytes);
+    buffer[30] = 0;
+    buffer[31] = 0;
+
+    if (m_buffer.size() >= FLUSH_SIZE)
+    {
+        Flush();
+    }
+}
+
+void
+BinaryTraceWriter::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    m_file.write(reinterpret_cast<const char*>(m_buffer.data()), m_buffer.size());
+    m_buffer.clear();
+}
+
+BinaryTraceReader::BinaryTraceReader()
+    : m_fail(false),
+      m_headerBytes(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+BinaryTraceReader::Open(const std::string& filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    Close();
+    m_file.open(filename, std::ios::in | std::ios::binary);
+
+    uint8_t header[FILE_HEADER_SIZE];
+    m_file.read(reinterpret_cast<char*>(header), FILE_HEADER_SIZE);
+    uint32_t magic;
+    uint16_t version;
+    uint32_t recordSize;
+    memcpy(&magic, header, sizeof(magic));
+    memcpy(&version, header + 4, sizeof(version));
+    memcpy(&m_headerBytes, header + 6, sizeof(m_headerBytes));
+    memcpy(&recordSize, header + 8, sizeof(recordSize));
+    m_fail = m_file.fail() || magic != MAGIC || version != VERSION || m_headerBytes > 255 ||
+             recordSize != RecordSize(m_headerBytes);
+    m_record.resize(RecordSize(m_headerBytes));
+}
+
+void
+BinaryTraceReader::Close()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_file.is_open())
+    {
+        m_file.close();
+    }
+    m_file.clear();
+    m_fail = false;
+    m_headerBytes = 0;
+}
+
+bool
+BinaryTraceReader::Fail() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_fail;
+}
+
+uint16_t
+BinaryTraceReader::GetHeaderBytes() const
+{
+    return m_headerBytes;
+}
+
+bool
+BinaryTraceReader::Read(BinaryTraceRecord& record)
+{
+    if (m_fail || !m_file.read(reinterpret_cast<char*>(m_record.data()), m_record.size()))
+    {
+        return false;
+    }
+    const uint8_t* buffer = m_record.data();
+    int64_t time;
+    memcpy(&time, buffer, sizeof(time));
+    record.time = NanoSeconds(time);
+    memcpy(&record.uid, buffer + 8, sizeof(record.uid));
+    memcpy(&record.node, buffer + 16, sizeof(record.node));
+    memcpy(&record.device, buffer + 20, sizeof(record.device));
+    memcpy(&record.size, buffer + 24, sizeof(record.size));
+    record.event = static_cast<BinaryTraceRecord::Event>(buffer[28]);
+    uint16_t captured = std::min<uint16_t>(buffer[29], m_headerBytes);
+    record.header.assign(buffer + RECORD_FIXED_SIZE, buffer + RECORD_FIXED_SIZE + captured);
+    return true;
+}
+
+uint64_t
+BinaryTraceReader::WriteAscii(std::ostream& os)
+{
+    NS_LOG_FUNCTION(this << &os);
+    BinaryTraceRecord record;
+    uint64_t n = 0;
+    while (Read(record))
+    {
+        record.PrintAscii(os);
+        os << '\n';
+        n++;
+    }
+    return n;
+}
+
+} // namespace ns3
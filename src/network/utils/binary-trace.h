@@ -0,0 +1,215 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BINARY_TRACE_H
+#define BINARY_TRACE_H
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <fstream>
+#include <ostream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+class Packet;
+
+/**
+ * \ingroup network
+ *
+ * \brief An event of a binary trace
+ *
+ * The events are those written by the ascii traces of the devices, see
+ * AsciiTraceHelperForDevice.
+ */
+struct BinaryTraceRecord
+{
+    /// The kind of event
+    enum Event : uint8_t
+    {
+        ENQUEUE = 0, //!< Packet enqueued in the transmit queue of the device
+        DEQUEUE,     //!< Packet dequeued from the transmit queue of the device
+        DROP,        //!< Packet dropped by the transmit queue of the device
+        RECEIVE,     //!< Packet received by the device, and forwarded up
+        PHY_RX_DROP, //!< Packet dropped by the device during reception
+    };
+
+    /**
+     * \brief Print the record as a line of the ascii traces, without the
+     * end of line
+     *
+     * The line starts with the character and the time of the ascii traces,
+     * followed by the path of the trace source, e.g.,
+     * "+ 1.5 /NodeList/0/DeviceList/1/TxQueue/Enqueue", and ends with the
+     * uid and the size of the packet, and the header bytes in hexadecimal,
+     * if any, as the packet itself is not recorded.
+     *
+     * \param os the output stream
+     */
+    void PrintAscii(std::ostream& os) const;
+
+    Time time;                   //!< the time of the event
+    uint32_t node;               //!< the id of the node
+    uint32_t device;             //!< the index of the device in the node
+    Event event;                 //!< the kind of event
+    uint64_t uid;                //!< the uid of the packet
+    uint32_t size;               //!< the size of the packet
+    std::vector<uint8_t> header; //!< the first bytes of the packet, if captured
+};
+
+/**
+ * \ingroup network
+ *
+ * \brief Write a binary trace file
+ *
+ * A binary trace file records the same events as the ascii traces of the
+ * devices, in fixed-size records rather than in text, without printing the
+ * packets.  It is much faster to write and to read back, and much smaller,
+ * than the ascii traces.  BinaryTraceReader reads the file, and converts it
+ * to text if needed.
+ *
+ * The file starts with a 16 bytes header: the magic number 0x6e733362, the
+ * version of the format on 16 bits, the number of header bytes captured on
+ * 16 bits, the size of the records on 32 bits, and 32 reserved bits.  Each
+ * record then holds the time in nanoseconds on 64 bits, the uid of the
+ * packet on 64 bits, the node id, the device index and the size of the
+ * packet on 32 bits each, the kind of event and the number of header bytes
+ * actually captured on 8 bits each, 16 reserved bits and the header bytes,
+ * padded to a multiple of 8 bytes.  All the fields are in host byte order.
+ *
+ * The records are accumulated in memory and written to the file in large
+ * chunks.
+ */
+class BinaryTraceWriter : public SimpleRefCount<BinaryTraceWriter>
+{
+  public:
+    BinaryTraceWriter();
+    ~BinaryTraceWriter();
+
+    /**
+     * Create a new binary trace file, and write its header.
+     *
+     * \param filename the name of the file.
+     * \param headerBytes the number of bytes at the start of each packet
+     * to record, at most 255.
+     */
+    void Open(const std::string& filename, uint16_t headerBytes = 0);
+
+    /**
+     * Write the pending records, and close the file.
+     */
+    void Close();
+
+    /**
+     * \returns true if the file could not be opened or written, false otherwise.
+     */
+    bool Fail() const;
+
+    /**
+     * \returns the number of bytes at the start of each packet recorded.
+     */
+    uint16_t GetHeaderBytes() const;
+
+    /**
+     * \brief Write a record
+     *
+     * \param t the time of the event.
+     * \param node the id of the node.
+     * \param device the index of the device in the node.
+     * \param event the kind of event.
+     * \param p the packet.
+     */
+    void Write(Time t,
+               uint32_t node,
+               uint32_t device,
+               BinaryTraceRecord::Event event,
+               Ptr<const Packet> p);
+
+  private:
+    /**
+     * \brief Write the pending records to the file
+     */
+    void Flush();
+
+    std::ofstream m_file;          //!< the file
+    uint16_t m_headerBytes;        //!< the number of header bytes recorded
+    uint32_t m_recordSize;         //!< the size of the records
+    std::vector<uint8_t> m_buffer; //!< the records not yet written
+};
+
+/**
+ * \ingroup network
+ *
+ * \brief Read a binary trace file written by BinaryTraceWriter
+ */
+class BinaryTraceReader
+{
+  public:
+    BinaryTraceReader();
+
+    /**
+     * Open a binary trace file, and read its header.
+     *
+     * \param filename the name of the file.
+     */
+    void Open(const std::string& filename);
+
+    /**
+     * Close the file.
+     */
+    void Close();
+
+    /**
+     * \returns true if the file could not be opened, or is not a binary
+     * trace file, false otherwise.
+     */
+    bool Fail() const;
+
+    /**
+     * \returns the number of bytes at the start of each packet recorded.
+     */
+    uint16_t GetHeaderBytes() const;
+
+    /**
+     * \brief Read the next record
+     *
+     * \param [out] record the record read.
+     * \returns false at the end of the file, true otherwise.
+     */
+    bool Read(BinaryTraceRecord& record);
+
+    /**
+     * \brief Convert the remaining records of the file to ascii traces
+     *
+     * \param os the output stream, to which one line is written per record.
+     * \returns the number of records converted.
+     */
+    uint64_t WriteAscii(std::ostream& os);
+
+  private:
+    std::ifstream m_file;          //!< the file
+    bool m_fail;                   //!< whether the file could not be opened or read
+    uint16_t m_headerBytes;        //!< the number of header bytes recorded
+    std::vector<uint8_t> m_record; //!< the bytes of the record read
+};
+
+} // namespace ns3
+
+#endif /* BINARY_TRACE_H */
@@ -20,6 +20,8 @@
 
 #include "queue.h"
 
+#include "ns3/checkpoint.h"
+
 namespace ns3
 {
 
@@ -29,7 +31,7 @@ namespace ns3
  * \brief A FIFO packet queue that drops tail-end packets on overflow
  */
 template <typename Item>
-class DropTailQueue : public Queue<Item>
+class DropTailQueue : public Queue<Item>, public Checkpointable
 {
   public:
     /**
@@ -51,12 +53,27 @@ class DropTailQueue : public Queue<Item>
     Ptr<Item> Remove() override;
     Ptr<const Item> Peek() const override;
 
+    /**
+     * Save the statistics and the packets of the queue.  Only the queues
+     * of packets can be saved when not empty.
+     *
+     * \param [in,out] writer The checkpoint writer.
+     */
+    void SaveState(CheckpointWriter& writer) const override;
+    /**
+     * Restore the statistics and the packets of the queue.
+     *
+     * \param [in,out] reader The checkpoint reader.
+     */
+    void RestoreState(CheckpointReader& reader) override;
+
   private:
     using Queue<Item>::GetContainer;
     using Queue<Item>::DoEnqueue;
     using Queue<Item>::DoDequeue;
     using Queue<Item>::DoRemove;
     using Queue<Item>::DoPeek;
+    using Queue<Item>::RestoreItem;
 
     NS_LOG_TEMPLATE_DECLARE; //!< redefinition of the log component
 };
@@ -140,6 +157,61 @@ DropTailQueue<Item>::Peek() const
     return DoPeek(GetContainer().begin());
 }
 
+template <typename Item>
+void
+DropTailQueue<Item>::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    writer.Write("totalReceivedBytes", this->m_nTotalReceivedBytes);
+    writer.Write("totalReceivedPackets", this->m_nTotalReceivedPackets);
+    writer.Write("totalDroppedBytes", this->m_nTotalDroppedBytes);
+    writer.Write("totalDroppedBytesBeforeEnqueue", this->m_nTotalDroppedBytesBeforeEnqueue);
+    writer.Write("totalDroppedBytesAfterDequeue", this->m_nTotalDroppedBytesAfterDequeue);
+    writer.Write("totalDroppedPackets", this->m_nTotalDroppedPackets);
+    writer.Write("totalDroppedPacketsBeforeEnqueue", this->m_nTotalDroppedPacketsBeforeEnqueue);
+    writer.Write("totalDroppedPacketsAfterDequeue", this->m_nTotalDroppedPacketsAfterDequeue);
+    writer.Write("nPackets", this->GetNPackets());
+    if constexpr (std::is_same_v<Item, Packet>)
+    {
+        uint32_t i = 0;
+        for (const auto& item : GetContainer())
+        {
+            WritePacket(writer, "packet." + std::to_string(i++), item);
+        }
+    }
+    else if (!this->IsEmpty())
+    {
+        NS_FATAL_ERROR("Cannot save the items of " << this->GetInstanceTypeId().GetName());
+    }
+}
+
+template <typename Item>
+void
+DropTailQueue<Item>::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(this->IsEmpty(), "Restoring a queue not empty");
+    if constexpr (std::is_same_v<Item, Packet>)
+    {
+        uint32_t n = reader.Read<uint32_t>("nPackets");
+        for (uint32_t i = 0; i < n; i++)
+        {
+            RestoreItem(ReadPacket(reader, "packet." + std::to_string(i)));
+        }
+    }
+    this->m_nTotalReceivedBytes = reader.Read<uint32_t>("totalReceivedBytes");
+    this->m_nTotalReceivedPackets = reader.Read<uint32_t>("totalReceivedPackets");
+    this->m_nTotalDroppedBytes = reader.Read<uint32_t>("totalDroppedBytes");
+    this->m_nTotalDroppedBytesBeforeEnqueue =
+        reader.Read<uint32_t>("totalDroppedBytesBeforeEnqueue");
+    this->m_nTotalDroppedBytesAfterDequeue = reader.Read<uint32_t>("totalDroppedBytesAfterDequeue");
+    this->m_nTotalDroppedPackets = reader.Read<uint32_t>("totalDroppedPackets");
+    this->m_nTotalDroppedPacketsBeforeEnqueue =
+        reader.Read<uint32_t>("totalDroppedPacketsBeforeEnqueue");
+    this->m_nTotalDroppedPacketsAfterDequeue =
+        reader.Read<uint32_t>("totalDroppedPacketsAfterDequeue");
+}
+
 // The following explicit template instantiation declarations prevent all the
 // translation units including this header file to implicitly instantiate the
 // DropTailQueue<Packet> class and the DropTailQueue<QueueDiscItem> class. The
@@ -285,4 +285,29 @@ NetDeviceQueueInterface::GetSelectQueueCallback() const
     return m_selectQueueCallback;
 }
 
+void
+NetDeviceQueueInterface::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    for (std::size_t i = 0; i < m_txQueuesVector.size(); i++)
+    {
+        NS_ABORT_MSG_IF(m_txQueuesVector[i]->GetQueueLimits(),
+                        "Cannot save the queue limits of the device transmission queues");
+        writer.Write("stopped." + std::to_string(i), m_txQueuesVector[i]->IsStopped());
+    }
+}
+
+void
+NetDeviceQueueInterface::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    for (std::size_t i = 0; i < m_txQueuesVector.size(); i++)
+    {
+        if (reader.Read<bool>("stopped." + std::to_string(i)))
+        {
+            m_txQueuesVector[i]->Stop();
+        }
+    }
+}
+
 } // namespace ns3
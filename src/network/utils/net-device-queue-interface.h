@@ -20,6 +20,7 @@
 #define NET_DEVICE_QUEUE_INTERFACE_H
 
 #include "ns3/callback.h"
+#include "ns3/checkpoint.h"
 #include "ns3/log.h"
 #include "ns3/net-device.h"
 #include "ns3/object-factory.h"
@@ -227,7 +228,7 @@ class NetDeviceQueue : public Object
  *   in which the netdevice would enqueue a given packet
  * NetDevice helpers create this interface and aggregate it to the device.
  */
-class NetDeviceQueueInterface : public Object
+class NetDeviceQueueInterface : public Object, public Checkpointable
 {
   public:
     /**
@@ -299,6 +300,19 @@ class NetDeviceQueueInterface : public Object
      */
     SelectQueueCallback GetSelectQueueCallback() const;
 
+    /**
+     * \brief Save whether the device transmission queues are stopped.
+     * \param writer the checkpoint writer.
+     *
+     * The queue limits are not supported.
+     */
+    void SaveState(CheckpointWriter& writer) const override;
+    /**
+     * \brief Restore whether the device transmission queues are stopped.
+     * \param reader the checkpoint reader.
+     */
+    void RestoreState(CheckpointReader& reader) override;
+
   protected:
     /**
      * \brief Dispose of the object
@@ -20,6 +20,7 @@
 
 #include "packet-socket.h"
 
+#include "ns3/checkpoint.h"
 #include "ns3/log.h"
 #include "ns3/node.h"
 
@@ -29,6 +30,7 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("PacketSocketFactory");
 
 NS_OBJECT_ENSURE_REGISTERED(PacketSocketFactory);
+NS_CHECKPOINT_STATELESS(PacketSocketFactory);
 
 TypeId
 PacketSocketFactory::GetTypeId()
@@ -48,11 +48,24 @@ PcapFileWrapper::GetTypeId()
                           "microseconds(default).",
                           BooleanValue(false),
                           MakeBooleanAccessor(&PcapFileWrapper::m_nanosecMode),
+                          MakeBooleanChecker())
+            .AddAttribute("WriteBufferSize",
+                          "Size in bytes of the buffer in which the packets are accumulated "
+                          "before being written to the file, 0 to write them directly.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&PcapFileWrapper::m_writeBufferSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("AsyncWrite",
+                          "Whether the full buffers are written to the file by a background "
+                          "thread, when WriteBufferSize is not 0.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PcapFileWrapper::m_asyncWrite),
                           MakeBooleanChecker());
     return tid;
 }
 
 PcapFileWrapper::PcapFileWrapper()
+    : m_interfaceId(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -67,6 +80,10 @@ bool
 PcapFileWrapper::Fail() const
 {
     NS_LOG_FUNCTION(this);
+    if (m_ngFile)
+    {
+        return m_ngFile->Fail();
+    }
     return m_file.Fail();
 }
 
@@ -88,6 +105,7 @@ void
 PcapFileWrapper::Close()
 {
     NS_LOG_FUNCTION(this);
+    m_ngFile = nullptr;
     m_file.Close();
 }
 
@@ -96,6 +114,18 @@ PcapFileWrapper::Open(const std::string& filename, std::ios::openmode mode)
 {
     NS_LOG_FUNCTION(this << filename << mode);
     m_file.Open(filename, mode);
+    if (mode & std::ios::out)
+    {
+        m_file.SetWriteBuffer(m_writeBufferSize, m_asyncWrite);
+    }
+}
+
+void
+PcapFileWrapper::Open(Ptr<PcapNgFile> file, const std::string& interfaceName)
+{
+    NS_LOG_FUNCTION(this << file << interfaceName);
+    m_ngFile = file;
+    m_interface = interfaceName;
 }
 
 void
@@ -107,6 +137,15 @@ PcapFileWrapper::Init(uint32_t dataLinkType, uint32_t snapLen, int32_t tzCorrect
     // a snaplen, we use the one provided.
     //
     NS_LOG_FUNCTION(this << dataLinkType << snapLen << tzCorrection);
+    if (m_ngFile)
+    {
+        // the time stamps of the PCAP-NG files are in UTC
+        m_interfaceId = m_ngFile->AddInterface(
+            m_interface,
+            dataLinkType,
+            snapLen != std::numeric_limits<uint32_t>::max() ? snapLen : m_snapLen);
+        return;
+    }
     if (snapLen != std::numeric_limits<uint32_t>::max())
     {
         m_file.Init(dataLinkType, snapLen, tzCorrection, false, m_nanosecMode);
@@ -121,6 +160,11 @@ void
 PcapFileWrapper::Write(Time t, Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(this << t << p);
+    if (m_ngFile)
+    {
+        m_ngFile->Write(m_interfaceId, t, p);
+        return;
+    }
     if (m_file.IsNanoSecMode())
     {
         uint64_t current = t.GetNanoSeconds();
@@ -141,6 +185,11 @@ void
 PcapFileWrapper::Write(Time t, const Header& header, Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(this << t << &header << p);
+    if (m_ngFile)
+    {
+        m_ngFile->Write(m_interfaceId, t, header, p);
+        return;
+    }
     if (m_file.IsNanoSecMode())
     {
         uint64_t current = t.GetNanoSeconds();
@@ -161,6 +210,11 @@ void
 PcapFileWrapper::Write(Time t, const uint8_t* buffer, uint32_t length)
 {
     NS_LOG_FUNCTION(this << t << &buffer << length);
+    if (m_ngFile)
+    {
+        m_ngFile->Write(m_interfaceId, t, buffer, length);
+        return;
+    }
     if (m_file.IsNanoSecMode())
     {
         uint64_t current = t.GetNanoSeconds();
@@ -19,6 +19,7 @@
 #define PCAP_FILE_WRAPPER_H
 
 #include "pcap-file.h"
+#include "pcapng-file.h"
 
 #include "ns3/nstime.h"
 #include "ns3/object.h"
@@ -75,9 +76,24 @@ class PcapFileWrapper : public Object
      *
      * \param mode String containing the access mode for the file.
      *
+     * The writes to a file opened with std::ios::out are buffered according
+     * to the WriteBufferSize and AsyncWrite attributes.
      */
     void Open(const std::string& filename, std::ios::openmode mode);
 
+    /**
+     * Write the packets to an interface of a PCAP-NG file, which may be
+     * shared with other PcapFileWrapper's, instead of a pcap file of
+     * their own.  The interface is added to the PCAP-NG file by Init(),
+     * and the packets are written by the Write() methods.  The methods
+     * reading the file, and the accessors of the pcap file header, are
+     * not available.
+     *
+     * \param file The PCAP-NG file.
+     * \param interfaceName The name of the interface.
+     */
+    void Open(Ptr<PcapNgFile> file, const std::string& interfaceName);
+
     /**
      * Close the underlying pcap file.
      */
@@ -222,9 +238,14 @@ class PcapFileWrapper : public Object
     uint32_t GetDataLinkType();
 
   private:
-    PcapFile m_file;    //!< Pcap file
-    uint32_t m_snapLen; //!< max length of saved packets
-    bool m_nanosecMode; //!< Timestamps in nanosecond mode
+    PcapFile m_file;            //!< Pcap file
+    Ptr<PcapNgFile> m_ngFile;   //!< PCAP-NG file, if written to an interface of it
+    std::string m_interface;    //!< Name of the interface of the PCAP-NG file
+    uint32_t m_interfaceId;     //!< Identifier of the interface of the PCAP-NG file
+    uint32_t m_snapLen;         //!< max length of saved packets
+    bool m_nanosecMode;         //!< Timestamps in nanosecond mode
+    uint32_t m_writeBufferSize; //!< Size of the write buffer
+    bool m_asyncWrite;          //!< Write the buffers in a background thread
 };
 
 } // namespace ns3
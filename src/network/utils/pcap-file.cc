@@ -28,8 +28,13 @@
 #include "ns3/log.h"
 #include "ns3/packet.h"
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
 //
 // This file is used as part of the ns-3 test framework, so please refrain from
@@ -51,10 +56,108 @@ const uint32_t NS_SWAPPED_MAGIC = 0x4d3cb2a1; /**< Looks this way if byte swappi
 const uint16_t VERSION_MAJOR = 2; /**< Major version of supported pcap file format */
 const uint16_t VERSION_MINOR = 4; /**< Minor version of supported pcap file format */
 
+namespace
+{
+
+/**
+ * \ingroup network
+ *
+ * Background thread writing the buffers of the pcap files in asynchronous
+ * mode.  The buffers are written in the order in which they are handed,
+ * hence the records of each file stay in order.
+ */
+class PcapWriterThread
+{
+  public:
+    /**
+     * \returns the writer thread, started on first use
+     */
+    static PcapWriterThread& Get()
+    {
+        // Never destroyed, so that the pcap files closed during the static
+        // destruction can still wait for their buffers.
+        static auto writer = new PcapWriterThread();
+        return *writer;
+    }
+
+    /**
+     * Queue a buffer to be written
+     * \param file the file to write to
+     * \param buffer the bytes to write
+     */
+    void Submit(std::fstream* file, std::vector<uint8_t>&& buffer)
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_jobs.push_back({file, std::move(buffer)});
+        }
+        m_wakeUp.notify_one();
+    }
+
+    /**
+     * Wait until all the buffers of a file are written
+     * \param file the file
+     */
+    void Wait(const std::fstream* file)
+    {
+        std::unique_lock lock(m_mutex);
+        m_done.wait(lock, [this, file]() {
+            return m_current != file &&
+                   std::none_of(m_jobs.begin(), m_jobs.end(), [file](const Job& job) {
+                       return job.file == file;
+                   });
+        });
+    }
+
+  private:
+    /// A buffer to write
+    struct Job
+    {
+        std::fstream* file;          //!< the file to write to
+        std::vector<uint8_t> buffer; //!< the bytes to write
+    };
+
+    PcapWriterThread()
+        : m_current(nullptr),
+          m_thread(&PcapWriterThread::Run, this)
+    {
+        m_thread.detach();
+    }
+
+    /// Write the buffers, forever
+    void Run()
+    {
+        std::unique_lock lock(m_mutex);
+        while (true)
+        {
+            m_wakeUp.wait(lock, [this]() { return !m_jobs.empty(); });
+            Job job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            m_current = job.file;
+            lock.unlock();
+            job.file->write(reinterpret_cast<const char*>(job.buffer.data()), job.buffer.size());
+            lock.lock();
+            m_current = nullptr;
+            m_done.notify_all();
+        }
+    }
+
+    std::mutex m_mutex;               //!< protects the members below
+    std::condition_variable m_wakeUp; //!< signals a new buffer
+    std::condition_variable m_done;   //!< signals a buffer written
+    std::deque<Job> m_jobs;           //!< the buffers to write
+    const std::fstream* m_current;    //!< the file being written
+    std::thread m_thread;             //!< the thread
+};
+
+} // namespace
+
 PcapFile::PcapFile()
     : m_file(),
       m_swapMode(false),
-      m_nanosecMode(false)
+      m_nanosecMode(false),
+      m_writeBufferSize(0),
+      m_asyncWrite(false)
 {
     NS_LOG_FUNCTION(this);
     FatalImpl::RegisterStream(&m_file);
@@ -71,6 +174,7 @@ bool
 PcapFile::Fail() const
 {
     NS_LOG_FUNCTION(this);
+    WaitForWrites();
     return m_file.fail();
 }
 
@@ -78,6 +182,7 @@ bool
 PcapFile::Eof() const
 {
     NS_LOG_FUNCTION(this);
+    WaitForWrites();
     return m_file.eof();
 }
 
@@ -85,6 +190,7 @@ void
 PcapFile::Clear()
 {
     NS_LOG_FUNCTION(this);
+    WaitForWrites();
     m_file.clear();
 }
 
@@ -92,9 +198,69 @@ void
 PcapFile::Close()
 {
     NS_LOG_FUNCTION(this);
+    FlushWriteBuffer();
+    WaitForWrites();
     m_file.close();
 }
 
+void
+PcapFile::SetWriteBuffer(uint32_t size, bool async)
+{
+    NS_LOG_FUNCTION(this << size << async);
+    FlushWriteBuffer();
+    WaitForWrites();
+    m_writeBufferSize = size;
+    m_asyncWrite = async && size > 0;
+    m_writeBuffer.reserve(size);
+}
+
+uint8_t*
+PcapFile::ReserveInWriteBuffer(uint32_t size)
+{
+    std::size_t offset = m_writeBuffer.size();
+    m_writeBuffer.resize(offset + size);
+    return m_writeBuffer.data() + offset;
+}
+
+void
+PcapFile::CheckWriteBuffer()
+{
+    if (m_writeBuffer.size() >= m_writeBufferSize)
+    {
+        FlushWriteBuffer();
+    }
+}
+
+void
+PcapFile::FlushWriteBuffer()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_writeBuffer.empty())
+    {
+        return;
+    }
+    if (m_asyncWrite)
+    {
+        PcapWriterThread::Get().Submit(&m_file, std::move(m_writeBuffer));
+        m_writeBuffer = std::vector<uint8_t>();
+        m_writeBuffer.reserve(m_writeBufferSize);
+    }
+    else
+    {
+        m_file.write(reinterpret_cast<const char*>(m_writeBuffer.data()), m_writeBuffer.size());
+        m_writeBuffer.clear();
+    }
+}
+
+void
+PcapFile::WaitForWrites() const
+{
+    if (m_asyncWrite)
+    {
+        PcapWriterThread::Get().Wait(&m_file);
+    }
+}
+
 uint32_t
 PcapFile::GetMagic()
 {
@@ -207,6 +373,8 @@ void
 PcapFile::WriteFileHeader()
 {
     NS_LOG_FUNCTION(this);
+    FlushWriteBuffer();
+    WaitForWrites();
     //
     // If we're initializing the file, we need to write the pcap file header
     // at the start of the file.
@@ -413,7 +581,7 @@ uint32_t
 PcapFile::WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << totalLen);
-    NS_ASSERT(m_file.good());
+    NS_ASSERT(m_asyncWrite || m_file.good());
 
     uint32_t inclLen = totalLen > m_fileHeader.m_snapLen ? m_fileHeader.m_snapLen : totalLen;
 
@@ -428,6 +596,16 @@ PcapFile::WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
         Swap(&header, &header);
     }
 
+    if (m_writeBufferSize > 0)
+    {
+        uint8_t* buffer = ReserveInWriteBuffer(16);
+        memcpy(buffer, &header.m_tsSec, sizeof(header.m_tsSec));
+        memcpy(buffer + 4, &header.m_tsUsec, sizeof(header.m_tsUsec));
+        memcpy(buffer + 8, &header.m_inclLen, sizeof(header.m_inclLen));
+        memcpy(buffer + 12, &header.m_origLen, sizeof(header.m_origLen));
+        return inclLen;
+    }
+
     //
     // Watch out for memory alignment differences between machines, so write
     // them all individually.
@@ -445,6 +623,12 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, const uint8_t* const data, uint
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << &data << totalLen);
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, totalLen);
+    if (m_writeBufferSize > 0)
+    {
+        memcpy(ReserveInWriteBuffer(inclLen), data, inclLen);
+        CheckWriteBuffer();
+        return;
+    }
     m_file.write((const char*)data, inclLen);
     NS_BUILD_DEBUG(m_file.flush());
 }
@@ -454,6 +638,12 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << p);
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, p->GetSize());
+    if (m_writeBufferSize > 0)
+    {
+        p->CopyData(ReserveInWriteBuffer(inclLen), inclLen);
+        CheckWriteBuffer();
+        return;
+    }
     p->CopyData(&m_file, inclLen);
     NS_BUILD_DEBUG(m_file.flush());
 }
@@ -470,6 +660,14 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, const Header& header, Ptr<const
     headerBuffer.AddAtStart(headerSize);
     header.Serialize(headerBuffer.Begin());
     uint32_t toCopy = std::min(headerSize, inclLen);
+    if (m_writeBufferSize > 0)
+    {
+        uint8_t* buffer = ReserveInWriteBuffer(inclLen);
+        headerBuffer.CopyData(buffer, toCopy);
+        p->CopyData(buffer + toCopy, inclLen - toCopy);
+        CheckWriteBuffer();
+        return;
+    }
     headerBuffer.CopyData(&m_file, toCopy);
     inclLen -= toCopy;
     p->CopyData(&m_file, inclLen);
@@ -25,6 +25,7 @@
 #include <fstream>
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 namespace ns3
 {
@@ -86,6 +87,26 @@ class PcapFile
      */
     void Close();
 
+    /**
+     * Buffer the records written to the file.
+     *
+     * The records are accumulated in a buffer of \p size bytes, which is
+     * written to the file once full, or when the file is closed.  In
+     * asynchronous mode, the full buffers are handed to a background
+     * thread, shared by all the pcap files, which writes them in the order
+     * in which they were filled.  The simulation thread then only copies
+     * the bytes of the records, up to the snapshot length, into the buffer.
+     *
+     * The file must have been opened in write mode.  The state of the file
+     * reported by Fail() and Eof() includes the writes of the background
+     * thread, which are waited for.
+     *
+     * \param size The size of the buffer, in bytes, or 0 to write the records
+     * directly to the file.
+     * \param async Whether the buffers are written by the background thread.
+     */
+    void SetWriteBuffer(uint32_t size, bool async);
+
     /**
      * Initialize the pcap file associated with this object.  This file must have
      * been previously opened with write permissions.
@@ -373,11 +394,36 @@ class PcapFile
      */
     void ReadAndVerifyFileHeader();
 
+    /**
+     * \brief Reserve room for a record in the write buffer
+     * \param size the number of bytes of the record
+     * \returns a pointer to the room reserved
+     */
+    uint8_t* ReserveInWriteBuffer(uint32_t size);
+    /**
+     * \brief Write the write buffer to the file if it is full
+     */
+    void CheckWriteBuffer();
+    /**
+     * \brief Write the write buffer to the file, or hand it to the background
+     * thread in asynchronous mode
+     */
+    void FlushWriteBuffer();
+    /**
+     * \brief Wait until the background thread has written all the buffers
+     * handed by this file
+     */
+    void WaitForWrites() const;
+
     std::string m_filename;      //!< file name
     std::fstream m_file;         //!< file stream
     PcapFileHeader m_fileHeader; //!< file header
     bool m_swapMode;             //!< swap mode
     bool m_nanosecMode;          //!< nanosecond timestamp mode
+
+    std::vector<uint8_t> m_writeBuffer; //!< records not yet written to the file
+    uint32_t m_writeBufferSize;         //!< size of the write buffer, 0 if disabled
+    bool m_asyncWrite;                  //!< the background thread writes the buffers
 };
 
 } // namespace ns3
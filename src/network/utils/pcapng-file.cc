@@ -0,0 +1,293 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "pcapng-file.h"
+
+#include "ns3/abort.h"
+#include "ns3/buffer.h"
+#include "ns3/header.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+
+#include <cstring>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PcapNgFile");
+
+namespace
+{
+
+const uint32_t SECTION_HEADER_BLOCK = 0x0a0d0d0a;        //!< Section Header Block type
+const uint32_t INTERFACE_DESCRIPTION_BLOCK = 0x00000001; //!< Interface Description Block type
+const uint32_t ENHANCED_PACKET_BLOCK = 0x00000006;       //!< Enhanced Packet Block type
+const uint32_t BYTE_ORDER_MAGIC = 0x1a2b3c4d;            //!< Byte order of the section
+
+const uint16_t OPT_ENDOFOPT = 0; //!< End of the options
+const uint16_t IF_NAME = 2;      //!< Name of the interface
+const uint16_t IF_TSRESOL = 9;   //!< Resolution of the time stamps of the interface
+
+const uint32_t FLUSH_SIZE = 1 << 20; //!< Bytes of blocks accumulated before being written
+
+/**
+ * \param size a number of bytes
+ * \returns \p size rounded up to a multiple of 4
+ */
+inline uint32_t
+Pad(uint32_t size)
+{
+    return (size + 3) & ~3U;
+}
+
+/**
+ * \brief Write a 32 bits value, in host byte order as recorded by the section
+ * \param buffer the bytes to write to
+ * \param value the value
+ */
+inline void
+WriteU32(uint8_t* buffer, uint32_t value)
+{
+    memcpy(buffer, &value, sizeof(value));
+}
+
+} // namespace
+
+PcapNgFile::PcapNgFile()
+    : m_gzFile(nullptr),
+      m_fail(false)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PcapNgFile::~PcapNgFile()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+bool
+PcapNgFile::IsCompressionSupported()
+{
+#ifdef HAVE_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+void
+PcapNgFile::Open(const std::string& filename, bool compress)
+{
+    NS_LOG_FUNCTION(this << filename << compress);
+    NS_ABORT_MSG_IF(compress && !IsCompressionSupported(),
+                    "Compressed PCAP-NG files need ns-3 to be built with zlib");
+    Close();
+    m_fail = false;
+    m_snapLen.clear();
+#ifdef HAVE_ZLIB
+    if (compress)
+    {
+        m_gzFile = gzopen(filename.c_str(), "wb");
+        m_fail = m_gzFile == nullptr;
+    }
+#endif
+    if (!compress)
+    {
+        m_file.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+        m_fail = m_file.fail();
+    }
+
+    uint8_t* block = Reserve(28);
+    WriteU32(block, SECTION_HEADER_BLOCK);
+    WriteU32(block + 4, 28);
+    WriteU32(block + 8, BYTE_ORDER_MAGIC);
+    uint16_t versionMajor = 1;
+    uint16_t versionMinor = 0;
+    memcpy(block + 12, &versionMajor, sizeof(versionMajor));
+    memcpy(block + 14, &versionMinor, sizeof(versionMinor));
+    // unknown section length
+    int64_t sectionLength = -1;
+    memcpy(block + 16, &sectionLength, sizeof(sectionLength));
+    WriteU32(block + 24, 28);
+}
+
+void
+PcapNgFile::Close()
+{
+    NS_LOG_FUNCTION(this);
+    Flush();
+#ifdef HAVE_ZLIB
+    if (m_gzFile != nullptr)
+    {
+        m_fail = m_fail || gzclose(static_cast<gzFile>(m_gzFile)) != Z_OK;
+        m_gzFile = nullptr;
+    }
+#endif
+    if (m_file.is_open())
+    {
+        m_file.close();
+    }
+}
+
+bool
+PcapNgFile::Fail() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_fail;
+}
+
+uint32_t
+PcapNgFile::AddInterface(const std::string& name, uint32_t dataLinkType, uint32_t snapLen)
+{
+    NS_LOG_FUNCTION(this << name << dataLinkType << snapLen);
+    std::size_t start = m_buffer.size();
+    uint8_t* block = Reserve(16);
+    WriteU32(block, INTERFACE_DESCRIPTION_BLOCK);
+    uint16_t linkType = dataLinkType;
+    memcpy(block + 8, &linkType, sizeof(linkType));
+    WriteU32(block + 12, snapLen);
+    WriteOption(IF_NAME, name.data(), name.size());
+    // time stamps in nanoseconds
+    uint8_t resolution = 9;
+    WriteOption(IF_TSRESOL, &resolution, sizeof(resolution));
+    WriteOption(OPT_ENDOFOPT, nullptr, 0);
+    uint32_t blockLength = m_buffer.size() + 4 - start;
+    WriteU32(Reserve(4), blockLength);
+    WriteU32(m_buffer.data() + start + 4, blockLength);
+
+    m_snapLen.push_back(snapLen);
+    return m_snapLen.size() - 1;
+}
+
+uint32_t
+PcapNgFile::GetNInterfaces() const
+{
+    return m_snapLen.size();
+}
+
+void
+PcapNgFile::Write(uint32_t interfaceId, Time t, const uint8_t* data, uint32_t totalLen)
+{
+    NS_LOG_FUNCTION(this << interfaceId << t << &data << totalLen);
+    uint32_t inclLen;
+    uint8_t* buffer = StartPacketBlock(interfaceId, t, totalLen, inclLen);
+    memcpy(buffer, data, inclLen);
+    CheckBuffer();
+}
+
+void
+PcapNgFile::Write(uint32_t interfaceId, Time t, Ptr<const Packet> p)
+{
+    NS_LOG_FUNCTION(this << interfaceId << t << p);
+    uint32_t inclLen;
+    uint8_t* buffer = StartPacketBlock(interfaceId, t, p->GetSize(), inclLen);
+    p->CopyData(buffer, inclLen);
+    CheckBuffer();
+}
+
+void
+PcapNgFile::Write(uint32_t interfaceId, Time t, const Header& header, Ptr<const Packet> p)
+{
+    NS_LOG_FUNCTION(this << interfaceId << t << &header << p);
+    uint32_t headerSize = header.GetSerializedSize();
+    uint32_t inclLen;
+    uint8_t* buffer = StartPacketBlock(interfaceId, t, headerSize + p->GetSize(), inclLen);
+
+    Buffer headerBuffer;
+    headerBuffer.AddAtStart(headerSize);
+    header.Serialize(headerBuffer.Begin());
+    uint32_t toCopy = std::min(headerSize, inclLen);
+    headerBuffer.CopyData(buffer, toCopy);
+    p->CopyData(buffer + toCopy, inclLen - toCopy);
+    CheckBuffer();
+}
+
+uint8_t*
+PcapNgFile::StartPacketBlock(uint32_t interfaceId, Time t, uint32_t totalLen, uint32_t& inclLen)
+{
+    NS_ASSERT_MSG(interfaceId < m_snapLen.size(), "Unknown interface " << interfaceId);
+    inclLen = std::min(totalLen, m_snapLen[interfaceId]);
+    uint32_t blockLength = 32 + Pad(inclLen);
+    uint8_t* block = Reserve(blockLength);
+    WriteU32(block, ENHANCED_PACKET_BLOCK);
+    WriteU32(block + 4, blockLength);
+    WriteU32(block + 8, interfaceId);
+    uint64_t timestamp = t.GetNanoSeconds();
+    WriteU32(block + 12, timestamp >> 32);
+    WriteU32(block + 16, timestamp & 0xffffffff);
+    WriteU32(block + 20, inclLen);
+    WriteU32(block + 24, totalLen);
+    WriteU32(block + blockLength - 4, blockLength);
+    return block + 28;
+}
+
+uint8_t*
+PcapNgFile::Reserve(uint32_t size)
+{
+    std::size_t offset = m_buffer.size();
+    m_buffer.resize(offset + size);
+    return m_buffer.data() + offset;
+}
+
+void
+PcapNgFile::WriteOption(uint16_t code, const void* value, uint16_t length)
+{
+    uint8_t* option = Reserve(4 + Pad(length));
+    memcpy(option, &code, sizeof(code));
+    memcpy(option + 2, &length, sizeof(length));
+    if (length > 0)
+    {
+        memcpy(option + 4, value, length);
+    }
+}
+
+void
+PcapNgFile::CheckBuffer()
+{
+    if (m_buffer.size() >= FLUSH_SIZE)
+    {
+        Flush();
+    }
+}
+
+void
+PcapNgFile::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_buffer.empty())
+    {
+        return;
+    }
+#ifdef HAVE_ZLIB
+    if (m_gzFile != nullptr)
+    {
+        int written = gzwrite(static_cast<gzFile>(m_gzFile), m_buffer.data(), m_buffer.size());
+        m_fail = m_fail || written != static_cast<int>(m_buffer.size());
+    }
+#endif
+    if (m_file.is_open())
+    {
+        m_file.write(reinterpret_cast<const char*>(m_buffer.data()), m_buffer.size());
+        m_fail = m_fail || m_file.fail();
+    }
+    m_buffer.clear();
+}
+
+} // namespace ns3
@@ -0,0 +1,172 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PCAPNG_FILE_H
+#define PCAPNG_FILE_H
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+class Header;
+class Packet;
+
+/**
+ * \ingroup network
+ *
+ * \brief A PCAP-NG file, in which the packets of several interfaces are
+ * written.
+ *
+ * The file holds a single section.  Each interface added to the file
+ * is described by an Interface Description Block, which records its
+ * name, data link type and snapshot length, and each packet is written
+ * in an Enhanced Packet Block, which refers to its interface.  The time
+ * stamps have a nanosecond resolution.
+ *
+ * The blocks are accumulated in memory and written to the file in large
+ * chunks.  The file can be compressed with gzip, when ns-3 is built with
+ * zlib, which Wireshark and tcpdump read directly.
+ *
+ * See the PCAP-NG specification, draft-ietf-opsawg-pcapng.
+ */
+class PcapNgFile : public SimpleRefCount<PcapNgFile>
+{
+  public:
+    PcapNgFile();
+    ~PcapNgFile();
+
+    /**
+     * \returns true if ns-3 is built with zlib, hence can compress the files.
+     */
+    static bool IsCompressionSupported();
+
+    /**
+     * Create a new PCAP-NG file, and write its Section Header Block.
+     *
+     * \param filename the name of the file.
+     * \param compress whether the file is compressed with gzip.
+     */
+    void Open(const std::string& filename, bool compress = false);
+
+    /**
+     * Write the pending blocks, and close the file.
+     */
+    void Close();
+
+    /**
+     * \returns true if the file could not be opened or written, false otherwise.
+     */
+    bool Fail() const;
+
+    /**
+     * Add an interface to the file, and write its Interface Description Block.
+     *
+     * \param name the name of the interface.
+     * \param dataLinkType the data link type of the packets of the interface,
+     * as defined in the pcap library.
+     * \param snapLen the maximum number of bytes of the packets written.
+     * \returns the identifier of the interface in the file.
+     */
+    uint32_t AddInterface(const std::string& name, uint32_t dataLinkType, uint32_t snapLen);
+
+    /**
+     * \returns the number of interfaces added to the file.
+     */
+    uint32_t GetNInterfaces() const;
+
+    /**
+     * \brief Write an Enhanced Packet Block
+     *
+     * \param interfaceId the identifier of the interface of the packet.
+     * \param t the time stamp of the packet.
+     * \param data the data of the packet.
+     * \param totalLen the size of the packet.
+     */
+    void Write(uint32_t interfaceId, Time t, const uint8_t* data, uint32_t totalLen);
+
+    /**
+     * \brief Write an Enhanced Packet Block
+     *
+     * \param interfaceId the identifier of the interface of the packet.
+     * \param t the time stamp of the packet.
+     * \param p the packet.
+     */
+    void Write(uint32_t interfaceId, Time t, Ptr<const Packet> p);
+
+    /**
+     * \brief Write an Enhanced Packet Block
+     *
+     * \param interfaceId the identifier of the interface of the packet.
+     * \param t the time stamp of the packet.
+     * \param header a header written before the packet.
+     * \param p the packet.
+     */
+    void Write(uint32_t interfaceId, Time t, const Header& header, Ptr<const Packet> p);
+
+  private:
+    /**
+     * \brief Start an Enhanced Packet Block
+     *
+     * \param interfaceId the identifier of the interface of the packet.
+     * \param t the time stamp of the packet.
+     * \param totalLen the size of the packet.
+     * \param [out] inclLen the number of bytes of the packet to write.
+     * \returns a pointer to the room for the bytes of the packet.
+     */
+    uint8_t* StartPacketBlock(uint32_t interfaceId, Time t, uint32_t totalLen, uint32_t& inclLen);
+
+    /**
+     * \brief Reserve room for a block
+     * \param size the number of bytes of the block
+     * \returns a pointer to the room reserved, zeroed
+     */
+    uint8_t* Reserve(uint32_t size);
+
+    /**
+     * \brief Write an option
+     * \param code the code of the option
+     * \param value the value of the option
+     * \param length the length of the value
+     */
+    void WriteOption(uint16_t code, const void* value, uint16_t length);
+
+    /**
+     * \brief Write the pending blocks to the file if there are enough of them
+     */
+    void CheckBuffer();
+
+    /**
+     * \brief Write the pending blocks to the file
+     */
+    void Flush();
+
+    std::ofstream m_file;            //!< the file, when not compressed
+    void* m_gzFile;                  //!< the gzFile, when compressed
+    bool m_fail;                     //!< whether the file could not be opened or written
+    std::vector<uint8_t> m_buffer;   //!< the blocks not yet written
+    std::vector<uint32_t> m_snapLen; //!< the snapshot length of each interface
+};
+
+} // namespace ns3
+
+#endif /* PCAPNG_FILE_H */
@@ -35,6 +35,7 @@
 #include <sstream>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 namespace ns3
 {
@@ -304,6 +305,16 @@ class Queue : public QueueBase
      */
     virtual Ptr<const Item> Peek() const = 0;
 
+    /**
+     * Remove up to \p maxItems items from the Queue by calling Dequeue()
+     * repeatedly, as a single operation for the caller. The items are counted
+     * and traced as dequeued, one by one.
+     * \param maxItems the maximum number of items to dequeue
+     * \param [out] items the vector to which the items dequeued are appended
+     * \return the number of items dequeued
+     */
+    uint32_t DequeueBatch(uint32_t maxItems, std::vector<Ptr<Item>>& items);
+
     /**
      * Flush the queue by calling Remove() on each item enqueued.  Note that
      * this operation will cause dequeue and drop counts to be incremented and
@@ -385,6 +396,15 @@ class Queue : public QueueBase
      */
     void DropAfterDequeue(Ptr<Item> item);
 
+    /**
+     * Insert an item restored from a checkpoint at the tail of the queue,
+     * without firing the trace sources.  The received and dropped
+     * statistics are restored separately.
+     *
+     * \param item the item
+     */
+    void RestoreItem(Ptr<Item> item);
+
     /** \copydoc ns3::Object::DoDispose */
     void DoDispose() override;
 
@@ -603,6 +623,25 @@ Queue<Item, Container>::DoRemove(ConstIterator pos)
     return item;
 }
 
+template <typename Item, typename Container>
+uint32_t
+Queue<Item, Container>::DequeueBatch(uint32_t maxItems, std::vector<Ptr<Item>>& items)
+{
+    NS_LOG_FUNCTION(this << maxItems);
+    uint32_t n = 0;
+    while (n < maxItems)
+    {
+        Ptr<Item> item = Dequeue();
+        if (!item)
+        {
+            break;
+        }
+        items.push_back(item);
+        n++;
+    }
+    return n;
+}
+
 template <typename Item, typename Container>
 void
 Queue<Item, Container>::Flush()
@@ -670,6 +709,16 @@ Queue<Item, Container>::DropAfterDequeue(Ptr<Item> item)
     m_traceDropAfterDequeue(item);
 }
 
+template <typename Item, typename Container>
+void
+Queue<Item, Container>::RestoreItem(Ptr<Item> item)
+{
+    NS_LOG_FUNCTION(this << item);
+    m_packets.insert(GetContainer().end(), item);
+    m_nBytes += item->GetSize();
+    m_nPackets++;
+}
+
 // The following explicit template instantiation declarations prevent all the
 // translation units including this header file to implicitly instantiate the
 // Queue<Packet> class and the Queue<QueueDiscItem> class. The unique instances
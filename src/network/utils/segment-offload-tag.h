@@ -0,0 +1,88 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef SEGMENT_OFFLOAD_TAG_H
+#define SEGMENT_OFFLOAD_TAG_H
+
+#include "ns3/tag.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup network
+ *
+ * \brief Packet tag of a super-segment, sent at once in place of several segments
+ *
+ * With the emulation of the segmentation offload (TSO/GRO), a transport
+ * protocol sends several consecutive segments as a single super-segment,
+ * which crosses the stack and the channels as one packet.  The tag carries
+ * the number of segments replaced by the super-segment, and the size of the
+ * headers which each of these segments would have carried.  The network
+ * layers do not fragment a tagged packet, and the devices account for the
+ * headers of all the segments in the transmission time of the packet.
+ */
+class SegmentOffloadTag : public Tag
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+    uint32_t GetSerializedSize() const override;
+    void Serialize(TagBuffer buf) const override;
+    void Deserialize(TagBuffer buf) override;
+    void Print(std::ostream& os) const override;
+    SegmentOffloadTag();
+
+    /**
+     * Constructs a SegmentOffloadTag
+     *
+     * \param segments the number of segments of the super-segment
+     * \param headerSize the size of the headers of each segment
+     */
+    SegmentOffloadTag(uint16_t segments, uint16_t headerSize);
+
+    /**
+     * \returns the number of segments of the super-segment
+     */
+    uint16_t GetSegments() const;
+
+    /**
+     * \returns the size of the headers of each segment
+     */
+    uint16_t GetHeaderSize() const;
+
+    /**
+     * \brief Get the size of a super-segment on the wire
+     *
+     * The headers of the network and transport layers, and the framing
+     * overhead of the device, are counted once per segment.
+     *
+     * \param size the size of the packet, with the headers of one segment
+     * \param framing the framing overhead of the device, per segment
+     * \returns the number of bytes to transmit
+     */
+    uint32_t GetWireSize(uint32_t size, uint32_t framing) const;
+
+  private:
+    uint16_t m_segments;   //!< Number of segments
+    uint16_t m_headerSize; //!< Size of the headers of each segment
+};
+
+} // namespace ns3
+
+#endif /* SEGMENT_OFFLOAD_TAG_H */
@@ -19,6 +19,7 @@
 
 #include "point-to-point-net-device.h"
 
+#include "ns3/event-impl.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
@@ -31,6 +32,52 @@ NS_LOG_COMPONENT_DEFINE("PointToPointChannel");
 
 NS_OBJECT_ENSURE_REGISTERED(PointToPointChannel);
 
+namespace
+{
+
+/**
+ * \ingroup point-to-point
+ * The reception of a packet at the end of a wire.
+ *
+ * The deliveries are found by their type among the pending events when
+ * saving a checkpoint, so the channel does not need to track them.
+ */
+class PointToPointDelivery : public EventImpl
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] channel The channel.
+     * \param [in] wire The wire.
+     * \param [in] dst The receiving device.
+     * \param [in] packet The packet.
+     */
+    PointToPointDelivery(const PointToPointChannel* channel,
+                         uint32_t wire,
+                         Ptr<PointToPointNetDevice> dst,
+                         Ptr<Packet> packet)
+        : m_channel(channel),
+          m_wire(wire),
+          m_dst(dst),
+          m_packet(packet)
+    {
+    }
+
+    const PointToPointChannel* m_channel; //!< The channel.
+    uint32_t m_wire;                      //!< The wire.
+    Ptr<PointToPointNetDevice> m_dst;     //!< The receiving device.
+    Ptr<Packet> m_packet;                 //!< The packet.
+
+  private:
+    void Notify() override
+    {
+        m_dst->Receive(m_packet);
+    }
+};
+
+} // unnamed namespace
+
 TypeId
 PointToPointChannel::GetTypeId()
 {
@@ -96,11 +143,10 @@ PointToPointChannel::TransmitStart(Ptr<const Packet> p, Ptr<PointToPointNetDevic
 
     uint32_t wire = src == m_link[0].m_src ? 0 : 1;
 
-    Simulator::ScheduleWithContext(m_link[wire].m_dst->GetNode()->GetId(),
-                                   txTime + m_delay,
-                                   &PointToPointNetDevice::Receive,
-                                   m_link[wire].m_dst,
-                                   p->Copy());
+    Simulator::ScheduleWithContext(
+        m_link[wire].m_dst->GetNode()->GetId(),
+        txTime + m_delay,
+        new PointToPointDelivery(this, wire, m_link[wire].m_dst, p->Copy()));
 
     // Call the tx anim callback on the net device
     m_txrxPointToPoint(p, src, m_link[wire].m_dst, txTime, txTime + m_delay);
@@ -129,6 +175,43 @@ PointToPointChannel::GetDevice(std::size_t i) const
     return GetPointToPointDevice(i);
 }
 
+void
+PointToPointChannel::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    uint32_t n = 0;
+    for (const auto& id : writer.GetPendingEvents())
+    {
+        auto delivery = dynamic_cast<const PointToPointDelivery*>(id.PeekEventImpl());
+        if (delivery != nullptr && delivery->m_channel == this)
+        {
+            std::string key = "delivery." + std::to_string(n++);
+            writer.Write(key + ".wire", delivery->m_wire);
+            WritePacket(writer, key + ".packet", delivery->m_packet);
+            writer.WriteEvent(key, id);
+        }
+    }
+    writer.Write("deliveries", n);
+}
+
+void
+PointToPointChannel::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    auto n = reader.Read<uint32_t>("deliveries");
+    for (uint32_t i = 0; i < n; i++)
+    {
+        std::string key = "delivery." + std::to_string(i);
+        auto wire = reader.Read<uint32_t>(key + ".wire");
+        NS_ABORT_MSG_IF(wire >= N_DEVICES, "Invalid wire " << wire << " in " << reader.GetPath());
+        reader.ReadEventImpl(key,
+                             new PointToPointDelivery(this,
+                                                      wire,
+                                                      m_link[wire].m_dst,
+                                                      ReadPacket(reader, key + ".packet")));
+    }
+}
+
 Time
 PointToPointChannel::GetDelay() const
 {
@@ -19,6 +19,7 @@
 #define POINT_TO_POINT_CHANNEL_H
 
 #include "ns3/channel.h"
+#include "ns3/checkpoint.h"
 #include "ns3/data-rate.h"
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
@@ -45,10 +46,13 @@ class Packet;
  * [0] wire to transmit on.  The second device gets the [1] wire.  There is a
  * state (IDLE, TRANSMITTING) associated with each wire.
  *
+ * The packets in flight are saved in the checkpoints, and their
+ * reception is restored with their original time and order.
+ *
  * \see Attach
  * \see TransmitStart
  */
-class PointToPointChannel : public Channel
+class PointToPointChannel : public Channel, public Checkpointable
 {
   public:
     /**
@@ -101,6 +105,10 @@ class PointToPointChannel : public Channel
      */
     Ptr<NetDevice> GetDevice(std::size_t i) const override;
 
+    // Inherited from Checkpointable
+    void SaveState(CheckpointWriter& writer) const override;
+    void RestoreState(CheckpointReader& reader) override;
+
   protected:
     /**
      * \brief Get the delay associated with this channel
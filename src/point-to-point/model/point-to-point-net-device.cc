@@ -24,8 +24,10 @@
 #include "ns3/llc-snap-header.h"
 #include "ns3/log.h"
 #include "ns3/mac48-address.h"
+#include "ns3/packet-burst.h"
 #include "ns3/pointer.h"
 #include "ns3/queue.h"
+#include "ns3/segment-offload-tag.h"
 #include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
@@ -71,6 +73,12 @@ PointToPointNetDevice::GetTypeId()
                           TimeValue(Seconds(0.0)),
                           MakeTimeAccessor(&PointToPointNetDevice::m_tInterframeGap),
                           MakeTimeChecker())
+            .AddAttribute("TxBurstSize",
+                          "The maximum number of packets dequeued at once and transmitted "
+                          "back to back, with a single transmit complete event",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&PointToPointNetDevice::m_txBurstSize),
+                          MakeUintegerChecker<uint32_t>(1))
 
             //
             // Transmit queueing discipline for the device which includes its own set
@@ -215,6 +223,7 @@ PointToPointNetDevice::DoDispose()
     m_channel = nullptr;
     m_receiveErrorModel = nullptr;
     m_currentPkt = nullptr;
+    m_burstPkts.clear();
     m_queue = nullptr;
     NetDevice::DoDispose();
 }
@@ -249,20 +258,63 @@ PointToPointNetDevice::TransmitStart(Ptr<Packet> p)
     m_currentPkt = p;
     m_phyTxBeginTrace(m_currentPkt);
 
-    Time txTime = m_bps.CalculateBytesTxTime(p->GetSize());
+    Time txTime = GetTxTime(p);
     Time txCompleteTime = txTime + m_tInterframeGap;
 
+    //
+    // In burst mode, the packets waiting in the queue are sent back to back
+    // after this one, each of them ending its transmission when it would have
+    // without bursts, and the transmission is complete at the end of the burst.
+    //
+    std::vector<Time> burstTxTimes;
+    if (m_txBurstSize > 1)
+    {
+        m_queue->DequeueBatch(m_txBurstSize - 1, m_burstPkts);
+        burstTxTimes.reserve(m_burstPkts.size());
+        for (const auto& packet : m_burstPkts)
+        {
+            Time packetTxTime = GetTxTime(packet);
+            burstTxTimes.push_back(txCompleteTime + packetTxTime);
+            txCompleteTime += packetTxTime + m_tInterframeGap;
+        }
+    }
+
     NS_LOG_LOGIC("Schedule TransmitCompleteEvent in " << txCompleteTime.As(Time::S));
-    Simulator::Schedule(txCompleteTime, &PointToPointNetDevice::TransmitComplete, this);
+    m_transmitCompleteEvent =
+        Simulator::Schedule(txCompleteTime, &PointToPointNetDevice::TransmitComplete, this);
 
     bool result = m_channel->TransmitStart(p, this, txTime);
     if (!result)
     {
         m_phyTxDropTrace(p);
     }
+
+    for (std::size_t i = 0; i < m_burstPkts.size(); i++)
+    {
+        m_snifferTrace(m_burstPkts[i]);
+        m_promiscSnifferTrace(m_burstPkts[i]);
+        m_phyTxBeginTrace(m_burstPkts[i]);
+        if (!m_channel->TransmitStart(m_burstPkts[i], this, burstTxTimes[i]))
+        {
+            m_phyTxDropTrace(m_burstPkts[i]);
+        }
+    }
     return result;
 }
 
+Time
+PointToPointNetDevice::GetTxTime(Ptr<const Packet> p) const
+{
+    SegmentOffloadTag offloadTag;
+    if (p->PeekPacketTag(offloadTag))
+    {
+        PppHeader ppp;
+        return m_bps.CalculateBytesTxTime(
+            offloadTag.GetWireSize(p->GetSize(), ppp.GetSerializedSize()));
+    }
+    return m_bps.CalculateBytesTxTime(p->GetSize());
+}
+
 void
 PointToPointNetDevice::TransmitComplete()
 {
@@ -281,6 +333,11 @@ PointToPointNetDevice::TransmitComplete()
 
     m_phyTxEndTrace(m_currentPkt);
     m_currentPkt = nullptr;
+    for (const auto& packet : m_burstPkts)
+    {
+        m_phyTxEndTrace(packet);
+    }
+    m_burstPkts.clear();
 
     Ptr<Packet> p = m_queue->Dequeue();
     if (!p)
@@ -356,9 +413,13 @@ PointToPointNetDevice::Receive(Ptr<Packet> packet)
 
         //
         // Trace sinks will expect complete packets, not packets without some of the
-        // headers.
+        // headers.  Only copy the packet if a trace sink is connected.
         //
-        Ptr<Packet> originalPacket = packet->Copy();
+        Ptr<Packet> originalPacket;
+        if (!m_macPromiscRxTrace.IsEmpty() || !m_macRxTrace.IsEmpty())
+        {
+            originalPacket = packet->Copy();
+        }
 
         //
         // Strip off the point-to-point protocol header and forward this packet
@@ -559,6 +620,55 @@ PointToPointNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t pr
     return false;
 }
 
+uint32_t
+PointToPointNetDevice::SendMany(Ptr<PacketBurst> burst,
+                                const Address& dest,
+                                uint16_t protocolNumber)
+{
+    NS_LOG_FUNCTION(this << burst << dest << protocolNumber);
+
+    if (!IsLinkUp())
+    {
+        for (auto i = burst->Begin(); i != burst->End(); ++i)
+        {
+            m_macTxDropTrace(*i);
+        }
+        return 0;
+    }
+
+    //
+    // Enqueue all the packets before starting the transmission, so that the
+    // transmission of a burst starts with all of them in the queue.
+    //
+    uint32_t sent = 0;
+    for (auto i = burst->Begin(); i != burst->End(); ++i)
+    {
+        Ptr<Packet> packet = *i;
+        AddHeader(packet, protocolNumber);
+        m_macTxTrace(packet);
+        if (m_queue->Enqueue(packet))
+        {
+            sent++;
+        }
+        else
+        {
+            m_macTxDropTrace(packet);
+        }
+    }
+
+    if (m_txMachineState == READY)
+    {
+        Ptr<Packet> packet = m_queue->Dequeue();
+        if (packet)
+        {
+            m_snifferTrace(packet);
+            m_promiscSnifferTrace(packet);
+            TransmitStart(packet);
+        }
+    }
+    return sent;
+}
+
 bool
 PointToPointNetDevice::SendFrom(Ptr<Packet> packet,
                                 const Address& source,
@@ -608,6 +718,41 @@ PointToPointNetDevice::SupportsSendFrom() const
     return false;
 }
 
+void
+PointToPointNetDevice::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    writer.Write("busy", m_txMachineState == BUSY);
+    if (m_txMachineState == BUSY)
+    {
+        WritePacket(writer, "currentPacket", m_currentPkt);
+        writer.Write("burstPackets", static_cast<uint32_t>(m_burstPkts.size()));
+        for (std::size_t i = 0; i < m_burstPkts.size(); i++)
+        {
+            WritePacket(writer, "burstPacket" + std::to_string(i), m_burstPkts[i]);
+        }
+        writer.WriteEvent("transmitComplete", m_transmitCompleteEvent);
+    }
+}
+
+void
+PointToPointNetDevice::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    m_txMachineState = reader.Read<bool>("busy") ? BUSY : READY;
+    if (m_txMachineState == BUSY)
+    {
+        m_currentPkt = ReadPacket(reader, "currentPacket");
+        m_burstPkts.resize(reader.Read<uint32_t>("burstPackets", 0));
+        for (std::size_t i = 0; i < m_burstPkts.size(); i++)
+        {
+            m_burstPkts[i] = ReadPacket(reader, "burstPacket" + std::to_string(i));
+        }
+        m_transmitCompleteEvent =
+            reader.ReadEvent("transmitComplete", &PointToPointNetDevice::TransmitComplete, this);
+    }
+}
+
 void
 PointToPointNetDevice::DoMpiReceive(Ptr<Packet> p)
 {
@@ -20,7 +20,9 @@
 
 #include "ns3/address.h"
 #include "ns3/callback.h"
+#include "ns3/checkpoint.h"
 #include "ns3/data-rate.h"
+#include "ns3/event-id.h"
 #include "ns3/mac48-address.h"
 #include "ns3/net-device.h"
 #include "ns3/node.h"
@@ -31,6 +33,7 @@
 #include "ns3/traced-callback.h"
 
 #include <cstring>
+#include <vector>
 
 namespace ns3
 {
@@ -59,8 +62,15 @@ class ErrorModel;
  * Key parameters or objects that can be specified for this device
  * include a queue, data rate, and interframe transmission gap (the
  * propagation delay is set in the PointToPointChannel).
+ *
+ * When the TxBurstSize attribute is greater than one, the packets waiting
+ * in the queue when a transmission starts are dequeued at once, up to
+ * TxBurstSize packets, and transmitted back to back with a single transmit
+ * complete event.  Each packet is received at the same time as without
+ * bursts, but leaves the queue, and hits the PhyTxBegin and PhyTxEnd trace
+ * sources, at the start and at the end of the burst.
  */
-class PointToPointNetDevice : public NetDevice
+class PointToPointNetDevice : public NetDevice, public Checkpointable
 {
   public:
     /**
@@ -185,6 +195,9 @@ class PointToPointNetDevice : public NetDevice
                   const Address& source,
                   const Address& dest,
                   uint16_t protocolNumber) override;
+    uint32_t SendMany(Ptr<PacketBurst> burst,
+                      const Address& dest,
+                      uint16_t protocolNumber) override;
 
     Ptr<Node> GetNode() const override;
     void SetNode(Ptr<Node> node) override;
@@ -198,6 +211,10 @@ class PointToPointNetDevice : public NetDevice
     void SetPromiscReceiveCallback(PromiscReceiveCallback cb) override;
     bool SupportsSendFrom() const override;
 
+    // Inherited from Checkpointable
+    void SaveState(CheckpointWriter& writer) const override;
+    void RestoreState(CheckpointReader& reader) override;
+
   protected:
     /**
      * \brief Handler for MPI receive event
@@ -244,7 +261,9 @@ class PointToPointNetDevice : public NetDevice
      * the channel.  The corresponding method is called on the channel to let
      * it know that the physical device this class represents has virtually
      * started sending signals.  An event is scheduled for the time at which
-     * the bits have been completely transmitted.
+     * the bits have been completely transmitted.  With bursts, the packets
+     * waiting in the queue are sent after this packet, and the event is
+     * scheduled at the end of the burst.
      *
      * \see PointToPointChannel::TransmitStart ()
      * \see TransmitComplete()
@@ -261,6 +280,17 @@ class PointToPointNetDevice : public NetDevice
      */
     void TransmitComplete();
 
+    /**
+     * \brief Get the transmission time of a packet
+     *
+     * The super-segments of the segmentation offload, see SegmentOffloadTag,
+     * are transmitted as their segments back to back, each with its headers.
+     *
+     * \param p the packet
+     * \returns the transmission time of the packet
+     */
+    Time GetTxTime(Ptr<const Packet> p) const;
+
     /**
      * \brief Make the link up and running
      *
@@ -294,6 +324,12 @@ class PointToPointNetDevice : public NetDevice
      */
     Time m_tInterframeGap;
 
+    /**
+     * The maximum number of packets transmitted back to back with a single
+     * transmit complete event
+     */
+    uint32_t m_txBurstSize;
+
     /**
      * The PointToPointChannel to which this PointToPointNetDevice has been
      * attached.
@@ -442,7 +478,9 @@ class PointToPointNetDevice : public NetDevice
      */
     uint32_t m_mtu;
 
-    Ptr<Packet> m_currentPkt; //!< Current packet processed
+    Ptr<Packet> m_currentPkt;             //!< Current packet processed
+    std::vector<Ptr<Packet>> m_burstPkts; //!< Packets sent after the current packet in the burst
+    EventId m_transmitCompleteEvent;      //!< End of the transmission of the current packet
 
     /**
      * \brief PPP to Ethernet protocol number mapping
@@ -19,12 +19,16 @@
 
 #include "ns3/drop-tail-queue.h"
 #include "ns3/net-device-queue-interface.h"
+#include "ns3/packet-burst.h"
 #include "ns3/point-to-point-channel.h"
 #include "ns3/point-to-point-net-device.h"
+#include "ns3/segment-offload-tag.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
 
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -139,6 +143,252 @@ PointToPointTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \brief Test class for the bursts of the PointToPoint model
+ *
+ * It sends several packets at once, with and without bursts, and checks
+ * that they are received at the same time with fewer events.
+ */
+class PointToPointBurstTest : public TestCase
+{
+  public:
+    /**
+     * \brief Create the test
+     */
+    PointToPointBurstTest();
+
+    /**
+     * \brief Run the test
+     */
+    void DoRun() override;
+
+  private:
+    /**
+     * \brief Send packets over a link
+     *
+     * \param burstSize The value of the TxBurstSize attribute of the devices.
+     * \param [out] rxTimes The times at which the packets are received.
+     * \returns the number of events executed.
+     */
+    uint64_t SendPackets(uint32_t burstSize, std::vector<Time>& rxTimes);
+
+    /**
+     * \brief Callback function which records the reception time
+     *
+     * \param rxTimes The times at which the packets are received.
+     * \param dev The receiving device.
+     * \param pkt The received packet.
+     * \param mode The protocol mode used.
+     * \param sender The sender address.
+     *
+     * \return A boolean indicating packet handled properly.
+     */
+    static bool RxPacket(std::vector<Time>* rxTimes,
+                         Ptr<NetDevice> dev,
+                         Ptr<const Packet> pkt,
+                         uint16_t mode,
+                         const Address& sender);
+};
+
+PointToPointBurstTest::PointToPointBurstTest()
+    : TestCase("PointToPoint bursts")
+{
+}
+
+bool
+PointToPointBurstTest::RxPacket(std::vector<Time>* rxTimes,
+                                Ptr<NetDevice> dev,
+                                Ptr<const Packet> pkt,
+                                uint16_t mode,
+                                const Address& sender)
+{
+    rxTimes->push_back(Simulator::Now());
+    return true;
+}
+
+uint64_t
+PointToPointBurstTest::SendPackets(uint32_t burstSize, std::vector<Time>& rxTimes)
+{
+    Ptr<Node> a = CreateObject<Node>();
+    Ptr<Node> b = CreateObject<Node>();
+    Ptr<PointToPointNetDevice> devA = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel>();
+    channel->SetAttribute("Delay", TimeValue(MilliSeconds(2)));
+
+    for (const auto& dev : {devA, devB})
+    {
+        dev->Attach(channel);
+        dev->SetAddress(Mac48Address::Allocate());
+        dev->SetQueue(CreateObject<DropTailQueue<Packet>>());
+        dev->SetDataRate(DataRate("8Mbps"));
+        dev->SetInterframeGap(MicroSeconds(10));
+        dev->SetAttribute("TxBurstSize", UintegerValue(burstSize));
+    }
+    a->AddDevice(devA);
+    b->AddDevice(devB);
+    devB->SetReceiveCallback(MakeBoundCallback(&PointToPointBurstTest::RxPacket, &rxTimes));
+
+    // Two bunches of packets of various sizes, the second one arriving while
+    // the first one is being transmitted
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        Ptr<PacketBurst> burst = Create<PacketBurst>();
+        for (uint32_t size : {1000, 200, 1400, 40, 600})
+        {
+            burst->AddPacket(Create<Packet>(size));
+        }
+        Simulator::Schedule(Seconds(1) + MilliSeconds(2) * i,
+                            &PointToPointNetDevice::SendMany,
+                            devA,
+                            burst,
+                            devB->GetBroadcast(),
+                            0x800);
+    }
+
+    Simulator::Run();
+    uint64_t events = Simulator::GetEventCount();
+    Simulator::Destroy();
+    return events;
+}
+
+void
+PointToPointBurstTest::DoRun()
+{
+    std::vector<Time> rxTimes;
+    uint64_t events = SendPackets(1, rxTimes);
+    NS_TEST_ASSERT_MSG_EQ(rxTimes.size(), 10, "Packets not received");
+
+    for (uint32_t burstSize : {3, 10})
+    {
+        std::vector<Time> burstRxTimes;
+        uint64_t burstEvents = SendPackets(burstSize, burstRxTimes);
+        NS_TEST_ASSERT_MSG_EQ(burstRxTimes.size(), 10, "Packets not received");
+        for (std::size_t i = 0; i < rxTimes.size(); i++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(burstRxTimes[i], rxTimes[i], "Bad reception time " << i);
+        }
+        NS_TEST_EXPECT_MSG_LT(burstEvents, events, "No events saved by bursts");
+    }
+}
+
+/**
+ * \brief Test class for the super-segments of the PointToPoint model
+ *
+ * It sends a super-segment of the segmentation offload, and checks that it
+ * is received when the last of the segments it replaces would have been.
+ */
+class PointToPointOffloadTest : public TestCase
+{
+  public:
+    /**
+     * \brief Create the test
+     */
+    PointToPointOffloadTest();
+
+    /**
+     * \brief Run the test
+     */
+    void DoRun() override;
+
+  private:
+    /**
+     * \brief Send packets over a link
+     *
+     * \param packets The packets to send at once.
+     * \param [out] rxTimes The times at which the packets are received.
+     */
+    void SendPackets(Ptr<PacketBurst> packets, std::vector<Time>& rxTimes);
+
+    /**
+     * \brief Callback function which records the reception time
+     *
+     * \param rxTimes The times at which the packets are received.
+     * \param dev The receiving device.
+     * \param pkt The received packet.
+     * \param mode The protocol mode used.
+     * \param sender The sender address.
+     *
+     * \return A boolean indicating packet handled properly.
+     */
+    static bool RxPacket(std::vector<Time>* rxTimes,
+                         Ptr<NetDevice> dev,
+                         Ptr<const Packet> pkt,
+                         uint16_t mode,
+                         const Address& sender);
+};
+
+PointToPointOffloadTest::PointToPointOffloadTest()
+    : TestCase("PointToPoint segmentation offload")
+{
+}
+
+bool
+PointToPointOffloadTest::RxPacket(std::vector<Time>* rxTimes,
+                                  Ptr<NetDevice> dev,
+                                  Ptr<const Packet> pkt,
+                                  uint16_t mode,
+                                  const Address& sender)
+{
+    rxTimes->push_back(Simulator::Now());
+    return true;
+}
+
+void
+PointToPointOffloadTest::SendPackets(Ptr<PacketBurst> packets, std::vector<Time>& rxTimes)
+{
+    Ptr<Node> a = CreateObject<Node>();
+    Ptr<Node> b = CreateObject<Node>();
+    Ptr<PointToPointNetDevice> devA = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel>();
+    channel->SetAttribute("Delay", TimeValue(MilliSeconds(2)));
+
+    for (const auto& dev : {devA, devB})
+    {
+        dev->Attach(channel);
+        dev->SetAddress(Mac48Address::Allocate());
+        dev->SetQueue(CreateObject<DropTailQueue<Packet>>());
+        dev->SetDataRate(DataRate("8Mbps"));
+    }
+    a->AddDevice(devA);
+    b->AddDevice(devB);
+    devB->SetReceiveCallback(MakeBoundCallback(&PointToPointOffloadTest::RxPacket, &rxTimes));
+
+    Simulator::Schedule(Seconds(1),
+                        &PointToPointNetDevice::SendMany,
+                        devA,
+                        packets,
+                        devB->GetBroadcast(),
+                        0x800);
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+void
+PointToPointOffloadTest::DoRun()
+{
+    // Three segments of 1000 bytes with 40 bytes of headers each
+    Ptr<PacketBurst> segments = Create<PacketBurst>();
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        segments->AddPacket(Create<Packet>(1040));
+    }
+    std::vector<Time> rxTimes;
+    SendPackets(segments, rxTimes);
+    NS_TEST_ASSERT_MSG_EQ(rxTimes.size(), 3, "Segments not received");
+
+    // The same segments, in a super-segment with the headers of one segment
+    Ptr<PacketBurst> superSegment = Create<PacketBurst>();
+    Ptr<Packet> packet = Create<Packet>(3040);
+    packet->AddPacketTag(SegmentOffloadTag(3, 40));
+    superSegment->AddPacket(packet);
+    std::vector<Time> offloadRxTimes;
+    SendPackets(superSegment, offloadRxTimes);
+    NS_TEST_ASSERT_MSG_EQ(offloadRxTimes.size(), 1, "Super-segment not received");
+    NS_TEST_EXPECT_MSG_EQ(offloadRxTimes.front(), rxTimes.back(), "Bad reception time");
+}
+
 /**
  * \brief TestSuite for PointToPoint module
  */
@@ -155,6 +405,8 @@ PointToPointTestSuite::PointToPointTestSuite()
     : TestSuite("devices-point-to-point", Type::UNIT)
 {
     AddTestCase(new PointToPointTest, TestCase::Duration::QUICK);
+    AddTestCase(new PointToPointBurstTest, TestCase::Duration::QUICK);
+    AddTestCase(new PointToPointOffloadTest, TestCase::Duration::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
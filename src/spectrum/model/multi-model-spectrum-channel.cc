@@ -41,6 +41,7 @@
 #include <algorithm>
 #include <iostream>
 #include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -240,6 +241,7 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     auto txSpectrumModelUid = txParams->psd->GetSpectrumModelUid();
     NS_LOG_LOGIC("txSpectrumModelUid " << txSpectrumModelUid);
 
+    std::vector<Simulator::ContextEvent> receptions;
     for (auto rxInfoIterator = m_rxSpectrumModelInfoMap.begin();
          rxInfoIterator != m_rxSpectrumModelInfoMap.end();
          ++rxInfoIterator)
@@ -336,30 +338,21 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                     }
                 }
 
-                if (rxNetDevice)
-                {
-                    // the receiver has a NetDevice, so we expect that it is attached to a Node
-                    auto dstNode = rxNetDevice->GetNode()->GetId();
-                    Simulator::ScheduleWithContext(dstNode,
-                                                   delay,
-                                                   &MultiModelSpectrumChannel::StartRx,
-                                                   this,
-                                                   rxParams,
-                                                   *rxPhyIterator);
-                }
-                else
-                {
-                    // the receiver is not attached to a NetDevice, so we cannot assume that it is
-                    // attached to a node
-                    Simulator::Schedule(delay,
-                                        &MultiModelSpectrumChannel::StartRx,
-                                        this,
-                                        rxParams,
-                                        *rxPhyIterator);
-                }
+                // the receiver has a NetDevice, so we expect that it is attached to a Node;
+                // otherwise, we cannot assume that it is attached to a node and the event
+                // is scheduled in the current context
+                uint32_t dstNode =
+                    rxNetDevice ? rxNetDevice->GetNode()->GetId() : Simulator::GetContext();
+                receptions.push_back({dstNode,
+                                      delay,
+                                      MakeEvent(&MultiModelSpectrumChannel::StartRx,
+                                                this,
+                                                rxParams,
+                                                *rxPhyIterator)});
             }
         }
     }
+    Simulator::ScheduleWithContextBatch(receptions);
 }
 
 void
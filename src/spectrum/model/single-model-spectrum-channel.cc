@@ -38,6 +38,7 @@
 #include <ns3/simulator.h>
 
 #include <algorithm>
+#include <vector>
 
 namespace ns3
 {
@@ -124,6 +125,8 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
 
     Ptr<MobilityModel> senderMobility = txParams->txPhy->GetMobility();
 
+    std::vector<Simulator::ContextEvent> receptions;
+    receptions.reserve(m_phyList.size());
     for (auto rxPhyIterator = m_phyList.begin(); rxPhyIterator != m_phyList.end(); ++rxPhyIterator)
     {
         Ptr<NetDevice> rxNetDevice = (*rxPhyIterator)->GetDevice();
@@ -206,29 +209,20 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                 }
             }
 
-            if (rxNetDevice)
-            {
-                // the receiver has a NetDevice, so we expect that it is attached to a Node
-                uint32_t dstNode = rxNetDevice->GetNode()->GetId();
-                Simulator::ScheduleWithContext(dstNode,
-                                               delay,
-                                               &SingleModelSpectrumChannel::StartRx,
-                                               this,
-                                               rxParams,
-                                               *rxPhyIterator);
-            }
-            else
-            {
-                // the receiver is not attached to a NetDevice, so we cannot assume that it is
-                // attached to a node
-                Simulator::Schedule(delay,
-                                    &SingleModelSpectrumChannel::StartRx,
-                                    this,
-                                    rxParams,
-                                    *rxPhyIterator);
-            }
+            // the receiver has a NetDevice, so we expect that it is attached to a Node;
+            // otherwise, we cannot assume that it is attached to a node and the event
+            // is scheduled in the current context
+            uint32_t dstNode =
+                rxNetDevice ? rxNetDevice->GetNode()->GetId() : Simulator::GetContext();
+            receptions.push_back({dstNode,
+                                  delay,
+                                  MakeEvent(&SingleModelSpectrumChannel::StartRx,
+                                            this,
+                                            rxParams,
+                                            *rxPhyIterator)});
         }
     }
+    Simulator::ScheduleWithContextBatch(receptions);
 }
 
 void
@@ -0,0 +1,243 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/application-container.h"
+#include "ns3/csma-helper.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-global-routing-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/on-off-helper.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/packet-sink.h"
+#include "ns3/packet.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/udp-echo-helper.h"
+#include "ns3/uinteger.h"
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup system-tests-checkpoint
+ * Checkpoint and restore of a complete simulation.
+ */
+
+/**
+ * \ingroup system-tests
+ * \defgroup system-tests-checkpoint Checkpoint system tests
+ */
+
+using namespace ns3;
+
+/**
+ * \ingroup system-tests-checkpoint
+ *
+ * \brief Check that a restored simulation continues like the saved one.
+ *
+ * A UDP echo client and an on/off application exchange packets through a
+ * point-to-point link and a CSMA channel.  The simulation is saved while
+ * packets are in flight and continued, then rebuilt, restored and run
+ * again: the packets received after the checkpoint must be the same.
+ */
+class CheckpointRestoreTestCase : public TestCase
+{
+  public:
+    CheckpointRestoreTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** Build the topology and the applications, and connect the traces. */
+    void BuildScenario();
+
+    /**
+     * Record a packet received by the sink.
+     * \param packet The packet.
+     * \param from The address of the sender.
+     */
+    void SinkRx(Ptr<const Packet> packet, const Address& from);
+
+    /**
+     * Record a packet received by the echo client.
+     * \param packet The packet.
+     */
+    void EchoRx(Ptr<const Packet> packet);
+
+    /** A received packet: the time, the uid and the size. */
+    typedef std::tuple<int64_t, uint64_t, uint32_t> Reception;
+
+    std::vector<Reception> m_sinkRx; //!< The packets received by the sink.
+    std::vector<Reception> m_echoRx; //!< The packets received by the echo client.
+    Ptr<PacketSink> m_sink;          //!< The packet sink.
+};
+
+CheckpointRestoreTestCase::CheckpointRestoreTestCase()
+    : TestCase("Check that a restored simulation continues like the saved one")
+{
+}
+
+void
+CheckpointRestoreTestCase::SinkRx(Ptr<const Packet> packet, const Address& from)
+{
+    m_sinkRx.emplace_back(Simulator::Now().GetTimeStep(), packet->GetUid(), packet->GetSize());
+}
+
+void
+CheckpointRestoreTestCase::EchoRx(Ptr<const Packet> packet)
+{
+    m_echoRx.emplace_back(Simulator::Now().GetTimeStep(), packet->GetUid(), packet->GetSize());
+}
+
+void
+CheckpointRestoreTestCase::BuildScenario()
+{
+    // n0 -- point-to-point -- n1 -- CSMA -- n2, n3
+    NodeContainer p2pNodes;
+    p2pNodes.Create(2);
+    NodeContainer csmaNodes;
+    csmaNodes.Add(p2pNodes.Get(1));
+    csmaNodes.Create(2);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", StringValue("5Mbps"));
+    pointToPoint.SetChannelAttribute("Delay", StringValue("2ms"));
+    NetDeviceContainer p2pDevices = pointToPoint.Install(p2pNodes);
+
+    CsmaHelper csma;
+    csma.SetChannelAttribute("DataRate", StringValue("10Mbps"));
+    csma.SetChannelAttribute("Delay", StringValue("6560ns"));
+    NetDeviceContainer csmaDevices = csma.Install(csmaNodes);
+
+    InternetStackHelper stack;
+    stack.Install(p2pNodes.Get(0));
+    stack.Install(csmaNodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer p2pInterfaces = address.Assign(p2pDevices);
+    address.SetBase("10.1.2.0", "255.255.255.0");
+    Ipv4InterfaceContainer csmaInterfaces = address.Assign(csmaDevices);
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    UdpEchoServerHelper echoServer(9);
+    ApplicationContainer serverApps = echoServer.Install(csmaNodes.Get(2));
+    serverApps.Start(Seconds(1));
+    serverApps.Stop(Seconds(10));
+
+    UdpEchoClientHelper echoClient(csmaInterfaces.GetAddress(2), 9);
+    echoClient.SetAttribute("MaxPackets", UintegerValue(1000));
+    echoClient.SetAttribute("Interval", TimeValue(MilliSeconds(50)));
+    echoClient.SetAttribute("PacketSize", UintegerValue(256));
+    ApplicationContainer clientApps = echoClient.Install(p2pNodes.Get(0));
+    clientApps.Start(Seconds(1));
+    clientApps.Stop(Seconds(10));
+    clientApps.Get(0)->TraceConnectWithoutContext(
+        "Rx",
+        MakeCallback(&CheckpointRestoreTestCase::EchoRx, this));
+
+    uint16_t port = 5000;
+    PacketSinkHelper sinkHelper("ns3::UdpSocketFactory",
+                                InetSocketAddress(Ipv4Address::GetAny(), port));
+    ApplicationContainer sinkApps = sinkHelper.Install(p2pNodes.Get(0));
+    sinkApps.Start(Seconds(0.5));
+    sinkApps.Stop(Seconds(10));
+    m_sink = DynamicCast<PacketSink>(sinkApps.Get(0));
+    m_sink->TraceConnectWithoutContext("Rx",
+                                       MakeCallback(&CheckpointRestoreTestCase::SinkRx, this));
+
+    OnOffHelper onOff("ns3::UdpSocketFactory",
+                      InetSocketAddress(p2pInterfaces.GetAddress(0), port));
+    onOff.SetAttribute("OnTime", StringValue("ns3::UniformRandomVariable[Min=0.1|Max=0.5]"));
+    onOff.SetAttribute("OffTime", StringValue("ns3::UniformRandomVariable[Min=0.1|Max=0.5]"));
+    onOff.SetAttribute("DataRate", StringValue("1Mbps"));
+    onOff.SetAttribute("PacketSize", UintegerValue(512));
+    ApplicationContainer onOffApps = onOff.Install(csmaNodes.Get(1));
+    onOffApps.Start(Seconds(1.1));
+    onOffApps.Stop(Seconds(10));
+}
+
+void
+CheckpointRestoreTestCase::DoRun()
+{
+    std::string file = CreateTempDirFilename("checkpoint.txt");
+    const Time checkpoint = MilliSeconds(2345);
+    const Time end = Seconds(5);
+
+    BuildScenario();
+    Simulator::Stop(checkpoint);
+    Simulator::Run();
+    Simulator::Checkpoint(file);
+    m_sinkRx.clear();
+    m_echoRx.clear();
+    Simulator::Stop(end - checkpoint);
+    Simulator::Run();
+    std::vector<Reception> sinkRx = m_sinkRx;
+    std::vector<Reception> echoRx = m_echoRx;
+    uint64_t totalRx = m_sink->GetTotalRx();
+    m_sink = nullptr;
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_GT(sinkRx.size(), 0, "No packet received by the sink");
+    NS_TEST_ASSERT_MSG_GT(echoRx.size(), 0, "No packet echoed");
+
+    m_sinkRx.clear();
+    m_echoRx.clear();
+    BuildScenario();
+    Simulator::Restore(file);
+    NS_TEST_ASSERT_MSG_EQ(Simulator::Now(), checkpoint, "Wrong time restored");
+    Simulator::Stop(end - checkpoint);
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_sinkRx.size(), sinkRx.size(), "Wrong number of packets received");
+    NS_TEST_ASSERT_MSG_EQ(m_echoRx.size(), echoRx.size(), "Wrong number of packets echoed");
+    for (std::size_t i = 0; i < sinkRx.size() && i < m_sinkRx.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ((m_sinkRx[i] == sinkRx[i]), true, "Packet " << i << " differs");
+    }
+    for (std::size_t i = 0; i < echoRx.size() && i < m_echoRx.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ((m_echoRx[i] == echoRx[i]), true, "Echo " << i << " differs");
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_sink->GetTotalRx(), totalRx, "Wrong number of bytes received");
+    m_sink = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup system-tests-checkpoint
+ *
+ * \brief Checkpoint TestSuite.
+ */
+class CheckpointTestSuite : public TestSuite
+{
+  public:
+    CheckpointTestSuite();
+};
+
+CheckpointTestSuite::CheckpointTestSuite()
+    : TestSuite("checkpoint", Type::SYSTEM)
+{
+    AddTestCase(new CheckpointRestoreTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static CheckpointTestSuite g_checkpointTestSuite;
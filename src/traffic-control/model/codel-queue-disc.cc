@@ -505,4 +505,30 @@ CoDelQueueDisc::InitializeParams()
     NS_LOG_FUNCTION(this);
 }
 
+void
+CoDelQueueDisc::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    SaveQueueDiscState(writer);
+    writer.Write("count", m_count.Get());
+    writer.Write("lastCount", m_lastCount.Get());
+    writer.Write("dropping", m_dropping.Get());
+    writer.Write("recInvSqrt", m_recInvSqrt);
+    writer.Write("firstAboveTime", m_firstAboveTime);
+    writer.Write("dropNext", m_dropNext.Get());
+}
+
+void
+CoDelQueueDisc::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    RestoreQueueDiscState(reader);
+    m_count = reader.Read<uint32_t>("count");
+    m_lastCount = reader.Read<uint32_t>("lastCount");
+    m_dropping = reader.Read<bool>("dropping");
+    m_recInvSqrt = reader.Read<uint16_t>("recInvSqrt");
+    m_firstAboveTime = reader.Read<uint32_t>("firstAboveTime");
+    m_dropNext = reader.Read<uint32_t>("dropNext");
+}
+
 } // namespace ns3
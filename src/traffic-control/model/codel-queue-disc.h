@@ -60,7 +60,7 @@ class TraceContainer;
  * \brief A CoDel packet queue disc
  */
 
-class CoDelQueueDisc : public QueueDisc
+class CoDelQueueDisc : public QueueDisc, public Checkpointable
 {
   public:
     /**
@@ -100,6 +100,17 @@ class CoDelQueueDisc : public QueueDisc
      */
     uint32_t GetDropNext();
 
+    /**
+     * \brief Save the state of the control law
+     * \param writer the checkpoint writer
+     */
+    void SaveState(CheckpointWriter& writer) const override;
+    /**
+     * \brief Restore the state of the control law
+     * \param reader the checkpoint reader
+     */
+    void RestoreState(CheckpointReader& reader) override;
+
     // Reasons for dropping packets
     static constexpr const char* TARGET_EXCEEDED_DROP =
         "Target exceeded drop";                                     //!< Sojourn time above target
@@ -105,6 +105,24 @@ FqCoDelFlow::GetIndex() const
     return m_index;
 }
 
+void
+FqCoDelFlow::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    writer.Write("deficit", m_deficit);
+    writer.Write("status", static_cast<uint32_t>(m_status));
+    writer.Write("index", m_index);
+}
+
+void
+FqCoDelFlow::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    m_deficit = reader.Read<int32_t>("deficit");
+    m_status = static_cast<FlowStatus>(reader.Read<uint32_t>("status"));
+    m_index = reader.Read<uint32_t>("index");
+}
+
 NS_OBJECT_ENSURE_REGISTERED(FqCoDelQueueDisc);
 
 TypeId
@@ -270,21 +288,7 @@ FqCoDelQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
     if (m_flowsIndices.find(h) == m_flowsIndices.end())
     {
         NS_LOG_DEBUG("Creating a new flow queue with index " << h);
-        flow = m_flowFactory.Create<FqCoDelFlow>();
-        Ptr<QueueDisc> qd = m_queueDiscFactory.Create<QueueDisc>();
-        // If CoDel, Set values of CoDelQueueDisc to match this QueueDisc
-        Ptr<CoDelQueueDisc> codel = qd->GetObject<CoDelQueueDisc>();
-        if (codel)
-        {
-            codel->SetAttribute("UseEcn", BooleanValue(m_useEcn));
-            codel->SetAttribute("CeThreshold", TimeValue(m_ceThreshold));
-            codel->SetAttribute("UseL4s", BooleanValue(m_useL4s));
-        }
-        qd->Initialize();
-        flow->SetQueueDisc(qd);
-        flow->SetIndex(h);
-        AddQueueDiscClass(flow);
-
+        flow = CreateFlow(h);
         m_flowsIndices[h] = GetNQueueDiscClasses() - 1;
     }
     else
@@ -501,4 +505,102 @@ FqCoDelQueueDisc::FqCoDelDrop()
     return index;
 }
 
+Ptr<FqCoDelFlow>
+FqCoDelQueueDisc::CreateFlow(uint32_t index)
+{
+    NS_LOG_FUNCTION(this << index);
+    Ptr<FqCoDelFlow> flow = m_flowFactory.Create<FqCoDelFlow>();
+    Ptr<QueueDisc> qd = m_queueDiscFactory.Create<QueueDisc>();
+    // If CoDel, Set values of CoDelQueueDisc to match this QueueDisc
+    Ptr<CoDelQueueDisc> codel = qd->GetObject<CoDelQueueDisc>();
+    if (codel)
+    {
+        codel->SetAttribute("UseEcn", BooleanValue(m_useEcn));
+        codel->SetAttribute("CeThreshold", TimeValue(m_ceThreshold));
+        codel->SetAttribute("UseL4s", BooleanValue(m_useL4s));
+    }
+    qd->Initialize();
+    flow->SetQueueDisc(qd);
+    flow->SetIndex(index);
+    AddQueueDiscClass(flow);
+    return flow;
+}
+
+void
+FqCoDelQueueDisc::SaveState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    SaveQueueDiscState(writer);
+    writer.Write("flows", GetNQueueDiscClasses());
+    for (std::size_t i = 0; i < GetNQueueDiscClasses(); i++)
+    {
+        Ptr<FqCoDelFlow> flow = StaticCast<FqCoDelFlow>(GetQueueDiscClass(i));
+        writer.Write("flow." + std::to_string(i), flow->GetIndex());
+    }
+    uint32_t n = 0;
+    for (const auto& [index, flow] : m_flowsIndices)
+    {
+        std::string key = "index." + std::to_string(n++);
+        writer.Write(key + ".flow", index);
+        writer.Write(key + ".class", flow);
+    }
+    writer.Write("indices", n);
+    n = 0;
+    for (const auto& [index, tag] : m_tags)
+    {
+        std::string key = "tag." + std::to_string(n++);
+        writer.Write(key + ".index", index);
+        writer.Write(key + ".tag", tag);
+    }
+    writer.Write("tags", n);
+    // The scheduling lists, as class indices
+    for (const auto& [name, flows] : {std::make_pair("newFlows", &m_newFlows),
+                                      std::make_pair("oldFlows", &m_oldFlows)})
+    {
+        n = 0;
+        for (const auto& flow : *flows)
+        {
+            writer.Write(std::string(name) + "." + std::to_string(n++),
+                         m_flowsIndices.at(flow->GetIndex()));
+        }
+        writer.Write(name, n);
+    }
+}
+
+void
+FqCoDelQueueDisc::RestoreState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(GetNQueueDiscClasses() != 0,
+                    "Cannot restore " << reader.GetPath() << ": flow queues already created");
+    RestoreQueueDiscState(reader);
+    for (uint32_t i = 0, n = reader.Read<uint32_t>("flows"); i < n; i++)
+    {
+        CreateFlow(reader.Read<uint32_t>("flow." + std::to_string(i)));
+    }
+    m_flowsIndices.clear();
+    for (uint32_t i = 0, n = reader.Read<uint32_t>("indices"); i < n; i++)
+    {
+        std::string key = "index." + std::to_string(i);
+        m_flowsIndices[reader.Read<uint32_t>(key + ".flow")] =
+            reader.Read<uint32_t>(key + ".class");
+    }
+    m_tags.clear();
+    for (uint32_t i = 0, n = reader.Read<uint32_t>("tags"); i < n; i++)
+    {
+        std::string key = "tag." + std::to_string(i);
+        m_tags[reader.Read<uint32_t>(key + ".index")] = reader.Read<uint32_t>(key + ".tag");
+    }
+    for (const auto& [name, flows] : {std::make_pair("newFlows", &m_newFlows),
+                                      std::make_pair("oldFlows", &m_oldFlows)})
+    {
+        flows->clear();
+        for (uint32_t i = 0, n = reader.Read<uint32_t>(name); i < n; i++)
+        {
+            uint32_t index = reader.Read<uint32_t>(std::string(name) + "." + std::to_string(i));
+            flows->push_back(StaticCast<FqCoDelFlow>(GetQueueDiscClass(index)));
+        }
+    }
+}
+
 } // namespace ns3
@@ -37,7 +37,7 @@ namespace ns3
  * \brief A flow queue used by the FqCoDel queue disc
  */
 
-class FqCoDelFlow : public QueueDiscClass
+class FqCoDelFlow : public QueueDiscClass, public Checkpointable
 {
   public:
     /**
@@ -99,6 +99,17 @@ class FqCoDelFlow : public QueueDiscClass
      */
     uint32_t GetIndex() const;
 
+    /**
+     * \brief Save the deficit and the status of the flow
+     * \param writer the checkpoint writer
+     */
+    void SaveState(CheckpointWriter& writer) const override;
+    /**
+     * \brief Restore the deficit and the status of the flow
+     * \param reader the checkpoint reader
+     */
+    void RestoreState(CheckpointReader& reader) override;
+
   private:
     int32_t m_deficit;   //!< the deficit for this flow
     FlowStatus m_status; //!< the status of this flow
@@ -109,9 +120,12 @@ class FqCoDelFlow : public QueueDiscClass
  * \ingroup traffic-control
  *
  * \brief A FqCoDel packet queue disc
+ *
+ * The flow queues are recreated when restoring a checkpoint, in the
+ * order they were created, so that they are restored in turn.
  */
 
-class FqCoDelQueueDisc : public QueueDisc
+class FqCoDelQueueDisc : public QueueDisc, public Checkpointable
 {
   public:
     /**
@@ -142,6 +156,17 @@ class FqCoDelQueueDisc : public QueueDisc
      */
     uint32_t GetQuantum() const;
 
+    /**
+     * \brief Save the flow queues and the scheduling lists
+     * \param writer the checkpoint writer
+     */
+    void SaveState(CheckpointWriter& writer) const override;
+    /**
+     * \brief Recreate the flow queues and restore the scheduling lists
+     * \param reader the checkpoint reader
+     */
+    void RestoreState(CheckpointReader& reader) override;
+
     // Reasons for dropping packets
     static constexpr const char* UNCLASSIFIED_DROP =
         "Unclassified drop"; //!< No packet filter able to classify packet
@@ -159,6 +184,13 @@ class FqCoDelQueueDisc : public QueueDisc
      */
     uint32_t FqCoDelDrop();
 
+    /**
+     * \brief Create a flow queue and add it as the last class
+     * \param index the index of the flow
+     * \return the new flow
+     */
+    Ptr<FqCoDelFlow> CreateFlow(uint32_t index);
+
     bool m_useEcn; //!< True if ECN is used (packets are marked instead of being dropped)
     /**
      * Compute the index of the queue for the flow having the given flowHash,
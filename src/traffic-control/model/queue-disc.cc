@@ -19,6 +19,7 @@
 #include "queue-disc.h"
 
 #include "ns3/abort.h"
+#include "ns3/checkpoint.h"
 #include "ns3/log.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/object-vector.h"
@@ -847,6 +848,123 @@ QueueDisc::Mark(Ptr<QueueDiscItem> item, const char* reason)
     return true;
 }
 
+namespace
+{
+
+/**
+ * \ingroup traffic-control
+ * Save the counters of a queue disc by reason.
+ *
+ * \tparam T \deduced The type of the counters.
+ * \param [in] writer The checkpoint writer.
+ * \param [in] key The key of the counters.
+ * \param [in] counters The counters.
+ */
+template <typename T>
+void
+WriteCounters(CheckpointWriter& writer,
+              const std::string& key,
+              const std::map<std::string, T, std::less<>>& counters)
+{
+    uint32_t n = 0;
+    for (const auto& [reason, counter] : counters)
+    {
+        std::string prefix = key + "." + std::to_string(n++);
+        writer.Write(prefix + ".reason", reason);
+        writer.Write(prefix + ".count", counter);
+    }
+    writer.Write(key, n);
+}
+
+/**
+ * \ingroup traffic-control
+ * Restore the counters of a queue disc by reason.
+ *
+ * \tparam T \deduced The type of the counters.
+ * \param [in] reader The checkpoint reader.
+ * \param [in] key The key of the counters.
+ * \param [out] counters The counters.
+ */
+template <typename T>
+void
+ReadCounters(const CheckpointReader& reader,
+             const std::string& key,
+             std::map<std::string, T, std::less<>>& counters)
+{
+    counters.clear();
+    for (uint32_t i = 0, n = reader.Read<uint32_t>(key); i < n; i++)
+    {
+        std::string prefix = key + "." + std::to_string(i);
+        counters[reader.ReadString(prefix + ".reason")] = reader.Read<T>(prefix + ".count");
+    }
+}
+
+} // unnamed namespace
+
+void
+QueueDisc::SaveQueueDiscState(CheckpointWriter& writer) const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(m_nPackets.Get() != 0 || m_requeued,
+                    "Cannot save a queue disc holding "
+                        << m_nPackets << " packets" << (m_requeued ? " and a requeued one" : ""));
+    writer.Write("receivedPackets", m_stats.nTotalReceivedPackets);
+    writer.Write("receivedBytes", m_stats.nTotalReceivedBytes);
+    writer.Write("sentPackets", m_stats.nTotalSentPackets);
+    writer.Write("sentBytes", m_stats.nTotalSentBytes);
+    writer.Write("enqueuedPackets", m_stats.nTotalEnqueuedPackets);
+    writer.Write("enqueuedBytes", m_stats.nTotalEnqueuedBytes);
+    writer.Write("dequeuedPackets", m_stats.nTotalDequeuedPackets);
+    writer.Write("dequeuedBytes", m_stats.nTotalDequeuedBytes);
+    writer.Write("droppedPackets", m_stats.nTotalDroppedPackets);
+    writer.Write("droppedPacketsBeforeEnqueue", m_stats.nTotalDroppedPacketsBeforeEnqueue);
+    WriteCounters(writer, "droppedPacketsBeforeEnqueueBy", m_stats.nDroppedPacketsBeforeEnqueue);
+    writer.Write("droppedPacketsAfterDequeue", m_stats.nTotalDroppedPacketsAfterDequeue);
+    WriteCounters(writer, "droppedPacketsAfterDequeueBy", m_stats.nDroppedPacketsAfterDequeue);
+    writer.Write("droppedBytes", m_stats.nTotalDroppedBytes);
+    writer.Write("droppedBytesBeforeEnqueue", m_stats.nTotalDroppedBytesBeforeEnqueue);
+    WriteCounters(writer, "droppedBytesBeforeEnqueueBy", m_stats.nDroppedBytesBeforeEnqueue);
+    writer.Write("droppedBytesAfterDequeue", m_stats.nTotalDroppedBytesAfterDequeue);
+    WriteCounters(writer, "droppedBytesAfterDequeueBy", m_stats.nDroppedBytesAfterDequeue);
+    writer.Write("requeuedPackets", m_stats.nTotalRequeuedPackets);
+    writer.Write("requeuedBytes", m_stats.nTotalRequeuedBytes);
+    writer.Write("markedPackets", m_stats.nTotalMarkedPackets);
+    WriteCounters(writer, "markedPacketsBy", m_stats.nMarkedPackets);
+    writer.Write("markedBytes", m_stats.nTotalMarkedBytes);
+    WriteCounters(writer, "markedBytesBy", m_stats.nMarkedBytes);
+}
+
+void
+QueueDisc::RestoreQueueDiscState(CheckpointReader& reader)
+{
+    NS_LOG_FUNCTION(this);
+    m_stats.nTotalReceivedPackets = reader.Read<uint32_t>("receivedPackets");
+    m_stats.nTotalReceivedBytes = reader.Read<uint64_t>("receivedBytes");
+    m_stats.nTotalSentPackets = reader.Read<uint32_t>("sentPackets");
+    m_stats.nTotalSentBytes = reader.Read<uint64_t>("sentBytes");
+    m_stats.nTotalEnqueuedPackets = reader.Read<uint32_t>("enqueuedPackets");
+    m_stats.nTotalEnqueuedBytes = reader.Read<uint64_t>("enqueuedBytes");
+    m_stats.nTotalDequeuedPackets = reader.Read<uint32_t>("dequeuedPackets");
+    m_stats.nTotalDequeuedBytes = reader.Read<uint64_t>("dequeuedBytes");
+    m_stats.nTotalDroppedPackets = reader.Read<uint32_t>("droppedPackets");
+    m_stats.nTotalDroppedPacketsBeforeEnqueue =
+        reader.Read<uint32_t>("droppedPacketsBeforeEnqueue");
+    ReadCounters(reader, "droppedPacketsBeforeEnqueueBy", m_stats.nDroppedPacketsBeforeEnqueue);
+    m_stats.nTotalDroppedPacketsAfterDequeue = reader.Read<uint32_t>("droppedPacketsAfterDequeue");
+    ReadCounters(reader, "droppedPacketsAfterDequeueBy", m_stats.nDroppedPacketsAfterDequeue);
+    m_stats.nTotalDroppedBytes = reader.Read<uint64_t>("droppedBytes");
+    m_stats.nTotalDroppedBytesBeforeEnqueue = reader.Read<uint64_t>("droppedBytesBeforeEnqueue");
+    ReadCounters(reader, "droppedBytesBeforeEnqueueBy", m_stats.nDroppedBytesBeforeEnqueue);
+    m_stats.nTotalDroppedBytesAfterDequeue = reader.Read<uint64_t>("droppedBytesAfterDequeue");
+    ReadCounters(reader, "droppedBytesAfterDequeueBy", m_stats.nDroppedBytesAfterDequeue);
+    m_stats.nTotalRequeuedPackets = reader.Read<uint32_t>("requeuedPackets");
+    m_stats.nTotalRequeuedBytes = reader.Read<uint64_t>("requeuedBytes");
+    m_stats.nTotalMarkedPackets = reader.Read<uint32_t>("markedPackets");
+    ReadCounters(reader, "markedPacketsBy", m_stats.nMarkedPackets);
+    m_stats.nTotalMarkedBytes = reader.Read<uint32_t>("markedBytes");
+    ReadCounters(reader, "markedBytesBy", m_stats.nMarkedBytes);
+}
+
 bool
 QueueDisc::Enqueue(Ptr<QueueDiscItem> item)
 {
@@ -882,6 +1000,22 @@ QueueDisc::Enqueue(Ptr<QueueDiscItem> item)
     return retval;
 }
 
+uint32_t
+QueueDisc::EnqueueBatch(const std::vector<Ptr<QueueDiscItem>>& items)
+{
+    NS_LOG_FUNCTION(this << items.size());
+
+    uint32_t enqueued = 0;
+    for (const auto& item : items)
+    {
+        if (Enqueue(item))
+        {
+            enqueued++;
+        }
+    }
+    return enqueued;
+}
+
 Ptr<QueueDiscItem>
 QueueDisc::Dequeue()
 {
@@ -21,6 +21,7 @@
 
 #include "packet-filter.h"
 
+#include "ns3/checkpoint.h"
 #include "ns3/object.h"
 #include "ns3/queue-fwd.h"
 #include "ns3/queue-item.h"
@@ -177,6 +178,10 @@ enum QueueDiscSizePolicy
  * the additional time the packet is retained within the traffic control
  * infrastructure in case it is requeued.
  *
+ * The queue discs supporting the checkpoints implement ns3::Checkpointable
+ * and save their statistics with QueueDisc::SaveQueueDiscState(). A queue
+ * disc can only be saved to a checkpoint when it is empty.
+ *
  * The design and implementation of this class is heavily inspired by Linux.
  * For more details, see the traffic-control model page.
  */
@@ -399,6 +404,15 @@ class QueueDisc : public Object
      */
     bool Enqueue(Ptr<QueueDiscItem> item);
 
+    /**
+     * Pass several packets to store to the queue discipline, in order, by
+     * calling Enqueue for each of them. The caller is expected to call Run
+     * once afterwards, rather than once per packet.
+     * \param items the items to enqueue
+     * \return the number of items successfully enqueued
+     */
+    uint32_t EnqueueBatch(const std::vector<Ptr<QueueDiscItem>>& items);
+
     /**
      * Extract from the queue disc the packet that has been dequeued by calling
      * Peek, if any, or call the private DoDequeue method (which must be
@@ -572,6 +586,19 @@ class QueueDisc : public Object
      */
     bool Mark(Ptr<QueueDiscItem> item, const char* reason);
 
+    /**
+     * \brief Save the statistics of the queue disc
+     * \param writer the checkpoint writer
+     *
+     * Aborts if the queue disc holds packets, including a requeued packet.
+     */
+    void SaveQueueDiscState(CheckpointWriter& writer) const;
+    /**
+     * \brief Restore the statistics of the queue disc
+     * \param reader the checkpoint reader
+     */
+    void RestoreQueueDiscState(CheckpointReader& reader);
+
   private:
     /**
      * This function actually enqueues a packet into the queue disc.
@@ -20,6 +20,7 @@
 
 #include "queue-disc.h"
 
+#include "ns3/checkpoint.h"
 #include "ns3/log.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/object-map.h"
@@ -34,6 +35,7 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("TrafficControlLayer");
 
 NS_OBJECT_ENSURE_REGISTERED(TrafficControlLayer);
+NS_CHECKPOINT_STATELESS(TrafficControlLayer);
 
 TypeId
 TrafficControlLayer::GetTypeId()
@@ -1230,15 +1230,17 @@ WifiMacHeader::GetSerializedSize() const
 void
 WifiMacHeader::Serialize(Buffer::Iterator i) const
 {
-    i.WriteHtolsbU16(GetFrameControl());
-    i.WriteHtolsbU16(m_duration);
-    WriteTo(i, m_addr1);
+    uint8_t* buffer = i.WriteSpan(2 + 2 + 6);
+    WriteHtolsbU16(buffer, GetFrameControl());
+    WriteHtolsbU16(buffer + 2, m_duration);
+    m_addr1.CopyTo(buffer + 4);
     switch (m_ctrlType)
     {
     case TYPE_MGT:
-        WriteTo(i, m_addr2);
-        WriteTo(i, m_addr3);
-        i.WriteHtolsbU16(GetSequenceControl());
+        buffer = i.WriteSpan(6 + 6 + 2);
+        m_addr2.CopyTo(buffer);
+        m_addr3.CopyTo(buffer + 6);
+        WriteHtolsbU16(buffer + 12, GetSequenceControl());
         break;
     case TYPE_CTL:
         switch (m_ctrlSubtype)
@@ -1262,16 +1264,19 @@ WifiMacHeader::Serialize(Buffer::Iterator i) const
         }
         break;
     case TYPE_DATA: {
-        WriteTo(i, m_addr2);
-        WriteTo(i, m_addr3);
-        i.WriteHtolsbU16(GetSequenceControl());
+        buffer = i.WriteSpan(GetSize() - (2 + 2 + 6));
+        m_addr2.CopyTo(buffer);
+        m_addr3.CopyTo(buffer + 6);
+        WriteHtolsbU16(buffer + 12, GetSequenceControl());
+        buffer += 6 + 6 + 2;
         if (m_ctrlToDs && m_ctrlFromDs)
         {
-            WriteTo(i, m_addr4);
+            m_addr4.CopyTo(buffer);
+            buffer += 6;
         }
         if (m_ctrlSubtype & 0x08)
         {
-            i.WriteHtolsbU16(GetQosControl());
+            WriteHtolsbU16(buffer, GetQosControl());
         }
     }
     break;
@@ -1286,16 +1291,19 @@ uint32_t
 WifiMacHeader::Deserialize(Buffer::Iterator start)
 {
     Buffer::Iterator i = start;
-    uint16_t frame_control = i.ReadLsbtohU16();
+    uint8_t scratch[32];
+    const uint8_t* buffer = i.ReadSpan(2 + 2 + 6, scratch);
+    uint16_t frame_control = ReadLsbtohU16(buffer);
     SetFrameControl(frame_control);
-    m_duration = i.ReadLsbtohU16();
-    ReadFrom(i, m_addr1);
+    m_duration = ReadLsbtohU16(buffer + 2);
+    m_addr1.CopyFrom(buffer + 4);
     switch (m_ctrlType)
     {
     case TYPE_MGT:
-        ReadFrom(i, m_addr2);
-        ReadFrom(i, m_addr3);
-        SetSequenceControl(i.ReadLsbtohU16());
+        buffer = i.ReadSpan(6 + 6 + 2, scratch);
+        m_addr2.CopyFrom(buffer);
+        m_addr3.CopyFrom(buffer + 6);
+        SetSequenceControl(ReadLsbtohU16(buffer + 12));
         break;
     case TYPE_CTL:
         switch (m_ctrlSubtype)
@@ -1315,16 +1323,19 @@ WifiMacHeader::Deserialize(Buffer::Iterator start)
         }
         break;
     case TYPE_DATA:
-        ReadFrom(i, m_addr2);
-        ReadFrom(i, m_addr3);
-        SetSequenceControl(i.ReadLsbtohU16());
+        buffer = i.ReadSpan(GetSize() - (2 + 2 + 6), scratch);
+        m_addr2.CopyFrom(buffer);
+        m_addr3.CopyFrom(buffer + 6);
+        SetSequenceControl(ReadLsbtohU16(buffer + 12));
+        buffer += 6 + 6 + 2;
         if (m_ctrlToDs && m_ctrlFromDs)
         {
-            ReadFrom(i, m_addr4);
+            m_addr4.CopyFrom(buffer);
+            buffer += 6;
         }
         if (m_ctrlSubtype & 0x08)
         {
-            SetQosControl(i.ReadLsbtohU16());
+            SetQosControl(ReadLsbtohU16(buffer));
         }
         break;
     }
@@ -33,6 +33,8 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -92,6 +94,8 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double
     NS_LOG_FUNCTION(this << sender << ppdu << txPowerDbm);
     Ptr<MobilityModel> senderMobility = sender->GetMobility();
     NS_ASSERT(senderMobility);
+    std::vector<Simulator::ContextEvent> receptions;
+    receptions.reserve(m_phyList.size());
     for (auto i = m_phyList.begin(); i != m_phyList.end(); i++)
     {
         if (sender != (*i))
@@ -120,14 +124,11 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double
                 dstNode = dstNetDevice->GetNode()->GetId();
             }
 
-            Simulator::ScheduleWithContext(dstNode,
-                                           delay,
-                                           &YansWifiChannel::Receive,
-                                           (*i),
-                                           ppdu,
-                                           rxPowerDbm);
+            receptions.push_back(
+                {dstNode, delay, MakeEvent(&YansWifiChannel::Receive, (*i), ppdu, rxPowerDbm)});
         }
     }
+    Simulator::ScheduleWithContextBatch(receptions);
 }
 
 void
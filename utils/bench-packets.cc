@@ -147,6 +147,97 @@ BenchHeader<N>::Deserialize(Buffer::Iterator start)
     return N;
 }
 
+/**
+ * BenchFieldsHeader class used for benchmarking the serialization of the
+ * fields of a header, like the IPv4 or TCP headers, either field by field
+ * or in bulk with Buffer::Iterator::WriteSpan() and Buffer::Iterator::ReadSpan()
+ */
+template <bool SPAN>
+class BenchFieldsHeader : public Header
+{
+  public:
+    /**
+     * Register this type.
+     * \return The TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId(SPAN ? "ns3::BenchSpanHeader" : "ns3::BenchFieldsHeader")
+                                .SetParent<Header>()
+                                .SetGroupName("Utils")
+                                .HideFromDocumentation()
+                                .AddConstructor<BenchFieldsHeader<SPAN>>();
+        return tid;
+    }
+
+    TypeId GetInstanceTypeId() const override
+    {
+        return GetTypeId();
+    }
+
+    void Print(std::ostream& os) const override
+    {
+        NS_ASSERT(false);
+    }
+
+    uint32_t GetSerializedSize() const override
+    {
+        return 20;
+    }
+
+    void Serialize(Buffer::Iterator start) const override
+    {
+        if (SPAN)
+        {
+            uint8_t* buffer = start.WriteSpan(20);
+            WriteHtonU16(buffer, m_port);
+            WriteHtonU16(buffer + 2, m_port);
+            WriteHtonU32(buffer + 4, m_sequence);
+            WriteHtonU32(buffer + 8, m_sequence);
+            buffer[12] = 5 << 4;
+            buffer[13] = 0x10;
+            WriteHtonU16(buffer + 14, m_port);
+            WriteHtonU32(buffer + 16, m_sequence);
+        }
+        else
+        {
+            start.WriteHtonU16(m_port);
+            start.WriteHtonU16(m_port);
+            start.WriteHtonU32(m_sequence);
+            start.WriteHtonU32(m_sequence);
+            start.WriteU8(5 << 4);
+            start.WriteU8(0x10);
+            start.WriteHtonU16(m_port);
+            start.WriteHtonU32(m_sequence);
+        }
+    }
+
+    uint32_t Deserialize(Buffer::Iterator start) override
+    {
+        if (SPAN)
+        {
+            uint8_t scratch[20];
+            const uint8_t* buffer = start.ReadSpan(20, scratch);
+            m_port = ReadNtohU16(buffer) ^ ReadNtohU16(buffer + 2) ^ ReadNtohU16(buffer + 14);
+            m_sequence = ReadNtohU32(buffer + 4) ^ ReadNtohU32(buffer + 8);
+            m_sequence ^= ReadNtohU32(buffer + 16) ^ buffer[12] ^ buffer[13];
+        }
+        else
+        {
+            m_port = start.ReadNtohU16() ^ start.ReadNtohU16();
+            m_sequence = start.ReadNtohU32() ^ start.ReadNtohU32();
+            m_sequence ^= start.ReadU8() ^ start.ReadU8();
+            m_port ^= start.ReadNtohU16();
+            m_sequence ^= start.ReadNtohU32();
+        }
+        return 20;
+    }
+
+  private:
+    uint16_t m_port{1234};       //!< The value of the 16 bits fields
+    uint32_t m_sequence{567890}; //!< The value of the 32 bits fields
+};
+
 /// BenchTag class used for benchmarking packet serialization/deserialization
 template <int N>
 class BenchTag : public Tag
@@ -350,6 +441,60 @@ benchByteTags(uint32_t n)
     }
 }
 
+static void
+benchPacketTags(uint32_t n)
+{
+    // A typical set of packet tags riding a wireless packet: SNR, bearer,
+    // radio bearer, flow id and socket priority
+    BenchTag<8> snr;
+    BenchTag<6> bearer;
+    BenchTag<5> radioBearer;
+    BenchTag<4> flowId;
+    BenchTag<1> priority;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(2000);
+        p->AddPacketTag(priority);
+        p->AddPacketTag(flowId);
+        p->AddPacketTag(bearer);
+        Ptr<Packet> o = p->Copy();
+        o->AddPacketTag(radioBearer);
+        o->AddPacketTag(snr);
+        o->PeekPacketTag(flowId);
+        o->PeekPacketTag(priority);
+        o->ReplacePacketTag(snr);
+        o->RemovePacketTag(bearer);
+        o->RemovePacketTag(radioBearer);
+        p->RemovePacketTag(flowId);
+    }
+}
+
+/**
+ * Add and remove two headers with 16 and 32 bits fields, field by field
+ * or with spans.
+ * \tparam SPAN Whether the headers use spans
+ * \param n The number of packets
+ */
+template <bool SPAN>
+static void
+benchFields(uint32_t n)
+{
+    BenchFieldsHeader<SPAN> ipv4;
+    BenchFieldsHeader<SPAN> tcp;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(2000);
+        p->AddHeader(tcp);
+        p->AddHeader(ipv4);
+        Ptr<Packet> o = p->Copy();
+        o->RemoveHeader(ipv4);
+        o->RemoveHeader(tcp);
+        p->PeekHeader(ipv4);
+    }
+}
+
 static uint64_t
 runBenchOneIteration(void (*bench)(uint32_t), uint32_t n)
 {
@@ -382,6 +527,7 @@ main(int argc, char* argv[])
     uint32_t n = 0;
     uint32_t minIterations = 1;
     bool enablePrinting = false;
+    bool arenaMetadata = false;
 
     CommandLine cmd(__FILE__);
     cmd.Usage("Benchmark Packet class");
@@ -390,6 +536,9 @@ main(int argc, char* argv[])
                  "number of subiterations to minimize iteration time over",
                  minIterations);
     cmd.AddValue("enable-printing", "enable packet printing", enablePrinting);
+    cmd.AddValue("arena-metadata",
+                 "store the metadata of the packets in the arena backend",
+                 arenaMetadata);
     cmd.Parse(argc, argv);
 
     if (n == 0)
@@ -398,6 +547,15 @@ main(int argc, char* argv[])
                   << "by command-line argument --n=(number of packets)" << std::endl;
         exit(1);
     }
+    if (arenaMetadata)
+    {
+        PacketMetadata::SetBackend(PacketMetadata::ARENA);
+    }
+    if (enablePrinting)
+    {
+        Packet::EnablePrinting();
+    }
+
     std::cout << "Running bench-packets with n=" << n << std::endl;
     std::cout << "All tests begin by adding UDP and IPv4 headers." << std::endl;
 
@@ -407,6 +565,9 @@ main(int argc, char* argv[])
     runBench(&benchD, n, minIterations, "Intermixed add/remove headers and tags");
     runBench(&benchFragment, n, minIterations, "Fragmentation and concatenation");
     runBench(&benchByteTags, n, minIterations, "Benchmark byte tags");
+    runBench(&benchPacketTags, n, minIterations, "Benchmark packet tags");
+    runBench(&benchFields<false>, n, minIterations, "Add/remove headers field by field");
+    runBench(&benchFields<true>, n, minIterations, "Add/remove headers with spans");
 
     return 0;
 }
@@ -0,0 +1,283 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the unicast route lookups of
+// Ipv4GlobalRouting, Ipv4StaticRouting and Ipv6StaticRouting, for various
+// numbers of routes in the routing table.
+// Sample usage:  ./ns3 run 'bench-routing --n=1000000 --routes=10,1000,100000'
+
+#include "ns3/command-line.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-global-routing.h"
+#include "ns3/ipv4-route.h"
+#include "ns3/ipv4-static-routing.h"
+#include "ns3/ipv6-route.h"
+#include "ns3/ipv6-static-routing.h"
+#include "ns3/node.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \brief Create a node with an interface, numbered 1, on 10.0.0.1/8 and 2001:db8::1/64
+ * \returns the node
+ */
+static Ptr<Node>
+CreateRouter()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.Install(node);
+    Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+    device->SetAddress(Mac48Address::Allocate());
+    node->AddDevice(device);
+
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    uint32_t interface = ipv4->AddInterface(device);
+    ipv4->AddAddress(interface, Ipv4InterfaceAddress("10.0.0.1", "255.0.0.0"));
+    ipv4->SetUp(interface);
+
+    Ptr<Ipv6> ipv6 = node->GetObject<Ipv6>();
+    interface = ipv6->AddInterface(device);
+    ipv6->AddAddress(interface, Ipv6InterfaceAddress("2001:db8::1", Ipv6Prefix(64)));
+    ipv6->SetUp(interface);
+    return node;
+}
+
+/**
+ * \param i the index of a route
+ * \returns the network of the route, a /24 from 11.0.0.0 upwards
+ */
+static Ipv4Address
+GetIpv4Network(uint32_t i)
+{
+    return Ipv4Address((11U << 24) + (i << 8));
+}
+
+/**
+ * \param i the index of a route
+ * \returns the network of the route, a /64 from 2001:db8:1::/64 upwards
+ */
+static Ipv6Address
+GetIpv6Network(uint32_t i)
+{
+    uint8_t bytes[16] = {0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01};
+    bytes[6] = (i >> 8) & 0xff;
+    bytes[7] = i & 0xff;
+    bytes[5] += i >> 16;
+    return Ipv6Address(bytes);
+}
+
+/**
+ * \param routes the number of routes
+ * \param n the number of lookups
+ * \returns the destinations of the lookups, each in a random route
+ */
+static std::vector<uint32_t>
+GetDestinations(uint32_t routes, uint32_t n)
+{
+    std::vector<uint32_t> destinations(n);
+    for (auto& destination : destinations)
+    {
+        destination = rand() % routes;
+    }
+    return destinations;
+}
+
+/**
+ * \brief Benchmark the lookups of Ipv4GlobalRouting
+ * \param routes the number of routes
+ * \param n the number of lookups
+ * \returns the duration of the lookups, in ms
+ */
+static uint64_t
+benchGlobal(uint32_t routes, uint32_t n)
+{
+    Ptr<Node> node = CreateRouter();
+    Ptr<Ipv4GlobalRouting> routing = CreateObject<Ipv4GlobalRouting>();
+    routing->SetIpv4(node->GetObject<Ipv4>());
+    routing->AddNetworkRouteTo("10.0.0.0", "255.0.0.0", 1);
+    for (uint32_t i = 0; i < routes; i++)
+    {
+        routing->AddNetworkRouteTo(GetIpv4Network(i), "255.255.255.0", "10.0.0.2", 1);
+    }
+    std::vector<uint32_t> destinations = GetDestinations(routes, n);
+
+    Ipv4Header header;
+    Socket::SocketErrno sockerr;
+    SystemWallClockMs time;
+    time.Start();
+    for (uint32_t destination : destinations)
+    {
+        header.SetDestination(Ipv4Address(GetIpv4Network(destination).Get() + 1));
+        routing->RouteOutput(nullptr, header, nullptr, sockerr);
+    }
+    uint64_t deltaMs = time.End();
+    routing->Dispose();
+    node->Dispose();
+    return deltaMs;
+}
+
+/**
+ * \brief Benchmark the lookups of Ipv4StaticRouting
+ * \param routes the number of routes
+ * \param n the number of lookups
+ * \returns the duration of the lookups, in ms
+ */
+static uint64_t
+benchIpv4Static(uint32_t routes, uint32_t n)
+{
+    Ptr<Node> node = CreateRouter();
+    Ptr<Ipv4StaticRouting> routing = CreateObject<Ipv4StaticRouting>();
+    routing->SetIpv4(node->GetObject<Ipv4>());
+    routing->SetDefaultRoute("10.0.0.2", 1);
+    for (uint32_t i = 0; i < routes; i++)
+    {
+        routing->AddNetworkRouteTo(GetIpv4Network(i), "255.255.255.0", "10.0.0.2", 1);
+    }
+    std::vector<uint32_t> destinations = GetDestinations(routes, n);
+
+    Ipv4Header header;
+    Socket::SocketErrno sockerr;
+    SystemWallClockMs time;
+    time.Start();
+    for (uint32_t destination : destinations)
+    {
+        header.SetDestination(Ipv4Address(GetIpv4Network(destination).Get() + 1));
+        routing->RouteOutput(nullptr, header, nullptr, sockerr);
+    }
+    uint64_t deltaMs = time.End();
+    routing->Dispose();
+    node->Dispose();
+    return deltaMs;
+}
+
+/**
+ * \brief Benchmark the lookups of Ipv6StaticRouting
+ * \param routes the number of routes
+ * \param n the number of lookups
+ * \returns the duration of the lookups, in ms
+ */
+static uint64_t
+benchIpv6Static(uint32_t routes, uint32_t n)
+{
+    Ptr<Node> node = CreateRouter();
+    Ptr<Ipv6StaticRouting> routing = CreateObject<Ipv6StaticRouting>();
+    routing->SetIpv6(node->GetObject<Ipv6>());
+    routing->SetDefaultRoute("2001:db8::2", 1);
+    for (uint32_t i = 0; i < routes; i++)
+    {
+        routing->AddNetworkRouteTo(GetIpv6Network(i), Ipv6Prefix(64), "2001:db8::2", 1);
+    }
+    std::vector<uint32_t> destinations = GetDestinations(routes, n);
+
+    Ipv6Header header;
+    Socket::SocketErrno sockerr;
+    SystemWallClockMs time;
+    time.Start();
+    for (uint32_t destination : destinations)
+    {
+        uint8_t bytes[16];
+        GetIpv6Network(destination).GetBytes(bytes);
+        bytes[15] = 1;
+        header.SetDestination(Ipv6Address(bytes));
+        routing->RouteOutput(nullptr, header, nullptr, sockerr);
+    }
+    uint64_t deltaMs = time.End();
+    routing->Dispose();
+    node->Dispose();
+    return deltaMs;
+}
+
+/**
+ * \brief Run a benchmark, and print the number of lookups per second
+ * \param bench the benchmark
+ * \param routes the number of routes
+ * \param n the number of lookups
+ * \param minIterations the number of runs to minimize the duration over
+ * \param name the name of the benchmark
+ */
+static void
+runBench(uint64_t (*bench)(uint32_t, uint32_t),
+         uint32_t routes,
+         uint32_t n,
+         uint32_t minIterations,
+         const char* name)
+{
+    uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        minDelay = std::min(minDelay, (*bench)(routes, n));
+    }
+    double ps = n;
+    ps *= 1000;
+    ps /= std::max<uint64_t>(minDelay, 1);
+    std::cout << ps << " lookups/s"
+              << " (" << minDelay << " ms elapsed)\t" << routes << " routes\t" << name
+              << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 0;
+    uint32_t minIterations = 1;
+    std::string routes = "10,100,1000,10000,100000";
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the route lookups of the unicast routing protocols");
+    cmd.AddValue("n", "number of lookups", n);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.AddValue("routes", "comma-separated numbers of routes (at most 1048576)", routes);
+    cmd.Parse(argc, argv);
+
+    if (n == 0)
+    {
+        std::cerr << "Error-- number of lookups must be specified "
+                  << "by command-line argument --n=(number of lookups)" << std::endl;
+        exit(1);
+    }
+    std::cout << "Running bench-routing with n=" << n << std::endl;
+
+    std::istringstream iss(routes);
+    std::string size;
+    while (std::getline(iss, size, ','))
+    {
+        uint32_t nRoutes = std::stoul(size);
+        if (nRoutes == 0 || nRoutes > 1048576)
+        {
+            std::cerr << "Error-- bad number of routes " << size << std::endl;
+            exit(1);
+        }
+        runBench(&benchGlobal, nRoutes, n, minIterations, "Ipv4GlobalRouting");
+        runBench(&benchIpv4Static, nRoutes, n, minIterations, "Ipv4StaticRouting");
+        runBench(&benchIpv6Static, nRoutes, n, minIterations, "Ipv6StaticRouting");
+    }
+    Simulator::Destroy();
+
+    return 0;
+}
@@ -0,0 +1,175 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark TcpTxBuffer and TcpRxBuffer during
+// the loss recovery of a large window, in which every other segment is lost.
+// Sample usage:  ./ns3 run 'bench-tcp-buffers --windows=1000,10000,100000'
+
+#include "ns3/command-line.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/tcp-header.h"
+#include "ns3/tcp-option-sack.h"
+#include "ns3/tcp-rx-buffer.h"
+#include "ns3/tcp-tx-buffer.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+
+/// The size of the segments
+static const uint32_t SEGMENT_SIZE = 1448;
+
+/**
+ * \brief Benchmark the sender buffer
+ *
+ * The window is sent, the odd segments are selectively acknowledged one at
+ * a time, the even segments found lost are retransmitted, and the window is
+ * acknowledged.
+ *
+ * \param segments the number of segments of the window
+ * \returns the duration of the recovery, in ms
+ */
+static uint64_t
+benchTx(uint32_t segments)
+{
+    TcpTxBuffer txBuf(1);
+    txBuf.SetMaxBufferSize(std::numeric_limits<uint32_t>::max());
+    txBuf.SetSegmentSize(SEGMENT_SIZE);
+    txBuf.SetDupAckThresh(3);
+    txBuf.Add(Create<Packet>(segments * SEGMENT_SIZE));
+    for (uint32_t i = 0; i < segments; i++)
+    {
+        txBuf.CopyFromSequence(SEGMENT_SIZE, SequenceNumber32(1 + i * SEGMENT_SIZE));
+    }
+
+    SystemWallClockMs time;
+    time.Start();
+    TcpOptionSack::SackList sackList(1);
+    for (uint32_t i = 1; i < segments; i += 2)
+    {
+        SequenceNumber32 seq(1 + i * SEGMENT_SIZE);
+        sackList.front() = TcpOptionSack::SackBlock(seq, seq + SEGMENT_SIZE);
+        txBuf.Update(sackList);
+    }
+
+    for (uint32_t i = 0; i < segments; i += 2)
+    {
+        SequenceNumber32 seq(1 + i * SEGMENT_SIZE);
+        if (txBuf.IsLost(seq))
+        {
+            txBuf.CopyFromSequence(SEGMENT_SIZE, seq);
+        }
+    }
+    txBuf.DiscardUpTo(SequenceNumber32(1 + segments * SEGMENT_SIZE));
+    return time.End();
+}
+
+/**
+ * \brief Benchmark the receiver buffer
+ *
+ * The odd segments of the window are received, then the even ones, and
+ * the window is extracted.
+ *
+ * \param segments the number of segments of the window
+ * \returns the duration of the reception, in ms
+ */
+static uint64_t
+benchRx(uint32_t segments)
+{
+    TcpRxBuffer rxBuf(1);
+    rxBuf.SetMaxBufferSize(std::numeric_limits<uint32_t>::max() / 2);
+    Ptr<Packet> segment = Create<Packet>(SEGMENT_SIZE);
+    TcpHeader header;
+
+    SystemWallClockMs time;
+    time.Start();
+    for (uint32_t first : {1, 0})
+    {
+        for (uint32_t i = first; i < segments; i += 2)
+        {
+            header.SetSequenceNumber(SequenceNumber32(1 + i * SEGMENT_SIZE));
+            rxBuf.Add(segment->Copy(), header);
+        }
+    }
+    while (rxBuf.Extract(64 * SEGMENT_SIZE))
+    {
+    }
+    return time.End();
+}
+
+/**
+ * \brief Run a benchmark, and print the number of segments per second
+ * \param bench the benchmark
+ * \param segments the number of segments of the window
+ * \param minIterations the number of runs to minimize the duration over
+ * \param name the name of the benchmark
+ */
+static void
+runBench(uint64_t (*bench)(uint32_t),
+         uint32_t segments,
+         uint32_t minIterations,
+         const char* name)
+{
+    uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        minDelay = std::min(minDelay, (*bench)(segments));
+    }
+    double ps = segments;
+    ps *= 1000;
+    ps /= std::max<uint64_t>(minDelay, 1);
+    std::cout << ps << " segments/s"
+              << " (" << minDelay << " ms elapsed)\t" << segments << " segments\t" << name
+              << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t minIterations = 1;
+    std::string windows = "1000,10000,100000";
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the TCP buffers during the loss recovery of large windows");
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.AddValue("windows", "comma-separated numbers of segments of the windows", windows);
+    cmd.Parse(argc, argv);
+
+    std::istringstream iss(windows);
+    std::string size;
+    while (std::getline(iss, size, ','))
+    {
+        uint32_t segments = std::stoul(size);
+        if (segments == 0 || segments > 1000000)
+        {
+            std::cerr << "Error-- bad number of segments " << size << std::endl;
+            exit(1);
+        }
+        runBench(&benchTx, segments, minIterations, "TcpTxBuffer");
+        runBench(&benchRx, segments, minIterations, "TcpRxBuffer");
+    }
+    Simulator::Destroy();
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program converts a binary trace file, written by BinaryTraceHelper,
+// to the text format of the ascii traces.
+// Sample usage:  ./ns3 run 'binary-trace-to-ascii --input=trace.bin --output=trace.tr'
+
+#include "ns3/binary-trace.h"
+#include "ns3/command-line.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    std::string input;
+    std::string output;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Convert a binary trace file to the text format of the ascii traces");
+    cmd.AddValue("input", "the binary trace file", input);
+    cmd.AddValue("output", "the text file, or the standard output if empty", output);
+    cmd.Parse(argc, argv);
+
+    BinaryTraceReader reader;
+    reader.Open(input);
+    if (reader.Fail())
+    {
+        std::cerr << "Error-- " << input << " is not a binary trace file" << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!output.empty())
+    {
+        file.open(output);
+        if (file.fail())
+        {
+            std::cerr << "Error-- unable to open " << output << " for write" << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& os = output.empty() ? std::cout : file;
+    uint64_t n = reader.WriteAscii(os);
+    os.flush();
+    std::cerr << n << " records converted" << std::endl;
+
+    return 0;
+}